@@ -0,0 +1,74 @@
+#ifndef BIRDS_EYE_PERSPECTIVE_H_
+#define BIRDS_EYE_PERSPECTIVE_H_
+
+#include <vector>
+
+#include <opencv/cv.h>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/ModelCoefficients.h>
+
+/**
+ * Computes the coordinate system of the floor plane and the homography from the camera image to the bird's eye perspective of the floor.
+ *
+ *	@param [in] 	input_cloud 				Organized point cloud of the camera image.
+ *	@param [in] 	plane_color_image 			Camera image that is black at all pixels which do not belong to the floor plane.
+ *	@param [in] 	plane_model 				Floor plane in camera coordinates.
+ *	@param [in] 	birdEyeResolution 			Resolution of the bird's eye perspective [pixel/m].
+ *	@param [in] 	maxDistanceToCamera 		Only floor points closer to the camera are used [m].
+ *	@param [out] 	H 							Homography that maps points from the camera plane to the floor plane, i.e. pp = H*pc
+ *	@param [out] 	R 							Rotation matrix for transformation between floor plane and world coordinates, i.e. [xw,yw,zw] = R*[xp,yp,0]+t and [xp,yp,0] = R^T*[xw,yw,zw] - R^T*t
+ *	@param [out] 	t 							Translation vector. See Rotation matrix.
+ *	@param [out] 	cameraImagePlaneOffset 		Offset in the camera image plane. Conversion from floor plane to  [xc, yc]
+ *	@return 		False if there are not enough floor points for the homography.
+ */
+bool computeFloorPlaneHomography(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const cv::Mat& plane_color_image, const pcl::ModelCoefficients& plane_model,
+		const double birdEyeResolution, const double maxDistanceToCamera, cv::Mat& H, cv::Mat& R, cv::Mat& t, cv::Point2f& cameraImagePlaneOffset);
+
+/**
+ * Computes cv::remap lookup tables (fixed point, CV_16SC2 and CV_16UC1) which warp an image of the given size with the homography H, like cv::warpPerspective.
+ */
+void computePerspectiveRemapTables(const cv::Mat& H, const cv::Size& size, cv::Mat& map1, cv::Mat& map2);
+
+/**
+ * Homography and remap tables of the last floor plane, see warpToBirdsEyePerspective.
+ */
+struct BirdsEyeWarpCache
+{
+	std::vector<int> planeKey;		// quantized floor plane model
+	cv::Size imageSize;				// size of the camera image
+	double birdEyeResolution;		// birdEyeResolution at the time of computation
+	double maxDistanceToCamera;		// maxDistanceToCamera at the time of computation
+	cv::Mat H, R, t;				// see computeFloorPlaneHomography
+	cv::Point2f cameraImagePlaneOffset;
+	cv::Mat map1, map2;				// cv::remap lookup tables (fixed point) that realize the warp with H
+	bool valid;
+
+	BirdsEyeWarpCache() : birdEyeResolution(0.), maxDistanceToCamera(0.), valid(false) {}
+};
+
+/**
+ * Warps the floor plane of the camera image into the bird's eye perspective.
+ *
+ * The floor plane hardly changes relative to the camera, so the homography and the remap tables are kept in cache and reused for the following
+ * frames as long as the floor plane model quantized with birdEyeWarpCacheQuantization, the image size and the bird's eye parameters do not change.
+ *
+ *	@param [in] 	input_cloud 				Organized point cloud of the camera image.
+ *	@param [in] 	plane_color_image 			Camera image that is black at all pixels which do not belong to the floor plane.
+ *	@param [in] 	plane_mask 					Mask of the floor plane pixels (255).
+ *	@param [in] 	plane_model 				Floor plane in camera coordinates.
+ *	@param [in] 	birdEyeResolution 			Resolution of the bird's eye perspective [pixel/m].
+ *	@param [in] 	maxDistanceToCamera 		Only floor points closer to the camera are used [m].
+ *	@param [in] 	birdEyeWarpCacheQuantization	Quantization of the plane model for the cache lookup (0 = no cache, warp with cv::warpPerspective).
+ *	@param [in,out]	cache 						Homography and remap tables of the last floor plane.
+ *	@param [out] 	H, R, t, cameraImagePlaneOffset	See computeFloorPlaneHomography.
+ *	@param [out] 	plane_color_image_warped 	plane_color_image in the bird's eye perspective.
+ *	@param [out] 	plane_mask_warped 			plane_mask in the bird's eye perspective.
+ *	@return 		False if there are not enough floor points for the homography.
+ */
+bool warpToBirdsEyePerspective(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const cv::Mat& plane_color_image, const cv::Mat& plane_mask, const pcl::ModelCoefficients& plane_model,
+		const double birdEyeResolution, const double maxDistanceToCamera, const double birdEyeWarpCacheQuantization, BirdsEyeWarpCache& cache,
+		cv::Mat& H, cv::Mat& R, cv::Mat& t, cv::Point2f& cameraImagePlaneOffset, cv::Mat& plane_color_image_warped, cv::Mat& plane_mask_warped);
+
+#endif /* BIRDS_EYE_PERSPECTIVE_H_ */
@@ -0,0 +1,174 @@
+#ifndef DIRT_DETECTION_STAGES_H_
+#define DIRT_DETECTION_STAGES_H_
+
+#include <vector>
+
+#include <opencv/cv.h>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/ModelCoefficients.h>
+
+#include "autopnp_dirt_detection/spectral_residual_saliency.h"
+#include "autopnp_dirt_detection/label_box.h"
+
+/**
+ * Pose of the camera in the /map frame, pointMap = rotation*pointCamera + translation.
+ */
+struct CameraPose
+{
+	cv::Matx33d rotation;
+	cv::Vec3d translation;
+};
+
+/**
+ * Conditions that a plane has to fulfill to be accepted as floor plane.
+ */
+struct FloorPlaneCriteria
+{
+	int minPlanePoints;			// minimum number of inliers of the floor plane
+	double planeNormalMaxZ;		// maximum z-value of the plane normal in the /map frame (ensures to have an floor plane)
+	double planeMaxHeight;		// maximum height of the plane above the mapped ground
+	bool checkPose;				// if false, only the number of inliers is checked (no localization available)
+};
+
+/**
+ * Floor plane of the last frame, used as initial guess for the next frame (see trackFloorPlane).
+ */
+struct FloorPlaneTrack
+{
+	pcl::ModelCoefficients planeModel;	// floor plane of the last frame
+	double referenceInlierRatio;		// inlier ratio on the subsampled point cloud when the plane was found with RANSAC
+	bool valid;
+
+	FloorPlaneTrack() : referenceInlierRatio(0.), valid(false) {}
+};
+
+/**
+ * Normalization statistics of the saliency image with artificial dirt (see updateArtificialDirtStatistics).
+ */
+struct ArtificialDirtStatistics
+{
+	double minv;		// minimum of the saliency image with artificial dirt
+	double maxv;		// maximum of the saliency image with artificial dirt
+	cv::Scalar mean;	// mean of the saliency image with artificial dirt within the floor mask
+	cv::Scalar stdDev;	// standard deviation of the saliency image with artificial dirt within the floor mask
+	cv::Size imageSize;	// size of the image the statistics were computed on
+	int framesSinceUpdate;	// number of frames that used these statistics
+	bool valid;
+
+	ArtificialDirtStatistics() : minv(0.), maxv(0.), framesSinceUpdate(0), valid(false) {}
+};
+
+/// collects the indices of all points of every step-th row and column of the organized input_cloud that lie within inlier_threshold of the plane, returns the number of valid points in the subsample
+int collectSubsampledPlaneInliers(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const pcl::ModelCoefficients& plane_model, const double inlier_threshold, const int step, std::vector<int>& inlier_indices);
+
+/// checks whether a plane with number_inliers inliers through plane_point is a valid floor plane (normal and height in the map frame)
+bool isValidFloorPlane(const pcl::ModelCoefficients& plane_model, const pcl::PointXYZRGB& plane_point, const int number_inliers, const FloorPlaneCriteria& criteria, const CameraPose& pose);
+
+/**
+ * Tries to find the floor plane close to the floor plane of the last frame, which saves the RANSAC search in most frames.
+ *
+ * The plane of the last frame is refined by a least squares fit to its inliers on a subsample of the organized point cloud.
+ * The refined plane is accepted if it is a valid floor plane and its inlier ratio did not drop below planeTrackingMinInlierRatio
+ * times the inlier ratio of the last RANSAC fit.
+ *
+ *	@param [in] 	input_cloud 				Organized point cloud.
+ *	@param [in] 	plane_inlier_threshold 		Maximum distance of inliers to the plane [m].
+ *	@param [in] 	planeTrackingSubsamplingStep	Every planeTrackingSubsamplingStep-th point of the point cloud is checked in both directions.
+ *	@param [in] 	planeTrackingMinInlierRatio	Minimum fraction of the reference inlier ratio.
+ *	@param [in,out]	track 						Floor plane of the last frame, updated if successful.
+ *	@param [out] 	plane_model 				The tracked floor plane, if successful.
+ *	@return 		True if the floor plane could be tracked.
+ */
+bool trackFloorPlane(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const double plane_inlier_threshold, const int planeTrackingSubsamplingStep, const double planeTrackingMinInlierRatio,
+		const FloorPlaneCriteria& criteria, const CameraPose& pose, FloorPlaneTrack& track, pcl::ModelCoefficients& plane_model);
+
+/**
+ * Finds the floor plane in the point cloud. The floor plane of the last frame is tracked first (if planeTrackingSubsamplingStep > 0),
+ * if this fails up to floorSearchIterations planes are searched with RANSAC until a valid floor plane is found.
+ *
+ *	@param [in] 	input_cloud 				Organized point cloud.
+ *	@param [in] 	plane_inlier_threshold 		Maximum distance of inliers to the plane [m].
+ *	@param [in] 	floorSearchIterations 		Maximum number of RANSAC planes that are checked.
+ *	@param [in] 	planeTrackingSubsamplingStep	See trackFloorPlane (0 = no tracking, always use RANSAC).
+ *	@param [in] 	planeTrackingMinInlierRatio	See trackFloorPlane.
+ *	@param [in,out]	track 						Floor plane of the last frame.
+ *	@param [out] 	plane_model 				The floor plane in camera coordinates with its normal pointing upwards.
+ *	@return 		True if a valid floor plane was found.
+ */
+bool findFloorPlane(const pcl::PointCloud<pcl::PointXYZRGB>::Ptr& input_cloud, const double plane_inlier_threshold, const int floorSearchIterations, const int planeTrackingSubsamplingStep,
+		const double planeTrackingMinInlierRatio, const FloorPlaneCriteria& criteria, const CameraPose& pose, FloorPlaneTrack& track, pcl::ModelCoefficients& plane_model);
+
+/**
+ * Creates the color image and the mask of all pixels that lie on the floor plane.
+ *
+ *	@param [out] 	plane_color_image 			Shows the true color of all pixel within the plane, all other pixels are black.
+ *	@param [out]	plane_mask					Plane pixels are white (255), all other pixels are black (0).
+ *	@param [out]	inlier_indices				Indices of all floor plane points in input_cloud.
+ */
+void extractFloorPlaneImage(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const pcl::ModelCoefficients& plane_model, const double plane_inlier_threshold,
+		cv::Mat& plane_color_image, cv::Mat& plane_mask, std::vector<int>& inlier_indices);
+
+/**
+ * Performs the saliency detection for a 3 channel color image.
+ *
+ * The function proceeds as follows:
+ * 						1.) The spectral residual of all 3 channels is computed in one pass and averaged (see SpectralResidualSaliency).
+ * 						2.) The result is smoothed and resized to the input size.
+ * 						3.) Responses at the border of the mask and of the image are removed.
+ *
+ * @param [in,out]	spectralResidualSaliency	Buffers of the spectral residual, reused between frames.
+ * @param [in]		spectralResidualImageSizeRatio	The image is scaled by this factor before the saliency detection.
+ * @param [in] 	C3_color_image			!!!THREE CHANNEL!!!('C3') image used to perform the saliency detection.
+ * @param [out]	C1_saliency_image		One channel image('C1') which results from the saliency detection.
+ * @param [in] 	mask					Determines the area of interest. Pixel of interests are white (255), all other pixels are black (0).
+ * @param [in]	gaussianBlurCycles		Determines the number of repetitions of the gaussian filter used to reduce the noise.
+ */
+void saliencyDetection_C3(SpectralResidualSaliency& spectralResidualSaliency, const double spectralResidualImageSizeRatio, const cv::Mat& C3_color_image,
+		cv::Mat& C1_saliency_image, const cv::Mat* mask, const int gaussianBlurCycles);
+
+/**
+ * Updates the normalization statistics with the saliency of the image with artificial dirt. The statistics change slowly with the floor appearance,
+ * so they are only recomputed every artificialDirtStatisticsUpdateInterval frames or if the image size changes.
+ *
+ * @param [out]	color_image_with_artificial_dirt		If not 0, receives the color image with artificial dirt when the statistics were recomputed.
+ * @param [out]	C1_saliency_image_with_artificial_dirt	If not 0, receives its saliency image when the statistics were recomputed.
+ * @param [out]	mask_with_artificial_dirt				If not 0, receives its mask when the statistics were recomputed.
+ * @return		True if the statistics were recomputed.
+ */
+bool updateArtificialDirtStatistics(SpectralResidualSaliency& spectralResidualSaliency, const double spectralResidualImageSizeRatio, const int gaussianBlurCycles,
+		const int artificialDirtStatisticsUpdateInterval, const cv::Mat& C3_color_image, const cv::Mat& mask, ArtificialDirtStatistics& statistics,
+		cv::Mat* color_image_with_artificial_dirt = 0, cv::Mat* C1_saliency_image_with_artificial_dirt = 0, cv::Mat* mask_with_artificial_dirt = 0);
+
+/**
+ * Scales the saliency image with the statistics of the image with artificial dirt, i.e. scaled = scale*C1_saliency_image + offset
+ * with the maximum response limited by spectralResidualNormalizationHighestMaxValue.
+ */
+void normalizeSaliency(const cv::Mat& C1_saliency_image, const ArtificialDirtStatistics& statistics, const double spectralResidualNormalizationHighestMaxValue,
+		cv::Mat& scaled_C1_saliency_image, double* scale = 0, double* offset = 0);
+
+/**
+ * Removes the saliency responses on strong lines of the color image. If line_image is not 0, it receives the edge image with the detected lines in red.
+ */
+void removeLineResponses(const cv::Mat& C3_color_image, cv::Mat& scaled_C1_saliency_image, cv::Mat* line_image = 0);
+
+/**
+ * Thresholds the normalized saliency image and returns the rotated bounding boxes of all dirt regions.
+ *
+ * @param [out]	C1_BlackWhite_image		One channel('C1') image in which all dirt pixels are 1 and all other pixels are 0.
+ * @param [out]	contours				If not 0, receives the contour of every dirt region in the order of dirtDetections.
+ */
+void extractDirtRegions(const cv::Mat& scaled_C1_saliency_image, const double dirtThreshold, cv::Mat& C1_BlackWhite_image, std::vector<cv::RotatedRect>& dirtDetections,
+		std::vector<std::vector<cv::Point> >* contours = 0);
+
+/**
+ * Samples all points along the principal axes of the detection and counts the detection in each grid cell of the map once.
+ *
+ * @param [in,out]	grid			Grid map (CV_32SC1) with the number of detections per cell.
+ * @param [in]		gridOrigin		Position of grid cell (0,0) in the /map frame [m].
+ * @param [in]		gridResolution	Resolution of the grid [cells/m].
+ */
+void putDetectionIntoGrid(cv::Mat& grid, const labelImage::RegionPointTriple& detection, const cv::Point2d& gridOrigin, const double gridResolution);
+
+#endif /* DIRT_DETECTION_STAGES_H_ */
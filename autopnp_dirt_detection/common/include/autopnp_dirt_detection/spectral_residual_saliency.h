@@ -0,0 +1,56 @@
+#ifndef SPECTRAL_RESIDUAL_SALIENCY_H_
+#define SPECTRAL_RESIDUAL_SALIENCY_H_
+
+#include <vector>
+
+#include <opencv/cv.h>
+
+/**
+ *  Computes the spectral residual saliency (Hou and Zhang, Saliency Detection: A Spectral Residual Approach, CVPR 2007)
+ *  of all channels of an image in one pass.
+ *
+ *  The image is resized once for all channels, the channels are transformed with a real-input DFT and the phase is kept by
+ *  scaling the real and imaginary parts with the ratio of the new and the old magnitude, i.e. without any atan2/sin/cos calls.
+ *  The working size is rounded to a size that the DFT handles efficiently (cv::getOptimalDFTSize) and all buffers are kept
+ *  between calls, so that a stream of equally sized images is processed without any memory allocations.
+ *  The object is not thread-safe, use one instance per thread.
+ */
+class SpectralResidualSaliency
+{
+public:
+
+	SpectralResidualSaliency();
+
+	/**
+	 * Computes the saliency of an image with any number of 8 bit channels.
+	 *
+	 * @param [in] 	image					Image used to perform the saliency detection (CV_8UC1 or CV_8UC3).
+	 * @param [out]	saliency_image			One channel image (CV_32FC1) with the average saliency of all channels, its size is the working size of the DFT.
+	 * @param [in]	image_size_ratio		The image is scaled by this factor (and then rounded to an efficient DFT size) before the saliency detection.
+	 */
+	void computeSaliency(const cv::Mat& image, cv::Mat& saliency_image, const double image_size_ratio);
+
+	/**
+	 * Returns the size of the images that the DFT is computed on for a given input size and size ratio.
+	 */
+	static cv::Size getWorkingSize(const cv::Size& image_size, const double image_size_ratio);
+
+protected:
+
+	/**
+	 * Replaces the magnitude of the spectrum by the exponential of the spectral residual, i.e. the log magnitude minus its 3x3 average, and keeps the phase.
+	 */
+	void computeResidualSpectrum();
+
+	cv::Mat resized_image_;				///< input image at the working size
+	cv::Mat float_image_;				///< resized image scaled to [0,1]
+	std::vector<cv::Mat> channels_;		///< channels of float_image_
+	cv::Mat spectrum_;					///< complex spectrum of one channel (CV_32FC2)
+	cv::Mat log_magnitude_;				///< log magnitude of spectrum_
+	cv::Mat padded_log_magnitude_;		///< log_magnitude_ with a periodic border of one pixel
+	cv::Mat average_log_magnitude_;		///< 3x3 average of padded_log_magnitude_
+	cv::Mat channel_saliency_;			///< saliency of one channel
+	cv::Mat saliency_sum_;				///< sum of the saliency of all channels
+};
+
+#endif /* SPECTRAL_RESIDUAL_SALIENCY_H_ */
@@ -0,0 +1,272 @@
+#include "autopnp_dirt_detection/birds_eye_perspective.h"
+
+#include <vector>
+#include <algorithm>
+
+
+bool computeFloorPlaneHomography(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const cv::Mat& plane_color_image, const pcl::ModelCoefficients& plane_model,
+		const double birdEyeResolution, const double maxDistanceToCamera, cv::Mat& H, cv::Mat& R, cv::Mat& t, cv::Point2f& cameraImagePlaneOffset)
+{
+	// 1. compute parameter representation of plane, construct plane coordinate system and compute transformation from camera frame (x,y,z) to plane frame (x,y,z)
+	// a) parameter form of plane equation
+	// choose two arbitrary points on the plane
+	cv::Point3d p1, p2;
+	double a=plane_model.values[0], b=plane_model.values[1], c=plane_model.values[2], d=plane_model.values[3];
+	if (a==0. && b==0.)
+	{
+		p1.x = 0;
+		p1.y = 0;
+		p1.z = -d/c;
+		p2.x = 1;
+		p2.y = 0;
+		p2.z = -d/c;
+	}
+	else if (a==0. && c==0.)
+	{
+		p1.x = 0;
+		p1.y = -d/b;
+		p1.z = 0;
+		p2.x = 1;
+		p2.y = -d/b;
+		p2.z = 0;
+	}
+	else if (b==0. && c==0.)
+	{
+		p1.x = -d/a;
+		p1.y = 0;
+		p1.z = 0;
+		p2.x = -d/a;
+		p2.y = 1;
+		p2.z = 0;
+	}
+	else if (a==0.)
+	{
+		p1.x = 0;
+		p1.y = 0;
+		p1.z = -d/c;
+		p2.x = 1;
+		p2.y = 0;
+		p2.z = -d/c;
+	}
+	else if (b==0.)
+	{
+		p1.x = 0;
+		p1.y = 0;
+		p1.z = -d/c;
+		p2.x = 0;
+		p2.y = 1;
+		p2.z = -d/c;
+	}
+	else if (c==0.)
+	{
+		p1.x = -d/a;
+		p1.y = 0;
+		p1.z = 0;
+		p2.x = -d/a;
+		p2.y = 0;
+		p2.z = 1;
+	}
+	else
+	{
+		p1.x = 0;
+		p1.y = 0;
+		p1.z = -d/c;
+		p2.x = 1;
+		p2.y = 0;
+		p2.z = (-d-a)/c;
+	}
+	// compute two normalized directions
+	cv::Point3d dirS, dirT, normal(a,b,c);
+	double lengthNormal = cv::norm(normal);
+//	if (c<0.)
+//		lengthNormal *= -1;
+	normal.x /= lengthNormal;
+	normal.y /= lengthNormal;
+	normal.z /= lengthNormal;
+	dirS = p2-p1;
+	double lengthS = cv::norm(dirS);
+	dirS.x /= lengthS;
+	dirS.y /= lengthS;
+	dirS.z /= lengthS;
+	dirT.x = normal.y*dirS.z - normal.z*dirS.y;
+	dirT.y = normal.z*dirS.x - normal.x*dirS.z;
+	dirT.z = normal.x*dirS.y - normal.y*dirS.x;
+	double lengthT = cv::norm(dirT);
+	dirT.x /= lengthT;
+	dirT.y /= lengthT;
+	dirT.z /= lengthT;
+
+	// b) construct plane coordinate system
+	// plane coordinate frame has center p1 and x-axis=dirS, y-axis=dirT, z-axis=normal
+
+	// c) compute transformation from camera frame (x,y,z) to plane frame (x,y,z)
+	t = (cv::Mat_<double>(3,1) << p1.x, p1.y, p1.z);
+	R = (cv::Mat_<double>(3,3) << dirS.x, dirT.x, normal.x, dirS.y, dirT.y, normal.y, dirS.z, dirT.z, normal.z);
+
+//		std::cout << "t: " << p1.x << ", " << p1.y << ", " << p1.z << std::endl;
+//		std::cout << "dirS: " << dirS.x << ", " << dirS.y << ", " << dirS.z << std::endl;
+//		std::cout << "dirT: " << dirT.x << ", " << dirT.y << ", " << dirT.z << std::endl;
+//		std::cout << "normal: " << normal.x << ", " << normal.y << ", " << normal.z << std::endl;
+
+	// 2. select data segment and compute final transformation of camera coordinates to scaled and centered plane coordinates
+	std::vector<cv::Point2f> pointsCamera, pointsPlane;
+	cv::Point2f minPlane(1e20,1e20), maxPlane(-1e20,-1e20);
+	// [xp,yp] = first two rows of R^T*[xc,yc,zc] - R^T*t, the columns of R are dirS, dirT and normal
+	const double RTt_x = dirS.x*p1.x + dirS.y*p1.y + dirS.z*p1.z;
+	const double RTt_y = dirT.x*p1.x + dirT.y*p1.y + dirT.z*p1.z;
+	const double maxSquaredDistanceToCamera = maxDistanceToCamera*maxDistanceToCamera;
+	for (int v=0; v<plane_color_image.rows; v++)
+	{
+		for (int u=0; u<plane_color_image.cols; u++)
+		{
+			// black pixels are not part of the plane
+			const cv::Vec3b& color = plane_color_image.at<cv::Vec3b>(v,u);
+			if (color[0]==0 && color[1]==0 && color[2]==0)
+				continue;
+
+			// distance to camera has to be below a maximum distance
+			const pcl::PointXYZRGB& point = input_cloud[v*plane_color_image.cols+u];
+			if (point.x*point.x + point.y*point.y + point.z*point.z > maxSquaredDistanceToCamera)
+				continue;
+
+			// determine max and min x and y coordinates of the plane
+			const cv::Point2f pointPlane(dirS.x*point.x + dirS.y*point.y + dirS.z*point.z - RTt_x, dirT.x*point.x + dirT.y*point.y + dirT.z*point.z - RTt_y);
+			pointsCamera.push_back(cv::Point2f(u,v));
+			pointsPlane.push_back(pointPlane);
+
+			minPlane.x = std::min(minPlane.x, pointPlane.x);
+			maxPlane.x = std::max(maxPlane.x, pointPlane.x);
+			minPlane.y = std::min(minPlane.y, pointPlane.y);
+			maxPlane.y = std::max(maxPlane.y, pointPlane.y);
+		}
+	}
+
+	// 3. find homography between image plane and plane coordinates
+	// a) collect point correspondences
+	if (pointsCamera.size()<100)
+		return false;
+	double step = std::max(1.0, (double)pointsCamera.size()/100.0);
+	std::vector<cv::Point2f> correspondencePointsCamera, correspondencePointsPlane;
+	cameraImagePlaneOffset = cv::Point2f((maxPlane.x+minPlane.x)/2.f - (double)plane_color_image.cols/(2*birdEyeResolution), (maxPlane.y+minPlane.y)/2.f - (double)plane_color_image.rows/(2*birdEyeResolution));
+	for (double i=0; i<(double)pointsCamera.size(); i+=step)
+	{
+		correspondencePointsCamera.push_back(pointsCamera[(int)i]);
+		correspondencePointsPlane.push_back(birdEyeResolution*(pointsPlane[(int)i]-cameraImagePlaneOffset));
+	}
+	// b) compute homography
+	H = cv::findHomography(correspondencePointsCamera, correspondencePointsPlane);
+	if (H.empty() == true)
+		return false;
+//		correspondencePointsCamera.push_back(cv::Point2f(160,400));
+//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
+//		correspondencePointsCamera.push_back(cv::Point2f(320,400));
+//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
+//		correspondencePointsCamera.push_back(cv::Point2f(480,400));
+//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
+//		correspondencePointsCamera.push_back(cv::Point2f(160,200));
+//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
+//		correspondencePointsCamera.push_back(cv::Point2f(320,200));
+//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
+//		correspondencePointsCamera.push_back(cv::Point2f(480,200));
+//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
+//		for (int i=0; i<(int)correspondencePointsCamera.size(); i++)
+//		{
+//			cv::Mat pc = (cv::Mat_<double>(3,1) << (double)correspondencePointsCamera[i].x, (double)correspondencePointsCamera[i].y, 1.0);
+//			cv::Mat pp = (cv::Mat_<double>(3,1) << (double)correspondencePointsPlane[i].x, (double)correspondencePointsPlane[i].y, 1.0);
+//
+//			cv::Mat Hp = H.inv()*pp;
+//			Hp.at<double>(0) /= Hp.at<double>(2);
+//			Hp.at<double>(1) /= Hp.at<double>(2);
+//			Hp.at<double>(2) = 1.0;
+//			cv::Mat r = pc - Hp;
+//
+//			std::cout << "H - " << i << ": " << r.at<double>(0) << ", " << r.at<double>(1) << ", " << r.at<double>(2) << std::endl;
+//		}
+
+	return true;
+}
+
+
+void computePerspectiveRemapTables(const cv::Mat& H, const cv::Size& size, cv::Mat& map1, cv::Mat& map2)
+{
+	// the source pixel of every pixel (x,y) of the warped image is H^-1*[x,y,1]
+	cv::Mat Hinv = H.inv();
+	cv::Mat map_x(size, CV_32FC1), map_y(size, CV_32FC1);
+	for (int v=0; v<map_x.rows; v++)
+	{
+		float* map_x_ptr = map_x.ptr<float>(v);
+		float* map_y_ptr = map_y.ptr<float>(v);
+		for (int u=0; u<map_x.cols; u++)
+		{
+			const double w = Hinv.at<double>(2,0)*u + Hinv.at<double>(2,1)*v + Hinv.at<double>(2,2);
+			if (w != 0.)
+			{
+				map_x_ptr[u] = (float)((Hinv.at<double>(0,0)*u + Hinv.at<double>(0,1)*v + Hinv.at<double>(0,2))/w);
+				map_y_ptr[u] = (float)((Hinv.at<double>(1,0)*u + Hinv.at<double>(1,1)*v + Hinv.at<double>(1,2))/w);
+			}
+			else
+			{
+				map_x_ptr[u] = -1.f;
+				map_y_ptr[u] = -1.f;
+			}
+		}
+	}
+	cv::convertMaps(map_x, map_y, map1, map2, CV_16SC2);
+}
+
+
+bool warpToBirdsEyePerspective(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const cv::Mat& plane_color_image, const cv::Mat& plane_mask, const pcl::ModelCoefficients& plane_model,
+		const double birdEyeResolution, const double maxDistanceToCamera, const double birdEyeWarpCacheQuantization, BirdsEyeWarpCache& cache,
+		cv::Mat& H, cv::Mat& R, cv::Mat& t, cv::Point2f& cameraImagePlaneOffset, cv::Mat& plane_color_image_warped, cv::Mat& plane_mask_warped)
+{
+	// 0. the floor plane hardly changes relative to the camera, so reuse homography and remap tables as long as the quantized plane model stays the same
+	std::vector<int> planeKey;
+	if (birdEyeWarpCacheQuantization > 0.)
+	{
+		planeKey.resize(4);
+		for (int i=0; i<4; i++)
+			planeKey[i] = cvRound(plane_model.values[i]/birdEyeWarpCacheQuantization);
+		if (cache.valid == true && cache.planeKey == planeKey && cache.imageSize == plane_color_image.size() &&
+				cache.birdEyeResolution == birdEyeResolution && cache.maxDistanceToCamera == maxDistanceToCamera)
+		{
+			H = cache.H;
+			R = cache.R;
+			t = cache.t;
+			cameraImagePlaneOffset = cache.cameraImagePlaneOffset;
+			cv::remap(plane_color_image, plane_color_image_warped, cache.map1, cache.map2, cv::INTER_LINEAR);
+			cv::remap(plane_mask, plane_mask_warped, cache.map1, cache.map2, cv::INTER_LINEAR);
+			return true;
+		}
+	}
+
+	// 1.-3. floor plane coordinate system and homography between the camera image and the bird's eye perspective
+	if (computeFloorPlaneHomography(input_cloud, plane_color_image, plane_model, birdEyeResolution, maxDistanceToCamera, H, R, t, cameraImagePlaneOffset) == false)
+		return false;
+
+	// 4. warp perspective
+	if (birdEyeWarpCacheQuantization > 0.)
+	{
+		computePerspectiveRemapTables(H, plane_color_image.size(), cache.map1, cache.map2);
+		cache.planeKey = planeKey;
+		cache.imageSize = plane_color_image.size();
+		cache.birdEyeResolution = birdEyeResolution;
+		cache.maxDistanceToCamera = maxDistanceToCamera;
+		cache.H = H;
+		cache.R = R;
+		cache.t = t;
+		cache.cameraImagePlaneOffset = cameraImagePlaneOffset;
+		cache.valid = true;
+
+		cv::remap(plane_color_image, plane_color_image_warped, cache.map1, cache.map2, cv::INTER_LINEAR);
+		// todo: better manual sampling of the warped mask needed
+		cv::remap(plane_mask, plane_mask_warped, cache.map1, cache.map2, cv::INTER_LINEAR);
+	}
+	else
+	{
+		cv::warpPerspective(plane_color_image, plane_color_image_warped, H, plane_color_image.size());
+		// todo: better manual sampling of the warped mask needed
+		cv::warpPerspective(plane_mask, plane_mask_warped, H, plane_mask.size());
+	}
+
+	return true;
+}
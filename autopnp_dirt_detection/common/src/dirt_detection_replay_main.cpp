@@ -0,0 +1,459 @@
+// Offline replay benchmark for the dirt detection pipeline.
+//
+// Streams recorded RGB-D frames through floor segmentation -> bird's eye warp -> spectral residual saliency -> post processing
+// -> dirt mapping as fast as possible, without ROS. It reports latency histograms for every stage, the throughput and the peak
+// memory usage and compares the resulting dirt map with the ground truth labels (labelImage::readTxt3d format).
+//
+// usage: dirt_detection_replay <replay index file> [parameter=value ...]
+//
+// The replay index file is a text file with one entry per line (paths are relative to the index file, '#' starts a comment):
+//   grid_origin <x> <y>                        origin of the dirt grid map in the /map frame [m]
+//   ground_truth <labels.xml>                  optional ground truth labels, may be given several times
+//   frame <cloud.pcd> <tx> <ty> <tz> <qx> <qy> <qz> <qw>
+//                                              organized XYZRGB point cloud and the pose of the camera in the /map frame (pointMap = T*pointCamera)
+//
+// parameters (defaults as in ros/launch/dirt_detection.yaml):
+//   spectralResidualGaussianBlurIterations, spectralResidualImageSizeRatio, spectralResidualNormalizationHighestMaxValue,
+//   artificialDirtStatisticsUpdateInterval, dirtThreshold, removeLines, birdEyeResolution, birdEyeWarpCacheQuantization,
+//   maxDistanceToCamera, floorSearchIterations, minPlanePoints, planeNormalMaxZ, planeMaxHeight, planeTrackingSubsamplingStep,
+//   planeTrackingMinInlierRatio, gridResolution,
+//   gridDimensions_x, gridDimensions_y, minDetectionVotes (grid cells with at least this many votes count as dirty),
+//   repetitions (number of passes over all frames)
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <sys/resource.h>
+
+#include <opencv/cv.h>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl/ModelCoefficients.h>
+#include <pcl/io/pcd_io.h>
+
+#include "autopnp_dirt_detection/timer.h"
+#include "autopnp_dirt_detection/spectral_residual_saliency.h"
+#include "autopnp_dirt_detection/birds_eye_perspective.h"
+#include "autopnp_dirt_detection/label_box.h"
+#include "autopnp_dirt_detection/dirt_detection_stages.h"
+
+
+/// collects the latencies of one processing stage
+class StageStatistics
+{
+public:
+
+	StageStatistics(const std::string& name = "")
+	: name_(name)
+	{
+	}
+
+	void addSample(const double milliseconds)
+	{
+		samples_.push_back(milliseconds);
+	}
+
+	double getSum() const
+	{
+		double sum = 0.;
+		for (size_t i=0; i<samples_.size(); i++)
+			sum += samples_[i];
+		return sum;
+	}
+
+	/// prints mean and percentiles and a histogram with logarithmic bins (powers of two from 1/16 ms on)
+	void print(std::ostream& out) const
+	{
+		out << name_ << ":";
+		if (samples_.size() == 0)
+		{
+			out << " no samples" << std::endl;
+			return;
+		}
+		std::vector<double> sorted = samples_;
+		std::sort(sorted.begin(), sorted.end());
+		out << std::fixed << std::setprecision(3) << "  n=" << sorted.size() << "  mean=" << getSum()/sorted.size() << "ms  min=" << sorted.front()
+				<< "ms  p50=" << percentile(sorted, 0.5) << "ms  p90=" << percentile(sorted, 0.9) << "ms  p99=" << percentile(sorted, 0.99)
+				<< "ms  max=" << sorted.back() << "ms" << std::endl;
+
+		const int number_bins = 20;
+		std::vector<int> histogram(number_bins, 0);
+		for (size_t i=0; i<sorted.size(); i++)
+		{
+			int bin = (sorted[i] > 0. ? (int)std::floor(std::log(sorted[i]*16.)/std::log(2.)) + 1 : 0);
+			histogram[std::max(0, std::min(number_bins-1, bin))]++;
+		}
+		const int max_count = *std::max_element(histogram.begin(), histogram.end());
+		for (int b=0; b<number_bins; b++)
+		{
+			if (histogram[b] == 0)
+				continue;
+			const double upper_bound = std::pow(2., b-4);
+			out << "    <" << std::setw(10) << upper_bound << "ms " << std::setw(6) << histogram[b] << " " << std::string((size_t)std::ceil(40.*histogram[b]/max_count), '#') << std::endl;
+		}
+	}
+
+protected:
+
+	static double percentile(const std::vector<double>& sorted, const double p)
+	{
+		size_t index = std::min(sorted.size()-1, (size_t)(p*(sorted.size()-1) + 0.5));
+		return sorted[index];
+	}
+
+	std::string name_;
+	std::vector<double> samples_;
+};
+
+
+struct ReplayFrame
+{
+	std::string cloudFilename;
+	CameraPose pose;
+};
+
+
+class DirtDetectionReplay
+{
+public:
+
+	DirtDetectionReplay(const std::map<std::string, double>& parameters)
+	{
+		spectralResidualGaussianBlurIterations_ = (int)getParameter(parameters, "spectralResidualGaussianBlurIterations", 3);
+		spectralResidualImageSizeRatio_ = getParameter(parameters, "spectralResidualImageSizeRatio", 0.25);
+		spectralResidualNormalizationHighestMaxValue_ = getParameter(parameters, "spectralResidualNormalizationHighestMaxValue", 1500.0);
+		artificialDirtStatisticsUpdateInterval_ = (int)getParameter(parameters, "artificialDirtStatisticsUpdateInterval", 10);
+		dirtThreshold_ = getParameter(parameters, "dirtThreshold", 0.2);
+		removeLines_ = (getParameter(parameters, "removeLines", 1) != 0.);
+		birdEyeResolution_ = getParameter(parameters, "birdEyeResolution", 300.0);
+		birdEyeWarpCacheQuantization_ = getParameter(parameters, "birdEyeWarpCacheQuantization", 0.002);
+		maxDistanceToCamera_ = getParameter(parameters, "maxDistanceToCamera", 3.0);
+		floorSearchIterations_ = (int)getParameter(parameters, "floorSearchIterations", 3);
+		minPlanePoints_ = (int)getParameter(parameters, "minPlanePoints", 100);
+		planeNormalMaxZ_ = getParameter(parameters, "planeNormalMaxZ", -0.5);
+		planeMaxHeight_ = getParameter(parameters, "planeMaxHeight", 0.3);
+		planeTrackingSubsamplingStep_ = (int)getParameter(parameters, "planeTrackingSubsamplingStep", 4);
+		planeTrackingMinInlierRatio_ = getParameter(parameters, "planeTrackingMinInlierRatio", 0.8);
+		floorPlaneCriteria_.minPlanePoints = minPlanePoints_;
+		floorPlaneCriteria_.planeNormalMaxZ = planeNormalMaxZ_;
+		floorPlaneCriteria_.planeMaxHeight = planeMaxHeight_;
+		floorPlaneCriteria_.checkPose = true;
+		gridResolution_ = getParameter(parameters, "gridResolution", 20.0);
+		gridDimensions_ = cv::Point2i((int)getParameter(parameters, "gridDimensions_x", 100), (int)getParameter(parameters, "gridDimensions_y", 100));
+		minDetectionVotes_ = (int)getParameter(parameters, "minDetectionVotes", 1);
+		repetitions_ = std::max(1, (int)getParameter(parameters, "repetitions", 1));
+		gridOrigin_ = cv::Point2d(0., 0.);
+
+		gridPositiveVotes_ = cv::Mat::zeros(gridDimensions_.y, gridDimensions_.x, CV_32SC1);
+
+		stageStatistics_.push_back(StageStatistics("load"));
+		stageStatistics_.push_back(StageStatistics("segmentation"));
+		stageStatistics_.push_back(StageStatistics("warp"));
+		stageStatistics_.push_back(StageStatistics("saliency"));
+		stageStatistics_.push_back(StageStatistics("postprocessing"));
+		stageStatistics_.push_back(StageStatistics("mapping"));
+	}
+
+	bool readIndex(const std::string& index_filename)
+	{
+		std::ifstream file(index_filename.c_str());
+		if (file.is_open() == false)
+		{
+			std::cout << "Error: replay index '" << index_filename << "' could not be opened." << std::endl;
+			return false;
+		}
+		std::string path = "";
+		if (index_filename.find_last_of('/') != std::string::npos)
+			path = index_filename.substr(0, index_filename.find_last_of('/')+1);
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			if (line.find('#') != std::string::npos)
+				line = line.substr(0, line.find('#'));
+			std::stringstream ss(line);
+			std::string key;
+			if (!(ss >> key))
+				continue;
+			if (key == "grid_origin")
+				ss >> gridOrigin_.x >> gridOrigin_.y;
+			else if (key == "ground_truth")
+			{
+				std::string filename;
+				ss >> filename;
+				groundTruthFilenames_.push_back(path + filename);
+			}
+			else if (key == "frame")
+			{
+				ReplayFrame frame;
+				double qx, qy, qz, qw;
+				ss >> frame.cloudFilename >> frame.pose.translation[0] >> frame.pose.translation[1] >> frame.pose.translation[2] >> qx >> qy >> qz >> qw;
+				if (ss.fail() == true)
+				{
+					std::cout << "Error: invalid frame entry '" << line << "'." << std::endl;
+					return false;
+				}
+				frame.cloudFilename = path + frame.cloudFilename;
+				const double n = std::sqrt(qx*qx + qy*qy + qz*qz + qw*qw);
+				qx /= n; qy /= n; qz /= n; qw /= n;
+				frame.pose.rotation = cv::Matx33d(1-2*(qy*qy+qz*qz), 2*(qx*qy-qz*qw), 2*(qx*qz+qy*qw),
+												  2*(qx*qy+qz*qw), 1-2*(qx*qx+qz*qz), 2*(qy*qz-qx*qw),
+												  2*(qx*qz-qy*qw), 2*(qy*qz+qx*qw), 1-2*(qx*qx+qy*qy));
+				frames_.push_back(frame);
+			}
+			else
+				std::cout << "Warning: unknown entry '" << key << "' in replay index." << std::endl;
+		}
+		std::cout << "Replay index contains " << frames_.size() << " frames and " << groundTruthFilenames_.size() << " ground truth files." << std::endl;
+		return frames_.size() > 0;
+	}
+
+	void run()
+	{
+		int processed_frames = 0, frames_with_floor = 0;
+		Timer total_timer;
+		total_timer.start();
+		for (int repetition=0; repetition<repetitions_; repetition++)
+		{
+			gridPositiveVotes_.setTo(cv::Scalar(0));
+			for (size_t f=0; f<frames_.size(); f++)
+			{
+				if (processFrame(frames_[f]) == true)
+					frames_with_floor++;
+				processed_frames++;
+				if (processed_frames % 50 == 0)
+					std::cout << "." << std::flush;
+			}
+		}
+		total_timer.stop();
+		const double total_time = total_timer.getElapsedTimeInSec();
+
+		// report
+		std::cout << std::endl << "Processed " << processed_frames << " frames (" << frames_with_floor << " with floor plane) in " << total_time << "s." << std::endl;
+		double processing_time = 0.;
+		for (size_t s=1; s<stageStatistics_.size(); s++)
+			processing_time += stageStatistics_[s].getSum();
+		std::cout << "Throughput: " << processed_frames/total_time << " frames/s including loading, " << (processing_time > 0. ? 1000.*processed_frames/processing_time : 0.) << " frames/s processing only." << std::endl;
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0)
+			std::cout << "Peak resident set size: " << usage.ru_maxrss/1024. << " MB" << std::endl;
+		std::cout << std::endl << "Stage latencies:" << std::endl;
+		for (size_t s=0; s<stageStatistics_.size(); s++)
+			stageStatistics_[s].print(std::cout);
+
+		evaluate();
+	}
+
+protected:
+
+	static double getParameter(const std::map<std::string, double>& parameters, const std::string& name, const double default_value)
+	{
+		std::map<std::string, double>::const_iterator it = parameters.find(name);
+		double value = (it != parameters.end() ? it->second : default_value);
+		std::cout << name << " = " << value << std::endl;
+		return value;
+	}
+
+	enum Stages {STAGE_LOAD=0, STAGE_SEGMENTATION, STAGE_WARP, STAGE_SALIENCY, STAGE_POSTPROCESSING, STAGE_MAPPING};
+
+	bool processFrame(const ReplayFrame& frame)
+	{
+		Timer timer;
+
+		timer.start();
+		pcl::PointCloud<pcl::PointXYZRGB>::Ptr input_cloud(new pcl::PointCloud<pcl::PointXYZRGB>);
+		if (pcl::io::loadPCDFile(frame.cloudFilename, *input_cloud) != 0 || input_cloud->height < 2)
+		{
+			std::cout << "Error: '" << frame.cloudFilename << "' is not an organized point cloud." << std::endl;
+			return false;
+		}
+		timer.stop();
+		stageStatistics_[STAGE_LOAD].addSample(timer.getElapsedTimeInMilliSec());
+
+		timer.start();
+		const double plane_inlier_threshold = 0.05;
+		cv::Mat plane_color_image, plane_mask;
+		pcl::ModelCoefficients plane_model;
+		bool found_plane = findFloorPlane(input_cloud, plane_inlier_threshold, floorSearchIterations_, planeTrackingSubsamplingStep_, planeTrackingMinInlierRatio_,
+				floorPlaneCriteria_, frame.pose, floorPlaneTrack_, plane_model);
+		if (found_plane == true)
+		{
+			std::vector<int> inlier_indices;
+			extractFloorPlaneImage(*input_cloud, plane_model, plane_inlier_threshold, plane_color_image, plane_mask, inlier_indices);
+		}
+		timer.stop();
+		stageStatistics_[STAGE_SEGMENTATION].addSample(timer.getElapsedTimeInMilliSec());
+		if (found_plane == false)
+			return false;
+
+		timer.start();
+		cv::Mat H, R, t, plane_color_image_warped, plane_mask_warped;
+		cv::Point2f cameraImagePlaneOffset;
+		bool warped = warpToBirdsEyePerspective(*input_cloud, plane_color_image, plane_mask, plane_model, birdEyeResolution_, maxDistanceToCamera_, birdEyeWarpCacheQuantization_,
+				birdsEyeWarpCache_, H, R, t, cameraImagePlaneOffset, plane_color_image_warped, plane_mask_warped);
+		timer.stop();
+		stageStatistics_[STAGE_WARP].addSample(timer.getElapsedTimeInMilliSec());
+		if (warped == false)
+			return false;
+
+		timer.start();
+		cv::Mat C1_saliency_image;
+		saliencyDetection_C3(spectralResidualSaliency_, spectralResidualImageSizeRatio_, plane_color_image_warped, C1_saliency_image, &plane_mask_warped, spectralResidualGaussianBlurIterations_);
+		timer.stop();
+		stageStatistics_[STAGE_SALIENCY].addSample(timer.getElapsedTimeInMilliSec());
+
+		timer.start();
+		std::vector<cv::RotatedRect> dirtDetections;
+		updateArtificialDirtStatistics(spectralResidualSaliency_, spectralResidualImageSizeRatio_, spectralResidualGaussianBlurIterations_, artificialDirtStatisticsUpdateInterval_,
+				plane_color_image_warped, plane_mask_warped, artificialDirtStatistics_);
+		cv::Mat scaled_C1_saliency_image, C1_BlackWhite_image;
+		normalizeSaliency(C1_saliency_image, artificialDirtStatistics_, spectralResidualNormalizationHighestMaxValue_, scaled_C1_saliency_image);
+		if (removeLines_ == true)
+			removeLineResponses(plane_color_image_warped, scaled_C1_saliency_image);
+		extractDirtRegions(scaled_C1_saliency_image, dirtThreshold_, C1_BlackWhite_image, dirtDetections);
+		timer.stop();
+		stageStatistics_[STAGE_POSTPROCESSING].addSample(timer.getElapsedTimeInMilliSec());
+
+		timer.start();
+		for (size_t i=0; i<dirtDetections.size(); i++)
+		{
+			const cv::RotatedRect& rect = dirtDetections[i];
+			labelImage::RegionPointTriple pointsWorldMap;
+			pointsWorldMap.center = transformPointFromCameraWarpedToWorld(rect.center.x, rect.center.y, R, t, cameraImagePlaneOffset, frame.pose);
+			double u = (double)rect.center.x+cos(-rect.angle*3.14159265359/180.f)*rect.size.width/2.f;
+			double v = (double)rect.center.y-sin(-rect.angle*3.14159265359/180.f)*rect.size.width/2.f;
+			pointsWorldMap.p1 = transformPointFromCameraWarpedToWorld(u, v, R, t, cameraImagePlaneOffset, frame.pose);
+			u = (double)rect.center.x-cos((-rect.angle-90)*3.14159265359/180.f)*rect.size.height/2.f;
+			v = (double)rect.center.y-sin((-rect.angle-90)*3.14159265359/180.f)*rect.size.height/2.f;
+			pointsWorldMap.p2 = transformPointFromCameraWarpedToWorld(u, v, R, t, cameraImagePlaneOffset, frame.pose);
+			putDetectionIntoGrid(gridPositiveVotes_, pointsWorldMap, gridOrigin_, gridResolution_);
+		}
+		timer.stop();
+		stageStatistics_[STAGE_MAPPING].addSample(timer.getElapsedTimeInMilliSec());
+
+		return true;
+	}
+
+	cv::Point3f transformPointFromCameraWarpedToWorld(const double u, const double v, const cv::Mat& R, const cv::Mat& t, const cv::Point2f& cameraImagePlaneOffset, const CameraPose& pose)
+	{
+		cv::Mat pointFloor = (cv::Mat_<double>(3,1) << u/birdEyeResolution_+cameraImagePlaneOffset.x, v/birdEyeResolution_+cameraImagePlaneOffset.y, 0.0);
+		cv::Mat pointWorldCamera = R*pointFloor + t;
+		const cv::Vec3d pointWorldMap = pose.rotation * cv::Vec3d(pointWorldCamera.at<double>(0), pointWorldCamera.at<double>(1), pointWorldCamera.at<double>(2)) + pose.translation;
+		return cv::Point3f(pointWorldMap[0], pointWorldMap[1], pointWorldMap[2]);
+	}
+
+	/// compares the dirt grid of the last pass with the ground truth grid cell by cell
+	void evaluate()
+	{
+		if (groundTruthFilenames_.size() == 0)
+		{
+			std::cout << std::endl << "No ground truth provided, skipping validation." << std::endl;
+			return;
+		}
+		cv::Mat groundTruthGrid = cv::Mat::zeros(gridPositiveVotes_.rows, gridPositiveVotes_.cols, CV_32SC1);
+		int number_labels = 0;
+		for (size_t f=0; f<groundTruthFilenames_.size(); f++)
+		{
+			std::vector<labelImage> groundTruthData;
+			labelImage::readTxt3d(groundTruthData, groundTruthFilenames_[f]);
+			for (size_t i=0; i<groundTruthData.size(); i++)
+				for (size_t j=0; j<groundTruthData[i].allRects3d.size(); j++, number_labels++)
+					putDetectionIntoGrid(groundTruthGrid, groundTruthData[i].allRects3d[j], gridOrigin_, gridResolution_);
+		}
+
+		int true_positives = 0, false_positives = 0, false_negatives = 0;
+		for (int v=0; v<groundTruthGrid.rows; v++)
+		{
+			for (int u=0; u<groundTruthGrid.cols; u++)
+			{
+				const bool dirt = (groundTruthGrid.at<int>(v,u) > 0);
+				const bool detected = (gridPositiveVotes_.at<int>(v,u) >= minDetectionVotes_);
+				if (dirt == true && detected == true)
+					true_positives++;
+				else if (dirt == false && detected == true)
+					false_positives++;
+				else if (dirt == true && detected == false)
+					false_negatives++;
+			}
+		}
+		const double precision = (true_positives+false_positives > 0 ? (double)true_positives/(true_positives+false_positives) : 0.);
+		const double recall = (true_positives+false_negatives > 0 ? (double)true_positives/(true_positives+false_negatives) : 0.);
+		std::cout << std::endl << "Validation against " << number_labels << " ground truth labels (grid cells with at least " << minDetectionVotes_ << " votes are dirty):" << std::endl;
+		std::cout << "  true positives=" << true_positives << "  false positives=" << false_positives << "  false negatives=" << false_negatives << std::endl;
+		std::cout << "  precision=" << precision << "  recall=" << recall << "  f1=" << (precision+recall > 0. ? 2.*precision*recall/(precision+recall) : 0.) << std::endl;
+	}
+
+	// parameters
+	int spectralResidualGaussianBlurIterations_;
+	double spectralResidualImageSizeRatio_;
+	double spectralResidualNormalizationHighestMaxValue_;
+	int artificialDirtStatisticsUpdateInterval_;
+	double dirtThreshold_;
+	bool removeLines_;
+	double birdEyeResolution_;
+	double birdEyeWarpCacheQuantization_;
+	double maxDistanceToCamera_;
+	int floorSearchIterations_;
+	int minPlanePoints_;
+	double planeNormalMaxZ_;
+	double planeMaxHeight_;
+	int planeTrackingSubsamplingStep_;
+	double planeTrackingMinInlierRatio_;
+	FloorPlaneCriteria floorPlaneCriteria_;
+	double gridResolution_;
+	cv::Point2d gridOrigin_;
+	cv::Point2i gridDimensions_;
+	int minDetectionVotes_;
+	int repetitions_;
+
+	// data
+	std::vector<ReplayFrame> frames_;
+	std::vector<std::string> groundTruthFilenames_;
+	cv::Mat gridPositiveVotes_;
+	std::vector<StageStatistics> stageStatistics_;
+
+	// state that is kept between frames like in the dirt detection node
+	SpectralResidualSaliency spectralResidualSaliency_;
+	ArtificialDirtStatistics artificialDirtStatistics_;
+	FloorPlaneTrack floorPlaneTrack_;
+	BirdsEyeWarpCache birdsEyeWarpCache_;
+};
+
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "usage: dirt_detection_replay <replay index file> [parameter=value ...]" << std::endl;
+		return 1;
+	}
+
+	std::map<std::string, double> parameters;
+	for (int i=2; i<argc; i++)
+	{
+		std::string argument(argv[i]);
+		size_t separator = argument.find('=');
+		if (separator == std::string::npos)
+		{
+			std::cout << "Error: parameters have to be given as name=value, got '" << argument << "'." << std::endl;
+			return 1;
+		}
+		parameters[argument.substr(0, separator)] = atof(argument.substr(separator+1).c_str());
+	}
+
+	DirtDetectionReplay replay(parameters);
+	if (replay.readIndex(argv[1]) == false)
+		return 1;
+	replay.run();
+
+	return 0;
+}
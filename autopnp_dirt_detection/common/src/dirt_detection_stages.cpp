@@ -0,0 +1,362 @@
+#include "autopnp_dirt_detection/dirt_detection_stages.h"
+
+#include <set>
+#include <cmath>
+#include <algorithm>
+
+#include <pcl/filters/voxel_grid.h>
+#include <pcl/filters/extract_indices.h>
+#include <pcl/sample_consensus/method_types.h>
+#include <pcl/sample_consensus/model_types.h>
+#include <pcl/segmentation/sac_segmentation.h>
+#include <pcl/common/centroid.h>
+#include <pcl/common/eigen.h>
+
+
+int collectSubsampledPlaneInliers(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const pcl::ModelCoefficients& plane_model, const double inlier_threshold, const int step, std::vector<int>& inlier_indices)
+{
+	inlier_indices.clear();
+	int valid_points = 0;
+	for (int v=0; v<(int)input_cloud.height; v+=step)
+	{
+		for (int u=0; u<(int)input_cloud.width; u+=step)
+		{
+			const int index = v*input_cloud.width + u;
+			const pcl::PointXYZRGB& point = input_cloud[index];
+			if (pcl_isfinite(point.z) == false || (point.x==0. && point.y==0. && point.z==0.))
+				continue;
+			valid_points++;
+
+			// check plane equation
+			double distance = plane_model.values[0]*point.x + plane_model.values[1]*point.y + plane_model.values[2]*point.z + plane_model.values[3];
+			if (distance > -inlier_threshold && distance < inlier_threshold)
+				inlier_indices.push_back(index);
+		}
+	}
+	return valid_points;
+}
+
+
+bool isValidFloorPlane(const pcl::ModelCoefficients& plane_model, const pcl::PointXYZRGB& plane_point, const int number_inliers, const FloorPlaneCriteria& criteria, const CameraPose& pose)
+{
+	if (criteria.checkPose == false)
+		return (number_inliers>criteria.minPlanePoints);
+
+	const cv::Vec3d planeNormalWorld = pose.rotation * cv::Vec3d(plane_model.values[0], plane_model.values[1], plane_model.values[2]);
+	const cv::Vec3d planePointWorld = pose.rotation * cv::Vec3d(plane_point.x, plane_point.y, plane_point.z) + pose.translation;
+	return (number_inliers>criteria.minPlanePoints && planeNormalWorld[2]<criteria.planeNormalMaxZ && std::fabs(planePointWorld[2])<criteria.planeMaxHeight);
+}
+
+
+bool trackFloorPlane(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const double plane_inlier_threshold, const int planeTrackingSubsamplingStep, const double planeTrackingMinInlierRatio,
+		const FloorPlaneCriteria& criteria, const CameraPose& pose, FloorPlaneTrack& track, pcl::ModelCoefficients& plane_model)
+{
+	// inliers of the last floor plane on a subsample of the organized point cloud
+	std::vector<int> inlier_indices;
+	int valid_points = collectSubsampledPlaneInliers(input_cloud, track.planeModel, plane_inlier_threshold, planeTrackingSubsamplingStep, inlier_indices);
+	if (valid_points == 0 || inlier_indices.size() < 3)
+		return false;
+
+	// refine the plane with a least squares fit to these inliers
+	EIGEN_ALIGN16 Eigen::Matrix3f covariance_matrix;
+	Eigen::Vector4f centroid;
+	if (pcl::computeMeanAndCovarianceMatrix(input_cloud, inlier_indices, covariance_matrix, centroid) < 3)
+		return false;
+	float eigen_value;
+	Eigen::Vector3f plane_normal;
+	pcl::eigen33(covariance_matrix, eigen_value, plane_normal);	// eigen vector of the smallest eigen value
+	plane_model.values.resize(4);
+	plane_model.values[0] = plane_normal[0];
+	plane_model.values[1] = plane_normal[1];
+	plane_model.values[2] = plane_normal[2];
+	plane_model.values[3] = -plane_normal.dot(centroid.head<3>());
+
+	// keep plane_normal upright
+	if (plane_model.values[2] < 0.)
+	{
+		plane_model.values[0] *= -1;
+		plane_model.values[1] *= -1;
+		plane_model.values[2] *= -1;
+		plane_model.values[3] *= -1;
+	}
+
+	// verify the refined plane, fall back to RANSAC if it lost too many inliers (e.g. the camera moved quickly or looks at a different scene)
+	valid_points = collectSubsampledPlaneInliers(input_cloud, plane_model, plane_inlier_threshold, planeTrackingSubsamplingStep, inlier_indices);
+	if (inlier_indices.size() == 0 || (double)inlier_indices.size()/(double)valid_points < planeTrackingMinInlierRatio*track.referenceInlierRatio)
+		return false;
+	if (isValidFloorPlane(plane_model, input_cloud[inlier_indices[inlier_indices.size()/2]], (int)inlier_indices.size(), criteria, pose) == false)
+		return false;
+
+	track.planeModel = plane_model;
+	return true;
+}
+
+
+bool findFloorPlane(const pcl::PointCloud<pcl::PointXYZRGB>::Ptr& input_cloud, const double plane_inlier_threshold, const int floorSearchIterations, const int planeTrackingSubsamplingStep,
+		const double planeTrackingMinInlierRatio, const FloorPlaneCriteria& criteria, const CameraPose& pose, FloorPlaneTrack& track, pcl::ModelCoefficients& plane_model)
+{
+	// the floor barely moves between frames, so first try to follow the floor plane of the last frame
+	if (planeTrackingSubsamplingStep > 0 && track.valid == true)
+		if (trackFloorPlane(*input_cloud, plane_inlier_threshold, planeTrackingSubsamplingStep, planeTrackingMinInlierRatio, criteria, pose, track, plane_model) == true)
+			return true;
+
+	// downsample the dataset with a voxel filter using a leaf size of 1cm
+	pcl::VoxelGrid<pcl::PointXYZRGB> vg;
+	pcl::PointCloud<pcl::PointXYZRGB>::Ptr filtered_input_cloud(new pcl::PointCloud<pcl::PointXYZRGB>);
+	vg.setInputCloud(input_cloud);
+	vg.setLeafSize(0.01f, 0.01f, 0.01f);
+	vg.filter(*filtered_input_cloud);
+
+	// try several times to find the ground plane
+	bool found_plane = false;
+	pcl::PointIndices::Ptr inliers(new pcl::PointIndices);
+	for (int trial=0; (trial<floorSearchIterations && filtered_input_cloud->points.size()>100); trial++)
+	{
+		// Create the segmentation object for the planar model and set all the parameters
+		inliers->indices.clear();
+		pcl::SACSegmentation<pcl::PointXYZRGB> seg;
+		seg.setOptimizeCoefficients(true);
+		seg.setModelType(pcl::SACMODEL_PLANE);
+		seg.setMethodType(pcl::SAC_RANSAC);
+		seg.setMaxIterations(100);
+		seg.setDistanceThreshold(plane_inlier_threshold);
+
+		seg.setInputCloud(filtered_input_cloud);
+		seg.segment(*inliers, plane_model);
+
+		// keep plane_normal upright
+		if (plane_model.values[2] < 0.)
+		{
+			plane_model.values[0] *= -1;
+			plane_model.values[1] *= -1;
+			plane_model.values[2] *= -1;
+			plane_model.values[3] *= -1;
+		}
+
+		// verify that plane is a valid ground plane
+		if (inliers->indices.size()!=0)
+		{
+			pcl::PointXYZRGB point = (*filtered_input_cloud)[(inliers->indices[inliers->indices.size()/2])];
+			if (isValidFloorPlane(plane_model, point, (int)inliers->indices.size(), criteria, pose) == true)
+			{
+				found_plane=true;
+				break;
+			}
+			else
+			{
+				// Extract the planar inliers from the input cloud
+				pcl::ExtractIndices<pcl::PointXYZRGB> extract;
+				extract.setInputCloud(filtered_input_cloud);
+				extract.setIndices(inliers);
+
+				// Remove the planar inliers, extract the rest
+				pcl::PointCloud<pcl::PointXYZRGB>::Ptr temp(new pcl::PointCloud<pcl::PointXYZRGB>);
+				extract.setNegative(true);
+				extract.filter(*temp);
+				filtered_input_cloud = temp;
+			}
+		}
+	}
+
+	// remember the plane and its inlier ratio for tracking it in the next frames
+	track.valid = false;
+	if (found_plane == true && planeTrackingSubsamplingStep > 0)
+	{
+		std::vector<int> subsampled_inliers;
+		int valid_points = collectSubsampledPlaneInliers(*input_cloud, plane_model, plane_inlier_threshold, planeTrackingSubsamplingStep, subsampled_inliers);
+		if (valid_points > 0)
+		{
+			track.planeModel = plane_model;
+			track.referenceInlierRatio = (double)subsampled_inliers.size()/(double)valid_points;
+			track.valid = true;
+		}
+	}
+
+	return found_plane;
+}
+
+
+void extractFloorPlaneImage(const pcl::PointCloud<pcl::PointXYZRGB>& input_cloud, const pcl::ModelCoefficients& plane_model, const double plane_inlier_threshold,
+		cv::Mat& plane_color_image, cv::Mat& plane_mask, std::vector<int>& inlier_indices)
+{
+	inlier_indices.clear();
+	plane_color_image = cv::Mat::zeros(input_cloud.height, input_cloud.width, CV_8UC3);
+	plane_mask = cv::Mat::zeros(input_cloud.height, input_cloud.width, CV_8UC1);
+	for (int v=0, i=0; v<(int)input_cloud.height; v++)
+	{
+		for (int u=0; u<(int)input_cloud.width; u++, i++)
+		{
+			const pcl::PointXYZRGB& point = input_cloud[i];
+			if (point.x==0. && point.y==0. && point.z==0.)
+				continue;
+
+			// check plane equation
+			double distance = plane_model.values[0]*point.x + plane_model.values[1]*point.y + plane_model.values[2]*point.z + plane_model.values[3];
+			if (distance > -plane_inlier_threshold && distance < plane_inlier_threshold)
+			{
+				inlier_indices.push_back(i);
+				plane_color_image.at<cv::Vec3b>(v, u) = cv::Vec3b(point.b, point.g, point.r);
+				plane_mask.at<uchar>(v, u) = 255;
+			}
+		}
+	}
+}
+
+
+void saliencyDetection_C3(SpectralResidualSaliency& spectralResidualSaliency, const double spectralResidualImageSizeRatio, const cv::Mat& C3_color_image,
+		cv::Mat& C1_saliency_image, const cv::Mat* mask, const int gaussianBlurCycles)
+{
+	// spectral residual of all three channels in one pass, averaged over the channels
+	cv::Mat realInput;
+	spectralResidualSaliency.computeSaliency(C3_color_image, realInput, spectralResidualImageSizeRatio);
+
+	for (int i=0; i<gaussianBlurCycles; i++)
+		cv::GaussianBlur(realInput, realInput, cv::Size(3,3), 0); //necessary!? --> less noise
+
+	cv::resize(realInput, C1_saliency_image, C3_color_image.size());
+
+	// remove borders of the ground plane because of artifacts at the border like lines
+	if (mask != 0)
+	{
+		cv::Mat mask_eroded = mask->clone();
+		cv::dilate(*mask, mask_eroded, cv::Mat(), cv::Point(-1, -1), 2);
+		cv::erode(mask_eroded, mask_eroded, cv::Mat(), cv::Point(-1, -1), 25.0/640.0*C3_color_image.cols);
+		cv::Mat neighborhood = cv::Mat::ones(3, 1, CV_8UC1);
+		cv::erode(mask_eroded, mask_eroded, neighborhood, cv::Point(-1, -1), 15.0/640.0*C3_color_image.cols);
+
+		cv::Mat temp;
+		C1_saliency_image.copyTo(temp, mask_eroded);
+		C1_saliency_image = temp;
+	}
+
+	// remove saliency at the image border (because of artifacts in the corners)
+	int borderX = C1_saliency_image.cols/20;
+	int borderY = C1_saliency_image.rows/20;
+	if (borderX > 0 && borderY > 0)
+	{
+		cv::Mat smallImage = C1_saliency_image(cv::Rect(borderX, borderY, C1_saliency_image.cols-2*borderX, C1_saliency_image.rows-2*borderY)).clone();
+		cv::copyMakeBorder(smallImage, C1_saliency_image, borderY, borderY, borderX, borderX, cv::BORDER_CONSTANT, cv::Scalar(0));
+	}
+}
+
+
+bool updateArtificialDirtStatistics(SpectralResidualSaliency& spectralResidualSaliency, const double spectralResidualImageSizeRatio, const int gaussianBlurCycles,
+		const int artificialDirtStatisticsUpdateInterval, const cv::Mat& C3_color_image, const cv::Mat& mask, ArtificialDirtStatistics& statistics,
+		cv::Mat* color_image_with_artificial_dirt, cv::Mat* C1_saliency_image_with_artificial_dirt, cv::Mat* mask_with_artificial_dirt)
+{
+	if (statistics.valid == true && statistics.imageSize == C3_color_image.size() && statistics.framesSinceUpdate+1 < artificialDirtStatisticsUpdateInterval)
+	{
+		statistics.framesSinceUpdate++;
+		return false;
+	}
+
+	// add dirt: two white and two black spots around the image center
+	cv::Mat color_image_with_dirt = C3_color_image.clone();
+	cv::Mat mask_with_dirt = mask.clone();
+	int dirtSize = cvRound(3.0/640.0 * C3_color_image.cols);
+	const cv::Point2f positions[4] = {cv::Point2f(0.4375*C3_color_image.cols, 0.416666667*C3_color_image.rows), cv::Point2f(0.5625*C3_color_image.cols, 0.583333333*C3_color_image.rows),
+			cv::Point2f(0.4375*C3_color_image.cols, 0.583333333*C3_color_image.rows), cv::Point2f(0.5625*C3_color_image.cols, 0.416666667*C3_color_image.rows)};
+	for (int i=0; i<4; i++)
+	{
+		const double color = (i<2 ? 255 : 0);
+		cv::ellipse(color_image_with_dirt, cv::RotatedRect(positions[i], cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(color, color, color), dirtSize);
+		cv::ellipse(mask_with_dirt, cv::RotatedRect(positions[i], cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(255, 255, 255), dirtSize);
+	}
+	cv::Mat saliency_image_with_dirt;
+	saliencyDetection_C3(spectralResidualSaliency, spectralResidualImageSizeRatio, color_image_with_dirt, saliency_image_with_dirt, &mask_with_dirt, gaussianBlurCycles);
+
+	cv::minMaxLoc(saliency_image_with_dirt, &statistics.minv, &statistics.maxv, 0, 0, mask_with_dirt);
+	cv::meanStdDev(saliency_image_with_dirt, statistics.mean, statistics.stdDev, mask);
+	statistics.imageSize = C3_color_image.size();
+	statistics.framesSinceUpdate = 0;
+	statistics.valid = true;
+
+	if (color_image_with_artificial_dirt != 0)
+		*color_image_with_artificial_dirt = color_image_with_dirt;
+	if (C1_saliency_image_with_artificial_dirt != 0)
+		*C1_saliency_image_with_artificial_dirt = saliency_image_with_dirt;
+	if (mask_with_artificial_dirt != 0)
+		*mask_with_artificial_dirt = mask_with_dirt;
+	return true;
+}
+
+
+void normalizeSaliency(const cv::Mat& C1_saliency_image, const ArtificialDirtStatistics& statistics, const double spectralResidualNormalizationHighestMaxValue,
+		cv::Mat& scaled_C1_saliency_image, double* scale, double* offset)
+{
+	const double minv = statistics.minv;
+	const double maxv = statistics.maxv;
+	const double newMaxVal = std::min(1.0, maxv/spectralResidualNormalizationHighestMaxValue);
+	const double a = newMaxVal/(maxv-minv);
+	const double b = -newMaxVal*(minv)/(maxv-minv);
+	C1_saliency_image.convertTo(scaled_C1_saliency_image, -1, a, b);
+	if (scale != 0)
+		*scale = a;
+	if (offset != 0)
+		*offset = b;
+}
+
+
+void removeLineResponses(const cv::Mat& C3_color_image, cv::Mat& scaled_C1_saliency_image, cv::Mat* line_image)
+{
+	cv::Mat src, dst;
+	cv::cvtColor(C3_color_image, src, CV_BGR2GRAY);
+	cv::Canny(src, dst, 90, 170, 3);
+	if (line_image != 0)
+		cv::cvtColor(dst, *line_image, CV_GRAY2BGR);
+
+	std::vector<cv::Vec4i> lines;
+	cv::HoughLinesP(dst, lines, 1, CV_PI/180, 80, 30, 10);
+	for (size_t i = 0; i < lines.size(); i++)
+	{
+		if (line_image != 0)
+			cv::line(*line_image, cv::Point(lines[i][0], lines[i][1]), cv::Point(lines[i][2], lines[i][3]), cv::Scalar(0,0,255), 3, 8);
+		cv::line(scaled_C1_saliency_image, cv::Point(lines[i][0], lines[i][1]), cv::Point(lines[i][2], lines[i][3]), cv::Scalar(0,0,0), 13, 8);
+	}
+}
+
+
+void extractDirtRegions(const cv::Mat& scaled_C1_saliency_image, const double dirtThreshold, cv::Mat& C1_BlackWhite_image, std::vector<cv::RotatedRect>& dirtDetections,
+		std::vector<std::vector<cv::Point> >* contours)
+{
+	//set dirt pixel to white
+	C1_BlackWhite_image = cv::Mat::zeros(scaled_C1_saliency_image.size(), CV_8UC1);
+	cv::threshold(scaled_C1_saliency_image, C1_BlackWhite_image, dirtThreshold, 1, cv::THRESH_BINARY);
+
+	cv::Mat CV_8UC_image;
+	C1_BlackWhite_image.convertTo(CV_8UC_image, CV_8UC1);
+
+	std::vector<std::vector<cv::Point> > region_contours;
+	std::vector<cv::Vec4i> hierarchy;
+	cv::findContours(CV_8UC_image, region_contours, hierarchy, CV_RETR_LIST, CV_CHAIN_APPROX_SIMPLE);
+	for (size_t i=0; i<region_contours.size(); i++)
+		dirtDetections.push_back(cv::minAreaRect(region_contours[i]));
+
+	if (contours != 0)
+		contours->swap(region_contours);
+}
+
+
+void putDetectionIntoGrid(cv::Mat& grid, const labelImage::RegionPointTriple& detection, const cv::Point2d& gridOrigin, const double gridResolution)
+{
+	// sample all points along the principal axis and count dirt detection in each grid cell of the map once
+	cv::Point3f lWidth = detection.p1-detection.center;
+	cv::Point3f lHeight = detection.p2-detection.center;
+	std::set<std::pair<int,int> > visitedGridCells;
+	for (double scaleW=-1.; scaleW<=1.; scaleW+=0.2)
+	{
+		for (double scaleH=-1.; scaleH<=1.; scaleH+=0.2)
+		{
+			cv::Point2i coordinates[2];
+			coordinates[0] = cv::Point2i((detection.center.x+scaleW*lWidth.x-gridOrigin.x)*gridResolution, (detection.center.y+scaleW*lWidth.y-gridOrigin.y)*gridResolution);
+			coordinates[1] = cv::Point2i((detection.center.x+scaleH*lHeight.x-gridOrigin.x)*gridResolution, (detection.center.y+scaleH*lHeight.y-gridOrigin.y)*gridResolution);
+			for (int i=0; i<2; i++)
+			{
+				const cv::Point2i& co = coordinates[i];
+				// grid cell has not been incremented, yet
+				if (co.x>=0 && co.x<grid.cols && co.y>=0 && co.y<grid.rows && visitedGridCells.insert(std::make_pair(co.x, co.y)).second == true)
+					grid.at<int>(co) = grid.at<int>(co) + 1;
+			}
+		}
+	}
+}
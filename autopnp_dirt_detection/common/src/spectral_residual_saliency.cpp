@@ -0,0 +1,97 @@
+#include "autopnp_dirt_detection/spectral_residual_saliency.h"
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+
+SpectralResidualSaliency::SpectralResidualSaliency()
+{
+}
+
+
+cv::Size SpectralResidualSaliency::getWorkingSize(const cv::Size& image_size, const double image_size_ratio)
+{
+	const int cols = std::max(1, (int)(image_size.width * image_size_ratio));
+	const int rows = std::max(1, (int)(image_size.height * image_size_ratio));
+	return cv::Size(cv::getOptimalDFTSize(cols), cv::getOptimalDFTSize(rows));
+}
+
+
+void SpectralResidualSaliency::computeSaliency(const cv::Mat& image, cv::Mat& saliency_image, const double image_size_ratio)
+{
+	const cv::Size working_size = getWorkingSize(image.size(), image_size_ratio);
+
+	// resize and convert all channels at once
+	cv::resize(image, resized_image_, working_size);
+	resized_image_.convertTo(float_image_, CV_32F, 1.0/255.0, 0);
+	cv::split(float_image_, channels_);
+
+	saliency_sum_.create(working_size, CV_32FC1);
+	saliency_sum_.setTo(cv::Scalar(0));
+	for (size_t c=0; c<channels_.size(); c++)
+	{
+		// the spectrum of a real image is conjugate symmetric, hence the real-input transform and the real-output inverse transform suffice
+		cv::dft(channels_[c], spectrum_, cv::DFT_COMPLEX_OUTPUT);
+		computeResidualSpectrum();
+		cv::dft(spectrum_, channel_saliency_, cv::DFT_INVERSE | cv::DFT_REAL_OUTPUT);
+		channel_saliency_ = cv::abs(channel_saliency_);
+		saliency_sum_ += channel_saliency_;
+	}
+
+	if (channels_.size() > 1)
+		saliency_sum_.convertTo(saliency_image, CV_32F, 1.0/(double)channels_.size(), 0);
+	else
+		saliency_sum_.copyTo(saliency_image);
+}
+
+
+void SpectralResidualSaliency::computeResidualSpectrum()
+{
+	const int rows = spectrum_.rows;
+	const int cols = spectrum_.cols;
+
+	// log magnitude, log(|F|) = 0.5*log(|F|^2)
+	log_magnitude_.create(rows, cols, CV_32FC1);
+	for (int v=0; v<rows; v++)
+	{
+		const cv::Vec2f* spectrum_ptr = spectrum_.ptr<cv::Vec2f>(v);
+		float* log_magnitude_ptr = log_magnitude_.ptr<float>(v);
+		for (int u=0; u<cols; u++)
+		{
+			const float squared_magnitude = spectrum_ptr[u][0]*spectrum_ptr[u][0] + spectrum_ptr[u][1]*spectrum_ptr[u][1];
+			log_magnitude_ptr[u] = 0.5f * std::log(std::max(squared_magnitude, FLT_MIN));
+		}
+	}
+
+	// 3x3 average of the log magnitude, the spectrum is periodic and wrapping the border keeps the result conjugate symmetric
+	cv::copyMakeBorder(log_magnitude_, padded_log_magnitude_, 1, 1, 1, 1, cv::BORDER_WRAP);
+	cv::blur(padded_log_magnitude_, average_log_magnitude_, cv::Size(3,3));
+	const cv::Mat average_log_magnitude = average_log_magnitude_(cv::Rect(1, 1, cols, rows));
+
+	// new magnitude exp(log|F| - avg(log|F|)) with the phase of F: scale real and imaginary part by new_magnitude/|F|
+	for (int v=0; v<rows; v++)
+	{
+		cv::Vec2f* spectrum_ptr = spectrum_.ptr<cv::Vec2f>(v);
+		const float* log_magnitude_ptr = log_magnitude_.ptr<float>(v);
+		const float* average_ptr = average_log_magnitude.ptr<float>(v);
+		for (int u=0; u<cols; u++)
+		{
+			const float log_residual = log_magnitude_ptr[u] - average_ptr[u];
+			const float squared_magnitude = spectrum_ptr[u][0]*spectrum_ptr[u][0] + spectrum_ptr[u][1]*spectrum_ptr[u][1];
+			if (squared_magnitude > 0.f)
+			{
+				// exp(log_residual)/|F| = exp(log_residual - log|F|)
+				const float factor = std::exp(log_residual - log_magnitude_ptr[u]);
+				spectrum_ptr[u][0] *= factor;
+				spectrum_ptr[u][1] *= factor;
+			}
+			else
+			{
+				// phase 0 as returned by cartToPolar for a zero vector
+				spectrum_ptr[u][0] = std::exp(log_residual);
+				spectrum_ptr[u][1] = 0.f;
+			}
+		}
+	}
+}
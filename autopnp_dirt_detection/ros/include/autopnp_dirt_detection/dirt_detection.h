@@ -131,6 +131,9 @@
 
 #include <time.h>
 #include "autopnp_dirt_detection/label_box.h"
+#include "autopnp_dirt_detection/spectral_residual_saliency.h"
+#include "autopnp_dirt_detection/birds_eye_perspective.h"
+#include "autopnp_dirt_detection/dirt_detection_stages.h"
 
 
 namespace ipa_DirtDetection {
@@ -227,9 +230,11 @@ protected:
 	double dirtThreshold_;
 	double spectralResidualNormalizationHighestMaxValue_;
 	double spectralResidualImageSizeRatio_;
+	int artificialDirtStatisticsUpdateInterval_;	// the normalization statistics of the saliency image with artificial dirt are recomputed every this many frames (1 = every frame)
 	double dirtCheckStdDevFactor_;
 	int modeOfOperation_;
 	double birdEyeResolution_;		// resolution for bird eye's perspective [pixel/m]
+	double birdEyeWarpCacheQuantization_;	// the bird's eye homography and remap tables are reused as long as the quantized floor plane model (values divided by this step) does not change (0 = recompute in every frame)
 	bool dirtDetectionActivatedOnStartup_;	// for normal operation mode, specifies whether dirt detection is on right from the beginning
 	std::string dirtMappingMaskFilename_;	// if not an empty string, this enables using a mask that defines areas in the map where dirt detections are valid (i.e. this mask can be used to exclude areas from dirt mapping, white=detection area, black=do not detect)
 	bool useDirtMappingMask_;
@@ -243,11 +248,21 @@ protected:
 	double maxDistanceToCamera_;	// only those points which are close enough to the camera are taken [max distance in m]
 	bool removeLines_;	// if true, strong lines in the image will not produce dirt responses
 
+	// saliency
+	SpectralResidualSaliency spectralResidualSaliency_;	///< computes the spectral residual of all color channels with buffers that are reused between frames
+	ArtificialDirtStatistics artificialDirtStatistics_;	///< cached normalization statistics from the image with artificial dirt
+
 	// plane search
 	int floorSearchIterations_;		// the number of attempts to segment the floor plane in the image
 	int minPlanePoints_;		// minimum number of points that are necessary to find the floor plane
 	double planeNormalMaxZ_;	// maximum z-value of the plane normal (ensures to have an floor plane)
 	double planeMaxHeight_;		// maximum height of the detected plane above the mapped ground
+	int planeTrackingSubsamplingStep_;	// the floor plane of the last frame is verified on every planeTrackingSubsamplingStep_-th point of the organized point cloud in both directions (0 = no tracking, always use RANSAC)
+	double planeTrackingMinInlierRatio_;	// the tracked plane is only accepted if its inlier ratio is at least this fraction of the inlier ratio at the time of the last RANSAC fit
+	FloorPlaneTrack floorPlaneTrack_;	///< floor plane of the last frame, used as initial guess for the next frame
+
+	// bird's eye perspective
+	BirdsEyeWarpCache birdsEyeWarpCache_;	///< homography and remap tables of the last floor plane
 
 	// further
 	ros::Time lastIncomingMessage_;
@@ -397,13 +412,21 @@ public:
 	 */
 	bool planeSegmentation(pcl::PointCloud<pcl::PointXYZRGB>::Ptr input_cloud, cv::Mat& plane_color_image, cv::Mat& plane_mask, pcl::ModelCoefficients& plane_model, const tf::StampedTransform& transform_map_camera, cv::Mat& grid_number_observations);
 
+	/// converts the transform from the camera to the /map frame into the pose that the floor plane search in dirt_detection_stages.h expects
+	void convertTransformToCameraPose(const tf::StampedTransform& transform_map_camera, CameraPose& pose);
+
 	/// remove perspective from image
 	/// @param H Homography that maps points from the camera plane to the floor plane, i.e. pp = H*pc
 	/// @param R Rotation matrix for transformation between floor plane and world coordinates, i.e. [xw,yw,zw] = R*[xp,yp,0]+t and [xp,yp,0] = R^T*[xw,yw,zw] - R^T*t
 	/// @param t Translation vector. See Rotation matrix.
 	/// @param cameraImagePlaneOffset Offset in the camera image plane. Conversion from floor plane to  [xc, yc]
+	/// The homography and the remap tables are cached and reused for the following frames as long as the quantized floor plane
+	/// model, the image size and the bird's eye parameters do not change (see birdEyeWarpCacheQuantization_ and warpToBirdsEyePerspective).
 	bool computeBirdsEyePerspective(pcl::PointCloud<pcl::PointXYZRGB>::Ptr input_cloud, cv::Mat& plane_color_image, cv::Mat& plane_mask, pcl::ModelCoefficients& plane_model, cv::Mat& H, cv::Mat& R, cv::Mat& t, cv::Point2f& cameraImagePlaneOffset, cv::Mat& plane_color_image_warped, cv::Mat& plane_mask_warped);
 
+	/// computes the affine transform A (2x3, CV_64FC1) that maps grid cell (u,v) of the dirt grid maps to the warped camera image, i.e. [x,y]^T = A*[u,v,1]^T
+	void computeGridToCameraWarpedTransform(const cv::Mat& R, const cv::Mat& t, const cv::Point2f& cameraImagePlaneOffset, const tf::StampedTransform& transformMapCamera, cv::Mat& A);
+
 	/// converts point pointCamera, that lies within the floor plane and is provided in coordinates of the original camera image, into map coordinates
 	void transformPointFromCameraImageToWorld(const cv::Mat& pointCamera, const cv::Mat& H, const cv::Mat& R, const cv::Mat& t, const cv::Point2f& cameraImagePlaneOffset, const tf::StampedTransform& transformMapCamera, cv::Point3f& pointWorld);
 
@@ -427,9 +450,9 @@ public:
 	 * This function performs a saliency detection for a  3 channel color image.
 	 *
 	 * The function proceeds as follows:
-	 * 						1.) The 3 channel image is split into their 3 channels.
-	 * 						2.) The saliency detection is performed for each channel.
-	 * 						3.) The resulting images are add up.
+	 * 						1.) The 3 channel image is resized once and split into their 3 channels.
+	 * 						2.) The saliency detection is performed for each channel (see SpectralResidualSaliency).
+	 * 						3.) The resulting images are averaged, smoothed and resized to the input size.
 	 *
 	 * @param [in] 	C3_color_image			!!!THREE CHANNEL!!!('C3') image used to perform the saliency detection.
 	 * @param [out]	C1_saliency_image		One channel image('C1') which results from the saliency detection.
@@ -2,8 +2,6 @@
 #include "cv.h"
 #include "highgui.h"
 
-#include <ros/ros.h>
-
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -66,6 +66,8 @@
 #include <pcl/point_types.h>
 #include <pcl/filters/extract_indices.h>
 #include <pcl/filters/voxel_grid.h>
+#include <pcl/common/centroid.h>
+#include <pcl/common/eigen.h>
 
 #include <set>
 #include <time.h>
@@ -129,6 +131,8 @@ void DirtDetection::init()
 	std::cout << "spectralResidualNormalizationHighestMaxValue = " << spectralResidualNormalizationHighestMaxValue_ << std::endl;
 	node_handle_.param("dirt_detection/spectralResidualImageSizeRatio", spectralResidualImageSizeRatio_, 0.25);
 	std::cout << "spectralResidualImageSizeRatio = " << spectralResidualImageSizeRatio_ << std::endl;
+	node_handle_.param("dirt_detection/artificialDirtStatisticsUpdateInterval", artificialDirtStatisticsUpdateInterval_, 10);
+	std::cout << "artificialDirtStatisticsUpdateInterval = " << artificialDirtStatisticsUpdateInterval_ << std::endl;
 	node_handle_.param("dirt_detection/dirtCheckStdDevFactor", dirtCheckStdDevFactor_, 2.5);
 	std::cout << "dirtCheckStdDevFactor = " << dirtCheckStdDevFactor_ << std::endl;
 	node_handle_.param("dirt_detection/modeOfOperation", modeOfOperation_, 0);
@@ -139,6 +143,8 @@ void DirtDetection::init()
 	std::cout << "warpImage = " << warpImage_ << std::endl;
 	node_handle_.param("dirt_detection/birdEyeResolution", birdEyeResolution_, 300.0);
 	std::cout << "birdEyeResolution = " << birdEyeResolution_ << std::endl;
+	node_handle_.param("dirt_detection/birdEyeWarpCacheQuantization", birdEyeWarpCacheQuantization_, 0.002);
+	std::cout << "birdEyeWarpCacheQuantization = " << birdEyeWarpCacheQuantization_ << std::endl;
 	node_handle_.param("dirt_detection/maxDistanceToCamera", maxDistanceToCamera_, 300.0);
 	std::cout << "maxDistanceToCamera = " << maxDistanceToCamera_ << std::endl;
 	node_handle_.param("dirt_detection/removeLines", removeLines_, true);
@@ -165,6 +171,10 @@ void DirtDetection::init()
 	std::cout << "planeNormalMaxZ = " << planeNormalMaxZ_ << std::endl;
 	node_handle_.param("dirt_detection/planeMaxHeight", planeMaxHeight_, 0.3);
 	std::cout << "planeMaxHeight = " << planeMaxHeight_ << std::endl;
+	node_handle_.param("dirt_detection/planeTrackingSubsamplingStep", planeTrackingSubsamplingStep_, 4);
+	std::cout << "planeTrackingSubsamplingStep = " << planeTrackingSubsamplingStep_ << std::endl;
+	node_handle_.param("dirt_detection/planeTrackingMinInlierRatio", planeTrackingMinInlierRatio_, 0.8);
+	std::cout << "planeTrackingMinInlierRatio = " << planeTrackingMinInlierRatio_ << std::endl;
 	node_handle_.param("dirt_detection/dirtMappingMaskFilename", dirtMappingMaskFilename_, std::string(""));
 	std::cout << "dirtMappingMaskFilename = " << dirtMappingMaskFilename_ << std::endl;
 	node_handle_.param("dirt_detection/experimentFolder", experimentFolder_, std::string(""));
@@ -282,19 +292,27 @@ void DirtDetection::dynamicReconfigureCallback(autopnp_dirt_detection::DirtDetec
 	detectionHistoryDepth_ = config.detectionHistoryDepth;
 	warpImage_ = config.warpImage;
 	birdEyeResolution_ = config.birdEyeResolution;
+	birdEyeWarpCacheQuantization_ = config.birdEyeWarpCacheQuantization;
 	maxDistanceToCamera_ = config.maxDistanceToCamera;
 	removeLines_ = config.removeLines;
 	floorSearchIterations_ = config.floorSearchIterations;
 	minPlanePoints_ = config.minPlanePoints;
+	planeTrackingSubsamplingStep_ = config.planeTrackingSubsamplingStep;
+	planeTrackingMinInlierRatio_ = config.planeTrackingMinInlierRatio;
+	artificialDirtStatisticsUpdateInterval_ = config.artificialDirtStatisticsUpdateInterval;
 	std::cout << "Dynamic reconfigure changed settings to \n";
 	std::cout << "  dirtThreshold = " << dirtThreshold_ << std::endl;
 	std::cout << "  detectionHistoryDepth = " << detectionHistoryDepth_ << std::endl;
 	std::cout << "  warpImage = " << warpImage_ << std::endl;
 	std::cout << "  birdEyeResolution = " << birdEyeResolution_ << std::endl;
+	std::cout << "  birdEyeWarpCacheQuantization = " << birdEyeWarpCacheQuantization_ << std::endl;
 	std::cout << "  maxDistanceToCamera = " << maxDistanceToCamera_ << std::endl;
 	std::cout << "  removeLines = " << removeLines_ << std::endl;
 	std::cout << "  floorSearchIterations = " << floorSearchIterations_ << std::endl;
 	std::cout << "  minPlanePoints = " << minPlanePoints_ << std::endl;
+	std::cout << "  planeTrackingSubsamplingStep = " << planeTrackingSubsamplingStep_ << std::endl;
+	std::cout << "  planeTrackingMinInlierRatio = " << planeTrackingMinInlierRatio_ << std::endl;
+	std::cout << "  artificialDirtStatisticsUpdateInterval = " << artificialDirtStatisticsUpdateInterval_ << std::endl;
 }
 
 void DirtDetection::floorPlanCallback(const nav_msgs::OccupancyGridConstPtr& map_msg)
@@ -952,8 +970,10 @@ void DirtDetection::dirtDetectionCallback(const sensor_msgs::PointCloud2ConstPtr
 
 		// todo: new mode with dirt deletion:
 //		cv::Point2i offset(0,0);//gridNumberObservations_.cols/2, gridNumberObservations_.rows/2);		//done: offset
-		cv::Mat Rt = R.t();
-		cv::Mat Rtt = Rt*t;
+		// grid cell -> warped image is an affine map, so it is evaluated with a few multiplications per cell instead of a tf and two matrix products
+		cv::Mat A;
+		if (warpImage_ == true)
+			computeGridToCameraWarpedTransform(R, t, cameraImagePlaneOffset, transformMapCamera, A);
 		for (int v=0; v<gridNumberObservations_.rows; v++)
 		{
 			for (int u=0; u<gridNumberObservations_.cols; u++)
@@ -963,18 +983,12 @@ void DirtDetection::dirtDetectionCallback(const sensor_msgs::PointCloud2ConstPtr
 				{
 					if (warpImage_ == true)
 					{
-						// todo: compute more efficiently
 						// only mark grid cells as observed if they are part of the warped image
-						//tf::Vector3 pointWorldMapBt(-(u-offset.x)/gridResolution_ + gridOrigin_.x, (v-offset.y)/gridResolution_ + gridOrigin_.y, 0.0);		//done: offset
-						tf::Vector3 pointWorldMapBt(u/gridResolution_ + gridOrigin_.x, v/gridResolution_ + gridOrigin_.y, 0.0);
-						tf::Vector3 pointWorldCameraBt = transformMapCamera.inverse() * pointWorldMapBt;	// transform map point (world coordinates) into camera coordinates
-						cv::Mat pointWorldCamera = (cv::Mat_<double>(3,1) << pointWorldCameraBt.getX(), pointWorldCameraBt.getY(), pointWorldCameraBt.getZ());
-						cv::Mat pointFloorPlane = Rt*pointWorldCamera - Rtt; 	// =point in detected floor plane in plane coordinate system
-						cv::Mat pointPlaneImage = (cv::Mat_<double>(3,1) << (pointFloorPlane.at<double>(0)-cameraImagePlaneOffset.x)*birdEyeResolution_, (pointFloorPlane.at<double>(1)-cameraImagePlaneOffset.y)*birdEyeResolution_, 1.0);
+						const double x = A.at<double>(0,0)*u + A.at<double>(0,1)*v + A.at<double>(0,2);
+						const double y = A.at<double>(1,0)*u + A.at<double>(1,1)*v + A.at<double>(1,2);
 						// todo: parameter candidate?
 						double borderOffset = 30.;	// pixel distance from image border - observations close to the border should not count as there are no detections happening
-						if (pointPlaneImage.at<double>(0) < 0.+borderOffset || pointPlaneImage.at<double>(0) > new_plane_color_image.cols-borderOffset ||
-							pointPlaneImage.at<double>(1) < 0.+borderOffset || pointPlaneImage.at<double>(1) > new_plane_color_image.rows-borderOffset)
+						if (x < 0.+borderOffset || x > new_plane_color_image.cols-borderOffset || y < 0.+borderOffset || y > new_plane_color_image.rows-borderOffset)
 						{
 							gridNumberObservations_.at<int>(v,u) = 0;
 							continue;
@@ -1314,128 +1328,35 @@ bool DirtDetection::planeSegmentation(pcl::PointCloud<pcl::PointXYZRGB>::Ptr inp
 	}
 
 
-	// try several times to find the ground plane
+	// try several times to find the ground plane, the floor barely moves between frames, so first try to follow the floor plane of the last frame
 	double plane_inlier_threshold = 0.05;	// cm
-	bool found_plane = false;
-
-	// downsample the dataset with a voxel filter using a leaf size of 1cm
-	pcl::VoxelGrid<pcl::PointXYZRGB> vg;
-	pcl::PointCloud<pcl::PointXYZRGB>::Ptr filtered_input_cloud(new pcl::PointCloud<pcl::PointXYZRGB>);
-	vg.setInputCloud(input_cloud->makeShared());
-	vg.setLeafSize(0.01f, 0.01f, 0.01f);
-	vg.filter(*filtered_input_cloud);
-	//std::cout << "PointCloud after filtering has: " << filtered_input_cloud->points.size ()  << " data points." << std::endl;
-
-	pcl::PointIndices::Ptr inliers(new pcl::PointIndices);
-	for (int trial=0; (trial<floorSearchIterations_ && 	filtered_input_cloud->points.size()>100); trial++)
-	{
-		// Create the segmentation object for the planar model and set all the parameters
-		inliers->indices.clear();
-		pcl::SACSegmentation<pcl::PointXYZRGB> seg;
-		seg.setOptimizeCoefficients(true);
-		seg.setModelType(pcl::SACMODEL_PLANE);
-		seg.setMethodType(pcl::SAC_RANSAC);
-		seg.setMaxIterations(100);
-		seg.setDistanceThreshold(plane_inlier_threshold);
-
-		seg.setInputCloud(filtered_input_cloud);
-		seg.segment(*inliers, plane_model);
-
-		// keep plane_normal upright
-		if (plane_model.values[2] < 0.)
-		{
-			plane_model.values[0] *= -1;
-			plane_model.values[1] *= -1;
-			plane_model.values[2] *= -1;
-			plane_model.values[3] *= -1;
-		}
-
-		// verify that plane is a valid ground plane
-		if (inliers->indices.size()!=0)
-		{
-			tf::StampedTransform rotationMapCamera = transform_map_camera;
-			rotationMapCamera.setOrigin(tf::Vector3(0,0,0));
-			tf::Vector3 planeNormalCamera(plane_model.values[0], plane_model.values[1], plane_model.values[2]);
-			tf::Vector3 planeNormalWorld = rotationMapCamera * planeNormalCamera;
-
-			pcl::PointXYZRGB point = (*filtered_input_cloud)[(inliers->indices[inliers->indices.size()/2])];
-			tf::Vector3 planePointCamera(point.x, point.y, point.z);
-			tf::Vector3 planePointWorld = transform_map_camera * planePointCamera;
-			//std::cout << "normCam: " << planeNormalCamera.getX() << ", " << planeNormalCamera.getY() << ", " << planeNormalCamera.getZ() << "  normW: " << planeNormalWorld.getX() << ", " << planeNormalWorld.getY() << ", " << planeNormalWorld.getZ() << "   point[half]: " << planePointWorld.getX() << ", " << planePointWorld.getY() << ", " << planePointWorld.getZ() << std::endl;
-
-			// verify that the found plane is a valid ground plane
+	FloorPlaneCriteria criteria;
+	criteria.minPlanePoints = minPlanePoints_;
+	criteria.planeNormalMaxZ = planeNormalMaxZ_;
+	criteria.planeMaxHeight = planeMaxHeight_;
 #ifdef WITH_MAP
-			if ((int)inliers->indices.size()>minPlanePoints_ && planeNormalWorld.getZ()<planeNormalMaxZ_ && abs(planePointWorld.getZ())<planeMaxHeight_)
-			{
-				found_plane=true;
-				break;
-			}
+	criteria.checkPose = true;
 #else
-			if ((int)inliers->indices.size()>minPlanePoints_)
-			{
-				found_plane=true;
-				break;
-			}
+	criteria.checkPose = false;
 #endif
-			else
-			{
-//				// the plane is not the ground plane -> remove that plane from the point cloud
-//				for (size_t i=0; i<inliers->indices.size(); i++)
-//				{
-//					// set all inliers to invalid
-//					pcl::PointXYZRGB& point = (*filtered_input_cloud)[(inliers->indices[i])];
-//					point.x = 0;
-//					point.y = 0;
-//					point.z = 0;
-//				}
-
-				// Extract the planar inliers from the input cloud
-				pcl::ExtractIndices<pcl::PointXYZRGB> extract;
-				extract.setInputCloud(filtered_input_cloud);
-				extract.setIndices(inliers);
-
-				// Remove the planar inliers, extract the rest
-				pcl::PointCloud<pcl::PointXYZRGB>::Ptr temp(new pcl::PointCloud<pcl::PointXYZRGB>);
-				extract.setNegative(true);
-				extract.filter(*temp);
-				filtered_input_cloud = temp;
-			}
-		}
-	}
+	CameraPose pose;
+	convertTransformToCameraPose(transform_map_camera, pose);
+	bool found_plane = findFloorPlane(input_cloud, plane_inlier_threshold, floorSearchIterations_, planeTrackingSubsamplingStep_, planeTrackingMinInlierRatio_, criteria, pose, floorPlaneTrack_, plane_model);
 
 	// if the ground plane was found, write the respective data to the images
 	if (found_plane == true)
 	{
 //		pcl::PointCloud<pcl::PointXYZRGB> floor_plane;
 
-		// determine all point indices in original point cloud for plane inliers
-		inliers->indices.clear();
-		for (unsigned int i=0; i<input_cloud->size(); i++)
-		{
-			pcl::PointXYZRGB& point = (*input_cloud)[i];
-			if (point.x!=0. || point.y!=0. || point.z!=0.)
-			{
-				// check plane equation
-				double distance = plane_model.values[0]*point.x + plane_model.values[1]*point.y + plane_model.values[2]*point.z + plane_model.values[3];
-				if (distance > -plane_inlier_threshold && distance < plane_inlier_threshold)
-					inliers->indices.push_back(i);
-			}
-		}
+		// determine all point indices in original point cloud for plane inliers, cropped color image and mask
+		std::vector<int> inlier_indices;
+		extractFloorPlaneImage(*input_cloud, plane_model, plane_inlier_threshold, plane_color_image, plane_mask, inlier_indices);
 
-		plane_color_image = cv::Mat::zeros(input_cloud->height, input_cloud->width, CV_8UC3);
-		plane_mask = cv::Mat::zeros(input_cloud->height, input_cloud->width, CV_8UC1);
 		std::set<cv::Point2i, lessPoint2i> visitedGridCells;	// secures that no two observations can count twice for the same grid cell
 //		cv::Point2i grid_offset(0,0);	//(grid_number_observations.cols/2, grid_number_observations.rows/2);	//done: offset
-		for (size_t i=0; i<inliers->indices.size(); i++)
+		for (size_t i=0; i<inlier_indices.size(); i++)
 		{
-			int v = inliers->indices[i]/input_cloud->width;	// check ob das immer abrundet ->noch offen!!!
-			int u = inliers->indices[i] - v*input_cloud->width;
-
-			// cropped color image and mask
-			pcl::PointXYZRGB point = (*input_cloud)[(inliers->indices[i])];
-			bgr bgr_ = {point.b, point.g, point.r};
-			plane_color_image.at<bgr>(v, u) = bgr_;
-			plane_mask.at<uchar>(v, u) = 255;
+			const pcl::PointXYZRGB& point = (*input_cloud)[inlier_indices[i]];
 
 			// populate visibility grid
 			tf::Vector3 planePointCamera(point.x, point.y, point.z);
@@ -1480,188 +1401,22 @@ bool DirtDetection::planeSegmentation(pcl::PointCloud<pcl::PointXYZRGB>::Ptr inp
 }
 
 
-bool DirtDetection::computeBirdsEyePerspective(pcl::PointCloud<pcl::PointXYZRGB>::Ptr input_cloud, cv::Mat& plane_color_image, cv::Mat& plane_mask, pcl::ModelCoefficients& plane_model, cv::Mat& H, cv::Mat& R, cv::Mat& t, cv::Point2f& cameraImagePlaneOffset, cv::Mat& plane_color_image_warped, cv::Mat& plane_mask_warped)
+void DirtDetection::convertTransformToCameraPose(const tf::StampedTransform& transform_map_camera, CameraPose& pose)
 {
-	// 1. compute parameter representation of plane, construct plane coordinate system and compute transformation from camera frame (x,y,z) to plane frame (x,y,z)
-	// a) parameter form of plane equation
-	// choose two arbitrary points on the plane
-	cv::Point3d p1, p2;
-	double a=plane_model.values[0], b=plane_model.values[1], c=plane_model.values[2], d=plane_model.values[3];
-	if (a==0. && b==0.)
-	{
-		p1.x = 0;
-		p1.y = 0;
-		p1.z = -d/c;
-		p2.x = 1;
-		p2.y = 0;
-		p2.z = -d/c;
-	}
-	else if (a==0. && c==0.)
-	{
-		p1.x = 0;
-		p1.y = -d/b;
-		p1.z = 0;
-		p2.x = 1;
-		p2.y = -d/b;
-		p2.z = 0;
-	}
-	else if (b==0. && c==0.)
-	{
-		p1.x = -d/a;
-		p1.y = 0;
-		p1.z = 0;
-		p2.x = -d/a;
-		p2.y = 1;
-		p2.z = 0;
-	}
-	else if (a==0.)
-	{
-		p1.x = 0;
-		p1.y = 0;
-		p1.z = -d/c;
-		p2.x = 1;
-		p2.y = 0;
-		p2.z = -d/c;
-	}
-	else if (b==0.)
-	{
-		p1.x = 0;
-		p1.y = 0;
-		p1.z = -d/c;
-		p2.x = 0;
-		p2.y = 1;
-		p2.z = -d/c;
-	}
-	else if (c==0.)
-	{
-		p1.x = -d/a;
-		p1.y = 0;
-		p1.z = 0;
-		p2.x = -d/a;
-		p2.y = 0;
-		p2.z = 1;
-	}
-	else
-	{
-		p1.x = 0;
-		p1.y = 0;
-		p1.z = -d/c;
-		p2.x = 1;
-		p2.y = 0;
-		p2.z = (-d-a)/c;
-	}
-	// compute two normalized directions
-	cv::Point3d dirS, dirT, normal(a,b,c);
-	double lengthNormal = cv::norm(normal);
-//	if (c<0.)
-//		lengthNormal *= -1;
-	normal.x /= lengthNormal;
-	normal.y /= lengthNormal;
-	normal.z /= lengthNormal;
-	dirS = p2-p1;
-	double lengthS = cv::norm(dirS);
-	dirS.x /= lengthS;
-	dirS.y /= lengthS;
-	dirS.z /= lengthS;
-	dirT.x = normal.y*dirS.z - normal.z*dirS.y;
-	dirT.y = normal.z*dirS.x - normal.x*dirS.z;
-	dirT.z = normal.x*dirS.y - normal.y*dirS.x;
-	double lengthT = cv::norm(dirT);
-	dirT.x /= lengthT;
-	dirT.y /= lengthT;
-	dirT.z /= lengthT;
-
-	// b) construct plane coordinate system
-	// plane coordinate frame has center p1 and x-axis=dirS, y-axis=dirT, z-axis=normal
-
-	// c) compute transformation from camera frame (x,y,z) to plane frame (x,y,z)
-	t = (cv::Mat_<double>(3,1) << p1.x, p1.y, p1.z);
-	R = (cv::Mat_<double>(3,3) << dirS.x, dirT.x, normal.x, dirS.y, dirT.y, normal.y, dirS.z, dirT.z, normal.z);
-
-//		std::cout << "t: " << p1.x << ", " << p1.y << ", " << p1.z << std::endl;
-//		std::cout << "dirS: " << dirS.x << ", " << dirS.y << ", " << dirS.z << std::endl;
-//		std::cout << "dirT: " << dirT.x << ", " << dirT.y << ", " << dirT.z << std::endl;
-//		std::cout << "normal: " << normal.x << ", " << normal.y << ", " << normal.z << std::endl;
-
-	// 2. select data segment and compute final transformation of camera coordinates to scaled and centered plane coordinates
-	std::vector<cv::Point2f> pointsCamera, pointsPlane;
-	cv::Point2f minPlane(1e20,1e20), maxPlane(-1e20,-1e20);
-	cv::Mat RTt = R.t()*t;
-	for (int v=0; v<plane_color_image.rows; v++)
-	{
-		for (int u=0; u<plane_color_image.cols; u++)
-		{
-			// black pixels are not part of the plane
-			bgr color = plane_color_image.at<bgr>(v,u);
-			if (color.r==0 && color.g==0 && color.b==0)
-				continue;
-
-			// distance to camera has to be below a maximum distance
-			pcl::PointXYZRGB point = (*input_cloud)[v*plane_color_image.cols+u];
-			if (point.x*point.x + point.y*point.y + point.z*point.z > maxDistanceToCamera_*maxDistanceToCamera_)
-				continue;
-
-			// determine max and min x and y coordinates of the plane
-			cv::Mat pointCamera = (cv::Mat_<double>(3,1) << point.x, point.y, point.z);
-			pointsCamera.push_back(cv::Point2f(u,v));
-			cv::Mat pointPlane = R.t()*pointCamera - RTt;
-			pointsPlane.push_back(cv::Point2f(pointPlane.at<double>(0),pointPlane.at<double>(1)));
-
-			if (minPlane.x>pointPlane.at<double>(0))
-				minPlane.x=pointPlane.at<double>(0);
-			if (maxPlane.x<pointPlane.at<double>(0))
-				maxPlane.x=pointPlane.at<double>(0);
-			if (minPlane.y>pointPlane.at<double>(1))
-				minPlane.y=pointPlane.at<double>(1);
-			if (maxPlane.y<pointPlane.at<double>(1))
-				maxPlane.y=pointPlane.at<double>(1);
-		}
-	}
+	const tf::Matrix3x3& basis = transform_map_camera.getBasis();
+	for (int i=0; i<3; i++)
+		for (int j=0; j<3; j++)
+			pose.rotation(i,j) = basis[i][j];
+	const tf::Vector3& origin = transform_map_camera.getOrigin();
+	pose.translation = cv::Vec3d(origin.getX(), origin.getY(), origin.getZ());
+}
 
-	// 3. find homography between image plane and plane coordinates
-	// a) collect point correspondences
-	if (pointsCamera.size()<100)
-		return false;
-	double step = std::max(1.0, (double)pointsCamera.size()/100.0);
-	std::vector<cv::Point2f> correspondencePointsCamera, correspondencePointsPlane;
-	cameraImagePlaneOffset = cv::Point2f((maxPlane.x+minPlane.x)/2.f - (double)plane_color_image.cols/(2*birdEyeResolution_), (maxPlane.y+minPlane.y)/2.f - (double)plane_color_image.rows/(2*birdEyeResolution_));
-	for (double i=0; i<(double)pointsCamera.size(); i+=step)
-	{
-		correspondencePointsCamera.push_back(pointsCamera[(int)i]);
-		correspondencePointsPlane.push_back(birdEyeResolution_*(pointsPlane[(int)i]-cameraImagePlaneOffset));
-	}
-	// b) compute homography
-	H = cv::findHomography(correspondencePointsCamera, correspondencePointsPlane);
-//		correspondencePointsCamera.push_back(cv::Point2f(160,400));
-//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
-//		correspondencePointsCamera.push_back(cv::Point2f(320,400));
-//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
-//		correspondencePointsCamera.push_back(cv::Point2f(480,400));
-//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
-//		correspondencePointsCamera.push_back(cv::Point2f(160,200));
-//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
-//		correspondencePointsCamera.push_back(cv::Point2f(320,200));
-//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
-//		correspondencePointsCamera.push_back(cv::Point2f(480,200));
-//		correspondencePointsPlane.push_back(cv::Point2f(0,0));
-//		for (int i=0; i<(int)correspondencePointsCamera.size(); i++)
-//		{
-//			cv::Mat pc = (cv::Mat_<double>(3,1) << (double)correspondencePointsCamera[i].x, (double)correspondencePointsCamera[i].y, 1.0);
-//			cv::Mat pp = (cv::Mat_<double>(3,1) << (double)correspondencePointsPlane[i].x, (double)correspondencePointsPlane[i].y, 1.0);
-//
-//			cv::Mat Hp = H.inv()*pp;
-//			Hp.at<double>(0) /= Hp.at<double>(2);
-//			Hp.at<double>(1) /= Hp.at<double>(2);
-//			Hp.at<double>(2) = 1.0;
-//			cv::Mat r = pc - Hp;
-//
-//			std::cout << "H - " << i << ": " << r.at<double>(0) << ", " << r.at<double>(1) << ", " << r.at<double>(2) << std::endl;
-//		}
 
-	// 4. warp perspective
-	cv::warpPerspective(plane_color_image, plane_color_image_warped, H, plane_color_image.size());
-	// todo: better manual sampling of the warped mask needed
-	cv::warpPerspective(plane_mask, plane_mask_warped, H, plane_mask.size());
+bool DirtDetection::computeBirdsEyePerspective(pcl::PointCloud<pcl::PointXYZRGB>::Ptr input_cloud, cv::Mat& plane_color_image, cv::Mat& plane_mask, pcl::ModelCoefficients& plane_model, cv::Mat& H, cv::Mat& R, cv::Mat& t, cv::Point2f& cameraImagePlaneOffset, cv::Mat& plane_color_image_warped, cv::Mat& plane_mask_warped)
+{
+	if (warpToBirdsEyePerspective(*input_cloud, plane_color_image, plane_mask, plane_model, birdEyeResolution_, maxDistanceToCamera_, birdEyeWarpCacheQuantization_, birdsEyeWarpCache_,
+			H, R, t, cameraImagePlaneOffset, plane_color_image_warped, plane_mask_warped) == false)
+		return false;
 
 //		// this example is correct, H transforms world points into the image coordinate system
 //		std::vector<cv::Point2f> c1, c2;
@@ -1758,155 +1513,29 @@ void DirtDetection::transformPointFromWorldToCameraWarped(const cv::Point3f& poi
 	}
 }
 
+void DirtDetection::computeGridToCameraWarpedTransform(const cv::Mat& R, const cv::Mat& t, const cv::Point2f& cameraImagePlaneOffset, const tf::StampedTransform& transformMapCamera, cv::Mat& A)
+{
+	// all transformations from grid cells via map and camera coordinates to the warped image are affine for points on the floor, hence three points determine A
+	const double baseline = 100.;	// distance of the three points in grid cells
+	cv::Mat p00, p10, p01;
+	transformPointFromWorldToCameraWarped(cv::Point3f(gridOrigin_.x, gridOrigin_.y, 0.f), R, t, cameraImagePlaneOffset, transformMapCamera, p00);
+	transformPointFromWorldToCameraWarped(cv::Point3f(baseline/gridResolution_ + gridOrigin_.x, gridOrigin_.y, 0.f), R, t, cameraImagePlaneOffset, transformMapCamera, p10);
+	transformPointFromWorldToCameraWarped(cv::Point3f(gridOrigin_.x, baseline/gridResolution_ + gridOrigin_.y, 0.f), R, t, cameraImagePlaneOffset, transformMapCamera, p01);
+	A = (cv::Mat_<double>(2,3) << (p10.at<double>(0)-p00.at<double>(0))/baseline, (p01.at<double>(0)-p00.at<double>(0))/baseline, p00.at<double>(0),
+								  (p10.at<double>(1)-p00.at<double>(1))/baseline, (p01.at<double>(1)-p00.at<double>(1))/baseline, p00.at<double>(1));
+}
+
 
 void DirtDetection::putDetectionIntoGrid(cv::Mat& grid, const labelImage::RegionPointTriple& detection)
 {
-	//// convert three map points to RotatedRect, neglect z-coordinates
-	//cv::Point3f lWidth = detection.p1-detection.center;
-	//double width = 2.*sqrt(lWidth.x*lWidth.x + lWidth.y*lWidth.y + lWidth.z*lWidth.z);
-	//cv::Point3f lHeight = detection.p2-detection.center;
-	//double height = 2.*sqrt(lHeight.x*lHeight.x + lHeight.y*lHeight.y + lHeight.z*lHeight.z);
-	//double alpha = -atan2(lWidth.y, lWidth.x);
-	//cv::RotatedRect detectionRect(cv::Point2f(detection.center.x, detection.center.y), cv::Size(width, height), alpha);
-
-	// sample all points along the principal axis and count dirt detection in each grid cell of the map once
-	cv::Point3f lWidth = detection.p1-detection.center;
-	cv::Point3f lHeight = detection.p2-detection.center;
-	std::set<cv::Point2i, lessPoint2i> visitedGridCells;
-	//std::cout << "lW: " << lWidth.x << ", " << lWidth.y << "  lH: " << lHeight.x << ", " << lHeight.y << std::endl;
-	for (double scaleW=-1.; scaleW<=1.; scaleW+=0.2)
-	{
-		for (double scaleH=-1.; scaleH<=1.; scaleH+=0.2)
-		{
-			//cv::Point2i offset(grid.cols/2, grid.rows/2);	//done: offset
-			cv::Point2i coordinates[2];
-//			coordinates[0] = cv::Point2i(-(detection.center.x+scaleW*lWidth.x-gridOrigin_.x)*gridResolution_+offset.x, (detection.center.y+scaleW*lWidth.y-gridOrigin_.y)*gridResolution_+offset.y);	//done: offset
-//			coordinates[1] = cv::Point2i(-(detection.center.x+scaleH*lHeight.x-gridOrigin_.x)*gridResolution_+offset.x, (detection.center.y+scaleH*lHeight.y-gridOrigin_.y)*gridResolution_+offset.y);
-			coordinates[0] = cv::Point2i((detection.center.x+scaleW*lWidth.x-gridOrigin_.x)*gridResolution_, (detection.center.y+scaleW*lWidth.y-gridOrigin_.y)*gridResolution_);
-			coordinates[1] = cv::Point2i((detection.center.x+scaleH*lHeight.x-gridOrigin_.x)*gridResolution_, (detection.center.y+scaleH*lHeight.y-gridOrigin_.y)*gridResolution_);
-			for (int i=0; i<2; i++)
-			{
-				for (int v=0; v<=0; v++)
-				{
-					for (int u=0; u<=0; u++)
-					{
-						cv::Point2i co(coordinates[i].x+u,coordinates[i].y+v);
-						//cv::Point2i co(coordinates[i].x,coordinates[i].y);
-						if (visitedGridCells.find(co)==visitedGridCells.end() && co.x>=0 && co.x<grid.cols && co.y>=0 && co.y<grid.rows)
-						{
-							//std::cout << "sW,sH: " << scaleW << ", " << scaleH << "  co: " << co.x << ", " << co.y << std::endl;
-							// grid cell has not been incremented, yet
-							visitedGridCells.insert(co);
-							grid.at<int>(co) = grid.at<int>(co) + 1;
-						}
-					}
-				}
-			}
-		}
-	}
+	::putDetectionIntoGrid(grid, detection, gridOrigin_, gridResolution_);
 }
 
 
 void DirtDetection::SaliencyDetection_C1(const cv::Mat& C1_image, cv::Mat& C1_saliency_image)
 {
 	//given a one channel image
-	//int scale = 6;
-	//unsigned int size = (int)floor((float)pow(2.0,scale)); //the size to do the saliency at
-	unsigned int size_cols = (int)(C1_image.cols * spectralResidualImageSizeRatio_);
-	unsigned int size_rows = (int)(C1_image.rows * spectralResidualImageSizeRatio_);
-
-	//create different images
-	cv::Mat bw_im;
-	cv::resize(C1_image,bw_im,cv::Size(size_cols,size_rows));
-
-	cv::Mat realInput(size_rows,size_cols, CV_32FC1);	//calculate number of test samples
-	//int NumTestSamples = 10; //ceil(NumSamples*percentage_testdata);
-	//printf("Anzahl zu ziehender test samples: %d \n", NumTestSamples);
-	cv::Mat imaginaryInput(size_rows,size_cols, CV_32FC1);
-	cv::Mat complexInput(size_rows,size_cols, CV_32FC2);
-
-	bw_im.convertTo(realInput,CV_32F,1.0/255,0);
-	imaginaryInput = cv::Mat::zeros(size_rows,size_cols,CV_32F);
-
-	std::vector<cv::Mat> vec;
-	vec.push_back(realInput);
-	vec.push_back(imaginaryInput);
-	cv::merge(vec, complexInput);
-
-	cv::Mat dft_A(size_rows,size_cols,CV_32FC2);
-
-	cv::dft(complexInput, dft_A, cv::DFT_COMPLEX_OUTPUT,size_rows);
-	vec.clear();
-	cv::split(dft_A,vec);
-	realInput = vec[0];
-	imaginaryInput = vec[1];
-
-	// Compute the phase angle
-	cv::Mat image_Mag(size_rows,size_cols, CV_32FC1);
-	cv::Mat image_Phase(size_rows,size_cols, CV_32FC1);
-
-	//compute the phase of the spectrum
-	cv::cartToPolar(realInput, imaginaryInput, image_Mag, image_Phase,0);
-//	std::vector<DirtDetection::CarpetFeatures> test_feat_vec;
-//	std::vector<DirtDetection::CarpetClass> test_class_vec;
-
-
-	std::string name;
-	std::vector<std::string> name_vec;
-
-	name = "carpet-gray.tepp";
-	name_vec.push_back(name);
-	cv::Mat log_mag(size_rows,size_cols, CV_32FC1);
-	cv::log(image_Mag, log_mag);
-
-//	cv::Mat log_mag_;
-//	cv::normalize(log_mag, log_mag_, 0, 1, NORM_MINMAX);
-//	cv::imshow("log_mag", log_mag_);
-
-	//Box filter the magnitude, then take the difference
-	cv::Mat log_mag_Filt(size_rows,size_cols, CV_32FC1);
-
-	cv::Mat filt = cv::Mat::ones(3, 3, CV_32FC1) * 1./9.;
-	//filt.convertTo(filt,-1,1.0/9.0,0);
-
-	cv::filter2D(log_mag, log_mag_Filt, -1, filt);
-	//cv::GaussianBlur(log_mag, log_mag_Filt, cv::Size2i(25,25), 0);
-	//log_mag = log_mag_Filt.clone();
-	//cv::medianBlur(log_mag, log_mag_Filt, 5);
-
-//	cv::Mat log_mag_filt_;
-//	cv::normalize(log_mag_Filt, log_mag_filt_, 0, 1, NORM_MINMAX);
-//	cv::imshow("log_mag_filt", log_mag_filt_);
-
-	//cv::subtract(log_mag, log_mag_Filt, log_mag);
-	log_mag -= log_mag_Filt;
-
-//	cv::Mat log_mag_sub_a_, log_mag_sub_;
-//	cv::normalize(log_mag, log_mag_sub_a_, 0, 1, NORM_MINMAX);
-//	cv::GaussianBlur(log_mag_sub_a_, log_mag_sub_, cv::Size2i(21,21), 0);
-//	cv::imshow("log_mag_sub", log_mag_sub_);
-//	log_mag_Filt = log_mag.clone();
-//	cv::GaussianBlur(log_mag_Filt, log_mag, cv::Size2i(21,21), 0);
-//	void GBTreeEvaluation(	std::vector<CarpetFeatures>& train_feat_vec, std::vector<CarpetClass>& train_class_vec,
-//						std::vector<CarpetFeatures>& test_feat_vec, std::vector<CarpetClass>& test_class_vec,
-//						CvGBTrees &carpet_GBTree);
-	cv::exp(log_mag, image_Mag);
-
-	cv::polarToCart(image_Mag, image_Phase, realInput, imaginaryInput,0);
-
-	vec.clear();
-	vec.push_back(realInput);
-	vec.push_back(imaginaryInput);
-	cv::merge(vec, dft_A);
-
-	cv::dft(dft_A, dft_A, cv::DFT_INVERSE,size_rows);
-
-	dft_A = abs(dft_A);
-	dft_A.mul(dft_A);
-
-	cv::split(dft_A, vec);
-
-	C1_saliency_image = vec[0];
+	spectralResidualSaliency_.computeSaliency(C1_image, C1_saliency_image, spectralResidualImageSizeRatio_);
 }
 
 std::vector<DirtDetection::CarpetFeatures> test_feat_vec;
@@ -1914,71 +1543,7 @@ std::vector<DirtDetection::CarpetFeatures> test_feat_vec;
 
 void DirtDetection::SaliencyDetection_C3(const cv::Mat& C3_color_image, cv::Mat& C1_saliency_image, const cv::Mat* mask, int gaussianBlurCycles)
 {
-	cv::Mat fci; // "fci"<-> first channel image
-	cv::Mat sci; // "sci"<-> second channel image
-	cv::Mat tci; //"tci"<-> second channel image
-
-	std::vector<cv::Mat> vec;
-	vec.push_back(fci);
-	vec.push_back(sci);
-	vec.push_back(tci);
-
-	cv::split(C3_color_image,vec);
-
-	fci = vec[0];
-	sci = vec[1];
-	tci = vec[2];
-
-	cv::Mat res_fci; // "fci"<-> first channel image
-	cv::Mat res_sci; // "sci"<-> second channel image
-	cv::Mat res_tci; //"tci"<-> second channel image
-
-	SaliencyDetection_C1(fci, res_fci);
-	SaliencyDetection_C1(sci, res_sci);
-	SaliencyDetection_C1(tci, res_tci);
-
-	cv::Mat realInput;
-
-	realInput = (res_fci + res_sci + res_tci)/3;
-
-	cv::Size2i ksize;
-	ksize.width = 3;
-	ksize.height = 3;
-	for (int i=0; i<gaussianBlurCycles; i++)
-		cv::GaussianBlur(realInput, realInput, ksize, 0); //necessary!? --> less noise
-
-
-	cv::resize(realInput,C1_saliency_image,C3_color_image.size());
-
-	// remove borders of the ground plane because of artifacts at the border like lines
-	if (mask != 0)
-	{
-		// maske erodiere
-		cv::Mat mask_eroded = mask->clone();
-		cv::dilate(*mask, mask_eroded, cv::Mat(), cv::Point(-1, -1), 2);
-		cv::erode(mask_eroded, mask_eroded, cv::Mat(), cv::Point(-1, -1), 25.0/640.0*C3_color_image.cols);
-		cv::Mat neighborhood = cv::Mat::ones(3, 1, CV_8UC1);
-		cv::erode(mask_eroded, mask_eroded, neighborhood, cv::Point(-1, -1), 15.0/640.0*C3_color_image.cols);
-
-		//cv::erode(mask_eroded, mask_eroded, cv::Mat(), cv::Point(-1, -1), 35.0/640.0*C3_color_image.cols);
-		// todo: hack for autonomik
-		//cv::erode(mask_eroded, mask_eroded, cv::Mat(), cv::Point(-1, -1), 45.0/640.0*C3_color_image.cols);
-
-		cv::Mat temp;
-		C1_saliency_image.copyTo(temp, mask_eroded);
-		C1_saliency_image = temp;
-	}
-
-	// remove saliency at the image border (because of artifacts in the corners)
-	int borderX = C1_saliency_image.cols/20;
-	int borderY = C1_saliency_image.rows/20;
-	if (borderX > 0 && borderY > 0)
-	{
-		cv::Mat smallImage_ = C1_saliency_image.colRange(borderX, C1_saliency_image.cols-borderX);
-		cv::Mat smallImage = smallImage_.rowRange(borderY, smallImage_.rows-borderY);
-
-		copyMakeBorder(smallImage, C1_saliency_image, borderY, borderY, borderX, borderX, cv::BORDER_CONSTANT, cv::Scalar(0));
-	}
+	saliencyDetection_C3(spectralResidualSaliency_, spectralResidualImageSizeRatio_, C3_color_image, C1_saliency_image, mask, gaussianBlurCycles);
 
 
 	// display the individual channels
@@ -2247,48 +1812,26 @@ void DirtDetection::SplitIntoTrainAndTestSamples(	int NumTestSamples,
 void DirtDetection::Image_Postprocessing_C1_rmb(const cv::Mat& C1_saliency_image, cv::Mat& C1_BlackWhite_image, cv::Mat& C3_color_image, std::vector<cv::RotatedRect>& dirtDetections, const cv::Mat& mask)
 {
 	// dirt detection on image with artificial dirt
-	cv::Mat color_image_with_artifical_dirt = C3_color_image.clone();
-	cv::Mat mask_with_artificial_dirt = mask.clone();
-	// add dirt
-	int dirtSize = cvRound(3.0/640.0 * C3_color_image.cols);
-	cv::Point2f ul(0.4375*C3_color_image.cols, 0.416666667*C3_color_image.rows);
-	cv::Point2f ur(0.5625*C3_color_image.cols, 0.416666667*C3_color_image.rows);
-	cv::Point2f ll(0.4375*C3_color_image.cols, 0.583333333*C3_color_image.rows);
-	cv::Point2f lr(0.5625*C3_color_image.cols, 0.583333333*C3_color_image.rows);
-	cv::ellipse(color_image_with_artifical_dirt, cv::RotatedRect(ul, cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(255, 255, 255), dirtSize);
-	cv::ellipse(mask_with_artificial_dirt, cv::RotatedRect(ul, cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(255, 255, 255), dirtSize);
-	cv::ellipse(color_image_with_artifical_dirt, cv::RotatedRect(lr, cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(255, 255, 255), dirtSize);
-	cv::ellipse(mask_with_artificial_dirt, cv::RotatedRect(lr, cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(255, 255, 255), dirtSize);
-	cv::ellipse(color_image_with_artifical_dirt, cv::RotatedRect(ll, cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(0, 0, 0), dirtSize);
-	cv::ellipse(mask_with_artificial_dirt, cv::RotatedRect(ll, cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(255, 255, 255), dirtSize);
-	cv::ellipse(color_image_with_artifical_dirt, cv::RotatedRect(ur, cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(0, 0, 0), dirtSize);
-	cv::ellipse(mask_with_artificial_dirt, cv::RotatedRect(ur, cv::Size2f(dirtSize,dirtSize), 0), cv::Scalar(255, 255, 255), dirtSize);
-	cv::Mat C1_saliency_image_with_artifical_dirt;
-	SaliencyDetection_C3(color_image_with_artifical_dirt, C1_saliency_image_with_artifical_dirt, &mask_with_artificial_dirt, spectralResidualGaussianBlurIterations_);
-	//cv::imshow("ai_dirt", color_image_with_artifical_dirt);
-
-	// display of images with artificial dirt
-	if (debug_["showColorWithArtificialDirt"] == true)
-		cv::imshow("color with artificial dirt", color_image_with_artifical_dirt);
-	cv::Mat C1_saliency_image_with_artifical_dirt_scaled;
-	double salminv, salmaxv;
-	cv::Point2i salminl, salmaxl;
-	cv::minMaxLoc(C1_saliency_image_with_artifical_dirt,&salminv,&salmaxv,&salminl,&salmaxl, mask_with_artificial_dirt);
-	C1_saliency_image_with_artifical_dirt.convertTo(C1_saliency_image_with_artifical_dirt_scaled, -1, 1.0/(salmaxv-salminv), -1.0*(salminv)/(salmaxv-salminv));
-	if (debug_["showSaliencyWithArtificialDirt"] == true)
-		cv::imshow("saliency with artificial dirt", C1_saliency_image_with_artifical_dirt_scaled);
-
-	// scale C1_saliency_image to value obtained from C1_saliency_image with artificially added dirt
-//	std::cout << "res_img: " << C1_saliency_image_with_artifical_dirt.at<float>(300,200);
-//	C1_saliency_image_with_artifical_dirt = C1_saliency_image_with_artifical_dirt.mul(C1_saliency_image_with_artifical_dirt);	// square C1_saliency_image_with_artifical_dirt to emphasize the dirt and increase the gap to background response
-//	std::cout << " -> " << C1_saliency_image_with_artifical_dirt.at<float>(300,200) << std::endl;
-	double minv, maxv;
-	cv::Point2i minl, maxl;
-	cv::minMaxLoc(C1_saliency_image_with_artifical_dirt,&minv,&maxv,&minl,&maxl, mask_with_artificial_dirt);
-	cv::Scalar mean, stdDev;
-	cv::meanStdDev(C1_saliency_image_with_artifical_dirt, mean, stdDev, mask);
-	double newMaxVal = std::min(1.0, maxv/spectralResidualNormalizationHighestMaxValue_);///mean.val[0] / spectralResidualNormalizationHighestMaxMeanRatio_);
-//	std::cout << "dirtThreshold=" << dirtThreshold_ << "\tmin=" << minv << "\tmax=" << maxv << "\tmean=" << mean.val[0] << "\tstddev=" << stdDev.val[0] << "\tnewMaxVal (r)=" << newMaxVal << std::endl;
+	// the normalization statistics change slowly with the floor appearance, so they are only recomputed every artificialDirtStatisticsUpdateInterval_ frames or if the image size changes
+	cv::Mat color_image_with_artifical_dirt, C1_saliency_image_with_artifical_dirt, mask_with_artificial_dirt;
+	if (updateArtificialDirtStatistics(spectralResidualSaliency_, spectralResidualImageSizeRatio_, spectralResidualGaussianBlurIterations_, artificialDirtStatisticsUpdateInterval_,
+			C3_color_image, mask, artificialDirtStatistics_, &color_image_with_artifical_dirt, &C1_saliency_image_with_artifical_dirt, &mask_with_artificial_dirt) == true)
+	{
+		// display of images with artificial dirt
+		if (debug_["showColorWithArtificialDirt"] == true)
+			cv::imshow("color with artificial dirt", color_image_with_artifical_dirt);
+		if (debug_["showSaliencyWithArtificialDirt"] == true)
+		{
+			cv::Mat C1_saliency_image_with_artifical_dirt_scaled;
+			double salminv, salmaxv;
+			cv::minMaxLoc(C1_saliency_image_with_artifical_dirt, &salminv, &salmaxv, 0, 0, mask_with_artificial_dirt);
+			C1_saliency_image_with_artifical_dirt.convertTo(C1_saliency_image_with_artifical_dirt_scaled, -1, 1.0/(salmaxv-salminv), -1.0*(salminv)/(salmaxv-salminv));
+			cv::imshow("saliency with artificial dirt", C1_saliency_image_with_artifical_dirt_scaled);
+		}
+	}
+	const cv::Scalar mean = artificialDirtStatistics_.mean;
+	const cv::Scalar stdDev = artificialDirtStatistics_.stdDev;
+//	std::cout << "dirtThreshold=" << dirtThreshold_ << "\tmin=" << artificialDirtStatistics_.minv << "\tmax=" << artificialDirtStatistics_.maxv << "\tmean=" << mean.val[0] << "\tstddev=" << stdDev.val[0] << std::endl;
 
 
 	//determine ros package path
@@ -2300,13 +1843,13 @@ void DirtDetection::Image_Postprocessing_C1_rmb(const cv::Mat& C1_saliency_image
 //	teppichfile.close();
 
 
-	////C1_saliency_image.convertTo(scaled_input_image, -1, 1.0/(maxv-minv), 1.0*(minv)/(maxv-minv));
-	cv::Mat scaled_C1_saliency_image = C1_saliency_image.clone();	// square C1_saliency_image_with_artifical_dirt to emphasize the dirt and increase the gap to background response
-	//scaled_C1_saliency_image = scaled_C1_saliency_image.mul(scaled_C1_saliency_image);
-	scaled_C1_saliency_image.convertTo(scaled_C1_saliency_image, -1, newMaxVal/(maxv-minv), -newMaxVal*(minv)/(maxv-minv));
+	// scale C1_saliency_image to value obtained from C1_saliency_image with artificially added dirt
+	cv::Mat scaled_C1_saliency_image;
+	double scale = 1., offset = 0.;
+	normalizeSaliency(C1_saliency_image, artificialDirtStatistics_, spectralResidualNormalizationHighestMaxValue_, scaled_C1_saliency_image, &scale, &offset);
 
-	double newMean = mean.val[0] * newMaxVal/(maxv-minv) - newMaxVal*(minv)/(maxv-minv);
-	double newStdDev = stdDev.val[0] * newMaxVal/(maxv-minv);
+	double newMean = mean.val[0] * scale + offset;
+	double newStdDev = stdDev.val[0] * scale;
 //	std::cout << "newMean=" << newMean << "   newStdDev=" << newStdDev << std::endl;
 
 //	// scale C1_saliency_image
@@ -2337,24 +1880,8 @@ void DirtDetection::Image_Postprocessing_C1_rmb(const cv::Mat& C1_saliency_image
 	// remove responses that lie on lines
 	if (removeLines_ == true)
 	{
-		cv::Mat src, dst, color_dst;
-
-		cv::cvtColor(C3_color_image, src, CV_BGR2GRAY);
-
-		// hack: autonomik
-		//cv::Canny(src, dst, 150, 200, 3);
-		cv::Canny(src, dst, 90, 170, 3);
-		cv::cvtColor(dst, color_dst, CV_GRAY2BGR);
-
-		std::vector<cv::Vec4i> lines;
-		cv::HoughLinesP(dst, lines, 1, CV_PI/180, 80, 30, 10);
-		for( size_t i = 0; i < lines.size(); i++ )
-		{
-			line(color_dst, cv::Point(lines[i][0], lines[i][1]), cv::Point(lines[i][2], lines[i][3]), cv::Scalar(0,0,255), 3, 8);
-			line(scaled_C1_saliency_image, cv::Point(lines[i][0], lines[i][1]), cv::Point(lines[i][2], lines[i][3]), cv::Scalar(0,0,0), 13, 8);
-			// todo: hack for autonomik
-			//line(scaled_C1_saliency_image, cv::Point(lines[i][0], lines[i][1]), cv::Point(lines[i][2], lines[i][3]), cv::Scalar(0,0,0), 35, 8);
-		}
+		cv::Mat color_dst;
+		removeLineResponses(C3_color_image, scaled_C1_saliency_image, (debug_["showDetectedLines"] == true ? &color_dst : 0));
 
 		if (debug_["showDetectedLines"] == true)
 		{
@@ -2369,43 +1896,25 @@ void DirtDetection::Image_Postprocessing_C1_rmb(const cv::Mat& C1_saliency_image
 		cvMoveWindow("saliency detection", 0, 530);
 	}
 
-	//set dirt pixel to white
-	C1_BlackWhite_image = cv::Mat::zeros(C1_saliency_image.size(), CV_8UC1);
-	cv::threshold(scaled_C1_saliency_image, C1_BlackWhite_image, dirtThreshold_, 1, cv::THRESH_BINARY);
-//	cv::threshold(scaled_C1_saliency_image, C1_BlackWhite_image, mean.val[0] + stdDev.val[0] * dirtCheckStdDevFactor_, 1, cv::THRESH_BINARY);
-
-//	std::cout << "(C1_saliency_image channels) = (" << C1_saliency_image.channels() << ")" << std::endl;
-
-	cv::Mat CV_8UC_image;
-	C1_BlackWhite_image.convertTo(CV_8UC_image, CV_8UC1);
-
-
-//	Mat dst = Mat::zeros(img.rows, img.cols, CV_8UC3);
-//	dst = C3_color_image;
-
+	// dirt regions
 	std::vector<std::vector<cv::Point> > contours;
-	std::vector<cv::Vec4i> hierarchy;
-
-	cv::findContours(CV_8UC_image, contours, hierarchy, CV_RETR_LIST, CV_CHAIN_APPROX_SIMPLE);
+	const size_t firstDetection = dirtDetections.size();
+	extractDirtRegions(scaled_C1_saliency_image, dirtThreshold_, C1_BlackWhite_image, dirtDetections, &contours);
 
 	cv::Scalar green(0, 255, 0);
 	cv::Scalar red(0, 0, 255);
 	for (int i = 0; i < (int)contours.size(); i++)
 	{
-		cv::RotatedRect rec = minAreaRect(contours[i]);
+		const cv::RotatedRect& rec = dirtDetections[firstDetection+i];
 		double meanIntensity = 0;
 		for (int t=0; t<(int)contours[i].size(); t++)
 			meanIntensity += scaled_C1_saliency_image.at<float>(contours[i][t].y, contours[i][t].x);
 		meanIntensity /= (double)contours[i].size();
+		// todo: hack: for autonomik all regions are kept as detections and drawn green
 		if (meanIntensity > newMean + dirtCheckStdDevFactor_ * newStdDev)
-		{
-			// todo: hack: for autonomik only detect green ellipses
-			//dirtDetections.push_back(rec);
 			cv::ellipse(C3_color_image, rec, green, 2);
-		}
 		else
 			cv::ellipse(C3_color_image, rec, green, 2);	// todo: use red
-		dirtDetections.push_back(rec);
 	}
 }
 
@@ -15,6 +15,7 @@
 #include <opencv/highgui.h>
 
 #include <ipa_building_navigation/node.h>
+#include <ipa_building_navigation/indexed_binary_heap.h>
 
 #pragma once //make sure this header gets included only one time when multiple classes need it in the same project
 			 //regarding to https://en.wikipedia.org/wiki/Pragma_once this is more efficient than #define
@@ -29,6 +30,14 @@
 //The algorithm also needs the Robot radius [m] and the map resolution [m²/pixel] to calculate the needed
 //amount of erosions to include the radius in the planning.
 //
+//The search mode selects the search algorithm on the downsampled grid. ASTAR_STANDARD is the original planner that expands
+//all 8 neighbors of each node. ASTAR_JUMP_POINT uses jump point search (Harabor and Grastien, 2011), which exploits the
+//uniform cost of the occupancy grid to only expand the few jump points along symmetric straight and diagonal runs. It uses
+//the same move costs as the standard planner, so the returned path lengths are the same, and works on an index-based binary
+//heap with preallocated node buffers instead of heap allocated nodes.
+//
+
+enum AStarSearchModes {ASTAR_STANDARD=1, ASTAR_JUMP_POINT=2};
 
 class AStarPlanner
 {
@@ -38,10 +47,37 @@ protected:
 
 	std::string route_;
 
+	int search_mode_;	// one of AStarSearchModes
+
+	// buffers of the jump point search, kept over successive calls to avoid allocations
+	IndexedBinaryHeap open_list_;				// open list over the linear cell index y*n+x
+	std::vector<int> cost_to_come_;				// cost from the start to each reached cell, valid if visited_stamp_ equals search_stamp_
+	std::vector<int> parent_cell_;				// linear index of the jump point a cell was reached from
+	std::vector<unsigned int> visited_stamp_;	// search number in which a cell was reached the last time
+	std::vector<unsigned char> closed_;			// closed flag per cell, valid if visited_stamp_ equals search_stamp_
+	unsigned int search_stamp_;
+
 	std::string pathFind(const int& xStart, const int& yStart, const int& xFinish, const int& yFinish, const cv::Mat& map);
 
+	std::string pathFindJumpPoint(const int& xStart, const int& yStart, const int& xFinish, const int& yFinish, const cv::Mat& map);
+
+	// moves from (x,y) into direction (dx,dy) until a jump point is found, returns its linear index or -1 if the run is blocked
+	int jump(int x, int y, const int dx, const int dy, const int xFinish, const int yFinish, const cv::Mat& map) const;
+
+	// checks whether a cell reached by a move into direction (dx,dy) has neighbors that can not be reached optimally without it
+	bool hasForcedNeighbor(const int x, const int y, const int dx, const int dy, const cv::Mat& map) const;
+
+	bool isAccessible(const int x, const int y, const cv::Mat& map) const
+	{
+		return (x >= 0 && x < n && y >= 0 && y < m && map.at<unsigned char>(y, x) == 255);
+	}
+
 public:
-	AStarPlanner();
+	AStarPlanner(const int search_mode=ASTAR_STANDARD);
+
+	void setSearchMode(const int search_mode);
+
+	int getSearchMode() const;
 
 	void drawRoute(cv::Mat& map, const cv::Point start_point, const std::string& route, double step_length);
 
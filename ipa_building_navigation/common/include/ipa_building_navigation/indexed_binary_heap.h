@@ -0,0 +1,129 @@
+#include <vector>
+
+#pragma once //make sure this header gets included only one time when multiple classes need it in the same project
+			 //regarding to https://en.wikipedia.org/wiki/Pragma_once this is more efficient than #define
+
+//This class provides a binary min-heap over integer element ids (e.g. the linear cell index y*width+x of a grid map).
+//In contrast to a std::priority_queue of node objects, each id can be contained at most once, its position in the heap
+//is tracked, so that the key of an already queued element can be decreased in O(log n) without rebuilding the queue.
+//All storage is kept in vectors that are only resized when a larger id range is requested, so a heap object can be
+//reused for many searches without any allocations per pushed element.
+class IndexedBinaryHeap
+{
+protected:
+	std::vector<int> heap_;				// heap ordered element ids
+	std::vector<int> keys_;				// key of each element id, only valid while the element is queued
+	std::vector<int> positions_;		// position of each element id in heap_, -1 if the element is not queued
+
+	bool less(const int a, const int b) const
+	{
+		return keys_[heap_[a]] < keys_[heap_[b]];
+	}
+
+	void swapEntries(const int a, const int b)
+	{
+		const int id = heap_[a];
+		heap_[a] = heap_[b];
+		heap_[b] = id;
+		positions_[heap_[a]] = a;
+		positions_[heap_[b]] = b;
+	}
+
+	void siftUp(int position)
+	{
+		while (position > 0)
+		{
+			const int parent = (position - 1) / 2;
+			if (!less(position, parent))
+				break;
+			swapEntries(position, parent);
+			position = parent;
+		}
+	}
+
+	void siftDown(int position)
+	{
+		const int size = (int)heap_.size();
+		while (true)
+		{
+			const int left = 2 * position + 1;
+			if (left >= size)
+				break;
+			int smallest = left;
+			if (left + 1 < size && less(left + 1, left))
+				smallest = left + 1;
+			if (!less(smallest, position))
+				break;
+			swapEntries(position, smallest);
+			position = smallest;
+		}
+	}
+
+public:
+	IndexedBinaryHeap()
+	{
+	}
+
+	// prepares the heap for element ids in [0, number_of_ids), keeps the allocated memory if it is already large enough
+	void reset(const int number_of_ids)
+	{
+		// only the currently queued elements need to be unmarked, which is cheaper than refilling the whole position array
+		for (size_t i = 0; i < heap_.size(); ++i)
+			positions_[heap_[i]] = -1;
+		heap_.clear();
+		if ((int)positions_.size() < number_of_ids)
+		{
+			positions_.resize(number_of_ids, -1);
+			keys_.resize(number_of_ids, 0);
+		}
+	}
+
+	bool empty() const
+	{
+		return heap_.empty();
+	}
+
+	size_t size() const
+	{
+		return heap_.size();
+	}
+
+	bool contains(const int id) const
+	{
+		return positions_[id] >= 0;
+	}
+
+	int key(const int id) const
+	{
+		return keys_[id];
+	}
+
+	// inserts the element id with the given key or lowers its key if it is already queued with a larger key
+	void pushOrDecrease(const int id, const int key)
+	{
+		if (positions_[id] < 0)
+		{
+			keys_[id] = key;
+			heap_.push_back(id);
+			positions_[id] = (int)heap_.size() - 1;
+			siftUp(positions_[id]);
+		}
+		else if (key < keys_[id])
+		{
+			keys_[id] = key;
+			siftUp(positions_[id]);
+		}
+	}
+
+	// removes and returns the element id with the smallest key
+	int pop()
+	{
+		const int top = heap_[0];
+		swapEntries(0, (int)heap_.size() - 1);
+		heap_.pop_back();
+		positions_[top] = -1;
+		if (!heap_.empty())
+			siftDown(0);
+		return top;
+	}
+};
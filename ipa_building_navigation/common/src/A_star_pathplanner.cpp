@@ -2,6 +2,8 @@
 
 #include <ipa_building_navigation/timer.h>
 
+#include <algorithm>
+
 const int dir = 8; // number of possible directions to go at any position
 // if dir==4
 //static int dx[dir]={1, 0, -1, 0};
@@ -20,10 +22,22 @@ bool operator<(const NodeAstar& a, const NodeAstar& b)
 	return a.getPriority() > b.getPriority();
 }
 
-AStarPlanner::AStarPlanner()
+AStarPlanner::AStarPlanner(const int search_mode)
 {
 	n = 1;
 	m = 1;
+	search_mode_ = search_mode;
+	search_stamp_ = 0;
+}
+
+void AStarPlanner::setSearchMode(const int search_mode)
+{
+	search_mode_ = search_mode;
+}
+
+int AStarPlanner::getSearchMode() const
+{
+	return search_mode_;
 }
 
 void AStarPlanner::drawRoute(cv::Mat& map, const cv::Point start_point, const std::string& route, double step_length)
@@ -95,6 +109,9 @@ void AStarPlanner::downsampleMap(const cv::Mat& map, cv::Mat& downsampled_map, c
 // The route returned is a string of direction digits.
 std::string AStarPlanner::pathFind(const int & xStart, const int & yStart, const int & xFinish, const int & yFinish, const cv::Mat& map)
 {
+	if (search_mode_ == ASTAR_JUMP_POINT)
+		return pathFindJumpPoint(xStart, yStart, xFinish, yFinish, map);
+
 	static std::priority_queue<NodeAstar> pq[2]; // list of open (not-yet-tried) nodes
 	static int pqi; // pq index
 	static NodeAstar* n0;
@@ -242,6 +259,194 @@ std::string AStarPlanner::pathFind(const int & xStart, const int & yStart, const
 	return ""; // no route found
 }
 
+// Checks for forced neighbors of cell (x,y) that was entered by a move into direction (dx,dy). A neighbor is forced if it is
+// accessible but the obstacle next to (x,y) blocks all paths to it that are at least as short and avoid (x,y).
+bool AStarPlanner::hasForcedNeighbor(const int x, const int y, const int dx, const int dy, const cv::Mat& map) const
+{
+	if (dx != 0 && dy != 0)
+	{
+		// diagonal move
+		return ((!isAccessible(x-dx, y, map) && isAccessible(x-dx, y+dy, map)) || (!isAccessible(x, y-dy, map) && isAccessible(x+dx, y-dy, map)));
+	}
+	else if (dx != 0)
+	{
+		// horizontal move
+		return ((!isAccessible(x, y+1, map) && isAccessible(x+dx, y+1, map)) || (!isAccessible(x, y-1, map) && isAccessible(x+dx, y-1, map)));
+	}
+	// vertical move
+	return ((!isAccessible(x+1, y, map) && isAccessible(x+1, y+dy, map)) || (!isAccessible(x-1, y, map) && isAccessible(x-1, y+dy, map)));
+}
+
+int AStarPlanner::jump(int x, int y, const int dx, const int dy, const int xFinish, const int yFinish, const cv::Mat& map) const
+{
+	while (true)
+	{
+		x += dx;
+		y += dy;
+		if (isAccessible(x, y, map) == false)
+			return -1;
+		if ((x == xFinish && y == yFinish) || hasForcedNeighbor(x, y, dx, dy, map) == true)
+			return y*n + x;
+		// a diagonal run stops where one of its straight components finds a jump point
+		if (dx != 0 && dy != 0 && (jump(x, y, dx, 0, xFinish, yFinish, map) >= 0 || jump(x, y, 0, dy, xFinish, yFinish, map) >= 0))
+			return y*n + x;
+	}
+}
+
+// Jump point search on the same 8-connected grid with costs 10 (straight) and 14 (diagonal) as the standard A-star.
+// The route returned is a string of direction digits, i.e. the straight and diagonal runs between the jump points are
+// unrolled into single steps, so it can be used in the same way as the result of the standard search.
+std::string AStarPlanner::pathFindJumpPoint(const int& xStart, const int& yStart, const int& xFinish, const int& yFinish, const cv::Mat& map)
+{
+	if (xStart < 0 || xStart >= n || yStart < 0 || yStart >= m || (xStart == xFinish && yStart == yFinish))
+		return "";
+
+	// prepare the buffers, the visited stamps make a full reset of the per cell data unnecessary
+	const int number_of_cells = n*m;
+	if ((int)visited_stamp_.size() < number_of_cells)
+	{
+		cost_to_come_.resize(number_of_cells);
+		parent_cell_.resize(number_of_cells);
+		closed_.resize(number_of_cells);
+		visited_stamp_.resize(number_of_cells, 0);
+	}
+	++search_stamp_;
+	if (search_stamp_ == 0)
+	{
+		std::fill(visited_stamp_.begin(), visited_stamp_.end(), 0);
+		search_stamp_ = 1;
+	}
+	open_list_.reset(number_of_cells);
+
+	const int start_index = yStart*n + xStart;
+	const int finish_index = yFinish*n + xFinish;
+	visited_stamp_[start_index] = search_stamp_;
+	cost_to_come_[start_index] = 0;
+	parent_cell_[start_index] = -1;
+	closed_[start_index] = 0;
+	open_list_.pushOrDecrease(start_index, 0);
+
+	int directions_x[dir];
+	int directions_y[dir];
+	while (!open_list_.empty())
+	{
+		const int current_index = open_list_.pop();
+		closed_[current_index] = 1;
+
+		if (current_index == finish_index)
+		{
+			// generate the path from finish to start by following the parent jump points
+			std::string path = "";
+			int index = finish_index;
+			while (parent_cell_[index] >= 0)
+			{
+				const int parent_index = parent_cell_[index];
+				const int step_x = index%n - parent_index%n;
+				const int step_y = index/n - parent_index/n;
+				const int sx = (step_x > 0) - (step_x < 0);
+				const int sy = (step_y > 0) - (step_y < 0);
+				int j = 0;
+				while (dx[j] != sx || dy[j] != sy)
+					++j;
+				path.append(std::max(abs(step_x), abs(step_y)), (char)('0' + j));
+				index = parent_index;
+			}
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+		// determine the directions that need to be searched from the current jump point
+		const int x = current_index % n;
+		const int y = current_index / n;
+		int number_of_directions = 0;
+		if (parent_cell_[current_index] < 0)
+		{
+			for (int i = 0; i < dir; i++)
+			{
+				directions_x[number_of_directions] = dx[i];
+				directions_y[number_of_directions++] = dy[i];
+			}
+		}
+		else
+		{
+			const int px = parent_cell_[current_index] % n;
+			const int py = parent_cell_[current_index] / n;
+			const int mx = (x > px) - (x < px);
+			const int my = (y > py) - (y < py);
+			if (mx != 0 && my != 0)
+			{
+				// natural neighbors of a diagonal move
+				directions_x[number_of_directions] = mx;
+				directions_y[number_of_directions++] = my;
+				directions_x[number_of_directions] = mx;
+				directions_y[number_of_directions++] = 0;
+				directions_x[number_of_directions] = 0;
+				directions_y[number_of_directions++] = my;
+				// forced neighbors
+				if (!isAccessible(x-mx, y, map) && isAccessible(x-mx, y+my, map))
+				{
+					directions_x[number_of_directions] = -mx;
+					directions_y[number_of_directions++] = my;
+				}
+				if (!isAccessible(x, y-my, map) && isAccessible(x+mx, y-my, map))
+				{
+					directions_x[number_of_directions] = mx;
+					directions_y[number_of_directions++] = -my;
+				}
+			}
+			else
+			{
+				// natural neighbor of a straight move
+				directions_x[number_of_directions] = mx;
+				directions_y[number_of_directions++] = my;
+				// forced neighbors, (ox,oy) is orthogonal to the move direction
+				const int ox = my;
+				const int oy = mx;
+				if (!isAccessible(x+ox, y+oy, map) && isAccessible(x+mx+ox, y+my+oy, map))
+				{
+					directions_x[number_of_directions] = mx+ox;
+					directions_y[number_of_directions++] = my+oy;
+				}
+				if (!isAccessible(x-ox, y-oy, map) && isAccessible(x+mx-ox, y+my-oy, map))
+				{
+					directions_x[number_of_directions] = mx-ox;
+					directions_y[number_of_directions++] = my-oy;
+				}
+			}
+		}
+
+		// generate the successor jump points
+		for (int i = 0; i < number_of_directions; i++)
+		{
+			const int successor_index = jump(x, y, directions_x[i], directions_y[i], xFinish, yFinish, map);
+			if (successor_index < 0)
+				continue;
+			const bool visited = (visited_stamp_[successor_index] == search_stamp_);
+			if (visited == true && closed_[successor_index] == 1)
+				continue;
+
+			expanding_counter++;
+
+			const int sx = successor_index % n;
+			const int sy = successor_index / n;
+			const int steps = std::max(abs(sx - x), abs(sy - y));
+			const int cost = cost_to_come_[current_index] + ((directions_x[i] != 0 && directions_y[i] != 0) ? 14 : 10) * steps;
+			if (visited == false || cost < cost_to_come_[successor_index])
+			{
+				visited_stamp_[successor_index] = search_stamp_;
+				closed_[successor_index] = 0;
+				cost_to_come_[successor_index] = cost;
+				parent_cell_[successor_index] = current_index;
+				// octile distance as heuristic, it is consistent with the straight and diagonal move costs
+				const int distance_x = abs(xFinish - sx);
+				const int distance_y = abs(yFinish - sy);
+				open_list_.pushOrDecrease(successor_index, cost + 10*std::max(distance_x, distance_y) + 4*std::min(distance_x, distance_y));
+			}
+		}
+	}
+	return ""; // no route found
+}
+
 //This is the path planning algorithm for this class. It downsamples the map with the given factor (0 < factor < 1) so the
 //map gets reduced and calculation time gets better. If it is set to 1 the map will have original size, if it is 0 the algorithm
 //won't work, so make sure to not set it to 0. The algorithm also needs the Robot radius [m] and the map resolution [m²/pixel] to
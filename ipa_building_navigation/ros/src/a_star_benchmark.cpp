@@ -0,0 +1,116 @@
+#include "ros/ros.h"
+#include <ros/package.h>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <math.h>
+#include <cstdlib>
+
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+
+#include <ipa_building_navigation/A_star_pathplanner.h>
+#include <ipa_building_navigation/timer.h>
+
+// Compares the standard A-star search with the jump point search of the AStarPlanner on the navigation test maps.
+// For each map, random pairs of accessible start and goal points are planned with both search modes on the same
+// downsampled map, the computation times are summed up and the path lengths are checked for equality.
+int main(int argc, char **argv)
+{
+	srand(5);
+	ros::init(argc, argv, "a_star_benchmark");
+	ros::NodeHandle nh;
+
+	const int number_of_queries = 200;
+	const double downsampling_factor = 0.25;
+	const double robot_radius = 0.3;
+	const double map_resolution = 0.05;
+	const double length_tolerance = 1e-6;
+
+	std::vector< std::string > map_names;
+	map_names.push_back("lab_ipa");
+	map_names.push_back("lab_c_scan");
+	map_names.push_back("Freiburg52_scan");
+	map_names.push_back("Freiburg79_scan");
+	map_names.push_back("lab_b_scan");
+	map_names.push_back("lab_intel");
+	map_names.push_back("Freiburg101_scan");
+	map_names.push_back("lab_d_scan");
+	map_names.push_back("lab_f_scan");
+	map_names.push_back("lab_a_scan");
+	map_names.push_back("NLB");
+	map_names.push_back("office_a");
+	map_names.push_back("office_e");
+	map_names.push_back("office_i");
+	map_names.push_back("lab_ipa_furnitures");
+	map_names.push_back("Freiburg52_scan_furnitures");
+	map_names.push_back("NLB_furnitures");
+
+	const std::string test_map_path = ros::package::getPath("ipa_room_segmentation") + "/common/files/test_maps/";
+
+	AStarPlanner standard_planner(ASTAR_STANDARD);
+	AStarPlanner jump_point_planner(ASTAR_JUMP_POINT);
+
+	double total_standard_time = 0., total_jump_point_time = 0.;
+	int total_mismatches = 0;
+	std::cout << std::setw(30) << std::left << "map" << std::setw(10) << "queries" << std::setw(14) << "A* [ms]"
+			<< std::setw(14) << "JPS [ms]" << std::setw(10) << "speedup" << "max length deviation" << std::endl;
+	for (size_t image_index = 0; image_index<map_names.size(); ++image_index)
+	{
+		std::string image_filename = test_map_path + map_names[image_index] + ".png";
+		cv::Mat map = cv::imread(image_filename.c_str(), 0);
+		if (map.empty())
+		{
+			std::cout << "could not load image: " << image_filename << std::endl;
+			continue;
+		}
+		//make non-white pixels black
+		for (int y = 0; y < map.rows; y++)
+			for (int x = 0; x < map.cols; x++)
+				map.at<unsigned char>(y, x) = (map.at<unsigned char>(y, x) > 250 ? 255 : 0);
+
+		// both planners work on the same downsampled map, sample start and goal points that are accessible in it
+		cv::Mat downsampled_map;
+		standard_planner.downsampleMap(map, downsampled_map, downsampling_factor, robot_radius, map_resolution);
+		std::vector<cv::Point> accessible_points;
+		for (int y = 0; y < downsampled_map.rows; y++)
+			for (int x = 0; x < downsampled_map.cols; x++)
+				if (downsampled_map.at<unsigned char>(y, x) == 255)
+					accessible_points.push_back(cv::Point(x/downsampling_factor, y/downsampling_factor));
+		if (accessible_points.size() < 2)
+			continue;
+
+		double standard_time = 0., jump_point_time = 0., max_deviation = 0.;
+		for (int query = 0; query < number_of_queries; ++query)
+		{
+			const cv::Point start = accessible_points[rand() % accessible_points.size()];
+			const cv::Point goal = accessible_points[rand() % accessible_points.size()];
+
+			Timer tim;
+			const double standard_length = standard_planner.planPath(map, downsampled_map, start, goal, downsampling_factor, 0., map_resolution);
+			standard_time += tim.getElapsedTimeInMilliSec();
+
+			tim.start();
+			const double jump_point_length = jump_point_planner.planPath(map, downsampled_map, start, goal, downsampling_factor, 0., map_resolution);
+			jump_point_time += tim.getElapsedTimeInMilliSec();
+
+			const double deviation = fabs(standard_length - jump_point_length);
+			max_deviation = std::max(max_deviation, deviation);
+			if (deviation > length_tolerance)
+			{
+				++total_mismatches;
+				std::cout << "  path length mismatch from " << start << " to " << goal << ": A*=" << standard_length << "  JPS=" << jump_point_length << std::endl;
+			}
+		}
+		total_standard_time += standard_time;
+		total_jump_point_time += jump_point_time;
+		std::cout << std::setw(30) << std::left << map_names[image_index] << std::setw(10) << number_of_queries << std::setw(14) << standard_time
+				<< std::setw(14) << jump_point_time << std::setw(10) << standard_time/std::max(jump_point_time, 1e-6) << max_deviation << std::endl;
+	}
+	std::cout << "total: A* " << total_standard_time << " ms, JPS " << total_jump_point_time << " ms, speedup "
+			<< total_standard_time/std::max(total_jump_point_time, 1e-6) << ", path length mismatches: " << total_mismatches << std::endl;
+
+	return (total_mismatches == 0 ? 0 : 1);
+}
@@ -85,6 +85,46 @@
 
 #define PI 3.14159265359
 
+// Reachability layer of a room map: the 8-connected components of the accessible area (value 255) of the (inflated) room map.
+// Two accessible positions are mutually reachable if they carry the same component label. The layer is computed once per map
+// and replaces the contour based approach path check of MapAccessibilityAnalysis::checkPerimeter, which extracts the contours
+// of the whole map for every perimeter check.
+class ReachabilityLayer
+{
+public:
+
+	ReachabilityLayer(const cv::Mat& room_map);
+
+	// returns the component label of an accessible position, 0 if the position is inaccessible or outside the map
+	int getComponentLabel(const cv::Point& position) const;
+
+	// returns the component of a robot position, if the position itself is not accessible the first accessible 8-neighbor is taken
+	int getRobotComponentLabel(const cv::Point& robot_position) const;
+
+	// returns true if there is a path from the robot position to the goal position, i.e. the goal is accessible and lies in the
+	// component of the robot position or of one of its 8-neighbors (the A* planner starts from any cell and expands to 8-neighbors)
+	bool isReachable(const cv::Point& robot_position, const cv::Point& goal_position) const;
+
+protected:
+
+	cv::Mat component_labels_;		// component label of each map cell, CV_32SC1, 0 for inaccessible cells
+};
+
+// best accessible robot pose on the perimeter around a fov pose for one component of the reachability layer
+struct PerimeterCandidate
+{
+	int component_label;
+	MapAccessibilityAnalysis::Pose pose;
+};
+
+// Samples the perimeter around all fov poses of a path at once (in parallel) in the same way as MapAccessibilityAnalysis::checkPerimeter.
+// For each fov pose and each component of the reachability layer the accessible perimeter pose that points in the viewing direction
+// of the fov pose best is stored (poses with the fov pose's orientation, corrected by fov_to_front_offset_angle), i.e. the best
+// reachable pose for a given robot position is the candidate of the robot's component.
+void computePerimeterCandidates(std::vector<std::vector<PerimeterCandidate> >& perimeter_candidates, const std::vector<geometry_msgs::Pose2D>& fov_path,
+		const double fov_radius_pixel, const double fov_to_front_offset_angle, const double rotational_sampling_step, const cv::Mat& room_map,
+		const ReachabilityLayer& reachability_layer);
+
 // Function that provides the functionality that a given field of view (fov) path gets mapped to a robot path by using the given parameters.
 // To do so simply a vector operation is applied. If the computed robot pose is not in the free space, another accessible
 // point is generated by finding it on the radius around the fov middlepoint s.t. the distance to the last robot position
@@ -59,6 +59,129 @@
 
 #include <ipa_room_exploration/fov_to_robot_mapper.h>
 
+
+ReachabilityLayer::ReachabilityLayer(const cv::Mat& room_map)
+{
+	// label the 8-connected components of the accessible area with a breadth first search
+	component_labels_ = cv::Mat::zeros(room_map.rows, room_map.cols, CV_32SC1);
+	int number_components = 0;
+	std::vector<cv::Point> queue;
+	for (int v=0; v<room_map.rows; ++v)
+	{
+		for (int u=0; u<room_map.cols; ++u)
+		{
+			if (room_map.at<uchar>(v,u)!=255 || component_labels_.at<int>(v,u)!=0)
+				continue;
+
+			++number_components;
+			component_labels_.at<int>(v,u) = number_components;
+			queue.clear();
+			queue.push_back(cv::Point(u,v));
+			for (size_t i=0; i<queue.size(); ++i)
+			{
+				const cv::Point current = queue[i];
+				for (int dv=-1; dv<=1; ++dv)
+				{
+					for (int du=-1; du<=1; ++du)
+					{
+						const int nu = current.x+du;
+						const int nv = current.y+dv;
+						if (nu<0 || nv<0 || nu>=room_map.cols || nv>=room_map.rows)
+							continue;
+						if (room_map.at<uchar>(nv,nu)==255 && component_labels_.at<int>(nv,nu)==0)
+						{
+							component_labels_.at<int>(nv,nu) = number_components;
+							queue.push_back(cv::Point(nu,nv));
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+int ReachabilityLayer::getComponentLabel(const cv::Point& position) const
+{
+	if (position.x<0 || position.y<0 || position.x>=component_labels_.cols || position.y>=component_labels_.rows)
+		return 0;
+	return component_labels_.at<int>(position);
+}
+
+int ReachabilityLayer::getRobotComponentLabel(const cv::Point& robot_position) const
+{
+	int label = getComponentLabel(robot_position);
+	for (int dv=-1; dv<=1 && label==0; ++dv)
+		for (int du=-1; du<=1 && label==0; ++du)
+			label = getComponentLabel(robot_position+cv::Point(du,dv));
+	return label;
+}
+
+bool ReachabilityLayer::isReachable(const cv::Point& robot_position, const cv::Point& goal_position) const
+{
+	const int goal_label = getComponentLabel(goal_position);
+	if (goal_label == 0)
+		return false;
+	for (int dv=-1; dv<=1; ++dv)
+		for (int du=-1; du<=1; ++du)
+			if (getComponentLabel(robot_position+cv::Point(du,dv)) == goal_label)
+				return true;
+	return false;
+}
+
+
+void computePerimeterCandidates(std::vector<std::vector<PerimeterCandidate> >& perimeter_candidates, const std::vector<geometry_msgs::Pose2D>& fov_path,
+		const double fov_radius_pixel, const double fov_to_front_offset_angle, const double rotational_sampling_step, const cv::Mat& room_map,
+		const ReachabilityLayer& reachability_layer)
+{
+	perimeter_candidates.clear();
+	perimeter_candidates.resize(fov_path.size());
+#pragma omp parallel for schedule(dynamic, 16)
+	for (int i=0; i<(int)fov_path.size(); ++i)
+	{
+		const MapAccessibilityAnalysis::Pose fov_center(fov_path[i].x, fov_path[i].y, fov_path[i].theta);
+		const cv::Point2d approach(cos(fov_center.orientation), sin(fov_center.orientation));
+		std::vector<double> max_cos_alpha;		// best value for each candidate in perimeter_candidates[i]
+		for (double angle=fov_center.orientation; angle<fov_center.orientation+2*PI; angle+=rotational_sampling_step)
+		{
+			// accessible position on the perimeter
+			const double x = fov_center.x + fov_radius_pixel*cos(angle);
+			const double y = fov_center.y + fov_radius_pixel*sin(angle);
+			if (x<0 || y<0 || x>=room_map.cols || y>=room_map.rows || room_map.at<uchar>(y,x)!=255)
+				continue;
+			MapAccessibilityAnalysis::Pose perimeter_pose(x, y, angle+PI);
+			while (perimeter_pose.orientation > 2*PI)
+				perimeter_pose.orientation -= 2*PI;
+			while (perimeter_pose.orientation < 0.)
+				perimeter_pose.orientation += 2*PI;
+
+			// exclude positions that are ahead of the moving direction
+			perimeter_pose.orientation -= fov_to_front_offset_angle; // robot heading correction of off-center fov
+			const cv::Point2d heading(cos(perimeter_pose.orientation), sin(perimeter_pose.orientation));
+			if (approach.x*heading.x+approach.y*heading.y < 0)
+				continue;
+
+			// rank by cos(angle) between approach direction and viewing direction, separately for each reachable component
+			const double cos_alpha = approach.x*heading.x + approach.y*heading.y;
+			const int component_label = reachability_layer.getComponentLabel(cv::Point(x,y));
+			size_t c=0;
+			for (; c<perimeter_candidates[i].size() && perimeter_candidates[i][c].component_label!=component_label; ++c);
+			if (c == perimeter_candidates[i].size())
+			{
+				PerimeterCandidate candidate;
+				candidate.component_label = component_label;
+				candidate.pose = perimeter_pose;
+				perimeter_candidates[i].push_back(candidate);
+				max_cos_alpha.push_back(cos_alpha);
+			}
+			else if (cos_alpha > max_cos_alpha[c])
+			{
+				perimeter_candidates[i][c].pose = perimeter_pose;
+				max_cos_alpha[c] = cos_alpha;
+			}
+		}
+	}
+}
+
 // Function that provides the functionality that a given fov path gets mapped to a robot path by using the given parameters.
 // To do so simply a vector operation is applied. If the computed robot pose is not in the free space, another accessible
 // point is generated by finding it on the radius around the fov middlepoint s.t. the distance to the last robot position
@@ -70,7 +193,6 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 		const double map_resolution, const cv::Point2d map_origin, const cv::Point& starting_point)
 {
 	// initialize helper classes
-	MapAccessibilityAnalysis map_accessibility;
 	AStarPlanner path_planner;
 	const double map_resolution_inv = 1.0/map_resolution;
 
@@ -84,68 +206,39 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 	const double fov_to_front_offset_angle = atan2((double)robot_to_fov_vector(1,0), (double)robot_to_fov_vector(0,0));
 	std::cout << "mapPath: fov_to_front_offset_angle: " << fov_to_front_offset_angle << "rad (" << fov_to_front_offset_angle*180./PI << "deg)" << std::endl;
 
+	// compute the reachable areas of the map once and the best accessible perimeter poses of all fov poses in one batch
+	const ReachabilityLayer reachability_layer(room_map);
+	std::vector<std::vector<PerimeterCandidate> > perimeter_candidates;
+	computePerimeterCandidates(perimeter_candidates, fov_path, fov_radius_pixel, fov_to_front_offset_angle, PI/64., room_map, reachability_layer);
+
 	// go trough the given poses and calculate accessible robot poses
-	// first try with A*, if this fails, call map_accessibility_analysis and finally try a directly computed pose shift
+	// first try with the accessible perimeter poses, if this fails, try a directly computed pose shift and finally the A* path
 	int found_with_astar = 0, found_with_map_acc = 0, found_with_shift = 0, not_found = 0;
-	for(std::vector<geometry_msgs::Pose2D>::const_iterator pose=fov_path.begin(); pose!=fov_path.end(); ++pose)
+	for(size_t pose_index=0; pose_index<fov_path.size(); ++pose_index)
 	{
+		const geometry_msgs::Pose2D* pose = &fov_path[pose_index];
 		bool found_pose = false;
 
-		// 1. try with map_accessibility_analysis
-		// compute accessible locations on perimeter around target fov center
-		MapAccessibilityAnalysis::Pose fov_center(pose->x, pose->y, pose->theta);
-		std::vector<MapAccessibilityAnalysis::Pose> accessible_poses_on_perimeter;
-		map_accessibility.checkPerimeter(accessible_poses_on_perimeter, fov_center, fov_radius_pixel, PI/64., room_map, true, robot_pos);
-
-		if(accessible_poses_on_perimeter.size()!=0)
+		// 1. take the accessible location on the perimeter around the target fov center that is reachable from the current robot position
+		// todo: also consider complete visibility of the fov_center (or whole cell) as a selection criterion
+		// todo: extend with a complete consideration of the exact robot footprint
+		const int robot_component_label = reachability_layer.getRobotComponentLabel(robot_pos);
+		for (size_t c=0; c<perimeter_candidates[pose_index].size() && robot_component_label!=0; ++c)
 		{
-			// todo: also consider complete visibility of the fov_center (or whole cell) as a selection criterion
-			// todo: extend with a complete consideration of the exact robot footprint
-			// go trough the found accessible positions and take the one that minimizes the angle between approach vector and robot heading direction at the target position
-			// and which lies in the half circle around fov_center which is "behind" the fov_center pose's orientation
-			double max_cos_alpha = -10;
-			MapAccessibilityAnalysis::Pose best_pose;
-			//std::cout << "Perimeter: \n robot_pos = " << robot_pos.x << ", " << robot_pos.y << "     fov_center = " << fov_center.x << ", " << fov_center.y << "\n";
-			for(std::vector<MapAccessibilityAnalysis::Pose>::iterator perimeter_pose = accessible_poses_on_perimeter.begin(); perimeter_pose != accessible_poses_on_perimeter.end(); ++perimeter_pose)
-			{
-				// exclude positions that are ahead of the moving direction
-				//cv::Point2d heading = cv::Point2d(fov_center.x, fov_center.y) - cv::Point2d(perimeter_pose->x, perimeter_pose->y);
-				//const double heading_norm = sqrt((double)heading.x*heading.x+heading.y*heading.y);
-				perimeter_pose->orientation -= fov_to_front_offset_angle; // robot heading correction of off-center fov
-				cv::Point2d heading = cv::Point2d(cos(perimeter_pose->orientation), sin(perimeter_pose->orientation));
-				const double heading_norm = 1.;
-				if ((cos(fov_center.orientation)*heading.x+sin(fov_center.orientation)*heading.y)/heading_norm < 0)
-					continue;
-
-				// rank by cos(angle) between approach direction and viewing direction
-				//cv::Point2d approach = cv::Point2d(perimeter_pose->x, perimeter_pose->y) - cv::Point2d(robot_pos.x, robot_pos.y);
-				//const double approach_norm = sqrt(approach.x*approach.x+approach.y*approach.y);
-				cv::Point2d approach = cv::Point2d(cos(fov_center.orientation), sin(fov_center.orientation));
-				const double approach_norm = 1.;
-				double cos_alpha = 1.;		// only remains 1.0 if robot_pose and perimeter_pose are identical
-				if (approach.x!=0 || approach.y!=0)	// compute the cos(angle) between approach direction and viewing direction
-					cos_alpha = (approach.x*heading.x + approach.y*heading.y)/(approach_norm*heading_norm);
-				//std::cout << " - perimeter_pose = " << perimeter_pose->x << ", " << perimeter_pose->y << "     cos_alpha = " << cos_alpha << "   max_cos_alpha = " << max_cos_alpha << std::endl;
-				if(cos_alpha>max_cos_alpha)
-				{
-					max_cos_alpha = cos_alpha;
-					best_pose = *perimeter_pose;
-					found_pose = true;
-				}
-			}
+			if (perimeter_candidates[pose_index][c].component_label != robot_component_label)
+				continue;
 
 			// add pose to path and set robot position to it
-			if (found_pose == true)
-			{
-				geometry_msgs::Pose2D best_pose_msg;
-				best_pose_msg.x = best_pose.x*map_resolution + map_origin.x;
-				best_pose_msg.y = best_pose.y*map_resolution + map_origin.y;
-				best_pose_msg.theta = best_pose.orientation;
-				robot_path.push_back(best_pose_msg);
-				robot_pos = cv::Point2d(best_pose.x, best_pose.y);
-				//std::cout << " best_pose = " << best_pose.x << ", " << best_pose.y << "      max_cos_alpha = " << max_cos_alpha << std::endl;
-				++found_with_map_acc;
-			}
+			const MapAccessibilityAnalysis::Pose& best_pose = perimeter_candidates[pose_index][c].pose;
+			geometry_msgs::Pose2D best_pose_msg;
+			best_pose_msg.x = best_pose.x*map_resolution + map_origin.x;
+			best_pose_msg.y = best_pose.y*map_resolution + map_origin.y;
+			best_pose_msg.theta = best_pose.orientation;
+			robot_path.push_back(best_pose_msg);
+			robot_pos = cv::Point2d(best_pose.x, best_pose.y);
+			found_pose = true;
+			++found_with_map_acc;
+			break;
 		}
 
 		// 2. if no accessible pose was found, try with a directly computed pose shift
@@ -186,7 +279,9 @@ void mapPath(const cv::Mat& room_map, std::vector<geometry_msgs::Pose2D>& robot_
 			// get vector from current position to desired fov position
 			cv::Point fov_position(pose->x, pose->y);
 			std::vector<cv::Point> astar_path;
-			path_planner.planPath(room_map, robot_pos, fov_position, 1.0, 0.0, map_resolution, 0, &astar_path);
+			// the planner only finds a path if the fov position is reachable, otherwise it would search the whole robot area in vain
+			if (reachability_layer.isReachable(robot_pos, fov_position) == true)
+				path_planner.planPath(room_map, robot_pos, fov_position, 1.0, 0.0, map_resolution, 0, &astar_path);
 
 			// find the point on the astar path that is on the viewing circle around the fov middlepoint
 			cv::Point accessible_position;
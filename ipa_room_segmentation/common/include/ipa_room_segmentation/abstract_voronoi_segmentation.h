@@ -10,7 +10,10 @@
 
 #include <ctime>
 
+#include <boost/unordered_map.hpp>
+
 #include <ipa_room_segmentation/room_class.h>
+#include <ipa_room_segmentation/voronoi_skeleton.h>
 
 #define PI 3.14159265
 
@@ -24,10 +27,43 @@ struct cv_Point_comp
 	}
 };
 
+// Union-find structure for the relabeling of rooms while they are merged.
+// The room ids are kept in disjoint sets, all ids of a set carry the same current label. Relabeling a room joins its set with the set
+// of the target label in almost constant time, the map is only relabeled once with the final labels by relabelMap.
+class RoomLabelUnionFind
+{
+public:
+
+	// registers a room id, initially it carries its own id as label
+	void addRoomID(const int room_id);
+
+	// relabels everything that currently carries room_to_merge_label with target_label (same effect as Room::setRoomId on the map)
+	void relabel(const int room_to_merge_label, const int target_label);
+
+	// returns the current label of a room id, ids that were never registered keep their value
+	int getLabel(const int room_id);
+
+	// replaces every label in the map by its current label
+	void relabelMap(cv::Mat& map);
+
+protected:
+
+	int findRoot(const int room_id);
+
+	boost::unordered_map<int,int> parents_;			// parent of each room id in the union-find forest, roots are their own parent
+	boost::unordered_map<int,int> root_labels_;		// current label of each root
+	boost::unordered_map<int,int> label_roots_;		// root of the set that currently carries a label
+};
+
+// methods to create the generalized Voronoi graph of a map
+enum VoronoiGraphGenerators {VORONOI_GENERATOR_SUBDIV2D=1, VORONOI_GENERATOR_DISTANCE_TRANSFORM=2};
+
 class AbstractVoronoiSegmentation
 {
 protected:
 
+	int voronoi_graph_generator_;	// method to create the Voronoi graph, see VoronoiGraphGenerators
+
 	// Function to get the ID of a room, when given an index in the storing vector.
 	// This function takes a vector of rooms and an index in this vector and returns the ID of this room, meaning the color it has
 	// been drawn in the map.
@@ -36,9 +72,9 @@ protected:
 	// Function to merge two rooms together on the given already segmented map.
 	// This function is used to merge two rooms together in the given already segmented map. It takes two indexes, showing which
 	// room is the bigger one and which is the smaller one. The smaller one should be merged together with the bigger one, what is
-	// done by changing the color of this room in the map to the color of the bigger room and inserting the members into the bigger
-	// room.
-	void mergeRoomPair(std::vector<Room>& rooms, const int target_index, const int room_to_merge_index, cv::Mat& segmented_map, const double map_resolution);
+	// done by relabeling this room with the color of the bigger room in room_labels and inserting the members into the bigger
+	// room. The map itself is relabeled later with RoomLabelUnionFind::relabelMap.
+	void mergeRoomPair(std::vector<Room>& rooms, const int target_index, const int room_to_merge_index, RoomLabelUnionFind& room_labels, const double map_resolution);
 
 	// Function to draw the generalized voronoi-diagram into a given map, not drawing lines that start or end at black pixels
 	// This function draws the Voronoi-diagram into a given map. It needs the facets as vector of Points, the contour of the
@@ -58,8 +94,14 @@ protected:
 	//	   and draws them using the drawVoronoi function. This function draws the facets that only have Points inside
 	//	   the map-contour (other lines go to not-reachable places and are not necessary to be looked at).
 	//	3. It returns the map that has the generalized voronoi-graph drawn in.
+	// With VORONOI_GENERATOR_DISTANCE_TRANSFORM, the graph is computed by createVoronoiGraphFromDistanceTransform instead.
 	void createVoronoiGraph(cv::Mat& map_for_voronoi_generation);
 
+	// Function to get the exact generalized voronoi-graph drawn into the map
+	// The graph is the skeleton of the Euclidean distance transform of the map (see drawVoronoiSkeleton), it is computed in
+	// linear time and does not contain the spurious lines of the approximation with the contour points.
+	void createVoronoiGraphFromDistanceTransform(cv::Mat& map_for_voronoi_generation);
+
 	// This function prunes the generalized Voronoi-graph in the given map.
 	// It reduces the graph down to the nodes in the graph. A node is a point on the Voronoi graph, that has at least 3
 	// neighbors. This deletes errors from the approximate generation of the graph that hasn't been eliminated from
@@ -76,9 +118,14 @@ protected:
 	// Function that goes trough each given room and checks if it should be merged together wit another bigger room, if it is too small.
 	// This function takes the segmented Map from the original Voronoi-segmentation-algorithm and merges rooms together,
 	// that are small enough and have only two or one neighbor.
+	// The region adjacency graph (room areas and common border lengths) is computed in one pass over the map, merged rooms
+	// are relabeled in a union-find structure and the map is relabeled once at the end.
 	void mergeRooms(cv::Mat& map_to_merge_rooms, std::vector<Room>& rooms, double map_resolution_from_subscription, double max_area_for_merging, bool display_map);
 
 public:
 
 	AbstractVoronoiSegmentation();
+
+	// sets the method that creates the Voronoi graph, see VoronoiGraphGenerators
+	void setVoronoiGraphGenerator(const int voronoi_graph_generator);
 };
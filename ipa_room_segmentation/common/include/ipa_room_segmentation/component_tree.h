@@ -0,0 +1,75 @@
+#pragma once
+
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+
+#include <iostream>
+#include <vector>
+
+// This class builds the component tree of the upper level sets {p : level_map(p) > t} of an integer image for all thresholds
+// t in [min_threshold, max_threshold] in a single pass. The pixels are inserted in order of decreasing value and merged with a
+// union-find structure (8-connectivity, like the foreground of cv::findContours), so the connected components of every
+// threshold are known without thresholding and contour extraction at each level.
+// Each node represents one connected component at one threshold. Besides its pixel count, a node stores the number of its
+// boundary pixels (pixels with a 4-neighbor outside of the component, including the neighbors in holes). The boundary count
+// allows to approximate the area that cv::contourArea yields for the outer contour minus the hole contours of a component,
+// because these polygons run through the centers of the boundary pixels. The approximation deviates by at most half of the
+// boundary pixels, so the exact area is only computed for components whose approximated area is that close to a limit.
+class ComponentTree
+{
+public:
+
+	struct Node
+	{
+		int threshold;			// the component is a connected component of {p : level_map(p) > threshold}
+		int parent;				// index of the node that contains this component at threshold-1, -1 at min_threshold
+		int area;				// number of pixels
+		int boundary_pixels;	// number of pixels with a 4-neighbor outside of the component
+		int seed_pixel;			// index row*cols+column of one pixel of the component
+		cv::Rect bounding_box;	// bounding box of the component
+	};
+
+	ComponentTree();
+
+	// builds the tree, level_map has to be of type CV_32SC1, values above max_threshold are treated like max_threshold+1
+	void build(const cv::Mat& level_map, const int min_threshold, const int max_threshold);
+
+	// all nodes, sorted by decreasing threshold, i.e. children are always stored before their parents
+	const std::vector<Node>& getNodes() const;
+
+	// indices of the nodes at the given threshold, i.e. the connected components of {p : level_map(p) > threshold}
+	const std::vector<int>& getThresholdNodes(const int threshold) const;
+
+	// index of the node at the highest threshold that contains the pixel, -1 if level_map(pixel) <= min_threshold
+	int getPixelNode(const int row, const int column) const;
+
+	// approximation of the area of the component in [pixel], corresponding to cv::contourArea of its outer contour minus its hole contours
+	double getContourArea(const int node) const;
+
+	// area of the component in [pixel] for the comparison with the given limits [pixel]: the approximation if it is farther than
+	// its maximum deviation from both limits, otherwise the exact cv::contourArea of its outer contour minus its hole contours
+	double getContourArea(const int node, const double lower_limit, const double upper_limit) const;
+
+	// cv::contourArea of the outer contour minus the hole contours of the component in [pixel]
+	double getExactContourArea(const int node) const;
+
+	int getMinThreshold() const;
+
+	int getMaxThreshold() const;
+
+protected:
+
+	int findRoot(int pixel);
+
+	std::vector<Node> nodes_;
+	std::vector< std::vector<int> > threshold_nodes_;	// node indices per threshold, threshold_nodes_[t-min_threshold_]
+	cv::Mat pixel_nodes_;								// node index of each pixel at its highest threshold, CV_32SC1
+
+	std::vector<int> union_find_parents_;				// union-find forest over the pixel indices, -1 if the pixel was not inserted yet
+	std::vector<int> root_area_;						// pixel count of the component, valid for root pixels
+	std::vector<int> root_boundary_pixels_;				// boundary pixel count of the component, valid for root pixels
+	std::vector<cv::Rect> root_bounding_boxes_;			// bounding box of the component, valid for root pixels
+
+	int min_threshold_;
+	int max_threshold_;
+};
@@ -67,10 +67,17 @@ class MeanShift2D
 public:
 	MeanShift2D(void) {};
 
-	void filter(const std::vector<cv::Vec2d>& data, std::vector<cv::Vec2d>& filtered_data, const double bandwidth, const int maximumIterations=100);
+	// mean shift with the Gaussian kernel exp(-bandwidth*d^2), the neighbors of each point are looked up in a grid with cells of the kernel support
+	// a point stops moving once its shift falls below convergence_threshold, the iteration ends when all points have converged
+	void filter(const std::vector<cv::Vec2d>& data, std::vector<cv::Vec2d>& filtered_data, const double bandwidth, const int maximumIterations=100, const double convergence_threshold=1e-3);
 
 	void computeConvergencePoints(const std::vector<cv::Vec2d>& filtered_data, std::vector<cv::Vec2d>& convergence_points, std::vector< std::vector<int> >& convergence_sets, const double sensitivity);
 
 	// map_resolution in [m/cell]
-	cv::Vec2d findRoomCenter(const cv::Mat& room_image, const std::vector<cv::Vec2d>& room_cells, double map_resolution);
+	// room_image may be a region of interest of the map that starts at room_image_offset, the room_cells and the returned center are map coordinates
+	cv::Vec2d findRoomCenter(const cv::Mat& room_image, const std::vector<cv::Vec2d>& room_cells, double map_resolution, const cv::Point& room_image_offset=cv::Point(0,0));
+
+protected:
+
+	static const double kernel_cutoff_;		// kernel weights below exp(-kernel_cutoff_) are neglected
 };
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+// This class does max-sum (i.e. max-product in the log domain) loopy belief propagation on a discrete factor graph with a
+// residual schedule (Elidan et al., Residual Belief Propagation: Informed Scheduling for Asynchronous Message Passing, 2006).
+// Instead of updating every message in every iteration, only the messages whose new value differs most from the current one
+// (the residual) are committed, and only the factors next to the changed variables compute new candidate messages. This
+// converges in far fewer message computations than the flooding schedule on the large, mostly tree-like graphs of the
+// Voronoi random field. To use several cores, all messages with a residual of at least residual_fraction times the maximal
+// residual are committed in one round and the candidates of the affected factors are computed in parallel (OpenMP).
+//
+// The factors are given as value tables, where the label of the first variable of a factor changes fastest, i.e. the value
+// of the labels (x_0, x_1, ...) is stored at x_0 + L*x_1 + L^2*x_2 + ... with L labels per variable. The sum of all factor
+// values is maximized.
+class ResidualBeliefPropagation
+{
+public:
+
+	ResidualBeliefPropagation(const size_t number_of_variables, const size_t number_of_labels);
+
+	// adds a factor over the given variables with the given value table, the table needs number_of_labels^variables.size() entries
+	void addFactor(const std::vector<size_t>& variables, const std::vector<double>& values);
+
+	// max_iterations limits the number of rounds in which messages are committed, the inference stops when no message changes
+	// by more than convergence_bound anymore
+	void infer(const size_t max_iterations, const double convergence_bound, const double residual_fraction=0.5);
+
+	// labels that maximize the beliefs of the variables
+	void arg(std::vector<size_t>& labels) const;
+
+	// sum of all factor values for the labels returned by arg()
+	double value() const;
+
+	// number of committed factor-to-variable messages of the last inference
+	size_t getNumberOfMessageUpdates() const;
+
+protected:
+
+	struct Factor
+	{
+		std::vector<size_t> variables;
+		std::vector<double> values;
+		size_t first_message;	// index of the message to variables[0], the messages to the other variables follow
+	};
+
+	// computes the candidate messages of the factor to all of its variables and their residuals
+	void computeCandidateMessages(const size_t factor);
+
+	size_t number_of_variables_;
+	size_t number_of_labels_;
+
+	std::vector<Factor> factors_;
+	std::vector< std::vector<size_t> > factors_of_variables_;
+
+	// factor-to-variable messages, message m is stored at [m*number_of_labels_, (m+1)*number_of_labels_)
+	std::vector<double> messages_;
+	std::vector<double> candidate_messages_;
+	std::vector<double> residuals_;
+	std::vector<size_t> message_variables_;		// receiving variable of each message
+
+	std::vector<double> beliefs_;	// sum of all incoming messages of each variable
+
+	size_t number_of_message_updates_;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <opencv/cv.h>
+#include <vector>
+
+#include <boost/function.hpp>
+
+// This class segments very large maps tile by tile, so that the memory needed by the segmentation algorithms is bounded
+// by the tile size instead of the map size. The map is split into a grid of tile_size x tile_size core tiles, every tile
+// is extended by tile_overlap cells on each side and segmented on its own (in parallel with OpenMP). Each tile only writes
+// its core into the segmented map. The labels of the extended part of a tile are compared with the labels of the neighboring
+// cores afterwards: two rooms of neighboring tiles are joined (union-find) when they cover the same cells of the overlap,
+// i.e. when their common cells make up at least min_overlap_ratio of the smaller of both rooms within that overlap.
+//
+// The segmented map follows the conventions of the segmentation algorithms: 0 are obstacles, 255*256 are free cells without
+// room, everything in between is a room label. The rooms are labeled consecutively from 1.
+// The tile size should be several times larger than the largest room and the overlap should be larger than a doorway width,
+// otherwise rooms are cut by the tile borders before they can be joined again and the room area limits of the algorithms
+// might discard the cut parts.
+class TiledSegmentation
+{
+public:
+
+	// segments a single tile map (same format as the full map) into tile_segmented_map (CV_32SC1), tile_offset is the
+	// position of the tile in the full map, the function is called concurrently for different tiles unless parallel_tiles is false
+	typedef boost::function<void (const cv::Mat& tile_map, cv::Mat& tile_segmented_map, const cv::Point& tile_offset)> TileSegmentationFunction;
+
+	TiledSegmentation();
+
+	// parallel_tiles: segment the tiles in parallel, set it to false if segment_tile is not thread safe or may throw
+	void segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat& segmented_map, const int tile_size, const int tile_overlap,
+			const TileSegmentationFunction& segment_tile, const double min_overlap_ratio=0.5, const bool parallel_tiles=true);
+
+protected:
+
+	// a labeled cell of the extended part of a tile, which lies in the core of a neighboring tile
+	struct SeamCell
+	{
+		int x, y;		// map coordinates
+		int label;		// room label of the tile that extends over this cell, 1..number of rooms in that tile
+	};
+
+	int findRoot(std::vector<int>& parents, int id);
+};
@@ -91,6 +91,7 @@
 #include <ipa_room_segmentation/clique_class.h>
 #include <ipa_room_segmentation/room_class.h>
 #include <ipa_room_segmentation/abstract_voronoi_segmentation.h>
+#include <ipa_room_segmentation/residual_belief_propagation.h>
 
 #pragma once
 
@@ -147,6 +148,9 @@ std::vector<T>& operator+=(std::vector<T>& a, const std::vector<T>& b)
     return a;
 }
 
+// inference algorithms for the conditional random field
+enum VrfInferenceMethods {VRF_INFERENCE_LOOPY_BP=1, VRF_INFERENCE_RESIDUAL_BP=2};
+
 class VoronoiRandomFieldSegmentation : public AbstractVoronoiSegmentation
 {
 protected:
@@ -166,6 +170,8 @@ protected:
 
 	std::vector<double> trained_conditional_weights_; // The weights that are needed for the feature-induction in the conditional random field.
 
+	int inference_method_; // Inference algorithm used for the conditional random field, see VrfInferenceMethods.
+
 	// Function to check if the given point is more far away from each point in the given set than the min_distance.
 	bool pointMoreFarAway(const std::set<cv::Point, cv_Point_comp>& points, const cv::Point& point, const double min_distance);
 
@@ -184,6 +190,14 @@ protected:
 	void getAdaBoostFeatureVector(std::vector<double>& feature_vector, Clique& clique,
 			 std::vector<uint>& given_labels, std::vector<unsigned int>& possible_labels);
 
+	// Same as above, but with the features of the clique members computed before by getCliqueMemberFeatures. Only the label
+	// dependent feature gets recomputed, so the features of a clique can be reused for all of its label configurations.
+	void getAdaBoostFeatureVector(std::vector<double>& feature_vector, const std::vector<std::vector<double> >& member_features,
+			 std::vector<uint>& given_labels, std::vector<unsigned int>& possible_labels);
+
+	// Function to calculate the features of each member of a clique, the label dependent feature is not set.
+	void getCliqueMemberFeatures(Clique& clique, std::vector<unsigned int>& possible_labels, std::vector<std::vector<double> >& member_features);
+
 	// Function that takes a map and draws a pruned voronoi graph in it.
 	void createPrunedVoronoiGraph(cv::Mat& map_for_voronoi_generation, std::set<cv::Point, cv_Point_comp>& node_points);
 
@@ -217,6 +231,9 @@ public:
 	// Constructor
 	VoronoiRandomFieldSegmentation();
 
+	// sets the inference algorithm for the conditional random field, see VrfInferenceMethods
+	void setInferenceMethod(const int inference_method);
+
 	// This function is used to train the algorithm. The above defined functions separately train the AdaBoost-classifiers and
 	// the conditional random field. By calling this function the training is done in the right order, because the AdaBoost-classifiers
 	// need to be trained to calculate features for the conditional random field.
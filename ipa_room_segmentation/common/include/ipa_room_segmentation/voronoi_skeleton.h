@@ -0,0 +1,25 @@
+#pragma once
+
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+
+#include <iostream>
+#include <vector>
+
+// Exact Euclidean distance transform with feature transform in linear time (Felzenszwalb and Huttenlocher, Distance Transforms
+// of Sampled Functions, 2012). For each pixel, squared_distance_map (CV_32SC1) stores the squared distance to the nearest
+// obstacle pixel (value 0 in map) and nearest_obstacle_map (CV_32SC1) the index row*cols+col of that obstacle pixel, or -1
+// if the map does not contain any obstacle. Like cv::distanceTransform, the region outside of the image is not treated as obstacle.
+void computeEuclideanDistanceTransform(const cv::Mat& map, cv::Mat& squared_distance_map, cv::Mat& nearest_obstacle_map);
+
+// Thins all regions with the given value in image to 8-connected lines of one pixel width (Zhang and Suen, 1984), the removed
+// pixels are set to background_value.
+void thinRegions(cv::Mat& image, const uchar region_value, const uchar background_value);
+
+// Computes the generalized Voronoi diagram of the free space (value 255) in map as skeleton of its Euclidean distance transform.
+// A pixel belongs to the skeleton if the nearest obstacle pixel of one of its neighbors is farther than
+// min_obstacle_separation [pixel] away from its own nearest obstacle pixel, i.e. if the pixel lies between two different walls or
+// two distant parts of the same wall. The skeleton is only drawn with voronoi_color into voronoi_map where valid_area is not 0
+// and thinned to a width of one pixel afterwards.
+void drawVoronoiSkeleton(const cv::Mat& map, const cv::Mat& valid_area, cv::Mat& voronoi_map, const uchar voronoi_color,
+		const double min_obstacle_separation=2.5);
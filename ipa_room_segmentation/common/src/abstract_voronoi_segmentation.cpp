@@ -9,10 +9,16 @@
 
 
 AbstractVoronoiSegmentation::AbstractVoronoiSegmentation()
+: voronoi_graph_generator_(VORONOI_GENERATOR_SUBDIV2D)
 {
 
 }
 
+void AbstractVoronoiSegmentation::setVoronoiGraphGenerator(const int voronoi_graph_generator)
+{
+	voronoi_graph_generator_ = voronoi_graph_generator;
+}
+
 bool AbstractVoronoiSegmentation::determineRoomIndexFromRoomID(const std::vector<Room>& rooms, const int room_id, size_t& room_index)
 {
 	bool found_id = false;
@@ -29,13 +35,89 @@ bool AbstractVoronoiSegmentation::determineRoomIndexFromRoomID(const std::vector
 	return found_id;
 }
 
-void AbstractVoronoiSegmentation::mergeRoomPair(std::vector<Room>& rooms, const int target_index, const int room_to_merge_index, cv::Mat& segmented_map, const double map_resolution)
+void RoomLabelUnionFind::addRoomID(const int room_id)
+{
+	if (parents_.find(room_id) != parents_.end())
+		return;
+	parents_[room_id] = room_id;
+	root_labels_[room_id] = room_id;
+	label_roots_[room_id] = room_id;
+}
+
+int RoomLabelUnionFind::findRoot(const int room_id)
+{
+	int root = room_id;
+	while (parents_[root] != root)
+		root = parents_[root];
+	// path compression
+	int current = room_id;
+	while (current != root)
+	{
+		const int next = parents_[current];
+		parents_[current] = root;
+		current = next;
+	}
+	return root;
+}
+
+void RoomLabelUnionFind::relabel(const int room_to_merge_label, const int target_label)
+{
+	if (room_to_merge_label == target_label)
+		return;
+	boost::unordered_map<int,int>::iterator it_merge = label_roots_.find(room_to_merge_label);
+	if (it_merge == label_roots_.end())
+		return;		// nothing carries this label anymore
+	const int root_merge = it_merge->second;
+	label_roots_.erase(it_merge);
+
+	boost::unordered_map<int,int>::iterator it_target = label_roots_.find(target_label);
+	if (it_target == label_roots_.end())
+	{
+		// the set is the only one with the target label
+		root_labels_[root_merge] = target_label;
+		label_roots_[target_label] = root_merge;
+	}
+	else
+	{
+		// join both sets
+		parents_[root_merge] = it_target->second;
+		root_labels_.erase(root_merge);
+	}
+}
+
+int RoomLabelUnionFind::getLabel(const int room_id)
+{
+	if (parents_.find(room_id) == parents_.end())
+		return room_id;
+	return root_labels_[findRoot(room_id)];
+}
+
+void RoomLabelUnionFind::relabelMap(cv::Mat& map)
+{
+	// rooms are contiguous, hence the label of the previous pixel is mostly the same
+	int last_label = 0, last_new_label = getLabel(0);
+	for (int v = 0; v < map.rows; ++v)
+	{
+		int* map_ptr = map.ptr<int>(v);
+		for (int u = 0; u < map.cols; ++u)
+		{
+			if (map_ptr[u] != last_label)
+			{
+				last_label = map_ptr[u];
+				last_new_label = getLabel(last_label);
+			}
+			map_ptr[u] = last_new_label;
+		}
+	}
+}
+
+void AbstractVoronoiSegmentation::mergeRoomPair(std::vector<Room>& rooms, const int target_index, const int room_to_merge_index, RoomLabelUnionFind& room_labels, const double map_resolution)
 {
 	// integrate room to merge into target and delete merged room
 	const int target_id = rooms[target_index].getID();
 	const int room_to_merge_id = rooms[room_to_merge_index].getID();
 	rooms[target_index].mergeRoom(rooms[room_to_merge_index], map_resolution);
-	rooms[room_to_merge_index].setRoomId(rooms[target_index].getID(), segmented_map);
+	room_labels.relabel(room_to_merge_id, target_id);
 	rooms.erase(rooms.begin()+room_to_merge_index);
 	std::sort(rooms.begin(), rooms.end(), sortRoomsAscending);
 
@@ -107,6 +189,12 @@ void AbstractVoronoiSegmentation::drawVoronoi(cv::Mat &img, const std::vector<st
 //	3. It returns the map that has the generalized voronoi-graph drawn in.
 void AbstractVoronoiSegmentation::createVoronoiGraph(cv::Mat& map_for_voronoi_generation)
 {
+	if (voronoi_graph_generator_ == VORONOI_GENERATOR_DISTANCE_TRANSFORM)
+	{
+		createVoronoiGraphFromDistanceTransform(map_for_voronoi_generation);
+		return;
+	}
+
 	cv::Mat map_to_draw_voronoi_in = map_for_voronoi_generation.clone(); //variable to save the given map for drawing in the voronoi-diagram
 
 	cv::Mat temporary_map_to_calculate_voronoi = map_for_voronoi_generation.clone(); //variable to save the given map in the createVoronoiGraph-function
@@ -174,6 +262,21 @@ void AbstractVoronoiSegmentation::createVoronoiGraph(cv::Mat& map_for_voronoi_ge
 	map_for_voronoi_generation = map_to_draw_voronoi_in;
 }
 
+void AbstractVoronoiSegmentation::createVoronoiGraphFromDistanceTransform(cv::Mat& map_for_voronoi_generation)
+{
+	//apply a closing-operator on the map so bad parts are neglected and erode it, so that no lines are drawn near the boundary
+	cv::Mat eroded_map;
+	cv::erode(map_for_voronoi_generation, eroded_map, cv::Mat());
+	cv::dilate(eroded_map, eroded_map, cv::Mat());
+	cv::erode(eroded_map, eroded_map, cv::Mat(), cv::Point(-1, -1), 2);
+
+	//the obstacles of the original map are the sites of the graph, like the contour points in createVoronoiGraph
+	const uchar voronoi_color = 127;
+	cv::Mat map_to_draw_voronoi_in = map_for_voronoi_generation.clone();
+	drawVoronoiSkeleton(map_for_voronoi_generation, eroded_map, map_to_draw_voronoi_in, voronoi_color);
+	map_for_voronoi_generation = map_to_draw_voronoi_in;
+}
+
 void AbstractVoronoiSegmentation::pruneVoronoiGraph(cv::Mat& voronoi_map, std::set<cv::Point, cv_Point_comp>& node_points)
 {
 	// 1.extract the node-points that have at least three neighbors on the voronoi diagram
@@ -256,53 +359,99 @@ void AbstractVoronoiSegmentation::mergeRooms(cv::Mat& map_to_merge_rooms, std::v
 	// This function takes the segmented Map from the original Voronoi-segmentation-algorithm and merges rooms together,
 	// that are small enough and have only two or one neighbor.
 
-	// 1. go trough every pixel and add points to the rooms with the same ID
+	// 1. go trough every pixel and count the members of the room with the same ID
+	// the members of a room are the pixels with its ID and the contour points it has been created with
+	boost::unordered_map<int,int> room_index_of_id;		// maps each room ID to the first room with this ID
+	RoomLabelUnionFind room_labels;
+	for (size_t current_room = 0; current_room < rooms.size(); current_room++)
+	{
+		room_index_of_id.insert(std::pair<int,int>(rooms[current_room].getID(), (int)current_room));
+		room_labels.addRoomID(rooms[current_room].getID());
+	}
+	cv::Mat room_index_map(map_to_merge_rooms.rows, map_to_merge_rooms.cols, CV_32SC1, cv::Scalar(-1));
+	std::vector<int> number_of_members(rooms.size(), 0);
+	int last_id = 0, last_index = -1;
 	for (int y = 0; y < map_to_merge_rooms.rows; y++)
 	{
+		const int* map_ptr = map_to_merge_rooms.ptr<int>(y);
+		int* index_ptr = room_index_map.ptr<int>(y);
 		for (int x = 0; x < map_to_merge_rooms.cols; x++)
 		{
-			int current_id = map_to_merge_rooms.at<int>(y, x);
-			if (current_id != 0)
+			const int current_id = map_ptr[x];
+			if (current_id == 0)
+				continue;
+			if (current_id != last_id)
 			{
-				for (size_t current_room = 0; current_room < rooms.size(); current_room++) //add the Points with the same Id as a room to it
-				{
-					if (rooms[current_room].getID() == current_id) //insert the current point into the corresponding room
-					{
-						rooms[current_room].insertMemberPoint(cv::Point(x, y), map_resolution_from_subscription);
-						break;
-					}
-				}
+				boost::unordered_map<int,int>::iterator it = room_index_of_id.find(current_id);
+				last_id = current_id;
+				last_index = (it != room_index_of_id.end() ? it->second : -1);
+			}
+			if (last_index >= 0)
+			{
+				index_ptr[x] = last_index;
+				number_of_members[last_index]++;
 			}
 		}
 	}
-
-	// 2. add the neighbor IDs for every point
-	for (int current_room = 0; current_room < rooms.size(); current_room++)
+	// contour points that do not carry the label of their room (anymore) are members as well
+	cv::Mat stray_member_mask = cv::Mat::zeros(map_to_merge_rooms.rows, map_to_merge_rooms.cols, CV_8UC1);
+	boost::unordered_multimap<int,int> stray_members;		// maps pixel offsets to room indices
+	for (size_t current_room = 0; current_room < rooms.size(); current_room++)
 	{
-		const int current_id = rooms[current_room].getID();
-		std::vector<cv::Point> considered_neighbors;		// storage for already counted neighborhood points
 		const std::vector<cv::Point>& current_points = rooms[current_room].getMembers();
-		for (int current_point = 0; current_point < current_points.size(); current_point++)
+		for (size_t current_point = 0; current_point < current_points.size(); current_point++)
 		{
-			for (int row_counter = -1; row_counter <= 1; row_counter++)
+			const cv::Point& point = current_points[current_point];
+			if (room_index_map.at<int>(point) != (int)current_room)
 			{
-				for (int col_counter = -1; col_counter <= 1; col_counter++)
-				{
-					const int label = map_to_merge_rooms.at<int>(current_points[current_point].y + row_counter, current_points[current_point].x + col_counter);
-
-					// collect neighbor IDs
-					if (label != 0 && label != current_id)
-						rooms[current_room].addNeighborID(label);
+				stray_members.insert(std::pair<int,int>(point.y*map_to_merge_rooms.cols + point.x, (int)current_room));
+				stray_member_mask.at<uchar>(point) = 255;
+				number_of_members[current_room]++;
+			}
+		}
+	}
+	for (size_t current_room = 0; current_room < rooms.size(); current_room++)
+		rooms[current_room].setArea(map_resolution_from_subscription * map_resolution_from_subscription * number_of_members[current_room]);
 
-					// neighborhood statistics
-					cv::Point neighbor_point(current_points[current_point].x + col_counter, current_points[current_point].y + row_counter);
-					if (!contains(considered_neighbors, neighbor_point) && label != current_id)
+	// 2. add the neighbor IDs and the neighborhood statistics (region adjacency graph)
+	//	every pixel in the 8-neighborhood of a member of a room that does not carry the room's ID counts once for the common
+	//	border of that room with the pixel's label
+	std::vector<int> window_rooms;
+	for (int y = 0; y < map_to_merge_rooms.rows; y++)
+	{
+		for (int x = 0; x < map_to_merge_rooms.cols; x++)
+		{
+			// collect the rooms with members in the 3x3 window around the pixel
+			window_rooms.clear();
+			for (int row_counter = std::max(0, y-1); row_counter <= std::min(map_to_merge_rooms.rows-1, y+1); row_counter++)
+			{
+				for (int col_counter = std::max(0, x-1); col_counter <= std::min(map_to_merge_rooms.cols-1, x+1); col_counter++)
+				{
+					const int index = room_index_map.at<int>(row_counter, col_counter);
+					if (index >= 0 && !contains(window_rooms, index))
+						window_rooms.push_back(index);
+					if (stray_member_mask.at<uchar>(row_counter, col_counter) != 0)
 					{
-						rooms[current_room].addNeighbor(label);
-						considered_neighbors.push_back(neighbor_point);
+						std::pair<boost::unordered_multimap<int,int>::iterator, boost::unordered_multimap<int,int>::iterator> range = stray_members.equal_range(row_counter*map_to_merge_rooms.cols + col_counter);
+						for (boost::unordered_multimap<int,int>::iterator it = range.first; it != range.second; ++it)
+							if (!contains(window_rooms, it->second))
+								window_rooms.push_back(it->second);
 					}
 				}
 			}
+
+			const int label = map_to_merge_rooms.at<int>(y, x);
+			for (size_t r = 0; r < window_rooms.size(); r++)
+			{
+				Room& current_room = rooms[window_rooms[r]];
+				if (label == current_room.getID())
+					continue;
+				// collect neighbor IDs
+				if (label != 0)
+					current_room.addNeighborID(label);
+				// neighborhood statistics
+				current_room.addNeighbor(label);
+			}
 		}
 	}
 
@@ -325,14 +474,18 @@ void AbstractVoronoiSegmentation::mergeRooms(cv::Mat& map_to_merge_rooms, std::v
 		if (merge_rooms == true)
 		{
 			//std::cout << "merge " << current_room.getCenter() << ", id=" << current_room.getID() << " into " << rooms[merge_index].getCenter() << ", id=" << rooms[merge_index].getID() << std::endl;
-			mergeRoomPair(rooms, merge_index, current_room_index, map_to_merge_rooms, map_resolution_from_subscription);
+			mergeRoomPair(rooms, merge_index, current_room_index, room_labels, map_resolution_from_subscription);
 			current_room_index = 0;
 		}
 		else
 			current_room_index++;
 	}
 	if (display_map == true)
-		cv::imshow("a", map_to_merge_rooms);
+	{
+		cv::Mat display = map_to_merge_rooms.clone();
+		room_labels.relabelMap(display);
+		cv::imshow("a", display);
+	}
 
 	// b) small rooms
 	for (int current_room_index = 0; current_room_index < rooms.size(); )
@@ -353,14 +506,18 @@ void AbstractVoronoiSegmentation::mergeRooms(cv::Mat& map_to_merge_rooms, std::v
 		if (merge_rooms == true)
 		{
 			//std::cout << "merge " << current_room.getCenter() << ", id=" << current_room.getID() << " into " << rooms[merge_index].getCenter() << ", id=" << rooms[merge_index].getID() << std::endl;
-			mergeRoomPair(rooms, merge_index, current_room_index, map_to_merge_rooms, map_resolution_from_subscription);
+			mergeRoomPair(rooms, merge_index, current_room_index, room_labels, map_resolution_from_subscription);
 			current_room_index = 0;
 		}
 		else
 			current_room_index++;
 	}
 	if (display_map == true)
-		cv::imshow("b", map_to_merge_rooms);
+	{
+		cv::Mat display = map_to_merge_rooms.clone();
+		room_labels.relabelMap(display);
+		cv::imshow("b", display);
+	}
 
 	// c) merge a room with one neighbor that has max. 2 neighbors and sufficient wall ratio (connect parts inside a room)
 	for (int current_room_index = 0; current_room_index < rooms.size(); )
@@ -383,14 +540,18 @@ void AbstractVoronoiSegmentation::mergeRooms(cv::Mat& map_to_merge_rooms, std::v
 		if (merge_rooms == true)
 		{
 			//std::cout << "merge " << current_room.getCenter() << ", id=" << current_room.getID() << " into " << rooms[merge_index].getCenter() << ", id=" << rooms[merge_index].getID() << std::endl;
-			mergeRoomPair(rooms, merge_index, current_room_index, map_to_merge_rooms, map_resolution_from_subscription);
+			mergeRoomPair(rooms, merge_index, current_room_index, room_labels, map_resolution_from_subscription);
 			current_room_index = 0;
 		}
 		else
 			current_room_index++;
 	}
 	if (display_map == true)
-		cv::imshow("c", map_to_merge_rooms);
+	{
+		cv::Mat display = map_to_merge_rooms.clone();
+		room_labels.relabelMap(display);
+		cv::imshow("c", display);
+	}
 
 	// d) merge rooms that share a significant part of their perimeter
 	for (int current_room_index = 0; current_room_index < rooms.size(); )
@@ -423,14 +584,18 @@ void AbstractVoronoiSegmentation::mergeRooms(cv::Mat& map_to_merge_rooms, std::v
 		if (merge_rooms == true)
 		{
 			//std::cout << "merge " << current_room.getCenter() << ", id=" << current_room.getID() << " into " << rooms[merge_index].getCenter() << ", id=" << rooms[merge_index].getID() << std::endl;
-			mergeRoomPair(rooms, merge_index, current_room_index, map_to_merge_rooms, map_resolution_from_subscription);
+			mergeRoomPair(rooms, merge_index, current_room_index, room_labels, map_resolution_from_subscription);
 			current_room_index = 0;
 		}
 		else
 			current_room_index++;
 	}
 	if (display_map == true)
-		cv::imshow("d", map_to_merge_rooms);
+	{
+		cv::Mat display = map_to_merge_rooms.clone();
+		room_labels.relabelMap(display);
+		cv::imshow("d", display);
+	}
 
 	// e) largest room neighbor touches > 0.5 perimeter (happens often with furniture)
 	for (int current_room_index = 0; current_room_index < rooms.size(); )
@@ -449,10 +614,13 @@ void AbstractVoronoiSegmentation::mergeRooms(cv::Mat& map_to_merge_rooms, std::v
 		if (merge_rooms == true)
 		{
 			//std::cout << "merge " << current_room.getCenter() << ", id=" << current_room.getID() << " into " << rooms[merge_index].getCenter() << ", id=" << rooms[merge_index].getID() << std::endl;
-			mergeRoomPair(rooms, merge_index, current_room_index, map_to_merge_rooms, map_resolution_from_subscription);
+			mergeRoomPair(rooms, merge_index, current_room_index, room_labels, map_resolution_from_subscription);
 			current_room_index = 0;
 		}
 		else
 			current_room_index++;
 	}
+
+	// write the labels of the merged rooms into the map
+	room_labels.relabelMap(map_to_merge_rooms);
 }
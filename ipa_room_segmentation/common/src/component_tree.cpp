@@ -0,0 +1,251 @@
+#include <ipa_room_segmentation/component_tree.h>
+
+#include <cmath>
+
+ComponentTree::ComponentTree()
+: min_threshold_(0), max_threshold_(-1)
+{
+}
+
+int ComponentTree::findRoot(int pixel)
+{
+	int root = pixel;
+	while (union_find_parents_[root] != root)
+		root = union_find_parents_[root];
+	// path compression
+	while (union_find_parents_[pixel] != root)
+	{
+		const int next = union_find_parents_[pixel];
+		union_find_parents_[pixel] = root;
+		pixel = next;
+	}
+	return root;
+}
+
+void ComponentTree::build(const cv::Mat& level_map, const int min_threshold, const int max_threshold)
+{
+	nodes_.clear();
+	threshold_nodes_.clear();
+	min_threshold_ = min_threshold;
+	max_threshold_ = max_threshold;
+	pixel_nodes_ = cv::Mat(level_map.rows, level_map.cols, CV_32SC1, cv::Scalar(-1));
+	if (level_map.type() != CV_32SC1)
+	{
+		std::cout << "Error: ComponentTree::build: provided level map is not of type CV_32SC1." << std::endl;
+		return;
+	}
+	if (max_threshold < min_threshold)
+		return;
+	threshold_nodes_.resize(max_threshold - min_threshold + 1);
+
+	// sort the pixels into buckets of the threshold at which they enter the upper level sets
+	const int rows = level_map.rows;
+	const int cols = level_map.cols;
+	const int number_pixels = rows*cols;
+	std::vector<int> bucket_sizes(max_threshold - min_threshold + 2, 0);
+	for (int v = 0; v < rows; ++v)
+	{
+		const int* level_ptr = level_map.ptr<int>(v);
+		for (int u = 0; u < cols; ++u)
+			if (level_ptr[u] > min_threshold)
+				++bucket_sizes[std::min(level_ptr[u]-1, max_threshold) - min_threshold + 1];
+	}
+	std::vector<int> bucket_starts(bucket_sizes.size(), 0);
+	for (size_t b = 1; b < bucket_sizes.size(); ++b)
+		bucket_starts[b] = bucket_starts[b-1] + bucket_sizes[b];
+	std::vector<int> sorted_pixels(bucket_starts.back());
+	std::vector<int> bucket_fill(bucket_starts.begin(), bucket_starts.end()-1);
+	for (int v = 0; v < rows; ++v)
+	{
+		const int* level_ptr = level_map.ptr<int>(v);
+		for (int u = 0; u < cols; ++u)
+			if (level_ptr[u] > min_threshold)
+				sorted_pixels[bucket_fill[std::min(level_ptr[u]-1, max_threshold) - min_threshold]++] = v*cols + u;
+	}
+
+	// insert the pixels from the highest to the lowest threshold
+	union_find_parents_.assign(number_pixels, -1);
+	root_area_.assign(number_pixels, 0);
+	root_boundary_pixels_.assign(number_pixels, 0);
+	root_bounding_boxes_.assign(number_pixels, cv::Rect());
+	std::vector<unsigned char> inserted_neighbors(number_pixels, 0);		// number of inserted 4-neighbors of each pixel
+	std::vector<int> node_of_root(number_pixels, -1);
+	std::vector<int> node_stamp(number_pixels, min_threshold-1);	// threshold at which node_of_root was set for a root pixel
+	std::vector<int> active_pixels;		// one pixel of each component at the previous threshold
+	std::vector<int> previous_nodes;	// the corresponding nodes
+	const int dx4[4] = {1, 0, -1, 0};
+	const int dy4[4] = {0, 1, 0, -1};
+	for (int threshold = max_threshold; threshold >= min_threshold; --threshold)
+	{
+		const int bucket_begin = bucket_starts[threshold - min_threshold];
+		const int bucket_end = bucket_starts[threshold - min_threshold + 1];
+		for (int i = bucket_begin; i < bucket_end; ++i)
+		{
+			const int pixel = sorted_pixels[i];
+			const int u = pixel % cols;
+			const int v = pixel / cols;
+			union_find_parents_[pixel] = pixel;
+			root_area_[pixel] = 1;
+			root_boundary_pixels_[pixel] = 0;
+			root_bounding_boxes_[pixel] = cv::Rect(u, v, 1, 1);
+
+			// update the boundary counts: inner pixels have all 4-neighbors inserted
+			int neighbors = 0;
+			for (int n = 0; n < 4; ++n)
+			{
+				const int nu = u + dx4[n];
+				const int nv = v + dy4[n];
+				if (nu < 0 || nu >= cols || nv < 0 || nv >= rows)
+					continue;
+				const int neighbor = nv*cols + nu;
+				if (union_find_parents_[neighbor] < 0)
+					continue;
+				++neighbors;
+				++inserted_neighbors[neighbor];
+				if (inserted_neighbors[neighbor] == 4)
+					--root_boundary_pixels_[findRoot(neighbor)];
+			}
+			inserted_neighbors[pixel] = neighbors;
+			if (neighbors < 4)
+				root_boundary_pixels_[pixel] = 1;
+
+			// merge with the inserted 8-neighbors
+			for (int dv = -1; dv <= 1; ++dv)
+			{
+				for (int du = -1; du <= 1; ++du)
+				{
+					const int nu = u + du;
+					const int nv = v + dv;
+					if ((du == 0 && dv == 0) || nu < 0 || nu >= cols || nv < 0 || nv >= rows || union_find_parents_[nv*cols + nu] < 0)
+						continue;
+					const int root_a = findRoot(pixel);
+					const int root_b = findRoot(nv*cols + nu);
+					if (root_a == root_b)
+						continue;
+					// attach the smaller component to the larger one
+					const int new_root = (root_area_[root_a] >= root_area_[root_b] ? root_a : root_b);
+					const int old_root = (new_root == root_a ? root_b : root_a);
+					union_find_parents_[old_root] = new_root;
+					root_area_[new_root] += root_area_[old_root];
+					root_boundary_pixels_[new_root] += root_boundary_pixels_[old_root];
+					root_bounding_boxes_[new_root] |= root_bounding_boxes_[old_root];
+				}
+			}
+			active_pixels.push_back(pixel);
+		}
+
+		// create one node for every component at this threshold and link the nodes of the previous threshold to them
+		std::vector<int> current_pixels;
+		std::vector<int>& current_nodes = threshold_nodes_[threshold - min_threshold];
+		for (size_t i = 0; i < active_pixels.size(); ++i)
+		{
+			const int root = findRoot(active_pixels[i]);
+			if (node_stamp[root] != threshold)
+			{
+				node_stamp[root] = threshold;
+				node_of_root[root] = (int)nodes_.size();
+				Node node;
+				node.threshold = threshold;
+				node.parent = -1;
+				node.area = root_area_[root];
+				node.boundary_pixels = root_boundary_pixels_[root];
+				node.seed_pixel = root;
+				node.bounding_box = root_bounding_boxes_[root];
+				nodes_.push_back(node);
+				current_nodes.push_back(node_of_root[root]);
+				current_pixels.push_back(root);
+			}
+			if (i < previous_nodes.size())
+				nodes_[previous_nodes[i]].parent = node_of_root[root];
+		}
+		for (int i = bucket_begin; i < bucket_end; ++i)
+		{
+			const int pixel = sorted_pixels[i];
+			pixel_nodes_.at<int>(pixel / cols, pixel % cols) = node_of_root[findRoot(pixel)];
+		}
+		active_pixels = current_pixels;
+		previous_nodes = current_nodes;
+	}
+
+	// free the construction memory
+	std::vector<int>().swap(union_find_parents_);
+	std::vector<int>().swap(root_area_);
+	std::vector<int>().swap(root_boundary_pixels_);
+	std::vector<cv::Rect>().swap(root_bounding_boxes_);
+}
+
+const std::vector<ComponentTree::Node>& ComponentTree::getNodes() const
+{
+	return nodes_;
+}
+
+const std::vector<int>& ComponentTree::getThresholdNodes(const int threshold) const
+{
+	return threshold_nodes_[threshold - min_threshold_];
+}
+
+int ComponentTree::getPixelNode(const int row, const int column) const
+{
+	return pixel_nodes_.at<int>(row, column);
+}
+
+double ComponentTree::getContourArea(const int node) const
+{
+	// the contour polygons run through the centers of the boundary pixels, so half of each boundary pixel lies outside
+	return std::max(0., nodes_[node].area - 0.5*nodes_[node].boundary_pixels);
+}
+
+double ComponentTree::getContourArea(const int node, const double lower_limit, const double upper_limit) const
+{
+	const double area = getContourArea(node);
+	// the approximation deviates by at most half of the boundary pixels from cv::contourArea
+	const double tolerance = 0.5*nodes_[node].boundary_pixels + 1.;
+	if (std::abs(area - lower_limit) <= tolerance || std::abs(area - upper_limit) <= tolerance)
+		return getExactContourArea(node);
+	return area;
+}
+
+double ComponentTree::getExactContourArea(const int node) const
+{
+	// draw the upper level set at the threshold of the node inside of its bounding box, with an empty border for cv::findContours
+	const Node& component = nodes_[node];
+	const cv::Rect& box = component.bounding_box;
+	cv::Mat level_set(box.height+2, box.width+2, CV_8UC1, cv::Scalar(0));
+	for (int v = box.y; v < box.y+box.height; ++v)
+	{
+		const int* pixel_nodes_ptr = pixel_nodes_.ptr<int>(v);
+		unsigned char* level_set_ptr = level_set.ptr<unsigned char>(v-box.y+1);
+		for (int u = box.x; u < box.x+box.width; ++u)
+			if (pixel_nodes_ptr[u] >= 0 && nodes_[pixel_nodes_ptr[u]].threshold >= component.threshold)
+				level_set_ptr[u-box.x+1] = 255;
+	}
+	// other components of the level set may reach into the bounding box, keep only the one connected to the seed pixel
+	const int cols = pixel_nodes_.cols;
+	const cv::Point seed(component.seed_pixel % cols - box.x + 1, component.seed_pixel / cols - box.y + 1);
+	cv::floodFill(level_set, seed, cv::Scalar(128), 0, cv::Scalar(), cv::Scalar(), 8);
+	cv::Mat component_map = (level_set == 128);
+
+	// area of the outer contour minus the areas of the hole contours, like in the erosion based segmentation
+	std::vector < std::vector<cv::Point> > contours;
+	std::vector < cv::Vec4i > hierarchy;
+	cv::findContours(component_map, contours, hierarchy, CV_RETR_CCOMP, CV_CHAIN_APPROX_SIMPLE);
+	double area = 0.;
+	for (size_t contour = 0; contour < contours.size(); ++contour)
+	{
+		if (hierarchy[contour][3] == -1)
+			area += cv::contourArea(contours[contour]);
+		else
+			area -= cv::contourArea(contours[contour]);
+	}
+	return area;
+}
+
+int ComponentTree::getMinThreshold() const
+{
+	return min_threshold_;
+}
+
+int ComponentTree::getMaxThreshold() const
+{
+	return max_threshold_;
+}
@@ -60,29 +60,124 @@
 #include "ipa_room_segmentation/meanshift2d.h"
 #include "ipa_room_segmentation/fast_math.h"
 
-void MeanShift2D::filter(const std::vector<cv::Vec2d>& data, std::vector<cv::Vec2d>& filtered_data, const double bandwidth, const int maximumIterations)
+#include <algorithm>
+#include <cmath>
+
+const double MeanShift2D::kernel_cutoff_ = 20.;
+
+void MeanShift2D::filter(const std::vector<cv::Vec2d>& data, std::vector<cv::Vec2d>& filtered_data, const double bandwidth, const int maximumIterations, const double convergence_threshold)
 {
-	//  prepare mean shift set
-	std::vector<cv::Vec2d> mean_shift_set(data.size());
 	filtered_data = data;
+	if (data.size() == 0)
+		return;
+
+	// the kernel exp(-bandwidth*d^2) is neglected beyond the support radius, where it falls below exp(-kernel_cutoff_)
+	const double support_radius = sqrt(kernel_cutoff_/bandwidth);
+	const double squared_convergence_threshold = convergence_threshold*convergence_threshold;
+	const float negative_bandwidth = -bandwidth;
+
+	//  prepare mean shift set
+	std::vector<cv::Vec2d> mean_shift_set;
+	std::vector<bool> converged(data.size(), false);
+	std::vector<int> point_cell(data.size());
+	std::vector<int> cell_start;
+	std::vector<float> cell_points_x(data.size()), cell_points_y(data.size());
 
 	//  mean shift iteration
 	for (int iter=0; iter<maximumIterations; iter++)
 	{
-		for (int i=0; i<(int)filtered_data.size(); i++)
+		// sort the current points into a grid with cells of the size of the support radius (counting sort),
+		// the points of each cell are stored contiguously relative to the grid origin
+		cv::Vec2d grid_min = filtered_data[0], grid_max = filtered_data[0];
+		for (size_t i=1; i<filtered_data.size(); i++)
+		{
+			grid_min[0] = std::min(grid_min[0], filtered_data[i][0]);
+			grid_min[1] = std::min(grid_min[1], filtered_data[i][1]);
+			grid_max[0] = std::max(grid_max[0], filtered_data[i][0]);
+			grid_max[1] = std::max(grid_max[1], filtered_data[i][1]);
+		}
+		const int grid_cols = (int)((grid_max[0]-grid_min[0])/support_radius) + 1;
+		const int grid_rows = (int)((grid_max[1]-grid_min[1])/support_radius) + 1;
+		cell_start.assign(grid_cols*grid_rows+1, 0);
+		for (size_t i=0; i<filtered_data.size(); i++)
+		{
+			const int u = (int)((filtered_data[i][0]-grid_min[0])/support_radius);
+			const int v = (int)((filtered_data[i][1]-grid_min[1])/support_radius);
+			point_cell[i] = v*grid_cols + u;
+			cell_start[point_cell[i]+1]++;
+		}
+		for (size_t c=1; c<cell_start.size(); c++)
+			cell_start[c] += cell_start[c-1];
+		std::vector<int> cell_fill(cell_start.begin(), cell_start.end()-1);
+		for (size_t i=0; i<filtered_data.size(); i++)
 		{
-			cv::Vec2d nominator(0., 0.);
-			double denominator = 0.;
-			for (int j=0; j<(int)filtered_data.size(); j++)
+			const int position = cell_fill[point_cell[i]]++;
+			cell_points_x[position] = filtered_data[i][0]-grid_min[0];
+			cell_points_y[position] = filtered_data[i][1]-grid_min[1];
+		}
+
+		// shift each point that has not converged yet to the weighted mean of its neighbors in the surrounding 3x3 grid cells
+		mean_shift_set = filtered_data;
+		int number_moving_points = 0;
+		for (size_t i=0; i<filtered_data.size(); i++)
+		{
+			if (converged[i] == true)
+				continue;
+
+			const float x = filtered_data[i][0]-grid_min[0];
+			const float y = filtered_data[i][1]-grid_min[1];
+			const int u = point_cell[i] % grid_cols;
+			const int v = point_cell[i] / grid_cols;
+			double weight_sum = 0., weighted_dx_sum = 0., weighted_dy_sum = 0.;
+			for (int nv=std::max(0, v-1); nv<=std::min(grid_rows-1, v+1); nv++)
 			{
-				cv::Vec2d diff = filtered_data[j]-filtered_data[i];
-				double weight = fasterexp(-bandwidth * (diff[0]*diff[0] + diff[1]*diff[1]));
-				nominator += weight*filtered_data[j];
-				denominator += weight;
+				for (int nu=std::max(0, u-1); nu<=std::min(grid_cols-1, u+1); nu++)
+				{
+					const int cell = nv*grid_cols + nu;
+					int j = cell_start[cell];
+					const int end = cell_start[cell+1];
+#ifdef __SSE2__
+					v4sf weights = _mm_setzero_ps(), weighted_dx = _mm_setzero_ps(), weighted_dy = _mm_setzero_ps();
+					const v4sf query_x = _mm_set1_ps(x), query_y = _mm_set1_ps(y), factor = _mm_set1_ps(negative_bandwidth);
+					for (; j+4<=end; j+=4)
+					{
+						const v4sf dx = _mm_loadu_ps(&cell_points_x[j]) - query_x;
+						const v4sf dy = _mm_loadu_ps(&cell_points_y[j]) - query_y;
+						const v4sf weight = vfasterexp(factor * (dx*dx + dy*dy));
+						weights += weight;
+						weighted_dx += weight*dx;
+						weighted_dy += weight*dy;
+					}
+					for (int k=0; k<4; k++)
+					{
+						weight_sum += v4sf_index(weights, k);
+						weighted_dx_sum += v4sf_index(weighted_dx, k);
+						weighted_dy_sum += v4sf_index(weighted_dy, k);
+					}
+#endif
+					for (; j<end; j++)
+					{
+						const float dx = cell_points_x[j] - x;
+						const float dy = cell_points_y[j] - y;
+						const float weight = fasterexp(negative_bandwidth * (dx*dx + dy*dy));
+						weight_sum += weight;
+						weighted_dx_sum += weight*dx;
+						weighted_dy_sum += weight*dy;
+					}
+				}
 			}
-			mean_shift_set[i] = nominator/denominator;
+			const cv::Vec2d shift(weighted_dx_sum/weight_sum, weighted_dy_sum/weight_sum);
+			mean_shift_set[i] = filtered_data[i] + shift;
+			if (shift[0]*shift[0] + shift[1]*shift[1] < squared_convergence_threshold)
+				converged[i] = true;
+			else
+				number_moving_points++;
 		}
-		filtered_data = mean_shift_set;
+		filtered_data.swap(mean_shift_set);
+
+		// all points have reached their mode
+		if (number_moving_points == 0)
+			break;
 	}
 //	for (int i=0; i<(int)filtered_data.size(); i++)
 //		std::cout << "  meanshift[" << i << "] = (" << filtered_data[i][0] << ", " << filtered_data[i][1] << ")" << std::endl;
@@ -115,29 +210,17 @@ void MeanShift2D::computeConvergencePoints(const std::vector<cv::Vec2d>& filtere
 	}
 }
 
-cv::Vec2d MeanShift2D::findRoomCenter(const cv::Mat& room_image, const std::vector<cv::Vec2d>& room_cells, double map_resolution)
+cv::Vec2d MeanShift2D::findRoomCenter(const cv::Mat& room_image, const std::vector<cv::Vec2d>& room_cells, double map_resolution, const cv::Point& room_image_offset)
 {
-	// downsample data if too big
-	std::vector<cv::Vec2d> room_cells_sampled;
-	if (room_cells.size() > 1000)
-	{
-		const int factor = room_cells.size()/1000;
-		for (size_t i=0; i<room_cells.size(); ++i)
-			if ((int)i % factor == 0)
-				room_cells_sampled.push_back(room_cells[i]);
-	}
-	else
-		room_cells_sampled = room_cells;
-
-	// mean shift filter
+	// mean shift filter on all room cells, the grid based filter only visits the neighbors within the kernel support
 	const double bandwidth = map_resolution/2.;		// paramter
 	std::vector<cv::Vec2d> filtered_room_cells;
-	filter(room_cells_sampled, filtered_room_cells, bandwidth, 100);
+	filter(room_cells, filtered_room_cells, bandwidth, 100);
 
 	// take mean of filtering result in simple rooms, i.e. if no obstacles is located at the computed cell
 	cv::Scalar mean_coordinates = cv::mean(filtered_room_cells);
 	cv::Vec2d room_center(mean_coordinates[0], mean_coordinates[1]);
-	if (room_image.at<uchar>(room_center[1], room_center[0]) == 255)
+	if (room_image.at<uchar>((int)room_center[1]-room_image_offset.y, (int)room_center[0]-room_image_offset.x) == 255)
 		return room_center;
 
 	// otherwise compute convergence sets of filtering results and return mean of largest convergence set
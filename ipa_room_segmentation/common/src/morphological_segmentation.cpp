@@ -2,6 +2,7 @@
 
 #include <ipa_room_segmentation/wavefront_region_growing.h>
 #include <ipa_room_segmentation/contains.h>
+#include <ipa_room_segmentation/component_tree.h>
 
 MorphologicalSegmentation::MorphologicalSegmentation()
 {
@@ -18,71 +19,56 @@ void MorphologicalSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv:
 	 * 4. draw and fill the saved contoures in a clone of the map from 1. with a random colour
 	 * 5. get the obstacle information from the original map and draw them in the clone from 4.
 	 * 6. spread the coloured regions to the white Pixels
+	 *
+	 * Eroding the map k times with the 3x3 kernel leaves exactly the pixels whose chessboard distance to the next obstacle is
+	 * larger than k. Hence, the free space after each erosion step is an upper level set of the chessboard distance transform and
+	 * the connected regions of all 73 erosion steps are computed at once with a component tree of the distance map. A region
+	 * that is found as room at erosion step k is made black in the eroded map, which removes it and all regions that it splits
+	 * into at the later steps, i.e. its subtree in the component tree.
 	 */
 
-	//make two map clones to work with
-	cv::Mat temporary_map_to_find_rooms = map_to_be_labeled.clone(); //map to find the rooms and for eroding
-	//**************erode temporary_map until last possible room found****************
-	//erode map a specified amount of times
-	std::vector < std::vector<cv::Point> > saved_contours; //saving variable for every contour that is between the upper and the lower limit
+	//**************erode map until last possible room found****************
 	ROS_INFO("starting eroding");
-	for (int counter = 0; counter < 73; counter++)
+	const int number_of_erosions = 73;
+	cv::Mat distance_map;
+	cv::distanceTransform(map_to_be_labeled, distance_map, CV_DIST_C, 3);
+	distance_map.convertTo(distance_map, CV_32SC1);
+	ComponentTree component_tree;
+	component_tree.build(distance_map, 1, number_of_erosions);
+
+	// walk through the erosion steps from the least to the most eroded map, parents are stored after their children
+	const std::vector<ComponentTree::Node>& nodes = component_tree.getNodes();
+	const double pixel_area = map_resolution_from_subscription * map_resolution_from_subscription;
+	std::vector<int> room_node_of_node(nodes.size(), -1);	// the node that was found as room and contains the respective node, -1 if none
+	int number_of_rooms = 0;
+	for (int node = (int)nodes.size()-1; node >= 0; --node)
 	{
-		//erode the map one time
-		cv::Mat eroded_map;
-		cv::Point anchor(-1, -1); //needed for opencv erode
-		cv::erode(temporary_map_to_find_rooms, eroded_map, cv::Mat(), anchor, 1);
-		//save the more eroded map
-		temporary_map_to_find_rooms = eroded_map;
-		//Save the eroded map in a second map, which is used to find the contours. This is neccesarry, because
-		//the function findContours changes the given map and would make it impossible to work any further with it
-		cv::Mat contour_map = eroded_map.clone();
-		//find Contours in the more eroded map
-		std::vector < std::vector<cv::Point> > temporary_contours; //temporary saving-variable
-		//hierarchy saves if the contours are hole-contours:
-		//hierarchy[{0,1,2,3}]={next contour (same level), previous contour (same level), child contour, parent contour}
-		//child-contour = 1 if it has one, = -1 if not, same for parent_contour
-		std::vector < cv::Vec4i > hierarchy;
-		cv::findContours(contour_map, temporary_contours, hierarchy, CV_RETR_CCOMP, CV_CHAIN_APPROX_SIMPLE);
-		if (temporary_contours.size() != 0)
+		if (nodes[node].parent >= 0 && room_node_of_node[nodes[node].parent] >= 0)
 		{
-			//check every contour if it fullfills the criteria of a room
-			for (int current_contour = 0; current_contour < temporary_contours.size(); current_contour++)
-			{ //only take first level contours --> second level contours belong to holes and doesn't need to be looked at
-				if (hierarchy[current_contour][3] == -1)
-				{
-					//check if contour is large/small enough for a room
-					double room_area = map_resolution_from_subscription * map_resolution_from_subscription
-					        * cv::contourArea(temporary_contours[current_contour]);
-					//subtract the area from the hole contours inside the found contour, because the contour area grows extremly large if it is a closed loop
-					for (int hole = 0; hole < temporary_contours.size(); hole++)
-					{
-						if (hierarchy[hole][3] == current_contour) //check if the parent of the hole is the current looked at contour
-						{
-							room_area -= map_resolution_from_subscription * map_resolution_from_subscription
-									* cv::contourArea(temporary_contours[hole]);
-						}
-					}
-					if (room_area_factor_lower_limit < room_area && room_area < room_area_factor_upper_limit)
-					{
-						//save contour for later drawing in map
-						saved_contours.push_back(temporary_contours[current_contour]);
-						//make region black if room found --> region doesn't need to be looked at anymore
-						cv::drawContours(temporary_map_to_find_rooms, temporary_contours, current_contour, cv::Scalar(0), CV_FILLED, 8, hierarchy, 2);
-					}
-				}
-			}
+			room_node_of_node[node] = room_node_of_node[nodes[node].parent];
+			continue;
+		}
+		//check if the region is large/small enough for a room, the hole areas are already excluded and the area is exact near the limits
+		const double room_area = pixel_area * component_tree.getContourArea(node, room_area_factor_lower_limit / pixel_area,
+				room_area_factor_upper_limit / pixel_area);
+		if (room_area_factor_lower_limit < room_area && room_area < room_area_factor_upper_limit)
+		{
+			room_node_of_node[node] = node;
+			++number_of_rooms;
 		}
 	}
-	//*******************draw contures in new map***********************
-	std::cout << "Segmentation Found " << saved_contours.size() << " rooms." << std::endl;
-	//draw filled contoures in new_map_to_draw_contours_ with random colour if this colour hasn't been used yet
-	cv::Mat new_map_to_draw_contours; //map for drawing the found contours
+
+	//*******************draw rooms in new map***********************
+	std::cout << "Segmentation Found " << number_of_rooms << " rooms." << std::endl;
+	//draw the found rooms in the new map with random colour if this colour hasn't been used yet
 	map_to_be_labeled.convertTo(segmented_map, CV_32SC1, 256, 0);
 	std::vector < cv::Scalar > already_used_coloures; //vector for saving the already used coloures
-	for (int idx = 0; idx < saved_contours.size(); idx++)
+	std::vector<int> room_colours(nodes.size(), 0);	// colour of each node that was found as room
+	for (int node = (int)nodes.size()-1; node >= 0; --node)
 	{
-		bool drawn = false; //checking-variable if contour has been drawn
+		if (room_node_of_node[node] != node)
+			continue;
+		bool drawn = false; //checking-variable if room has been drawn
 		int draw_counter = 0; //counter to exit loop if it gets into an endless-loop (e.g. when there are more rooms than possible)
 		do
 		{
@@ -90,13 +76,22 @@ void MorphologicalSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv:
 			cv::Scalar fill_colour(rand() % 52224 + 13056);
 			if (!contains(already_used_coloures, fill_colour) || draw_counter > 250)
 			{
-				//if colour is unique draw Contour in map
-				cv::drawContours(segmented_map, saved_contours, idx, fill_colour, CV_FILLED);
+				//if colour is unique use it for the room
+				room_colours[node] = (int)fill_colour[0];
 				already_used_coloures.push_back(fill_colour); //add colour to used coloures
 				drawn = true;
 			}
 		} while (!drawn);
 	}
+	for (int row = 0; row < segmented_map.rows; ++row)
+	{
+		for (int col = 0; col < segmented_map.cols; ++col)
+		{
+			const int node = component_tree.getPixelNode(row, col);
+			if (node >= 0 && room_node_of_node[node] >= 0)
+				segmented_map.at<int>(row, col) = room_colours[room_node_of_node[node]];
+		}
+	}
 	//*************************obstacles***********************
 	//get obstacle informations and draw them into the new map
 	ROS_INFO("starting getting obstacle information");
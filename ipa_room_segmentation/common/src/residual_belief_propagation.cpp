@@ -0,0 +1,167 @@
+#include <ipa_room_segmentation/residual_belief_propagation.h>
+
+ResidualBeliefPropagation::ResidualBeliefPropagation(const size_t number_of_variables, const size_t number_of_labels)
+: number_of_variables_(number_of_variables), number_of_labels_(number_of_labels), factors_of_variables_(number_of_variables),
+  beliefs_(number_of_variables*number_of_labels, 0.), number_of_message_updates_(0)
+{
+}
+
+void ResidualBeliefPropagation::addFactor(const std::vector<size_t>& variables, const std::vector<double>& values)
+{
+	size_t table_size = 1;
+	for (size_t v = 0; v < variables.size(); ++v)
+		table_size *= number_of_labels_;
+	if (values.size() != table_size)
+	{
+		std::cout << "Error: ResidualBeliefPropagation::addFactor: value table has " << values.size() << " entries instead of " << table_size << "." << std::endl;
+		return;
+	}
+
+	Factor factor;
+	factor.variables = variables;
+	factor.values = values;
+	factor.first_message = message_variables_.size();
+	for (size_t v = 0; v < variables.size(); ++v)
+	{
+		message_variables_.push_back(variables[v]);
+		factors_of_variables_[variables[v]].push_back(factors_.size());
+	}
+	factors_.push_back(factor);
+}
+
+void ResidualBeliefPropagation::computeCandidateMessages(const size_t factor_index)
+{
+	const Factor& factor = factors_[factor_index];
+	const size_t number_of_factor_variables = factor.variables.size();
+	const size_t L = number_of_labels_;
+
+	// messages from the variables to this factor: all incoming messages of the variable except the one of this factor
+	std::vector<double> variable_messages(number_of_factor_variables*L);
+	for (size_t k = 0; k < number_of_factor_variables; ++k)
+		for (size_t l = 0; l < L; ++l)
+			variable_messages[k*L + l] = beliefs_[factor.variables[k]*L + l] - messages_[(factor.first_message + k)*L + l];
+
+	// maximize the factor value plus the incoming messages over all labels of the other variables
+	double* candidates = &candidate_messages_[factor.first_message*L];
+	std::fill(candidates, candidates + number_of_factor_variables*L, -std::numeric_limits<double>::infinity());
+	std::vector<size_t> labels(number_of_factor_variables, 0);
+	for (size_t configuration = 0; configuration < factor.values.size(); ++configuration)
+	{
+		double configuration_value = factor.values[configuration];
+		for (size_t k = 0; k < number_of_factor_variables; ++k)
+			configuration_value += variable_messages[k*L + labels[k]];
+		for (size_t k = 0; k < number_of_factor_variables; ++k)
+		{
+			const double message_value = configuration_value - variable_messages[k*L + labels[k]];
+			if (message_value > candidates[k*L + labels[k]])
+				candidates[k*L + labels[k]] = message_value;
+		}
+
+		// next configuration, the first variable changes fastest
+		for (size_t k = 0; k < number_of_factor_variables; ++k)
+		{
+			if (++labels[k] < L)
+				break;
+			labels[k] = 0;
+		}
+	}
+
+	// normalize the candidates to a maximum of 0 and compute the residuals to the current messages
+	for (size_t k = 0; k < number_of_factor_variables; ++k)
+	{
+		double* candidate = &candidates[k*L];
+		const double* message = &messages_[(factor.first_message + k)*L];
+		const double max_value = *std::max_element(candidate, candidate + L);
+		double residual = 0.;
+		for (size_t l = 0; l < L; ++l)
+		{
+			candidate[l] -= max_value;
+			residual = std::max(residual, std::fabs(candidate[l] - message[l]));
+		}
+		residuals_[factor.first_message + k] = residual;
+	}
+}
+
+void ResidualBeliefPropagation::infer(const size_t max_iterations, const double convergence_bound, const double residual_fraction)
+{
+	const size_t L = number_of_labels_;
+	const size_t number_of_messages = message_variables_.size();
+	messages_.assign(number_of_messages*L, 0.);
+	candidate_messages_.assign(number_of_messages*L, 0.);
+	residuals_.assign(number_of_messages, 0.);
+	beliefs_.assign(number_of_variables_*L, 0.);
+	number_of_message_updates_ = 0;
+
+	// initially, every factor has to compute its messages
+	std::vector<int> dirty_factors(factors_.size());
+	for (size_t f = 0; f < factors_.size(); ++f)
+		dirty_factors[f] = (int)f;
+	std::vector<unsigned char> factor_is_dirty(factors_.size(), 0);
+
+	for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+	{
+		// compute the new candidate messages of all factors whose incoming messages changed
+#pragma omp parallel for schedule(dynamic, 16)
+		for (int i = 0; i < (int)dirty_factors.size(); ++i)
+			computeCandidateMessages(dirty_factors[i]);
+
+		const double max_residual = (number_of_messages > 0 ? *std::max_element(residuals_.begin(), residuals_.end()) : 0.);
+		if (max_residual <= convergence_bound)
+			break;
+
+		// commit the messages with the largest residuals and mark the factors next to the changed variables
+		const double commit_threshold = std::max(convergence_bound, residual_fraction*max_residual);
+		dirty_factors.clear();
+		for (size_t m = 0; m < number_of_messages; ++m)
+		{
+			if (residuals_[m] < commit_threshold)
+				continue;
+			const size_t variable = message_variables_[m];
+			for (size_t l = 0; l < L; ++l)
+			{
+				beliefs_[variable*L + l] += candidate_messages_[m*L + l] - messages_[m*L + l];
+				messages_[m*L + l] = candidate_messages_[m*L + l];
+			}
+			residuals_[m] = 0.;
+			++number_of_message_updates_;
+			for (size_t f = 0; f < factors_of_variables_[variable].size(); ++f)
+			{
+				const size_t factor = factors_of_variables_[variable][f];
+				if (factor_is_dirty[factor] == 0)
+				{
+					factor_is_dirty[factor] = 1;
+					dirty_factors.push_back((int)factor);
+				}
+			}
+		}
+		for (size_t i = 0; i < dirty_factors.size(); ++i)
+			factor_is_dirty[dirty_factors[i]] = 0;
+	}
+}
+
+void ResidualBeliefPropagation::arg(std::vector<size_t>& labels) const
+{
+	labels.resize(number_of_variables_);
+	for (size_t v = 0; v < number_of_variables_; ++v)
+		labels[v] = std::max_element(beliefs_.begin() + v*number_of_labels_, beliefs_.begin() + (v+1)*number_of_labels_) - (beliefs_.begin() + v*number_of_labels_);
+}
+
+double ResidualBeliefPropagation::value() const
+{
+	std::vector<size_t> labels;
+	arg(labels);
+	double sum = 0.;
+	for (size_t f = 0; f < factors_.size(); ++f)
+	{
+		size_t index = 0;
+		for (size_t k = factors_[f].variables.size(); k > 0; --k)
+			index = index*number_of_labels_ + labels[factors_[f].variables[k-1]];
+		sum += factors_[f].values[index];
+	}
+	return sum;
+}
+
+size_t ResidualBeliefPropagation::getNumberOfMessageUpdates() const
+{
+	return number_of_message_updates_;
+}
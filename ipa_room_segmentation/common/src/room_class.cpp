@@ -10,8 +10,10 @@ Room::Room(int id_of_room)
 
 void Room::mergeRoom(Room& room_to_merge, double map_resolution)
 {
-	// member_points_, room_area_
+	// member_points_, room_area_ (the members may be only a part of the room, e.g. its contour, hence the areas are added)
+	const double merged_area = room_area_ + room_to_merge.room_area_;
 	insertMemberPoints(room_to_merge.getMembers(), map_resolution);
+	room_area_ = merged_area;
 
 	// neighbor_room_ids_
 	const std::vector<int>& neighbor_ids = room_to_merge.getNeighborIDs();
@@ -69,9 +71,10 @@ int Room::insertMemberPoint(cv::Point new_member, double map_resolution)
 //function to add a few Points
 int Room::insertMemberPoints(const std::vector<cv::Point>& new_members, double map_resolution)
 {
+	PointSet member_set(member_points_.begin(), member_points_.end());
 	for (size_t point = 0; point < new_members.size(); point++)
 	{
-		if (!contains(member_points_, new_members[point]))
+		if (member_set.insert(new_members[point]).second == true)
 		{
 			member_points_.push_back(new_members[point]);
 		}
@@ -0,0 +1,188 @@
+#include <ipa_room_segmentation/tiled_segmentation.h>
+
+#include <map>
+#include <algorithm>
+
+TiledSegmentation::TiledSegmentation()
+{
+
+}
+
+int TiledSegmentation::findRoot(std::vector<int>& parents, int id)
+{
+	while (parents[id] != id)
+	{
+		parents[id] = parents[parents[id]];	// path halving
+		id = parents[id];
+	}
+	return id;
+}
+
+void TiledSegmentation::segmentMap(const cv::Mat& map_to_be_labeled, cv::Mat& segmented_map, const int tile_size, const int tile_overlap,
+		const TileSegmentationFunction& segment_tile, const double min_overlap_ratio, const bool parallel_tiles)
+{
+	const int size = std::max(1, tile_size);
+	const int overlap = std::max(0, tile_overlap);
+	const int number_tiles_x = (map_to_be_labeled.cols + size - 1) / size;
+	const int number_tiles_y = (map_to_be_labeled.rows + size - 1) / size;
+	const int number_tiles = number_tiles_x * number_tiles_y;
+	segmented_map.create(map_to_be_labeled.rows, map_to_be_labeled.cols, CV_32SC1);
+
+	// 1. segment all tiles, the cores receive the room labels of their tile (1..number_rooms[tile]), the extended parts are kept as seam cells
+	std::vector<cv::Rect> core_rects(number_tiles), extended_rects(number_tiles);
+	for (int tile = 0; tile < number_tiles; ++tile)
+	{
+		const int core_x = (tile % number_tiles_x) * size;
+		const int core_y = (tile / number_tiles_x) * size;
+		core_rects[tile] = cv::Rect(core_x, core_y, std::min(size, map_to_be_labeled.cols-core_x), std::min(size, map_to_be_labeled.rows-core_y));
+		const int min_x = std::max(0, core_x-overlap);
+		const int min_y = std::max(0, core_y-overlap);
+		const int max_x = std::min(map_to_be_labeled.cols, core_rects[tile].br().x+overlap);
+		const int max_y = std::min(map_to_be_labeled.rows, core_rects[tile].br().y+overlap);
+		extended_rects[tile] = cv::Rect(min_x, min_y, max_x-min_x, max_y-min_y);
+	}
+	std::vector<int> number_rooms(number_tiles, 0);
+	std::vector<std::vector<SeamCell> > seam_cells(number_tiles);
+#pragma omp parallel for schedule(dynamic) if(parallel_tiles)
+	for (int tile = 0; tile < number_tiles; ++tile)
+	{
+		const cv::Rect& core = core_rects[tile];
+		const cv::Rect& extended = extended_rects[tile];
+		const cv::Mat tile_map = map_to_be_labeled(extended).clone();
+		cv::Mat tile_segmented_map;
+		segment_tile(tile_map, tile_segmented_map, extended.tl());
+
+		std::map<int, int> tile_labels;		// maps the labels of the algorithm to 1..number_rooms[tile]
+		int last_label = -1, last_tile_label = 0;
+		for (int v = 0; v < tile_segmented_map.rows; ++v)
+		{
+			const int y = v + extended.y;
+			const bool core_row = (y >= core.y && y < core.br().y);
+			const int* tile_segmented_map_ptr = tile_segmented_map.ptr<int>(v);
+			int* segmented_map_ptr = segmented_map.ptr<int>(y);
+			for (int u = 0; u < tile_segmented_map.cols; ++u)
+			{
+				const int x = u + extended.x;
+				const bool core_cell = (core_row == true && x >= core.x && x < core.br().x);
+				const int label = tile_segmented_map_ptr[u];
+				if (label > 0 && label < 65280)
+				{
+					if (label != last_label)
+					{
+						std::map<int, int>::iterator it = tile_labels.find(label);
+						if (it == tile_labels.end())
+							it = tile_labels.insert(std::pair<int, int>(label, (int)tile_labels.size()+1)).first;
+						last_label = label;
+						last_tile_label = it->second;
+					}
+					if (core_cell == true)
+						segmented_map_ptr[x] = last_tile_label;
+					else
+					{
+						SeamCell cell;
+						cell.x = x;
+						cell.y = y;
+						cell.label = last_tile_label;
+						seam_cells[tile].push_back(cell);
+					}
+				}
+				else if (core_cell == true)
+					segmented_map_ptr[x] = label;
+			}
+		}
+		number_rooms[tile] = (int)tile_labels.size();
+	}
+
+	// 2. give every room of every tile a unique id
+	std::vector<int> room_id_offsets(number_tiles, 0);
+	int number_room_ids = 0;
+	for (int tile = 0; tile < number_tiles; ++tile)
+	{
+		room_id_offsets[tile] = number_room_ids;
+		number_room_ids += number_rooms[tile];
+	}
+	std::vector<int> room_tiles(number_room_ids+1, -1);
+	std::vector<int> parents(number_room_ids+1);
+	for (int tile = 0; tile < number_tiles; ++tile)
+		for (int label = 1; label <= number_rooms[tile]; ++label)
+			room_tiles[room_id_offsets[tile]+label] = tile;
+	for (int id = 0; id <= number_room_ids; ++id)
+		parents[id] = id;
+
+	// 3. count the common cells of the rooms of neighboring tiles within the overlaps
+	std::map<std::pair<int, int>, int> common_cells;		// (room id of the extending tile, room id of the core tile) -> number of common cells
+	std::map<std::pair<int, int>, int> overlap_cells;		// (room id, other tile) -> number of cells of the room within the overlap with the other tile
+	for (int tile = 0; tile < number_tiles; ++tile)
+	{
+		// rooms of this tile within the cores of its neighbors
+		for (size_t i = 0; i < seam_cells[tile].size(); ++i)
+		{
+			const SeamCell& cell = seam_cells[tile][i];
+			const int neighbor = (cell.y / size) * number_tiles_x + cell.x / size;
+			const int id = room_id_offsets[tile] + cell.label;
+			++overlap_cells[std::pair<int, int>(id, neighbor)];
+			const int neighbor_label = segmented_map.at<int>(cell.y, cell.x);
+			if (neighbor_label > 0 && neighbor_label < 65280)
+				++common_cells[std::pair<int, int>(id, room_id_offsets[neighbor]+neighbor_label)];
+		}
+		std::vector<SeamCell>().swap(seam_cells[tile]);
+
+		// rooms of the neighbors within the extended part of this tile
+		const int tile_x = tile % number_tiles_x, tile_y = tile / number_tiles_x;
+		for (int neighbor_y = std::max(0, tile_y-1); neighbor_y <= std::min(number_tiles_y-1, tile_y+1); ++neighbor_y)
+		{
+			for (int neighbor_x = std::max(0, tile_x-1); neighbor_x <= std::min(number_tiles_x-1, tile_x+1); ++neighbor_x)
+			{
+				const int neighbor = neighbor_y * number_tiles_x + neighbor_x;
+				if (neighbor == tile)
+					continue;
+				const cv::Rect intersection = extended_rects[tile] & core_rects[neighbor];
+				for (int y = intersection.y; y < intersection.br().y; ++y)
+				{
+					const int* segmented_map_ptr = segmented_map.ptr<int>(y);
+					for (int x = intersection.x; x < intersection.br().x; ++x)
+						if (segmented_map_ptr[x] > 0 && segmented_map_ptr[x] < 65280)
+							++overlap_cells[std::pair<int, int>(room_id_offsets[neighbor]+segmented_map_ptr[x], tile)];
+				}
+			}
+		}
+	}
+
+	// 4. join the rooms that cover the same part of an overlap
+	for (std::map<std::pair<int, int>, int>::const_iterator it = common_cells.begin(); it != common_cells.end(); ++it)
+	{
+		const int id = it->first.first;
+		const int neighbor_id = it->first.second;
+		const int cells = overlap_cells[std::pair<int, int>(id, room_tiles[neighbor_id])];
+		const int neighbor_cells = overlap_cells[std::pair<int, int>(neighbor_id, room_tiles[id])];
+		if (it->second >= min_overlap_ratio * std::min(cells, neighbor_cells))
+		{
+			const int root = findRoot(parents, id);
+			const int neighbor_root = findRoot(parents, neighbor_id);
+			if (root != neighbor_root)
+				parents[std::max(root, neighbor_root)] = std::min(root, neighbor_root);
+		}
+	}
+
+	// 5. label the joined rooms consecutively in the order of their appearance
+	std::vector<int> final_labels(number_room_ids+1, 0);
+	int number_final_labels = 0;
+	for (int y = 0; y < segmented_map.rows; ++y)
+	{
+		int* segmented_map_ptr = segmented_map.ptr<int>(y);
+		for (int tile = (y / size) * number_tiles_x; tile < (y / size + 1) * number_tiles_x; ++tile)
+		{
+			const cv::Rect& core = core_rects[tile];
+			for (int x = core.x; x < core.br().x; ++x)
+			{
+				if (segmented_map_ptr[x] > 0 && segmented_map_ptr[x] < 65280)
+				{
+					const int root = findRoot(parents, room_id_offsets[tile]+segmented_map_ptr[x]);
+					if (final_labels[root] == 0)
+						final_labels[root] = ++number_final_labels;
+					segmented_map_ptr[x] = final_labels[root];
+				}
+			}
+		}
+	}
+}
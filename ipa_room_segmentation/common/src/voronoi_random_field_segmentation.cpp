@@ -216,6 +216,13 @@ VoronoiRandomFieldSegmentation::VoronoiRandomFieldSegmentation()
 	params_ = params;
 	trained_boost_ = false;
 	trained_conditional_field_ = false;
+
+	inference_method_ = VRF_INFERENCE_LOOPY_BP;
+}
+
+void VoronoiRandomFieldSegmentation::setInferenceMethod(const int inference_method)
+{
+	inference_method_ = inference_method;
 }
 
 // This Function checks if the given cv::Point is more far away from all the cv::Points in the given set. If one point gets found
@@ -276,46 +283,38 @@ std::vector<double> VoronoiRandomFieldSegmentation::raycasting(const cv::Mat& ma
 // This function computes all possible configurations for n variables that each can have m labels, e.g. when there are 2 variabels
 // with 3 possible label for each there are 9 possible configurations. Important is that this function does compute multiple
 // configurations like (1,2) and (2,1).
-// This is done using the std::next_permutation function that computes the permutations of a given vector/array. To get all possible
-// configurations first a vector is created and filled that stores n*m elements, representing the label for each variable. Then
-// after the vector gets sorted all possible permutations are listed and the first n elements in this permutation are one configuration
-// and going to be saved, if it hasn't occurred yet.
+// The configurations are enumerated like the digits of a number with base m, where the last variable changes fastest and the
+// labels are used in increasing order. This yields the configurations in lexicographic order, each one exactly once, without
+// enumerating the permutations of all n*m labels.
 void VoronoiRandomFieldSegmentation::getPossibleConfigurations(std::vector<std::vector<uint> >& possible_configurations,
 		const std::vector<uint>& possible_labels, const uint number_of_variables)
 {
-	// check how many possible labels there are and create a vector with number_of_variables*number_of_labels length
-	uint number_of_labels = possible_labels.size();
-	std::vector<uint> label_vector(number_of_labels*number_of_variables);
-
-	// fill the created vector with the labels for each variable
-	for(size_t variable = 0; variable < number_of_variables; ++variable)
-		for(size_t label = 0; label < number_of_labels; ++label)
-			label_vector[label + number_of_labels * variable] = possible_labels[label];
-
-	// sort the vector (expected from std::next_permutation)
-	std::sort (label_vector.begin(),label_vector.end());
-
-	// set to save the found configurations --> to easily check if one configuration has already been found
-	std::set<std::vector<uint> > found_configurations;
-
-	// get all permutations and create one configuration out of each
-	do
+	// sort the labels, so the configurations are found in lexicographic order
+	std::vector<uint> sorted_labels = possible_labels;
+	std::sort(sorted_labels.begin(), sorted_labels.end());
+	if(sorted_labels.empty() == true)
+		return;
+
+	// label index of each variable in the current configuration
+	std::vector<size_t> digits(number_of_variables, 0);
+	while(true)
 	{
-		// configuration-vector
 		std::vector<uint> current_config(number_of_variables);
-
-		// resave the first number_of_variables elements
 		for(size_t v = 0; v < number_of_variables; ++v)
-			current_config[v] = label_vector[v];
+			current_config[v] = sorted_labels[digits[v]];
+		possible_configurations.push_back(current_config);
 
-		// check if the current_configuration has occurred yet, if not add it to the possible configurations
-		if(found_configurations.find(current_config) == found_configurations.end())
+		// go to the next configuration, stop when all digits overflowed
+		int v = (int)number_of_variables - 1;
+		for(; v >= 0; --v)
 		{
-			found_configurations.insert(current_config);
-			possible_configurations.push_back(current_config);
+			if(++digits[v] < sorted_labels.size())
+				break;
+			digits[v] = 0;
 		}
-
-	}while (std::next_permutation(label_vector.begin(),label_vector.end()));
+		if(v < 0)
+			break;
+	}
 }
 
 //
@@ -594,16 +593,43 @@ void VoronoiRandomFieldSegmentation::trainBoostClassifiers(const std::vector<cv:
 //		room, hallway, doorway
 void VoronoiRandomFieldSegmentation::getAdaBoostFeatureVector(std::vector<double>& feature_vector, Clique& clique,
 		std::vector<uint>& given_labels, std::vector<unsigned int>& possible_labels)
+{
+	std::vector<std::vector<double> > member_features;
+	getCliqueMemberFeatures(clique, possible_labels, member_features);
+	getAdaBoostFeatureVector(feature_vector, member_features, given_labels, possible_labels);
+}
+
+// This function computes the features of each clique member. Only feature 25 depends on the labels of the clique and it is the
+// same for all members, so the features computed here can be used for every label configuration of the clique.
+void VoronoiRandomFieldSegmentation::getCliqueMemberFeatures(Clique& clique, std::vector<unsigned int>& possible_labels,
+		std::vector<std::vector<double> >& member_features)
 {
 	// Get the points that belong to the clique and the stored simulated beams for each one.
 	std::vector<cv::Point> clique_members = clique.getMemberPoints();
 	std::vector< std::vector<double> > beams_for_points = clique.getBeams();
 
+	// arbitrary labels, the label dependent feature gets replaced later
+	std::vector<uint> labels(clique_members.size(), possible_labels[0]);
+
+	voronoiRandomFieldFeatures vrf_feature_computer;
+	member_features.resize(clique_members.size());
+	for(size_t point = 0; point < clique_members.size(); ++point)
+		vrf_feature_computer.getFeatures(beams_for_points[point], angles_for_simulation_, clique_members, labels, possible_labels, clique_members[point], member_features[point]);
+}
+
+void VoronoiRandomFieldSegmentation::getAdaBoostFeatureVector(std::vector<double>& feature_vector, const std::vector<std::vector<double> >& member_features,
+		std::vector<uint>& given_labels, std::vector<unsigned int>& possible_labels)
+{
 	// vector that is used to sum up the calculated features
 	std::vector<double> temporary_feature_vector(feature_vector.size(), 0.0);
 
+	// the label dependent feature is the same for all members of the clique
+	voronoiRandomFieldFeatures vrf_feature_computer;
+	vrf_feature_computer.resetCachedData();
+	const double label_feature = vrf_feature_computer.calcFeature25(possible_labels, given_labels);
+
 	// For each member of this clique calculate the weak-hypothesis and add the resulting vectors in the end
-	for(size_t point = 0; point < clique_members.size(); ++point)
+	for(size_t point = 0; point < member_features.size(); ++point)
 	{
 		// Check which classifier (room, hallway or doorway) needs to be used.
 		unsigned int classifier;
@@ -617,15 +643,12 @@ void VoronoiRandomFieldSegmentation::getAdaBoostFeatureVector(std::vector<double
 		}
 
 		// get the features for the central point of the clique
-		voronoiRandomFieldFeatures vrf_feature_computer;
 		cv::Mat featuresMat(1, vrf_feature_computer.getFeatureCount(), CV_32FC1); //OpenCV expects a 32-floating-point Matrix as feature input
-		std::vector<double> current_features;
-		vrf_feature_computer.getFeatures(beams_for_points[point], angles_for_simulation_, clique_members, given_labels, possible_labels, clique_members[point], current_features);
-
 		for (int f = 1; f <= vrf_feature_computer.getFeatureCount(); ++f)
 		{
-			featuresMat.at<float>(0, f - 1) = (float) current_features[f-1];
+			featuresMat.at<float>(0, f - 1) = (float) member_features[point][f-1];
 		}
+		featuresMat.at<float>(0, 24) = (float) label_feature;
 
 		// Calculate the weak hypothesis by using the wanted classifier.
 		CvMat features = featuresMat;
@@ -1316,6 +1339,9 @@ void VoronoiRandomFieldSegmentation::segmentMap(const cv::Mat& original_map, cv:
 	// It has a size of 4, because in this algorithm only cliques with 2-5 members are possible.
 	std::vector<std::vector<std::vector<uint> > > label_configurations(5);
 
+	// the same configurations with the real labels instead of the label indices, needed to compute the features of a clique
+	std::vector<std::vector<std::vector<uint> > > real_label_configurations(5);
+
 	// vector that stores the index for each possible label as element
 	// 		--> to get the order as index list, so it can be used to assign the value of functions
 	std::vector<uint> label_indices(possible_labels.size());
@@ -1326,66 +1352,75 @@ void VoronoiRandomFieldSegmentation::segmentMap(const cv::Mat& original_map, cv:
 
 	for(uint size = 1; size <= 5; ++size)
 	{
-		// vector that stores all possible configurations for one member-size
-		std::vector<std::vector<uint> > possible_configurations;
-
 		// use the above defined function to find all possible configurations for the possible labels and save them in the map
-		getPossibleConfigurations(possible_configurations, label_indices, size);
-		label_configurations[size-1] = possible_configurations;
+		getPossibleConfigurations(label_configurations[size-1], label_indices, size);
+
+		// find the real labels and assign them into the configurations so the feature-vector gets calculated correctly
+		real_label_configurations[size-1] = label_configurations[size-1];
+		for(size_t configuration = 0; configuration < real_label_configurations[size-1].size(); ++configuration)
+			for(size_t variable = 0; variable < size; ++variable)
+				real_label_configurations[size-1][configuration][variable] = possible_labels[label_configurations[size-1][configuration][variable]];
 	}
 
 	std::cout << "Created all possible label-configurations. Time: " << timer.getElapsedTimeInMilliSec() << "ms" << std::endl;
 
+	// index of each crf-node in the set that stores all nodes
+	std::map<cv::Point, size_t, cv_Point_comp> node_indices;
+	for(std::set<cv::Point, cv_Point_comp>::iterator node = conditional_field_nodes.begin(); node != conditional_field_nodes.end(); ++node)
+		node_indices.insert(std::make_pair(*node, node_indices.size()));
+
 	timer.start();
-	// Go trough each clique and define the function and factor for it.
-	for(std::vector<Clique>::iterator current_clique = conditional_random_field_cliques.begin(); current_clique != conditional_random_field_cliques.end(); ++current_clique)
+	// Go trough each clique and compute its potential for every label configuration. The cliques are independent of each
+	// other, so this is done in parallel. The potentials of a clique are stored as value table, in which the label of the
+	// variable with the smallest index changes fastest. The functions and factors are added to the factor graph afterwards,
+	// because OpenGM doesn't allow to do this in parallel.
+	const int number_of_cliques = (int)conditional_random_field_cliques.size();
+	std::vector<std::vector<size_t> > clique_variables(number_of_cliques); // sorted indices of the crf-nodes of each clique
+	std::vector<std::vector<double> > clique_potentials(number_of_cliques); // value table of each clique
+#pragma omp parallel for schedule(dynamic)
+	for(int clique_index = 0; clique_index < number_of_cliques; ++clique_index)
 	{
-		// get the number of members in this clique and depending on this the possible label configurations defined above
-		size_t number_of_members = current_clique->getNumberOfMembers();
-
-		std::vector<std::vector<uint> > current_possible_configurations = label_configurations[number_of_members-1]; // -1 because this vector stores configurations for cliques with 1-5 members (others are not possible in this case).
-
-		// find the real labels and assign them into the current configuration so the feature-vector gets calculated correctly
-		for(size_t configuration = 0; configuration < current_possible_configurations.size(); ++configuration)
-			for(size_t variable = 0; variable < current_possible_configurations[configuration].size(); ++variable)
-				current_possible_configurations[configuration][variable] = possible_labels[current_possible_configurations[configuration][variable]];
-
-		// define an array that has as many elements as the clique has members and assign the number of possible labels for each
-		size_t variable_space[number_of_members];
-		std::fill_n(variable_space, number_of_members, number_of_classes_);
+		Clique& current_clique = conditional_random_field_cliques[clique_index];
 
-		// define a explicit function-object from OpenGM containing the initial value -1.0 for each combination
-		opengm::ExplicitFunction<double> f(variable_space, variable_space + number_of_members, -1.0);
+		// get the number of members in this clique and depending on this the possible label configurations defined above
+		size_t number_of_members = current_clique.getNumberOfMembers();
+		const std::vector<std::vector<uint> >& current_possible_configurations = real_label_configurations[number_of_members-1]; // -1 because this vector stores configurations for cliques with 1-5 members (others are not possible in this case).
 
-		// go trough all points of the clique and find the index of it in the vector the nodes of the CRF are stored in
+		// go trough all points of the clique and find the index of it in the set the nodes of the CRF are stored in
 		//  --> necessary to sort the nodes correctly
-		size_t indices[current_clique->getNumberOfMembers()]; // array the indices are stored in
-		std::vector<cv::Point> clique_points = current_clique->getMemberPoints();
+		std::vector<size_t> indices(number_of_members);
+		std::vector<cv::Point> clique_points = current_clique.getMemberPoints();
 		for(size_t point = 0; point < clique_points.size(); ++point)
 		{
-			// get the iterator to the element and use the std::distance function to calculate the index of the point
-			std::set<cv::Point>::iterator iterator = conditional_field_nodes.find(clique_points[point]);
+			std::map<cv::Point, size_t, cv_Point_comp>::const_iterator iterator = node_indices.find(clique_points[point]);
 
-			if(iterator != conditional_field_nodes.end()) // check if element was found --> should be
-				indices[point] = std::distance(conditional_field_nodes.begin(), iterator);
+			if(iterator != node_indices.end()) // check if element was found --> should be
+				indices[point] = iterator->second;
 			else
 				std::cout << "element not in set" << std::endl;
 		}
 
 		// get the possible configurations and swap them, respecting the indices, then sort the indices themself
-		std::vector<std::vector<uint> > swap_configurations = label_configurations[number_of_members-1]; // -1 because this vector stores configurations for cliques with 1-5 members (others are not possible in this case).
-		swapConfigsRegardingNodeIndices(swap_configurations, indices);
-		std::sort(indices, indices + current_clique->getNumberOfMembers());
+		std::vector<std::vector<uint> > swap_configurations = label_configurations[number_of_members-1];
+		swapConfigsRegardingNodeIndices(swap_configurations, &indices[0]);
+		std::sort(indices.begin(), indices.end());
+		clique_variables[clique_index] = indices;
+
+		// the features of the clique members don't depend on the configuration, so compute them only once
+		std::vector<std::vector<double> > member_features;
+		getCliqueMemberFeatures(current_clique, possible_labels, member_features);
 
 		// Go trough each possible configuration and compute the function value for it. Use the original configuration, because
 		// the nodes are stored in this way, but later the value is assigned in the position using the swaped configurations.
+		std::vector<double>& potentials = clique_potentials[clique_index];
+		potentials.resize(current_possible_configurations.size(), -1.0);
 		for(size_t configuration = 0; configuration < current_possible_configurations.size(); ++configuration)
 		{
 			std::vector<uint> current_configuration = current_possible_configurations[configuration];
 
 			// get current feature-vector and multiply it with the trained weights
 			std::vector<double> current_features(number_of_classifiers_);
-			getAdaBoostFeatureVector(current_features, *current_clique, current_configuration, possible_labels);
+			getAdaBoostFeatureVector(current_features, member_features, current_configuration, possible_labels);
 
 			double clique_potential = 0;
 			for(size_t weight = 0; weight < number_of_classifiers_; ++weight)
@@ -1393,9 +1428,36 @@ void VoronoiRandomFieldSegmentation::segmentMap(const cv::Mat& original_map, cv:
 				clique_potential += trained_conditional_weights_[weight] * current_features[weight];
 			}
 
-			// assign the calculated clique potential at the right position in the function --> !!Important: factors need the variables to be sorted
-			//																								 as increasing index
-			f(swap_configurations[configuration].begin()) = clique_potential;//std::exp(clique_potential);
+			// assign the calculated clique potential at the right position in the table --> !!Important: factors need the variables to be sorted
+			//																						   as increasing index
+			size_t table_index = 0;
+			for(size_t variable = number_of_members; variable > 0; --variable)
+				table_index = table_index * number_of_classes_ + swap_configurations[configuration][variable-1];
+			potentials[table_index] = clique_potential;//std::exp(clique_potential);
+		}
+	}
+
+	// add the computed potentials to the factor graph
+	for(int clique_index = 0; clique_index < number_of_cliques; ++clique_index)
+	{
+		const std::vector<size_t>& indices = clique_variables[clique_index];
+		const size_t number_of_members = indices.size();
+
+		// define an array that has as many elements as the clique has members and assign the number of possible labels for each
+		std::vector<size_t> variable_space(number_of_members, number_of_classes_);
+
+		// define a explicit function-object from OpenGM containing the initial value -1.0 for each combination and copy the table
+		opengm::ExplicitFunction<double> f(variable_space.begin(), variable_space.end(), -1.0);
+		std::vector<size_t> labels(number_of_members, 0);
+		for(size_t table_index = 0; table_index < clique_potentials[clique_index].size(); ++table_index)
+		{
+			f(labels.begin()) = clique_potentials[clique_index][table_index];
+			for(size_t variable = 0; variable < number_of_members; ++variable)
+			{
+				if(++labels[variable] < (size_t)number_of_classes_)
+					break;
+				labels[variable] = 0;
+			}
 		}
 
 		// add the defined function to the model and catch the returned function-identifier to specify which variables
@@ -1403,32 +1465,51 @@ void VoronoiRandomFieldSegmentation::segmentMap(const cv::Mat& original_map, cv:
 		FactorGraph::FunctionIdentifier identifier = factor_graph.addFunction(f);
 
 		// add the Factor to the graph, that represents which variables (and labels of each) are used for the above defined function
-		factor_graph.addFactor(identifier, indices, indices+current_clique->getNumberOfMembers());
-
+		factor_graph.addFactor(identifier, indices.begin(), indices.end());
 	}
 	std::cout << "calculated all features for the cliques. Time: " << timer.getElapsedTimeInSec() << "s" << std::endl;
 
 	// ************* V. Do inference in the defined factor-graph to find best labels. *************
 	//
-	// Do Inference in the above created graphical model using OpengM. This function has three control parameters:
+	// Do Inference in the above created graphical model. Either OpenGM's loopy belief propagation is used or the residual
+	// belief propagation (see residual_belief_propagation.h), that only updates the messages that changed most and needs much
+	// less message updates on large maps. Both have the following control parameters:
 	//		i. The maximum number of iterations done
 	//		ii. The convergence Bound, which is used to check if the messages haven't changed a lot after the last step.
-	//		iii. The damping-factor, which implies how many messages should be dumped, in this case 0.
+	//		iii. The damping-factor, which implies how many messages should be dumped, in this case 0 (only loopy belief propagation).
 	const double convergence_bound = 1e-7;
 	const double damping_factor = 0.0;
-	LoopyBeliefPropagation::Parameter parameters(max_inference_iterations, convergence_bound, damping_factor);
+	std::vector<FactorGraph::LabelType> best_labels(conditional_field_nodes.size());
+	timer.start();
+	if(inference_method_ == VRF_INFERENCE_RESIDUAL_BP)
+	{
+		ResidualBeliefPropagation residual_belief_propagation(conditional_field_nodes.size(), number_of_classes_);
+		for(int clique_index = 0; clique_index < number_of_cliques; ++clique_index)
+			residual_belief_propagation.addFactor(clique_variables[clique_index], clique_potentials[clique_index]);
+
+		// do inference
+		residual_belief_propagation.infer(max_inference_iterations, convergence_bound);
+		std::cout << "Done Inference. Time: " << timer.getElapsedTimeInMilliSec() << "ms. Message updates: " << residual_belief_propagation.getNumberOfMessageUpdates() << std::endl;
+
+		// obtain the labels that get the max value of the defined function
+		std::vector<size_t> labels;
+		residual_belief_propagation.arg(labels);
+		std::copy(labels.begin(), labels.end(), best_labels.begin());
+	}
+	else
+	{
+		LoopyBeliefPropagation::Parameter parameters(max_inference_iterations, convergence_bound, damping_factor);
 
-	// create LoopyBeliefPropagation object that does inference on the graphical model defined above
-	LoopyBeliefPropagation belief_propagation(factor_graph, parameters);
+		// create LoopyBeliefPropagation object that does inference on the graphical model defined above
+		LoopyBeliefPropagation belief_propagation(factor_graph, parameters);
 
-	// do inference
-	timer.start();
-	belief_propagation.infer();
-	std::cout << "Done Inference. Time: " << timer.getElapsedTimeInMilliSec() << "ms" << std::endl;
+		// do inference
+		belief_propagation.infer();
+		std::cout << "Done Inference. Time: " << timer.getElapsedTimeInMilliSec() << "ms" << std::endl;
 
-	// obtain the labels that get the max value of the defined function
-	std::vector<FactorGraph::LabelType> best_labels(conditional_field_nodes.size());
-	belief_propagation.arg(best_labels);
+		// obtain the labels that get the max value of the defined function
+		belief_propagation.arg(best_labels);
+	}
 
 	// print the solution if wanted
 	if(show_results == true)
@@ -1444,10 +1525,10 @@ void VoronoiRandomFieldSegmentation::segmentMap(const cv::Mat& original_map, cv:
 		cv::imshow("node-map", resulting_map);
 //		cv::waitKey();
 	}
-	std::cout << "complete Potential: " << belief_propagation.value() << std::endl;
+	std::cout << "complete Potential: " << factor_graph.evaluate(best_labels.begin()) << std::endl;
 
 	// for optimization purpose
-//	return belief_propagation.value();
+//	return factor_graph.evaluate(best_labels.begin());
 
 	// ************* VI. Search for different regions of same color and make them a individual segment *************
 	//
@@ -0,0 +1,175 @@
+#include <ipa_room_segmentation/voronoi_skeleton.h>
+
+#include <limits>
+
+void computeEuclideanDistanceTransform(const cv::Mat& map, cv::Mat& squared_distance_map, cv::Mat& nearest_obstacle_map)
+{
+	const int rows = map.rows;
+	const int cols = map.cols;
+	const int infinity = std::numeric_limits<int>::max();
+	squared_distance_map = cv::Mat(rows, cols, CV_32SC1, cv::Scalar(infinity));
+	nearest_obstacle_map = cv::Mat(rows, cols, CV_32SC1, cv::Scalar(-1));
+	if (rows == 0 || cols == 0)
+		return;
+
+	// 1. distance to the nearest obstacle within each column
+	std::vector<int> column_obstacle_row(rows*cols, -1);	// row of the nearest obstacle in the same column, -1 if there is none
+	for (int u = 0; u < cols; ++u)
+	{
+		int last_obstacle = -1;
+		for (int v = 0; v < rows; ++v)
+		{
+			if (map.at<uchar>(v, u) == 0)
+				last_obstacle = v;
+			column_obstacle_row[v*cols + u] = last_obstacle;
+		}
+		last_obstacle = -1;
+		for (int v = rows-1; v >= 0; --v)
+		{
+			if (map.at<uchar>(v, u) == 0)
+				last_obstacle = v;
+			int& nearest = column_obstacle_row[v*cols + u];
+			if (last_obstacle >= 0 && (nearest < 0 || last_obstacle - v < v - nearest))
+				nearest = last_obstacle;
+		}
+	}
+
+	// 2. lower envelope of the parabolas (u-q)^2 + g(q)^2 within each row, where g(q) is the column distance of pixel q
+	std::vector<int> parabola_columns(cols);		// columns q of the parabolas in the lower envelope
+	std::vector<double> boundaries(cols+1);			// the parabola k is the lowest between boundaries[k] and boundaries[k+1]
+	std::vector<double> f(cols);
+	for (int v = 0; v < rows; ++v)
+	{
+		int k = -1;
+		for (int q = 0; q < cols; ++q)
+		{
+			const int obstacle_row = column_obstacle_row[v*cols + q];
+			if (obstacle_row < 0)
+				continue;
+			f[q] = (double)(v - obstacle_row)*(v - obstacle_row);
+			double s = -std::numeric_limits<double>::infinity();
+			while (k >= 0)
+			{
+				const int p = parabola_columns[k];
+				s = ((f[q] + (double)q*q) - (f[p] + (double)p*p)) / (2.*(q - p));
+				if (s > boundaries[k])
+					break;
+				--k;
+			}
+			++k;
+			parabola_columns[k] = q;
+			boundaries[k] = (k == 0 ? -std::numeric_limits<double>::infinity() : s);
+			boundaries[k+1] = std::numeric_limits<double>::infinity();
+		}
+		if (k < 0)
+			continue;	// no obstacle in any column
+
+		int* distance_ptr = squared_distance_map.ptr<int>(v);
+		int* obstacle_ptr = nearest_obstacle_map.ptr<int>(v);
+		int j = 0;
+		for (int u = 0; u < cols; ++u)
+		{
+			while (boundaries[j+1] < u)
+				++j;
+			const int q = parabola_columns[j];
+			distance_ptr[u] = (u - q)*(u - q) + (int)f[q];
+			obstacle_ptr[u] = column_obstacle_row[v*cols + q]*cols + q;
+		}
+	}
+}
+
+void thinRegions(cv::Mat& image, const uchar region_value, const uchar background_value)
+{
+	std::vector<cv::Point> pixels_to_remove;
+	bool changed = true;
+	while (changed == true)
+	{
+		changed = false;
+		for (int sub_iteration = 0; sub_iteration < 2; ++sub_iteration)
+		{
+			pixels_to_remove.clear();
+			for (int v = 1; v < image.rows-1; ++v)
+			{
+				for (int u = 1; u < image.cols-1; ++u)
+				{
+					if (image.at<uchar>(v, u) != region_value)
+						continue;
+
+					// neighbors p2..p9, clockwise starting at the top
+					const bool p[8] = {	image.at<uchar>(v-1, u) == region_value, image.at<uchar>(v-1, u+1) == region_value,
+										image.at<uchar>(v, u+1) == region_value, image.at<uchar>(v+1, u+1) == region_value,
+										image.at<uchar>(v+1, u) == region_value, image.at<uchar>(v+1, u-1) == region_value,
+										image.at<uchar>(v, u-1) == region_value, image.at<uchar>(v-1, u-1) == region_value };
+					int neighbors = 0;
+					int transitions = 0;
+					for (int i = 0; i < 8; ++i)
+					{
+						neighbors += p[i];
+						transitions += (p[i] == false && p[(i+1)%8] == true);
+					}
+					if (neighbors < 2 || neighbors > 6 || transitions != 1)
+						continue;
+					if (sub_iteration == 0 && ((p[0] && p[2] && p[4]) || (p[2] && p[4] && p[6])))
+						continue;
+					if (sub_iteration == 1 && ((p[0] && p[2] && p[6]) || (p[0] && p[4] && p[6])))
+						continue;
+					pixels_to_remove.push_back(cv::Point(u, v));
+				}
+			}
+			for (size_t i = 0; i < pixels_to_remove.size(); ++i)
+				image.at<uchar>(pixels_to_remove[i]) = background_value;
+			if (pixels_to_remove.empty() == false)
+				changed = true;
+		}
+	}
+}
+
+void drawVoronoiSkeleton(const cv::Mat& map, const cv::Mat& valid_area, cv::Mat& voronoi_map, const uchar voronoi_color,
+		const double min_obstacle_separation)
+{
+	cv::Mat squared_distance_map, nearest_obstacle_map;
+	computeEuclideanDistanceTransform(map, squared_distance_map, nearest_obstacle_map);
+
+	// mark both pixels of each neighboring pair whose nearest obstacle pixels are far apart, the Voronoi line passes between them
+	const double min_squared_separation = min_obstacle_separation*min_obstacle_separation;
+	const int cols = map.cols;
+	const int du[4] = {1, -1, 0, 1};
+	const int dv[4] = {0, 1, 1, 1};
+	cv::Mat skeleton = cv::Mat::zeros(map.rows, map.cols, CV_8UC1);
+	for (int v = 0; v < map.rows; ++v)
+	{
+		for (int u = 0; u < map.cols; ++u)
+		{
+			const int obstacle = nearest_obstacle_map.at<int>(v, u);
+			if (map.at<uchar>(v, u) != 255 || obstacle < 0)
+				continue;
+			for (int n = 0; n < 4; ++n)
+			{
+				const int nu = u + du[n];
+				const int nv = v + dv[n];
+				if (nu < 0 || nu >= map.cols || nv >= map.rows || map.at<uchar>(nv, nu) != 255)
+					continue;
+				const int neighbor_obstacle = nearest_obstacle_map.at<int>(nv, nu);
+				const double dx = obstacle%cols - neighbor_obstacle%cols;
+				const double dy = obstacle/cols - neighbor_obstacle/cols;
+				if (dx*dx + dy*dy > min_squared_separation)
+				{
+					skeleton.at<uchar>(v, u) = 255;
+					skeleton.at<uchar>(nv, nu) = 255;
+				}
+			}
+		}
+	}
+
+	// only keep the lines that are not too close to the obstacles and make them one pixel wide
+	for (int v = 0; v < map.rows; ++v)
+		for (int u = 0; u < map.cols; ++u)
+			if (valid_area.at<uchar>(v, u) == 0)
+				skeleton.at<uchar>(v, u) = 0;
+	thinRegions(skeleton, 255, 0);
+
+	for (int v = 0; v < map.rows; ++v)
+		for (int u = 0; u < map.cols; ++u)
+			if (skeleton.at<uchar>(v, u) != 0)
+				voronoi_map.at<uchar>(v, u) = voronoi_color;
+}
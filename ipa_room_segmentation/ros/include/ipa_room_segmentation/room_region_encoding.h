@@ -0,0 +1,70 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ * Copyright (c) 2015 \n
+ * Fraunhofer Institute for Manufacturing Engineering
+ * and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ * Project name: Care-O-bot
+ * \note
+ * ROS stack name: autopnp
+ * \note
+ * ROS package name: ipa_room_segmentation
+ *
+ * \brief
+ * Run-length encoding of the rooms of a segmented map and reconstruction of single room masks.
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer. \n
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution. \n
+ * - Neither the name of the Fraunhofer Institute for Manufacturing
+ * Engineering and Automation (IPA) nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <opencv/cv.h>
+
+#include <ipa_building_msgs/RoomRegion.h>
+
+// Creates a compact description of every room of an indexed map (labels 1..number_rooms, 0 and labels > number_rooms
+// are not part of any room). Each room is stored as horizontal runs of cells together with its bounding box and area,
+// all rooms are encoded within a single pass over the map. room_regions[i-1] describes the room with label i,
+// the room centers are not known here and have to be set by the caller.
+void encodeRoomRegions(const cv::Mat& indexed_map, const int number_rooms, std::vector<ipa_building_msgs::RoomRegion>& room_regions);
+
+// Restores the mask of a single room from its runs. roi_mask (CV_8UC1) covers only the bounding box of the room,
+// room cells are 255 and all other cells are 0. roi_offset is the position of the upper left mask cell in the map,
+// i.e. mask cell (u,v) corresponds to map cell (u+roi_offset.x, v+roi_offset.y).
+void decodeRoomRegionMask(const ipa_building_msgs::RoomRegion& room_region, cv::Mat& roi_mask, cv::Point& roi_offset);
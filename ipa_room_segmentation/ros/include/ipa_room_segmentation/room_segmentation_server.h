@@ -84,6 +84,7 @@
 #include <ipa_room_segmentation/voronoi_segmentation.h>
 #include <ipa_room_segmentation/adaboost_classifier.h>
 #include <ipa_room_segmentation/voronoi_random_field_segmentation.h>
+#include <ipa_room_segmentation/tiled_segmentation.h>
 
 class RoomSegmentationServer
 {
@@ -108,9 +109,13 @@ protected:
 	int min_neighborhood_size_; //Variable that stores the minimum size of a neighborhood, used for the vrf method.
 	double min_voronoi_random_field_node_distance_; //Variable that shows how near two nodes of the conditional random field can be in the vrf method. [pixel]
 	int max_voronoi_random_field_inference_iterations_; //Variable that shows how many iterations should max. be done when infering in the conditional random field.
+	int voronoi_random_field_inference_method_; //Variable that selects the inference algorithm for the conditional random field, see VrfInferenceMethods
 	double min_critical_point_distance_factor_; //Variable that sets the minimal distance between two critical Points before one gets eliminated
+	int voronoi_graph_generator_; //Variable that selects the method to create the Voronoi graph in the voronoi method and vrf method, see VoronoiGraphGenerators
 	double max_area_for_merging_; //Variable that shows the maximal area of a room that should be merged with its surrounding rooms
 	bool display_segmented_map_;	// displays the segmented map upon service call
+	double tile_size_;	// maps larger than tile_size_ x tile_size_ [m] are segmented tile by tile to bound the memory, 0 segments the whole map at once
+	double tile_overlap_;	// overlap [m] of neighboring tiles that is used to join the rooms at the tile borders
 	std::vector<cv::Point> doorway_points_; // vector that saves the found doorway points, when using the 5th algorithm (vrf)
 
 	std::vector<std::string> semantic_training_maps_room_file_list_;	// list of files containing maps with room labels for training the semantic segmentation
@@ -133,6 +138,13 @@ protected:
 		return meter_value_obj_y;
 	}
 
+	// segments a map with the selected algorithm, returns false if the selected algorithm is undefined
+	bool segmentMapWithSelectedAlgorithm(const cv::Mat& map, cv::Mat& segmented_map, const float map_resolution,
+			const bool display_map, std::vector<cv::Point>& doorway_points);
+
+	// segments a single tile of a map, called by TiledSegmentation, from several threads unless a classifier based algorithm is selected
+	void segmentTile(const cv::Mat& tile_map, cv::Mat& tile_segmented_map, const cv::Point& tile_offset, const float map_resolution);
+
 	//This is the execution function used by action server
 	void execute_segmentation_server(const ipa_building_msgs::MapSegmentationGoalConstPtr &goal);
 
@@ -0,0 +1,72 @@
+#include <ipa_room_segmentation/room_region_encoding.h>
+
+#include <algorithm>
+
+void encodeRoomRegions(const cv::Mat& indexed_map, const int number_rooms, std::vector<ipa_building_msgs::RoomRegion>& room_regions)
+{
+	room_regions.clear();
+	room_regions.resize(number_rooms);
+	for (int i = 0; i < number_rooms; ++i)
+	{
+		room_regions[i].label = i+1;
+		room_regions[i].min_x = indexed_map.cols;
+		room_regions[i].min_y = indexed_map.rows;
+		room_regions[i].max_x = -1;
+		room_regions[i].max_y = -1;
+		room_regions[i].area = 0;
+	}
+
+	// scan the map row by row and close a run whenever the label changes
+	for (int v = 0; v < indexed_map.rows; ++v)
+	{
+		const int* map_ptr = indexed_map.ptr<int>(v);
+		int u = 0;
+		while (u < indexed_map.cols)
+		{
+			const int label = map_ptr[u];
+			const int run_start = u;
+			while (u < indexed_map.cols && map_ptr[u] == label)
+				++u;
+			if (label < 1 || label > number_rooms)
+				continue;
+
+			ipa_building_msgs::RoomRegion& room_region = room_regions[label-1];
+			const int run_length = u - run_start;
+			room_region.run_rows.push_back(v);
+			room_region.run_starts.push_back(run_start);
+			room_region.run_lengths.push_back(run_length);
+			room_region.area += run_length;
+			room_region.min_x = std::min(room_region.min_x, run_start);
+			room_region.max_x = std::max(room_region.max_x, u-1);
+			room_region.min_y = std::min(room_region.min_y, v);
+			room_region.max_y = std::max(room_region.max_y, v);
+		}
+	}
+
+	// rooms without any cell get an empty bounding box at the origin
+	for (int i = 0; i < number_rooms; ++i)
+	{
+		if (room_regions[i].area == 0)
+		{
+			room_regions[i].min_x = 0;
+			room_regions[i].min_y = 0;
+			room_regions[i].max_x = -1;
+			room_regions[i].max_y = -1;
+		}
+	}
+}
+
+void decodeRoomRegionMask(const ipa_building_msgs::RoomRegion& room_region, cv::Mat& roi_mask, cv::Point& roi_offset)
+{
+	roi_offset = cv::Point(room_region.min_x, room_region.min_y);
+	const int width = std::max(0, room_region.max_x - room_region.min_x + 1);
+	const int height = std::max(0, room_region.max_y - room_region.min_y + 1);
+	roi_mask = cv::Mat::zeros(height, width, CV_8UC1);
+	for (size_t i = 0; i < room_region.run_rows.size(); ++i)
+	{
+		uchar* mask_ptr = roi_mask.ptr<uchar>(room_region.run_rows[i] - roi_offset.y);
+		const int start = room_region.run_starts[i] - roi_offset.x;
+		for (int u = start; u < start + room_region.run_lengths[i]; ++u)
+			mask_ptr[u] = 255;
+	}
+}
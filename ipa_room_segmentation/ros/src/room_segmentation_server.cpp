@@ -61,6 +61,7 @@
 
 #include <ros/package.h>
 #include <ipa_room_segmentation/meanshift2d.h>
+#include <ipa_room_segmentation/room_region_encoding.h>
 #include <ipa_room_segmentation/dynamic_reconfigure_client.h>
 
 #include <boost/algorithm/string.hpp>
@@ -121,6 +122,8 @@ RoomSegmentationServer::RoomSegmentationServer(ros::NodeHandle nh, std::string n
 		std::cout << "room_segmentation/max_iterations = " << max_iterations_ << std::endl;
 		node_handle_.param("min_critical_point_distance_factor", min_critical_point_distance_factor_, 1.6);
 		std::cout << "room_segmentation/min_critical_point_distance_factor = " << min_critical_point_distance_factor_ << std::endl;
+		node_handle_.param("voronoi_graph_generator", voronoi_graph_generator_, 1);
+		std::cout << "room_segmentation/voronoi_graph_generator = " << voronoi_graph_generator_ << std::endl;
 		node_handle_.param("max_area_for_merging", max_area_for_merging_, 12.5);
 		std::cout << "room_segmentation/max_area_for_merging = " << max_area_for_merging_ << std::endl;
 	}
@@ -191,6 +194,12 @@ RoomSegmentationServer::RoomSegmentationServer(ros::NodeHandle nh, std::string n
 		node_handle_.param("max_voronoi_random_field_inference_iterations", max_voronoi_random_field_inference_iterations_, 9000);
 		std::cout << "room_segmentation/max_voronoi_random_field_inference_iterations = " << max_voronoi_random_field_inference_iterations_ << std::endl;
 
+		node_handle_.param("voronoi_graph_generator", voronoi_graph_generator_, 1);
+		std::cout << "room_segmentation/voronoi_graph_generator = " << voronoi_graph_generator_ << std::endl;
+
+		node_handle_.param("voronoi_random_field_inference_method", voronoi_random_field_inference_method_, 1);
+		std::cout << "room_segmentation/voronoi_random_field_inference_method = " << voronoi_random_field_inference_method_ << std::endl;
+
 		node_handle_.param("max_iterations", max_iterations_, 150);
 		std::cout << "room_segmentation/max_iterations = " << max_iterations_ << std::endl;
 
@@ -201,6 +210,7 @@ RoomSegmentationServer::RoomSegmentationServer(ros::NodeHandle nh, std::string n
 		if(train_vrf_ == true)
 		{
 			VoronoiRandomFieldSegmentation vrf_segmentation; //voronoi random field segmentation method
+			vrf_segmentation.setVoronoiGraphGenerator(voronoi_graph_generator_);
 			const std::string package_path = ros::package::getPath("ipa_room_segmentation");
 			std::string classifier_default_path = package_path + "/common/files/classifier_models/";
 			std::string classifier_storage_path = "room_segmentation/classifier_models/";
@@ -270,6 +280,10 @@ RoomSegmentationServer::RoomSegmentationServer(ros::NodeHandle nh, std::string n
 	}
 	node_handle_.param("display_segmented_map", display_segmented_map_, false);
 	std::cout << "room_segmentation/display_segmented_map_ = " << display_segmented_map_ << std::endl;
+	node_handle_.param("tile_size", tile_size_, 0.0);
+	std::cout << "room_segmentation/tile_size = " << tile_size_ << std::endl;
+	node_handle_.param("tile_overlap", tile_overlap_, 10.0);
+	std::cout << "room_segmentation/tile_overlap = " << tile_overlap_ << std::endl;
 
 
 	// start action server
@@ -314,10 +328,12 @@ void RoomSegmentationServer::dynamic_reconfigure_callback(ipa_room_segmentation:
 		voronoi_neighborhood_index_ = config.voronoi_neighborhood_index;
 		max_iterations_ = config.max_iterations;
 		min_critical_point_distance_factor_ = config.min_critical_point_distance_factor;
+		voronoi_graph_generator_ = config.voronoi_graph_generator;
 		max_area_for_merging_ = config.max_area_for_merging;
 		std::cout << "room_segmentation/voronoi_neighborhood_index = " << voronoi_neighborhood_index_ << std::endl;
 		std::cout << "room_segmentation/max_iterations = " << max_iterations_ << std::endl;
 		std::cout << "room_segmentation/min_critical_point_distance_factor = " << min_critical_point_distance_factor_ << std::endl;
+		std::cout << "room_segmentation/voronoi_graph_generator = " << voronoi_graph_generator_ << std::endl;
 		std::cout << "room_segmentation/max_area_for_merging = " << max_area_for_merging_ << std::endl;
 	}
 	if (room_segmentation_algorithm_ == 4) //set semantic parameters
@@ -340,6 +356,8 @@ void RoomSegmentationServer::dynamic_reconfigure_callback(ipa_room_segmentation:
 		max_iterations_ = config.max_iterations;
 		min_voronoi_random_field_node_distance_ = config.min_voronoi_random_field_node_distance;
 		max_voronoi_random_field_inference_iterations_ = config.max_voronoi_random_field_inference_iterations;
+		voronoi_random_field_inference_method_ = config.voronoi_random_field_inference_method;
+		voronoi_graph_generator_ = config.voronoi_graph_generator;
 		max_area_for_merging_ = config.max_area_for_merging;
 
 		std::cout << "room_segmentation/voronoi_random_field_epsilon_for_neighborhood = " << voronoi_random_field_epsilon_for_neighborhood_ << std::endl;
@@ -347,13 +365,81 @@ void RoomSegmentationServer::dynamic_reconfigure_callback(ipa_room_segmentation:
 		std::cout << "room_segmentation/max_iterations = " << max_iterations_ << std::endl;
 		std::cout << "room_segmentation/min_voronoi_random_field_node_distance = " << min_voronoi_random_field_node_distance_ << std::endl;
 		std::cout << "room_segmentation/max_voronoi_random_field_inference_iterations = " << max_voronoi_random_field_inference_iterations_ << std::endl;
+		std::cout << "room_segmentation/voronoi_random_field_inference_method = " << voronoi_random_field_inference_method_ << std::endl;
+		std::cout << "room_segmentation/voronoi_graph_generator = " << voronoi_graph_generator_ << std::endl;
 		std::cout << "room_segmentation/max_area_for_merging = " << max_area_for_merging_ << std::endl;
 	}
 	display_segmented_map_ = config.display_segmented_map;
 	std::cout << "room_segmentation/display_segmented_map = " << display_segmented_map_ << std::endl;
+	tile_size_ = config.tile_size;
+	tile_overlap_ = config.tile_overlap;
+	std::cout << "room_segmentation/tile_size = " << tile_size_ << std::endl;
+	std::cout << "room_segmentation/tile_overlap = " << tile_overlap_ << std::endl;
 	std::cout << "######################################################################################" << std::endl;
 }
 
+bool RoomSegmentationServer::segmentMapWithSelectedAlgorithm(const cv::Mat& map, cv::Mat& segmented_map, const float map_resolution,
+		const bool display_map, std::vector<cv::Point>& doorway_points)
+{
+	if (room_segmentation_algorithm_ == 1)
+	{
+		MorphologicalSegmentation morphological_segmentation; //morphological segmentation method
+		morphological_segmentation.segmentMap(map, segmented_map, map_resolution, room_lower_limit_morphological_, room_upper_limit_morphological_);
+	}
+	else if (room_segmentation_algorithm_ == 2)
+	{
+		DistanceSegmentation distance_segmentation; //distance segmentation method
+		distance_segmentation.segmentMap(map, segmented_map, map_resolution, room_lower_limit_distance_, room_upper_limit_distance_);
+	}
+	else if (room_segmentation_algorithm_ == 3)
+	{
+		VoronoiSegmentation voronoi_segmentation; //voronoi segmentation method
+		voronoi_segmentation.setVoronoiGraphGenerator(voronoi_graph_generator_);
+		voronoi_segmentation.segmentMap(map, segmented_map, map_resolution, room_lower_limit_voronoi_, room_upper_limit_voronoi_,
+			voronoi_neighborhood_index_, max_iterations_, min_critical_point_distance_factor_, max_area_for_merging_, display_map);
+	}
+	else if (room_segmentation_algorithm_ == 4)
+	{
+		AdaboostClassifier semantic_segmentation; //semantic segmentation method
+		const std::string package_path = ros::package::getPath("ipa_room_segmentation");
+		const std::string classifier_default_path = package_path + "/common/files/classifier_models/";
+		const std::string classifier_path = "room_segmentation/classifier_models/";
+		semantic_segmentation.segmentMap(map, segmented_map, map_resolution, room_lower_limit_semantic_, room_upper_limit_semantic_,
+			classifier_path, classifier_default_path, display_map);
+	}
+	else if (room_segmentation_algorithm_ == 5)
+	{
+		VoronoiRandomFieldSegmentation vrf_segmentation; //voronoi random field segmentation method
+		vrf_segmentation.setVoronoiGraphGenerator(voronoi_graph_generator_);
+		vrf_segmentation.setInferenceMethod(voronoi_random_field_inference_method_);
+		const std::string package_path = ros::package::getPath("ipa_room_segmentation");
+		std::string classifier_default_path = package_path + "/common/files/classifier_models/";
+		std::string classifier_storage_path = "room_segmentation/classifier_models/";
+		// vector that stores the possible labels that are drawn in the training maps. Order: room - hallway - doorway
+		std::vector<uint> possible_labels(3);
+		possible_labels[0] = 77;
+		possible_labels[1] = 115;
+		possible_labels[2] = 179;
+		vrf_segmentation.segmentMap(map, segmented_map, voronoi_random_field_epsilon_for_neighborhood_, max_iterations_,
+				min_neighborhood_size_, possible_labels, min_voronoi_random_field_node_distance_,
+				display_map, classifier_storage_path, classifier_default_path, max_voronoi_random_field_inference_iterations_,
+				map_resolution, room_lower_limit_voronoi_random_, room_upper_limit_voronoi_random_, max_area_for_merging_, &doorway_points);
+	}
+	else
+		return false;
+	return true;
+}
+
+void RoomSegmentationServer::segmentTile(const cv::Mat& tile_map, cv::Mat& tile_segmented_map, const cv::Point& tile_offset, const float map_resolution)
+{
+	// the tiles may be segmented in parallel, hence no display and the doorway points are collected separately
+	std::vector<cv::Point> tile_doorway_points;
+	segmentMapWithSelectedAlgorithm(tile_map, tile_segmented_map, map_resolution, false, tile_doorway_points);
+#pragma omp critical (doorway_points)
+	for (size_t i = 0; i < tile_doorway_points.size(); ++i)
+		doorway_points_.push_back(tile_doorway_points[i] + tile_offset);
+}
+
 void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs::MapSegmentationGoalConstPtr &goal)
 {
 	ros::Rate looping_rate(1);
@@ -418,53 +504,27 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 
 	//segment the given map
 	cv::Mat segmented_map;
-	if (room_segmentation_algorithm_ == 1)
-	{
-		MorphologicalSegmentation morphological_segmentation; //morphological segmentation method
-		morphological_segmentation.segmentMap(original_img, segmented_map, map_resolution, room_lower_limit_morphological_, room_upper_limit_morphological_);
-	}
-	else if (room_segmentation_algorithm_ == 2)
-	{
-		DistanceSegmentation distance_segmentation; //distance segmentation method
-		distance_segmentation.segmentMap(original_img, segmented_map, map_resolution, room_lower_limit_distance_, room_upper_limit_distance_);
-	}
-	else if (room_segmentation_algorithm_ == 3)
+	if (room_segmentation_algorithm_ < 1 || room_segmentation_algorithm_ > 5)
 	{
-		VoronoiSegmentation voronoi_segmentation; //voronoi segmentation method
-		voronoi_segmentation.segmentMap(original_img, segmented_map, map_resolution, room_lower_limit_voronoi_, room_upper_limit_voronoi_,
-			voronoi_neighborhood_index_, max_iterations_, min_critical_point_distance_factor_, max_area_for_merging_, display_segmented_map_);
+		ROS_ERROR("Undefined algorithm selected.");
+		return;
 	}
-	else if (room_segmentation_algorithm_ == 4)
+	doorway_points_.clear();
+	const int tile_size = (int)(tile_size_ / map_resolution);
+	if (tile_size > 0 && (tile_size < original_img.cols || tile_size < original_img.rows))
 	{
-		AdaboostClassifier semantic_segmentation; //semantic segmentation method
-		const std::string package_path = ros::package::getPath("ipa_room_segmentation");
-		const std::string classifier_default_path = package_path + "/common/files/classifier_models/";
-		const std::string classifier_path = "room_segmentation/classifier_models/";
-		semantic_segmentation.segmentMap(original_img, segmented_map, map_resolution, room_lower_limit_semantic_, room_upper_limit_semantic_,
-			classifier_path, classifier_default_path, display_segmented_map_);
-	}
-	else if (room_segmentation_algorithm_ == 5)
-	{
-		VoronoiRandomFieldSegmentation vrf_segmentation; //voronoi random field segmentation method
-		const std::string package_path = ros::package::getPath("ipa_room_segmentation");
-		std::string classifier_default_path = package_path + "/common/files/classifier_models/";
-		std::string classifier_storage_path = "room_segmentation/classifier_models/";
-		// vector that stores the possible labels that are drawn in the training maps. Order: room - hallway - doorway
-		std::vector<uint> possible_labels(3);
-		possible_labels[0] = 77;
-		possible_labels[1] = 115;
-		possible_labels[2] = 179;
-		doorway_points_.clear();
-		vrf_segmentation.segmentMap(original_img, segmented_map, voronoi_random_field_epsilon_for_neighborhood_, max_iterations_,
-				min_neighborhood_size_, possible_labels, min_voronoi_random_field_node_distance_,
-				display_segmented_map_, classifier_storage_path, classifier_default_path, max_voronoi_random_field_inference_iterations_,
-				map_resolution, room_lower_limit_voronoi_random_, room_upper_limit_voronoi_random_, max_area_for_merging_, &doorway_points_);
+		// segment large maps tile by tile to bound the memory of the algorithms
+		const int tile_overlap = (int)(tile_overlap_ / map_resolution);
+		ROS_INFO("Segmenting the map in tiles of %d x %d cells with an overlap of %d cells.", tile_size, tile_size, tile_overlap);
+		// the semantic and the voronoi random field segmentations load (and possibly copy) their classifier files on every call,
+		// which must not happen concurrently, their tiles are segmented one after another and the algorithms parallelize internally
+		const bool parallel_tiles = (room_segmentation_algorithm_ != 4 && room_segmentation_algorithm_ != 5);
+		TiledSegmentation tiled_segmentation;
+		tiled_segmentation.segmentMap(original_img, segmented_map, tile_size, tile_overlap,
+				boost::bind(&RoomSegmentationServer::segmentTile, this, _1, _2, _3, map_resolution), 0.5, parallel_tiles);
 	}
 	else
-	{
-		ROS_ERROR("Undefined algorithm selected.");
-		return;
-	}
+		segmentMapWithSelectedAlgorithm(original_img, segmented_map, map_resolution, display_segmented_map_, doorway_points_);
 
 	ROS_INFO("********Segmented the map************");
 //	looping_rate.sleep();
@@ -472,48 +532,45 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 
 // get the min/max-values and the room-centers
 // compute room label codebook
+	// a single pass over the map assigns the vector positions and records the bounding box of each room
 	std::map<int, size_t> label_vector_index_codebook; // maps each room label to a position in the rooms vector
-	size_t vector_index = 0;
-	for (int v = 0; v < segmented_map.rows; ++v)
+	//min/max y/x-values vector for each room. Initialized with extreme values
+	std::vector<int> min_x_value_of_the_room, max_x_value_of_the_room, min_y_value_of_the_room, max_y_value_of_the_room;
+	int last_label = -1;
+	size_t last_index = 0;
+	for (int y = 0; y < segmented_map.rows; ++y)
 	{
-		for (int u = 0; u < segmented_map.cols; ++u)
+		const int* segmented_map_ptr = segmented_map.ptr<int>(y);
+		for (int x = 0; x < segmented_map.cols; ++x)
 		{
-			const int label = segmented_map.at<int>(v, u);
-			if (label > 0 && label < 65280) // do not count walls/obstacles or free space as label
+			const int label = segmented_map_ptr[x];
+			if (label > 0 && label < 65280) //if Pixel is white or black it is no room --> doesn't need to be checked
 			{
-				if (label_vector_index_codebook.find(label) == label_vector_index_codebook.end())
+				// neighboring pixels mostly share the label, so the codebook lookup is only done when the label changes
+				if (label != last_label)
 				{
-					label_vector_index_codebook[label] = vector_index;
-					vector_index++;
+					std::map<int, size_t>::iterator it = label_vector_index_codebook.find(label);
+					if (it == label_vector_index_codebook.end())
+					{
+						it = label_vector_index_codebook.insert(std::pair<int, size_t>(label, min_x_value_of_the_room.size())).first;
+						min_x_value_of_the_room.push_back(100000000);
+						max_x_value_of_the_room.push_back(0);
+						min_y_value_of_the_room.push_back(100000000);
+						max_y_value_of_the_room.push_back(0);
+					}
+					last_label = label;
+					last_index = it->second;
 				}
+				min_x_value_of_the_room[last_index] = std::min(x, min_x_value_of_the_room[last_index]);
+				max_x_value_of_the_room[last_index] = std::max(x, max_x_value_of_the_room[last_index]);
+				max_y_value_of_the_room[last_index] = std::max(y, max_y_value_of_the_room[last_index]);
+				min_y_value_of_the_room[last_index] = std::min(y, min_y_value_of_the_room[last_index]);
 			}
 		}
 	}
-	//min/max y/x-values vector for each room. Initialized with extreme values
-	std::vector<int> min_x_value_of_the_room(label_vector_index_codebook.size(), 100000000);
-	std::vector<int> max_x_value_of_the_room(label_vector_index_codebook.size(), 0);
-	std::vector<int> min_y_value_of_the_room(label_vector_index_codebook.size(), 100000000);
-	std::vector<int> max_y_value_of_the_room(label_vector_index_codebook.size(), 0);
 	//vector of the central Point for each room, initially filled with Points out of the map
 	std::vector<int> room_centers_x_values(label_vector_index_codebook.size(), -1);
 	std::vector<int> room_centers_y_values(label_vector_index_codebook.size(), -1);
-	//***********************Find min/max x and y coordinate and center of each found room********************
-	//check y/x-value for every Pixel and make the larger/smaller value to the current value of the room
-	for (int y = 0; y < segmented_map.rows; ++y)
-	{
-		for (int x = 0; x < segmented_map.cols; ++x)
-		{
-			const int label = segmented_map.at<int>(y, x);
-			if (label > 0 && label < 65280) //if Pixel is white or black it is no room --> doesn't need to be checked
-			{
-				const int index = label_vector_index_codebook[label];
-				min_x_value_of_the_room[index] = std::min(x, min_x_value_of_the_room[index]);
-				max_x_value_of_the_room[index] = std::max(x, max_x_value_of_the_room[index]);
-				max_y_value_of_the_room[index] = std::max(y, max_y_value_of_the_room[index]);
-				min_y_value_of_the_room[index] = std::min(y, min_y_value_of_the_room[index]);
-			}
-		}
-	}
 	//get centers for each room
 //	for (size_t idx = 0; idx < room_centers_x_values.size(); ++idx)
 //	{
@@ -578,9 +635,21 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 			}
 		}
 	}
-	MeanShift2D ms;
-	for (std::map<int, size_t>::iterator it = label_vector_index_codebook.begin(); it != label_vector_index_codebook.end(); ++it)
+	// the rooms are processed in parallel, each on the region of interest given by its bounding box
+	// the region of interest is enlarged by a border of 2 obstacle cells, which keeps the 5x5 distance transform identical to the one on the whole map
+	std::vector<std::pair<int, size_t> > rooms(label_vector_index_codebook.begin(), label_vector_index_codebook.end());
+#pragma omp parallel for schedule(dynamic)
+	for (int r = 0; r < (int)rooms.size(); ++r)
 	{
+		MeanShift2D ms;
+		const int label = rooms[r].first;
+		const size_t index = rooms[r].second;
+		const int roi_min_x = std::max(0, min_x_value_of_the_room[index]-2);
+		const int roi_max_x = std::min(segmented_map_copy.cols-1, max_x_value_of_the_room[index]+2);
+		const int roi_min_y = std::max(0, min_y_value_of_the_room[index]-2);
+		const int roi_max_y = std::min(segmented_map_copy.rows-1, max_y_value_of_the_room[index]+2);
+		const cv::Point roi_offset(roi_min_x, roi_min_y);
+
 		int trial = 1; 	// use robot_radius to avoid room centers that are not accessible by a robot with a given radius
 		if (goal->robot_radius <= 0.)
 			trial = 2;
@@ -588,16 +657,20 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 		for (; trial <= 2; ++trial)
 		{
 			// compute distance transform for each room
-			const int label = it->first;
 			int number_room_pixels = 0;
-			cv::Mat room = cv::Mat::zeros(segmented_map_copy.rows, segmented_map_copy.cols, CV_8UC1);
-			for (int v = 0; v < segmented_map_copy.rows; ++v)
-				for (int u = 0; u < segmented_map_copy.cols; ++u)
-					if (segmented_map_copy.at<int>(v, u) == label && (trial==2 || connection_to_other_rooms.at<uchar>(v,u)==255))
+			cv::Mat room = cv::Mat::zeros(roi_max_y-roi_min_y+1, roi_max_x-roi_min_x+1, CV_8UC1);
+			for (int v = 0; v < room.rows; ++v)
+			{
+				const int* segmented_map_ptr = segmented_map_copy.ptr<int>(v+roi_min_y);
+				const uchar* connection_ptr = connection_to_other_rooms.ptr<uchar>(v+roi_min_y);
+				uchar* room_ptr = room.ptr<uchar>(v);
+				for (int u = 0; u < room.cols; ++u)
+					if (segmented_map_ptr[u+roi_min_x] == label && (trial==2 || connection_ptr[u+roi_min_x]==255))
 					{
-						room.at<uchar>(v, u) = 255;
+						room_ptr[u] = 255;
 						++number_room_pixels;
 					}
+			}
 			if (number_room_pixels == 0)
 				continue;
 			cv::Mat distance_map; //variable for the distance-transformed map, type: CV_32FC1
@@ -609,12 +682,11 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 			for (int v = 0; v < distance_map.rows; ++v)
 				for (int u = 0; u < distance_map.cols; ++u)
 					if (distance_map.at<float>(v, u) > max_val * 0.95f)
-						room_cells.push_back(cv::Vec2d(u, v));
+						room_cells.push_back(cv::Vec2d(u+roi_min_x, v+roi_min_y));
 			if (room_cells.size()==0)
 				continue;
 			// use meanshift to find the modes in that set
-			cv::Vec2d room_center = ms.findRoomCenter(room, room_cells, map_resolution);
-			const int index = it->second;
+			cv::Vec2d room_center = ms.findRoomCenter(room, room_cells, map_resolution, roi_offset);
 			room_centers_x_values[index] = room_center[0];
 			room_centers_y_values[index] = room_center[1];
 
@@ -669,6 +741,14 @@ void RoomSegmentationServer::execute_segmentation_server(const ipa_building_msgs
 	action_result.map_resolution = goal->map_resolution;
 	action_result.map_origin = goal->map_origin;
 
+	// compact per-room description (runs, bounding box, area, center in pixels) so that clients do not need to rescan the segmented map
+	encodeRoomRegions(indexed_map, (int)room_centers_x_values.size(), action_result.room_regions);
+	for (size_t i=0; i<action_result.room_regions.size(); ++i)
+	{
+		action_result.room_regions[i].room_center.x = room_centers_x_values[i];
+		action_result.room_regions[i].room_center.y = room_centers_y_values[i];
+	}
+
 	//setting massages in pixel value
 	action_result.room_information_in_pixel.clear();
 	if (goal->return_format_in_pixel == true)
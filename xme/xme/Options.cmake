@@ -53,7 +53,9 @@ xme_build_option(XME_HAL_DEFINES_MAX_RESOURCEMANAGER_LOCAL_RESPONSE_INSTANCE_ITE
 xme_build_option(XME_HAL_DEFINES_MAX_SOCKETS 5 "xme/xme_opt.h" "Description missing")
 
 xme_build_option(XME_HAL_DEFINES_MAX_TASK_DESCRIPTORS 8 "xme/xme_opt.h" "Description missing")
-xme_build_option(XME_HAL_DEFINES_MAX_CRITICAL_SECTION_DESCRIPTORS 5 "xme/xme_opt.h" "Description missing")
+xme_build_option(XME_HAL_DEFINES_MAX_CRITICAL_SECTION_DESCRIPTORS 5 "xme/xme_opt.h" "Maximum number of critical sections on platforms with a fixed descriptor table; on POSIX the number of critical section descriptors allocated at once (one page)")
+xme_build_option(XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES 256 "xme/xme_opt.h" "Maximum number of critical section descriptor pages on POSIX; at most XME_HAL_DEFINES_MAX_CRITICAL_SECTION_DESCRIPTORS times this value critical sections can exist at the same time")
+xme_build_option(XME_HAL_SYNC_SPIN_COUNT 0 "xme/xme_opt.h" "Number of times entering an occupied critical section is retried by spinning before the calling thread blocks; 0 blocks immediately")
 xme_build_option(XME_HAL_DEFINES_MAX_TLS_ITEMS 5 "xme/xme_opt.h" "Description missing")
 
 # Option used by xme/prim components
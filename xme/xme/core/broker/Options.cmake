@@ -16,6 +16,7 @@
 #
 
 xme_build_option(XME_CORE_BROKER_TRANSFERTABLE_SIZE 512 "xme/xme_opt.h" "Used for declaring the size of the transfer table.")
+xme_build_option(XME_CORE_BROKER_TRANSFERINDEX_SIZE 64 "xme/xme_opt.h" "defines the number of buckets of the transfer table indices by source and destination data packet.")
 xme_build_option(XME_CORE_BROKER_MAX_DATAPACKET_ITEMS 20 "xme/xme_opt.h" "defines the maximum number data packets that can be registered in the broker.")
 xme_build_option(XME_CORE_BROKER_MAX_SUBSCRIBER_FUNCTIONS 25 "xme/xme_opt.h" "defines the maximum number of functions associated to a given data packet.")
 xme_build_option(XME_CORE_BROKER_MAX_FUNCTION_DATA_ITEMS 30 "xme/xme_opt.h" "defines the maximum number of functions registered in the broker.")
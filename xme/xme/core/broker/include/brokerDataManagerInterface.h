@@ -89,6 +89,57 @@ xme_core_broker_isFunctionReady
     const xme_core_component_functionVariantId_t functionVariantId
 );
 
+/**
+ * \brief Determines if two functions can execute at the same time without
+ *        depending on each other's data.
+ * \details Two functions depend on each other if any of their data packets
+ *          (of any function variant) is used by both of them, or if a transfer
+ *          entry connects a data packet of one function with a data packet of
+ *          the other one, in either direction. Functions that are not
+ *          registered in the broker do not use any data packets.
+ *
+ * \param componentId1 the component identifier of the first function.
+ * \param functionId1 the function identifier of the first function.
+ * \param componentId2 the component identifier of the second function.
+ * \param functionId2 the function identifier of the second function.
+ *
+ * \retval true if the functions do not exchange any data.
+ * \retval false if the functions exchange data.
+ */
+bool
+xme_core_broker_areFunctionsIndependent
+(
+    xme_core_component_t componentId1,
+    xme_core_component_functionId_t functionId1,
+    xme_core_component_t componentId2,
+    xme_core_component_functionId_t functionId2
+);
+
+/**
+ * \brief Returns the destination data packets of the transfer entries
+ *        of a source data packet.
+ *
+ * \details These are the data packets the broker writes to when the data
+ *          availability of the source data packet is raised. At most
+ *          maxCount of them are stored, but all of them are counted.
+ *
+ * \param srcDataPacketId the source data packet identifier.
+ * \param destDataPacketIds array receiving the destination data packet
+ *        identifiers. May be NULL if maxCount is zero.
+ * \param maxCount the number of elements in destDataPacketIds.
+ *
+ * \return the number of transfer entries with the given source data packet.
+ *          If it exceeds maxCount, only the first maxCount destinations
+ *          have been stored.
+ */
+uint16_t
+xme_core_broker_getTransferDestinations
+(
+    xme_core_dataManager_dataPacketId_t srcDataPacketId,
+    xme_core_dataManager_dataPacketId_t* destDataPacketIds,
+    uint16_t maxCount
+);
+
 XME_EXTERN_C_END
 
 /**
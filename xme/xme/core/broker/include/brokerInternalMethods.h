@@ -91,6 +91,8 @@ xme_core_broker_updateDataReadiness
  *
  * \details If and only if data packet is included in the transfer list as source
  *          data packet, this means that the data packet is an output data packet.
+ *          This holds even if the data packet is the destination of another
+ *          transfer entry, regardless of the order the entries were added in.
  *
  * \param dataPacketId the data packet identifier
  *
@@ -137,6 +139,24 @@ xme_core_broker_isSourceDataPacketLocked
     xme_core_dataManager_dataPacketId_t dataPacketId
 );
 
+/**
+ * \brief Looks up the transfer entry between two data packets.
+ *
+ * \details Only the bucket of the source data packet in the source index
+ *          is searched.
+ *
+ * \param srcDataPacketId the source data packet identifier.
+ * \param dstDataPacketId the destination data packet identifier.
+ *
+ * \return the transfer entry, or NULL if no such entry exists.
+ */
+xme_core_broker_transferDataPacketItem_t*
+xme_core_broker_findTransferEntry
+(
+    xme_core_dataManager_dataPacketId_t srcDataPacketId,
+    xme_core_dataManager_dataPacketId_t dstDataPacketId
+);
+
 /**
  * \brief Unlocks a source data packed.
  * \details A source data packet is locked during the complete write operation. 
@@ -44,12 +44,14 @@
  * \struct xme_core_broker_transferDataPacketItem_t
  * \brief the structure for relating output data packets and input data packets.
  */
-typedef struct
+typedef struct xme_core_broker_transferDataPacketItem_s
 {
     xme_core_dataManager_dataPacketId_t srcDataPacketId; ///< source data packet.
     xme_core_dataManager_dataPacketId_t destDataPacketId; ///< destination data packet.
     uint16_t referenceCount; ///< total reference count for this source and destination DataPackeIds
     bool srcLocked; ///< the source data packet is locked during a complete write operation. 
+    struct xme_core_broker_transferDataPacketItem_s* nextBySource; ///< next entry in the same bucket of the source index.
+    struct xme_core_broker_transferDataPacketItem_s* nextByDestination; ///< next entry in the same bucket of the destination index.
 } 
 xme_core_broker_transferDataPacketItem_t;
 
@@ -140,9 +142,22 @@ typedef XME_HAL_TABLE
 );
 
 /**
- * \brief transfer relationships linked list. 
+ * \brief transfer relationships hashed by data packet identifier.
+ *
+ * \details Each bucket is the head of a chain of transfer entries whose
+ *          (source or destination) data packet maps to that bucket, linked
+ *          through the nextBySource or nextByDestination members. Entries
+ *          of the same data packet keep the order in which they were added.
+ */
+typedef xme_core_broker_transferDataPacketItem_t* transferDataPacketIndex_t[XME_CORE_BROKER_TRANSFERINDEX_SIZE];
+
+/**
+ * \def XME_CORE_BROKER_TRANSFERINDEX_BUCKET
+ *
+ * \brief Returns the bucket of the given data packet in a transferDataPacketIndex_t.
  */
-typedef xme_hal_singlyLinkedList_t(XME_CORE_BROKER_TRANSFERTABLE_SIZE) transferDataPacketTable_t;
+#define XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dataPacketId) \
+    ((uint16_t)(((uint32_t)(dataPacketId)) % ((uint32_t)XME_CORE_BROKER_TRANSFERINDEX_SIZE)))
 
 #endif // #ifndef XME_CORE_BROKER_BROKERINTERNALTYPES_H
 
@@ -54,11 +54,26 @@ xme_core_broker_functionDescriptionTable_t functionDescriptions;
 xme_core_broker_dataSubscriberTable_t dataPacketSubscribers;
 
 /**
- * \var transferDataPacketTable
+ * \var transferDataPacketSourceIndex
  * 
- * \brief Establish relationships between source and destination data packets for transfer function. 
+ * \brief Establish relationships between source and destination data packets for transfer function,
+ *        hashed by source data packet.
  */
-transferDataPacketTable_t transferDataPacketTable;
+transferDataPacketIndex_t transferDataPacketSourceIndex;
+
+/**
+ * \var transferDataPacketDestinationIndex
+ * 
+ * \brief The same transfer entries as transferDataPacketSourceIndex, hashed by destination data packet.
+ */
+transferDataPacketIndex_t transferDataPacketDestinationIndex;
+
+/**
+ * \var transferDataPacketCount
+ * 
+ * \brief Number of entries in the transfer indices.
+ */
+static uint16_t transferDataPacketCount;
 
 /**
  * \var xme_core_transferDataCallback
@@ -80,7 +95,9 @@ xme_core_broker_init (void* params)
 
     xme_core_transferDataCallback = NULL;
 
-    XME_HAL_SINGLYLINKEDLIST_INIT(transferDataPacketTable);
+    (void) xme_hal_mem_set(transferDataPacketSourceIndex, 0, sizeof(transferDataPacketSourceIndex));
+    (void) xme_hal_mem_set(transferDataPacketDestinationIndex, 0, sizeof(transferDataPacketDestinationIndex));
+    transferDataPacketCount = 0U;
 
     return XME_STATUS_SUCCESS;
 }
@@ -88,8 +105,22 @@ xme_core_broker_init (void* params)
 void
 xme_core_broker_fini (void)
 {
-    xme_hal_singlyLinkedList_fini(&transferDataPacketTable);
-    
+    uint16_t bucket;
+
+    // Every entry is chained exactly once in the source index
+    for (bucket = 0U; bucket < XME_CORE_BROKER_TRANSFERINDEX_SIZE; bucket++)
+    {
+        while (NULL != transferDataPacketSourceIndex[bucket])
+        {
+            xme_core_broker_transferDataPacketItem_t* transferDataPacketItem = transferDataPacketSourceIndex[bucket];
+
+            transferDataPacketSourceIndex[bucket] = transferDataPacketItem->nextBySource;
+            xme_hal_mem_free(transferDataPacketItem);
+        }
+        transferDataPacketDestinationIndex[bucket] = NULL;
+    }
+    transferDataPacketCount = 0U;
+
     XME_HAL_TABLE_ITERATE_BEGIN(
         dataPacketSubscribers,
         xme_hal_table_rowHandle_t,
@@ -125,35 +156,48 @@ xme_core_broker_addDataPacketTransferEntry
 )
 {
     xme_core_broker_transferDataPacketItem_t* newTransferDataPacketItem;
+    xme_core_broker_transferDataPacketItem_t** link;
 
     XME_CHECK(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != srcDataPacketId, XME_STATUS_INVALID_PARAMETER);
     XME_CHECK(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != dstDataPacketId, XME_STATUS_INVALID_PARAMETER);
 
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-        transferDataPacketTable, 
-        xme_core_broker_transferDataPacketItem_t, 
-        transferDataPacketItem);
+    newTransferDataPacketItem = xme_core_broker_findTransferEntry(srcDataPacketId, dstDataPacketId);
+    if (NULL != newTransferDataPacketItem)
     {
-        if (transferDataPacketItem->srcDataPacketId == srcDataPacketId && 
-            transferDataPacketItem->destDataPacketId == dstDataPacketId)
-        {
-            transferDataPacketItem->referenceCount++;
-            return XME_STATUS_SUCCESS;
-        }
+        newTransferDataPacketItem->referenceCount++;
+        return XME_STATUS_SUCCESS;
     }
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
 
+    XME_CHECK(transferDataPacketCount < XME_CORE_BROKER_TRANSFERTABLE_SIZE, XME_STATUS_OUT_OF_RESOURCES);
+
+    newTransferDataPacketItem = (xme_core_broker_transferDataPacketItem_t*) xme_hal_mem_alloc (sizeof(xme_core_broker_transferDataPacketItem_t));
+
+    XME_CHECK(NULL != newTransferDataPacketItem, XME_STATUS_OUT_OF_RESOURCES);
+    newTransferDataPacketItem->srcDataPacketId = srcDataPacketId;
+    newTransferDataPacketItem->destDataPacketId = dstDataPacketId;
+    newTransferDataPacketItem->referenceCount = 1;
+    newTransferDataPacketItem->srcLocked = false;
+    newTransferDataPacketItem->nextBySource = NULL;
+    newTransferDataPacketItem->nextByDestination = NULL;
+
+    // Append to the end of both chains to keep the order of addition
+    link = &transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(srcDataPacketId)];
+    while (NULL != *link)
+    {
+        link = &(*link)->nextBySource;
+    }
+    *link = newTransferDataPacketItem;
+
+    link = &transferDataPacketDestinationIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dstDataPacketId)];
+    while (NULL != *link)
     {
-        newTransferDataPacketItem = (xme_core_broker_transferDataPacketItem_t*) xme_hal_mem_alloc (sizeof(xme_core_broker_transferDataPacketItem_t));
-        
-        XME_CHECK(NULL != newTransferDataPacketItem, XME_STATUS_OUT_OF_RESOURCES);
-        newTransferDataPacketItem->srcDataPacketId = srcDataPacketId;
-        newTransferDataPacketItem->destDataPacketId = dstDataPacketId;
-        newTransferDataPacketItem->referenceCount = 1;
-        newTransferDataPacketItem->srcLocked = false;
-
-        return xme_hal_singlyLinkedList_addItem(&transferDataPacketTable, newTransferDataPacketItem);
+        link = &(*link)->nextByDestination;
     }
+    *link = newTransferDataPacketItem;
+
+    transferDataPacketCount++;
+
+    return XME_STATUS_SUCCESS;
 }
 
 xme_status_t
@@ -163,31 +207,41 @@ xme_core_broker_removeDataPacketTransferEntry
     xme_core_dataManager_dataPacketId_t dstDataPacketId
 )
 {
+    xme_core_broker_transferDataPacketItem_t* transferDataPacketItem;
+    xme_core_broker_transferDataPacketItem_t** link;
+
     XME_CHECK(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != srcDataPacketId, XME_STATUS_INVALID_PARAMETER);
     XME_CHECK(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != dstDataPacketId, XME_STATUS_INVALID_PARAMETER);
 
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-        transferDataPacketTable, 
-        xme_core_broker_transferDataPacketItem_t, 
-        transferDataPacketItem);
+    transferDataPacketItem = xme_core_broker_findTransferEntry(srcDataPacketId, dstDataPacketId);
+    XME_CHECK(NULL != transferDataPacketItem, XME_STATUS_NOT_FOUND);
+
+    if (1 < transferDataPacketItem->referenceCount)
     {
-        if (transferDataPacketItem->srcDataPacketId == srcDataPacketId && 
-            transferDataPacketItem->destDataPacketId == dstDataPacketId)
-        {
-            if (1 == transferDataPacketItem->referenceCount)
-            {
-                XME_CHECK(0 < xme_hal_singlyLinkedList_removeItem(&transferDataPacketTable, transferDataPacketItem, (bool)false), XME_STATUS_INTERNAL_ERROR);
-            }
-            else
-            {
-                transferDataPacketItem->referenceCount--;
-            }
-            return XME_STATUS_SUCCESS;
-        }
+        transferDataPacketItem->referenceCount--;
+        return XME_STATUS_SUCCESS;
     }
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
 
-    return XME_STATUS_NOT_FOUND;
+    link = &transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(srcDataPacketId)];
+    while (transferDataPacketItem != *link)
+    {
+        XME_CHECK(NULL != *link, XME_STATUS_INTERNAL_ERROR);
+        link = &(*link)->nextBySource;
+    }
+    *link = transferDataPacketItem->nextBySource;
+
+    link = &transferDataPacketDestinationIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dstDataPacketId)];
+    while (transferDataPacketItem != *link)
+    {
+        XME_CHECK(NULL != *link, XME_STATUS_INTERNAL_ERROR);
+        link = &(*link)->nextByDestination;
+    }
+    *link = transferDataPacketItem->nextByDestination;
+
+    xme_hal_mem_free(transferDataPacketItem);
+    transferDataPacketCount--;
+
+    return XME_STATUS_SUCCESS;
 }
 
 uint16_t
@@ -197,6 +251,9 @@ xme_core_broker_dataPacketTransferEntryCount
     xme_core_dataManager_dataPacketId_t dstDataPacketId
 )
 {
+    xme_core_broker_transferDataPacketItem_t* transferDataPacketItem;
+    uint16_t totalCount = 0;
+
     if (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID == srcDataPacketId &&
            XME_CORE_DATAMANAGER_DATAPACKETID_INVALID == dstDataPacketId)
     {
@@ -205,50 +262,33 @@ xme_core_broker_dataPacketTransferEntryCount
     else if (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != srcDataPacketId &&
                  XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != dstDataPacketId)
     {
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-            transferDataPacketTable, 
-            xme_core_broker_transferDataPacketItem_t, 
-            transferDataPacketItem);
-        {
-            if (transferDataPacketItem->srcDataPacketId == srcDataPacketId && 
-                    transferDataPacketItem->destDataPacketId == dstDataPacketId)
-            {
-                return transferDataPacketItem->referenceCount;
-            }
-        }
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
-        return 0;
+        transferDataPacketItem = xme_core_broker_findTransferEntry(srcDataPacketId, dstDataPacketId);
+        return (NULL == transferDataPacketItem) ? 0 : transferDataPacketItem->referenceCount;
     }
     else if (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != srcDataPacketId)
     {
-        uint16_t totalCount = 0;
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-            transferDataPacketTable, 
-            xme_core_broker_transferDataPacketItem_t, 
-            transferDataPacketItem);
+        for (transferDataPacketItem = transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(srcDataPacketId)];
+             NULL != transferDataPacketItem;
+             transferDataPacketItem = transferDataPacketItem->nextBySource)
         {
             if (transferDataPacketItem->srcDataPacketId == srcDataPacketId)
             {
                 totalCount += transferDataPacketItem->referenceCount;
             }
         }
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
         return totalCount;
     }
     else
     {
-        uint16_t totalCount = 0;
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-            transferDataPacketTable, 
-            xme_core_broker_transferDataPacketItem_t, 
-            transferDataPacketItem);
+        for (transferDataPacketItem = transferDataPacketDestinationIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dstDataPacketId)];
+             NULL != transferDataPacketItem;
+             transferDataPacketItem = transferDataPacketItem->nextByDestination)
         {
             if (transferDataPacketItem->destDataPacketId == dstDataPacketId)
             {
                 totalCount += transferDataPacketItem->referenceCount;
             }
         }
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
         return totalCount;
     }
 }
@@ -406,27 +446,46 @@ xme_core_broker_updateDataReadiness
     return XME_STATUS_SUCCESS;
 }
 
+xme_core_broker_transferDataPacketItem_t*
+xme_core_broker_findTransferEntry
+(
+    xme_core_dataManager_dataPacketId_t srcDataPacketId,
+    xme_core_dataManager_dataPacketId_t dstDataPacketId
+)
+{
+    xme_core_broker_transferDataPacketItem_t* transferDataPacketItem;
+
+    for (transferDataPacketItem = transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(srcDataPacketId)];
+         NULL != transferDataPacketItem;
+         transferDataPacketItem = transferDataPacketItem->nextBySource)
+    {
+        if (transferDataPacketItem->srcDataPacketId == srcDataPacketId && 
+            transferDataPacketItem->destDataPacketId == dstDataPacketId)
+        {
+            return transferDataPacketItem;
+        }
+    }
+
+    return NULL;
+}
+
 bool
 xme_core_broker_isOutputDataPacket
 (
     xme_core_dataManager_dataPacketId_t dataPacketId
 )
 {
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-        transferDataPacketTable, 
-        xme_core_broker_transferDataPacketItem_t, 
-        transferDataPacketItem);
+    xme_core_broker_transferDataPacketItem_t* transferDataPacketItem;
+
+    for (transferDataPacketItem = transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dataPacketId)];
+         NULL != transferDataPacketItem;
+         transferDataPacketItem = transferDataPacketItem->nextBySource)
     {
-        if(transferDataPacketItem->srcDataPacketId == dataPacketId)
+        if (transferDataPacketItem->srcDataPacketId == dataPacketId)
         {
             return true;
         }
-        else if (transferDataPacketItem->destDataPacketId == dataPacketId)
-        {
-            return false;
-        }
     }
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
 
     return false;
 }
@@ -437,17 +496,17 @@ xme_core_broker_isInputDataPacket
     xme_core_dataManager_dataPacketId_t dataPacketId
 )
 {
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-        transferDataPacketTable, 
-        xme_core_broker_transferDataPacketItem_t, 
-        transferDataPacketItem);
+    xme_core_broker_transferDataPacketItem_t* transferDataPacketItem;
+
+    for (transferDataPacketItem = transferDataPacketDestinationIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dataPacketId)];
+         NULL != transferDataPacketItem;
+         transferDataPacketItem = transferDataPacketItem->nextByDestination)
     {
-        if(transferDataPacketItem->destDataPacketId == dataPacketId)
+        if (transferDataPacketItem->destDataPacketId == dataPacketId)
         {
             return true;
         }
     }
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
 
     // we perform an additional check: if data packet is
     // registered as input parameter for a function,
@@ -466,17 +525,17 @@ xme_core_broker_isSourceDataPacketLocked
     xme_core_dataManager_dataPacketId_t dataPacketId
 )
 {
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-        transferDataPacketTable, 
-        xme_core_broker_transferDataPacketItem_t, 
-        transferDataPacketItem);
+    xme_core_broker_transferDataPacketItem_t* transferDataPacketItem;
+
+    for (transferDataPacketItem = transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dataPacketId)];
+         NULL != transferDataPacketItem;
+         transferDataPacketItem = transferDataPacketItem->nextBySource)
     {
-        if(transferDataPacketItem->srcDataPacketId == dataPacketId)
+        if (transferDataPacketItem->srcDataPacketId == dataPacketId)
         {
             return transferDataPacketItem->srcLocked;
         }
     }
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
 
     return false;
 }
@@ -487,17 +546,17 @@ xme_core_broker_unlockSourceDataPacket
     xme_core_dataManager_dataPacketId_t dataPacketId
 )
 {
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-        transferDataPacketTable, 
-        xme_core_broker_transferDataPacketItem_t, 
-        transferDataPacketItem);
+    xme_core_broker_transferDataPacketItem_t* transferDataPacketItem;
+
+    for (transferDataPacketItem = transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dataPacketId)];
+         NULL != transferDataPacketItem;
+         transferDataPacketItem = transferDataPacketItem->nextBySource)
     {
-        if(transferDataPacketItem->srcDataPacketId == dataPacketId)
+        if (transferDataPacketItem->srcDataPacketId == dataPacketId)
         {
             transferDataPacketItem->srcLocked = false;
         }
     }
-    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
 
     return XME_STATUS_SUCCESS;
 }
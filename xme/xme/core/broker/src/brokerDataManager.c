@@ -44,12 +44,35 @@ xme_core_broker_functionDescriptionTable_t functionDescriptions;
 
 // Documented in brokerInternalTypes.h
 extern 
-transferDataPacketTable_t transferDataPacketTable;
+transferDataPacketIndex_t transferDataPacketSourceIndex;
 
 // Documented in brokerInternalTypes.h
 extern
 xme_core_transferDataCallback_t xme_core_transferDataCallback;
 
+/******************************************************************************/
+/***   Prototypes                                                           ***/
+/******************************************************************************/
+
+/**
+ * \brief Determines if a data packet is used by a function or connected to one
+ *        of its data packets by a transfer entry.
+ *
+ * \param dataPacketId the data packet identifier.
+ * \param componentId the component identifier of the function.
+ * \param functionId the function identifier of the function.
+ *
+ * \retval true if the function exchanges data with the data packet.
+ * \retval false otherwise.
+ */
+static bool
+isDataPacketExchangedWithFunction
+(
+    xme_core_dataManager_dataPacketId_t dataPacketId,
+    xme_core_component_t componentId,
+    xme_core_component_functionId_t functionId
+);
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
@@ -64,6 +87,7 @@ xme_core_broker_dataAvailabilityChange
     //check if output data packet is a member of the source data packets 
     //in the transfer data packet table. 
     xme_status_t status;
+    xme_core_broker_transferDataPacketItem_t* transferItem;
     bool found;
 
     XME_LOG(XME_LOG_DEBUG, "Broker: xme_core_broker_dataAvailabilityChange(%i, %i)\n", dataPacketId, size);
@@ -107,10 +131,9 @@ xme_core_broker_dataAvailabilityChange
         XME_LOG(XME_LOG_DEBUG, "Broker: xme_core_dataHandler_startReadOperation(%i)\n", dataPacketId);
         XME_CHECK(XME_STATUS_SUCCESS == xme_core_dataHandler_startReadOperation(dataPacketId), XME_STATUS_INTERNAL_ERROR);
 
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-            transferDataPacketTable, 
-            xme_core_broker_transferDataPacketItem_t, 
-            transferItem);
+        for (transferItem = transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dataPacketId)];
+             NULL != transferItem;
+             transferItem = transferItem->nextBySource)
         {
             if(transferItem->srcDataPacketId == dataPacketId)
             {
@@ -142,7 +165,6 @@ xme_core_broker_dataAvailabilityChange
                 transferItem->srcLocked = true;
             }
         }
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
 
         XME_LOG(XME_LOG_DEBUG, "Broker: xme_core_dataHandler_completeReadOperation(%i)\n", dataPacketId);
         status = xme_core_dataHandler_completeReadOperation(dataPacketId);
@@ -164,10 +186,9 @@ xme_core_broker_dataAvailabilityChange
     {
         // data is no longer available, so check all related input ports to deactivate them. 
         found = false;
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
-            transferDataPacketTable, 
-            xme_core_broker_transferDataPacketItem_t, 
-            transferItem);
+        for (transferItem = transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(dataPacketId)];
+             NULL != transferItem;
+             transferItem = transferItem->nextBySource)
         {
             // for each entry where the srcDataPacket appears, remove availability in all dst. 
             if(transferItem->srcDataPacketId == dataPacketId)
@@ -176,7 +197,6 @@ xme_core_broker_dataAvailabilityChange
                 found = true;
             }
         }
-        XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
             
         if (!found)
         {
@@ -240,6 +260,113 @@ xme_core_broker_isFunctionReady
     return XME_STATUS_NOT_FOUND;
 }
 
+bool
+xme_core_broker_areFunctionsIndependent
+(
+    xme_core_component_t componentId1,
+    xme_core_component_functionId_t functionId1,
+    xme_core_component_t componentId2,
+    xme_core_component_functionId_t functionId2
+)
+{
+    XME_HAL_TABLE_ITERATE_BEGIN(
+        functionDescriptions,
+        xme_hal_table_rowHandle_t,
+        handle,
+        xme_core_broker_functionDescriptionItem_t,
+        functionItem
+    );
+    {
+        if (functionItem->componentId == componentId1 &&
+            functionItem->functionId == functionId1)
+        {
+            XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
+                functionItem->parameters,
+                xme_core_broker_functionDataPacket_t,
+                functionParameter);
+            {
+                if (isDataPacketExchangedWithFunction(functionParameter->dataPacketId, componentId2, functionId2))
+                {
+                    return false;
+                }
+            }
+            XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
+        }
+    }
+    XME_HAL_TABLE_ITERATE_END();
+
+    return true;
+}
+
+static bool
+isDataPacketExchangedWithFunction
+(
+    xme_core_dataManager_dataPacketId_t dataPacketId,
+    xme_core_component_t componentId,
+    xme_core_component_functionId_t functionId
+)
+{
+    XME_HAL_TABLE_ITERATE_BEGIN(
+        functionDescriptions,
+        xme_hal_table_rowHandle_t,
+        handle,
+        xme_core_broker_functionDescriptionItem_t,
+        functionItem
+    );
+    {
+        if (functionItem->componentId == componentId &&
+            functionItem->functionId == functionId)
+        {
+            XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(
+                functionItem->parameters,
+                xme_core_broker_functionDataPacket_t,
+                functionParameter);
+            {
+                if (functionParameter->dataPacketId == dataPacketId ||
+                    NULL != xme_core_broker_findTransferEntry(dataPacketId, functionParameter->dataPacketId) ||
+                    NULL != xme_core_broker_findTransferEntry(functionParameter->dataPacketId, dataPacketId))
+                {
+                    return true;
+                }
+            }
+            XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
+        }
+    }
+    XME_HAL_TABLE_ITERATE_END();
+
+    return false;
+}
+
+uint16_t
+xme_core_broker_getTransferDestinations
+(
+    xme_core_dataManager_dataPacketId_t srcDataPacketId,
+    xme_core_dataManager_dataPacketId_t* destDataPacketIds,
+    uint16_t maxCount
+)
+{
+    xme_core_broker_transferDataPacketItem_t* transferItem;
+    uint16_t count = 0U;
+
+    XME_CHECK(NULL != destDataPacketIds || 0U == maxCount, 0U);
+
+    for (transferItem = transferDataPacketSourceIndex[XME_CORE_BROKER_TRANSFERINDEX_BUCKET(srcDataPacketId)];
+         NULL != transferItem;
+         transferItem = transferItem->nextBySource)
+    {
+        if (transferItem->srcDataPacketId == srcDataPacketId)
+        {
+            if (count < maxCount)
+            {
+                destDataPacketIds[count] = transferItem->destDataPacketId;
+            }
+            count++;
+        }
+    }
+
+    return count;
+}
+
 /**
  * @}
  */
@@ -27,6 +27,7 @@
 #include "xme/core/dataManagerTypes.h"
 #include "xme/core/broker/include/broker.h"
 #include "xme/core/broker/include/brokerDataManagerInterface.h"
+#include "xme/core/broker/include/brokerInternalMethods.h"
 #include "xme/core/broker/include/brokerPnpManagerInterface.h"
 
 #include "xme/hal/include/linkedList.h"
@@ -699,6 +700,67 @@ TEST_F(BrokerInterfaceTest, RemoveDataPacketTransferEntryUsingAddFunctionAndDoub
     ASSERT_EQ(XME_STATUS_NOT_FOUND, xme_core_broker_removeDataPacketTransferEntry(src, dst));
 }
 
+TEST_F(BrokerInterfaceTest, DataPacketTransferEntriesWithCollidingIndexBuckets)
+{
+    // Data packets that differ by the index size share the same bucket
+    xme_core_dataManager_dataPacketId_t src = (xme_core_dataManager_dataPacketId_t) 1u;
+    xme_core_dataManager_dataPacketId_t src2 = (xme_core_dataManager_dataPacketId_t) (1u + XME_CORE_BROKER_TRANSFERINDEX_SIZE);
+    xme_core_dataManager_dataPacketId_t dst = (xme_core_dataManager_dataPacketId_t) 2u;
+    xme_core_dataManager_dataPacketId_t dst2 = (xme_core_dataManager_dataPacketId_t) (2u + XME_CORE_BROKER_TRANSFERINDEX_SIZE);
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(src, dst));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(src2, dst2));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(src, dst2));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(src, dst2));
+
+    EXPECT_EQ(1u, xme_core_broker_dataPacketTransferEntryCount(src, dst));
+    EXPECT_EQ(0u, xme_core_broker_dataPacketTransferEntryCount(src2, dst));
+    EXPECT_EQ(2u, xme_core_broker_dataPacketTransferEntryCount(src, dst2));
+    EXPECT_EQ(3u, xme_core_broker_dataPacketTransferEntryCount(src, XME_CORE_DATAMANAGER_DATAPACKETID_INVALID));
+    EXPECT_EQ(1u, xme_core_broker_dataPacketTransferEntryCount(src2, XME_CORE_DATAMANAGER_DATAPACKETID_INVALID));
+    EXPECT_EQ(1u, xme_core_broker_dataPacketTransferEntryCount(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID, dst));
+    EXPECT_EQ(3u, xme_core_broker_dataPacketTransferEntryCount(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID, dst2));
+
+    // Remove the entry in the middle of both bucket chains
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_removeDataPacketTransferEntry(src2, dst2));
+    ASSERT_EQ(XME_STATUS_NOT_FOUND, xme_core_broker_removeDataPacketTransferEntry(src2, dst2));
+    EXPECT_EQ(0u, xme_core_broker_dataPacketTransferEntryCount(src2, XME_CORE_DATAMANAGER_DATAPACKETID_INVALID));
+    EXPECT_EQ(2u, xme_core_broker_dataPacketTransferEntryCount(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID, dst2));
+    EXPECT_EQ(XME_STATUS_NOT_FOUND, xme_core_broker_dataAvailabilityChange(src2, 0));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_broker_dataAvailabilityChange(src, 0));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_removeDataPacketTransferEntry(src, dst));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_removeDataPacketTransferEntry(src, dst2));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_removeDataPacketTransferEntry(src, dst2));
+    EXPECT_EQ(0u, xme_core_broker_dataPacketTransferEntryCount(src, XME_CORE_DATAMANAGER_DATAPACKETID_INVALID));
+    EXPECT_EQ(0u, xme_core_broker_dataPacketTransferEntryCount(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID, dst2));
+}
+
+TEST_F(BrokerInterfaceTest, IsOutputDataPacketWithChainedTransferEntries)
+{
+    xme_core_dataManager_dataPacketId_t first = (xme_core_dataManager_dataPacketId_t) 1u;
+    xme_core_dataManager_dataPacketId_t second = (xme_core_dataManager_dataPacketId_t) 2u;
+    xme_core_dataManager_dataPacketId_t third = (xme_core_dataManager_dataPacketId_t) 3u;
+
+    EXPECT_FALSE(xme_core_broker_isOutputDataPacket(second));
+
+    // The entry that receives the data packet is added before the one that forwards it
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(first, second));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(second, third));
+
+    EXPECT_TRUE(xme_core_broker_isOutputDataPacket(first));
+    EXPECT_TRUE(xme_core_broker_isOutputDataPacket(second));
+    EXPECT_FALSE(xme_core_broker_isOutputDataPacket(third));
+
+    // The result does not depend on the order of the entries
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_removeDataPacketTransferEntry(first, second));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(first, second));
+    EXPECT_TRUE(xme_core_broker_isOutputDataPacket(second));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_removeDataPacketTransferEntry(second, third));
+    EXPECT_FALSE(xme_core_broker_isOutputDataPacket(second));
+    EXPECT_TRUE(xme_core_broker_isOutputDataPacket(first));
+}
+
 TEST_F(BrokerInterfaceTest, DataAvailabilityChangeWithInvalidDataPacket)
 {
     ASSERT_EQ(XME_STATUS_INVALID_PARAMETER, xme_core_broker_dataAvailabilityChange(
@@ -829,6 +891,56 @@ TEST_F(BrokerInterfaceTest, BrokerDataManagerIsFunctionReadyWithOtherFunctionRea
     ASSERT_EQ(XME_STATUS_NOT_FOUND, xme_core_broker_isFunctionReady(componentId, functionId1, functionVariantId2));
 }
 
+TEST_F(BrokerInterfaceTest, BrokerDataManagerAreFunctionsIndependent) {
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_registerFunction(componentId, functionId1, functionVariantId1));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_registerFunction(componentId, functionId2, functionVariantId2));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_registerFunction(componentId, functionId3, functionVariantId3));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketToFunction(inDataPacketId1, componentId, functionId1, functionVariantId1, true));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketToFunction(inDataPacketId2, componentId, functionId2, functionVariantId2, true));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketToFunction(inDataPacketId3, componentId, functionId3, functionVariantId3, true));
+
+    // Functions without common data packets or transfer entries
+    EXPECT_TRUE(xme_core_broker_areFunctionsIndependent(componentId, functionId1, componentId, functionId2));
+    EXPECT_TRUE(xme_core_broker_areFunctionsIndependent(componentId, functionId1, componentId, functionId3));
+
+    // Unregistered functions do not use any data packets
+    EXPECT_TRUE(xme_core_broker_areFunctionsIndependent(componentId, functionId1, XME_CORE_COMPONENT_MAX_COMPONENT_CONTEXT, functionId1));
+
+    // A transfer entry makes both its source and its sink function dependent, in either order
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(inDataPacketId1, inDataPacketId2));
+    EXPECT_FALSE(xme_core_broker_areFunctionsIndependent(componentId, functionId1, componentId, functionId2));
+    EXPECT_FALSE(xme_core_broker_areFunctionsIndependent(componentId, functionId2, componentId, functionId1));
+    EXPECT_TRUE(xme_core_broker_areFunctionsIndependent(componentId, functionId2, componentId, functionId3));
+
+    // So does a data packet used by both functions
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketToFunction(inDataPacketId3, componentId, functionId2, functionVariantId2, false));
+    EXPECT_FALSE(xme_core_broker_areFunctionsIndependent(componentId, functionId2, componentId, functionId3));
+}
+
+TEST_F(BrokerInterfaceTest, BrokerDataManagerGetTransferDestinations) {
+    xme_core_dataManager_dataPacketId_t destinations[2];
+
+    // Data packets without transfer entries have no destinations
+    EXPECT_EQ(0U, xme_core_broker_getTransferDestinations(inDataPacketId1, destinations, 2U));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(inDataPacketId1, inDataPacketId2));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(inDataPacketId1, inDataPacketId3));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(inDataPacketId4, inDataPacketId1));
+
+    ASSERT_EQ(2U, xme_core_broker_getTransferDestinations(inDataPacketId1, destinations, 2U));
+    EXPECT_TRUE((inDataPacketId2 == destinations[0] && inDataPacketId3 == destinations[1]) ||
+                (inDataPacketId3 == destinations[0] && inDataPacketId2 == destinations[1]));
+
+    // Destinations are only counted beyond the capacity of the array
+    EXPECT_EQ(2U, xme_core_broker_getTransferDestinations(inDataPacketId1, NULL, 0U));
+    EXPECT_EQ(0U, xme_core_broker_getTransferDestinations(inDataPacketId1, NULL, 2U));
+
+    // Destination data packets are no sources
+    EXPECT_EQ(0U, xme_core_broker_getTransferDestinations(inDataPacketId2, destinations, 2U));
+    ASSERT_EQ(1U, xme_core_broker_getTransferDestinations(inDataPacketId4, destinations, 2U));
+    EXPECT_EQ(inDataPacketId1, destinations[0]);
+}
+
 TEST_F(BrokerInterfaceTest, BrokerDataManagerInterfaceComplete)
 {
     // 1. register functions and data packets
@@ -21,6 +21,7 @@ xme_build_option(XME_CORE_DATAHANDLER_MAXATTRIBUTE_COUNT 1024 "xme/xme_opt.h" "T
 xme_build_option(XME_CORE_DATAHANDLER_MAXMEMORYREGION_COUNT 16 "xme/xme_opt.h" "The maximum number of memory regions that can be declared for XME.")
 xme_build_option(XME_CORE_DATAHANDLER_MAXMEMORYREGIONCOPIES_COUNT 8 "xme/xme_opt.h" "Maximum number of copies inside a given memory region.")
 
+xme_build_option(XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT 4 "xme/xme_opt.h" "The number of critical sections the data packets are distributed over in striped locking mode.")
 xme_build_option(XME_CORE_DATAHANDLER_CRITICALSECTION_CONCURRENT 8 "xme/xme_opt.h" "The maximum number of data packets concurrently getting a critical section handle.")
 
 xme_build_option(XME_CORE_DATAHANDLER_DATABASETESTPROBE_MAXMANIPULATIONS 64 "xme/xme_opt.h" "The maximum number of manipulations.")
@@ -35,6 +35,34 @@
 
 #include <stdbool.h>
 
+/******************************************************************************/
+/***   Type definitions                                                     ***/
+/******************************************************************************/
+
+/**
+ * \enum xme_core_dataHandler_lockingMode_t
+ *
+ * \brief Locking modes of the data handler in multithreaded builds.
+ */
+typedef enum
+{
+    XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL = 0, ///< All read and write operations share one critical section (default).
+    XME_CORE_DATAHANDLER_LOCKINGMODE_STRIPED = 1 ///< The data packets are distributed over XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT critical sections.
+}
+xme_core_dataHandler_lockingMode_t;
+
+/**
+ * \enum xme_core_dataHandler_transferMode_t
+ *
+ * \brief Transfer modes of the data handler.
+ */
+typedef enum
+{
+    XME_CORE_DATAHANDLER_TRANSFERMODE_COPY = 0, ///< Transfers copy the topic and attributes into the destination data packet (default).
+    XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED = 1 ///< Destination data packets share the buffer of the source data packet until one of them is written.
+}
+xme_core_dataHandler_transferMode_t;
+
 /******************************************************************************/
 /***   Prototypes                                                           ***/
 /******************************************************************************/
@@ -310,6 +338,87 @@ xme_core_dataHandler_createAttribute
 xme_status_t
 xme_core_dataHandler_configure(void);
 
+/**
+ * \brief Selects how read and write operations are synchronized between threads.
+ * \details In global mode, every operation from xme_core_dataHandler_startWriteOperation()
+ *          or xme_core_dataHandler_startReadOperation() to the matching complete call
+ *          holds one critical section shared by all data packets. In striped mode, the
+ *          data packet with identifier i uses critical section
+ *          i % XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT, so that threads working on
+ *          unrelated data packets do not wait for each other.
+ *          An operation on a data packet also holds the stripes of the destinations the
+ *          broker transfers it to, which are all entered up front in ascending order.
+ *          Completing a write operation hence transfers the data without waiting for
+ *          another stripe, and without giving up the stripes it holds.
+ * \note The locking mode must be set before any thread starts read or write operations.
+ *       It has no effect in builds without XME_MULTITHREAD. Striped mode cannot be
+ *       combined with the shared transfer mode (see xme_core_dataHandler_setTransferMode()).
+ *
+ * \param[in] lockingMode The locking mode to use.
+ *
+ * \retval XME_STATUS_SUCCESS if the locking mode has been set.
+ * \retval XME_STATUS_INVALID_PARAMETER if the locking mode is unknown.
+ * \retval XME_STATUS_INVALID_CONFIGURATION if the data handler is not initialized, or
+ *         if striped mode is requested while the shared transfer mode is active.
+ * \retval XME_STATUS_OUT_OF_RESOURCES if the critical sections for striped mode
+ *         cannot be created. The previous locking mode stays active.
+ */
+xme_status_t
+xme_core_dataHandler_setLockingMode
+(
+    xme_core_dataHandler_lockingMode_t lockingMode
+);
+
+/**
+ * \brief Returns the active locking mode.
+ *
+ * \return The locking mode set by xme_core_dataHandler_setLockingMode(), or
+ *         XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL if it has not been called.
+ */
+xme_core_dataHandler_lockingMode_t
+xme_core_dataHandler_getLockingMode(void);
+
+/**
+ * \brief Selects how xme_core_dataHandler_transferData() moves the data.
+ * \details In copy mode, the topic and the attributes of the source data packet are
+ *          copied into the destination data packet on every transfer. In shared mode,
+ *          the destination data packet reads the buffer of the source data packet
+ *          instead, and the transfer costs no copy. The buffer is immutable while it
+ *          is shared: a write to the destination data packet or to the source data
+ *          packet first copies the content for the destination (copy-on-write).
+ *          Consuming the data of a non-persistent destination data packet ends the
+ *          sharing without any copy.
+ *          Transfers fall back to copying if the destination is a queue, is located
+ *          in a memory region with several copies, is manipulated by the test probe,
+ *          or has an attribute which the source does not provide with the same size.
+ * \note Readers observe the same data in both modes. Data packets already sharing
+ *       a buffer keep sharing it when switching back to copy mode.
+ * \note Shared mode requires the global locking mode: a write to the source data
+ *       packet modifies the destination data packets, whose lock stripes are not
+ *       held by the writer (see xme_core_dataHandler_setLockingMode()).
+ *
+ * \param[in] transferMode The transfer mode to use.
+ *
+ * \retval XME_STATUS_SUCCESS if the transfer mode has been set.
+ * \retval XME_STATUS_INVALID_PARAMETER if the transfer mode is unknown.
+ * \retval XME_STATUS_INVALID_CONFIGURATION if the data handler is not initialized, or
+ *         if shared mode is requested while the striped locking mode is active.
+ */
+xme_status_t
+xme_core_dataHandler_setTransferMode
+(
+    xme_core_dataHandler_transferMode_t transferMode
+);
+
+/**
+ * \brief Returns the active transfer mode.
+ *
+ * \return The transfer mode set by xme_core_dataHandler_setTransferMode(), or
+ *         XME_CORE_DATAHANDLER_TRANSFERMODE_COPY if it has not been called.
+ */
+xme_core_dataHandler_transferMode_t
+xme_core_dataHandler_getTransferMode(void);
+
 XME_EXTERN_C_END
 
 /**
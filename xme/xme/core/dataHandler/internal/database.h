@@ -59,6 +59,30 @@ xme_core_dataHandler_database_init(void);
 void
 xme_core_dataHandler_database_fini(void);
 
+/**
+ * \brief Selects whether transfers copy the data or share the buffer of the source.
+ * \details In shared mode, a transfer lets the sink read the buffer of the source
+ *          instead of copying the topic and attributes. The sink gets its own copy
+ *          as soon as the sink or the source is modified (copy-on-write). Transfers
+ *          which cannot write the complete sink are always copied. 
+ *
+ * \param[in] shared true to share the buffers, false to copy them. 
+ */
+void
+xme_core_dataHandler_database_setSharedTransfer
+(
+    bool shared
+);
+
+/**
+ * \brief Determines whether transfers share the buffer of the source.
+ *
+ * \retval true if transfers share the buffer of the source.
+ * \retval false if transfers copy the data.
+ */
+bool
+xme_core_dataHandler_database_isSharedTransfer(void);
+
 /**
  * \brief Writes the data associated to a data packet from database. 
  * \details The data to be written is placed in the input buffer. 
@@ -229,6 +253,8 @@ xme_core_dataHandler_database_readAttribute
  *       the source data packet. 
  * \note For the transfer operation the database index taken into account is the 
  *       default one associated to each data packet. 
+ * \note In shared transfer mode, the sink may share the buffer of the source
+ *       instead (see ::xme_core_dataHandler_database_setSharedTransfer). 
  * 
  * \param[in] sourceDataPacketID The source data packet identifier. 
  * \param[in] sinkDataPacketID The sink data packet identifier. 
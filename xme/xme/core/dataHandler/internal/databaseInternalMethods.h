@@ -46,12 +46,13 @@
  * \note The database is agnostic about attribute arrays. This means that is the user the one who
  *       should reserve as much memory size as needed for the whole attribute value. 
  */
-typedef struct
+typedef struct xme_core_dataHandler_database_attribute_s
 {
     size_t attributeOffset; ///< The offset inside the database in which is located the attribute region. 
     uint32_t key; ///< The attribute key. 
     size_t attributeValueSize; ///< The size of the attribute value expressed in bytes. 
     bool dataAvailable; ///< Indicates that there is data available for this data packet.
+    struct xme_core_dataHandler_database_attribute_s* transferSourceAttribute; ///< The attribute with the same key in the data store referenced by transferSourceID, or NULL if it has no such attribute. 
 } xme_core_dataHandler_database_attribute_t;
 
 /**
@@ -124,6 +125,13 @@ typedef struct
     uint32_t currentCBReadPosition; ///< The reference to circular buffer read index to enable readAttribute operation for queues. 
     xme_core_dataHandler_database_memoryRegion_t* memoryRegion; ///< The memory region associated to the current data store. 
     bool manipulated; ///< Determines if the data packet is manipulated. 
+    xme_core_dataManager_dataStoreID_t transferSourceID; ///< The source data store for which the transferSourceAttribute fields of the attributes are computed. 
+    bool transferShareable; ///< Indicates that every attribute has a counterpart of the same size in the data store referenced by transferSourceID. 
+    xme_core_dataManager_dataStoreID_t sharedSourceID; ///< The source data store whose buffer is read instead of the own one after a shared transfer, or XME_CORE_DATAMANAGER_DATAPACKETID_INVALID. 
+    uint16_t sharedReferenceCount; ///< The number of data stores currently reading the buffer of this data store. 
+    xme_core_dataManager_dataStoreID_t firstSharerID; ///< The first data store reading the buffer of this data store, or XME_CORE_DATAMANAGER_DATAPACKETID_INVALID. The others follow through nextSharerID. 
+    xme_core_dataManager_dataStoreID_t nextSharerID; ///< The next data store reading the buffer of the same source as this one, or XME_CORE_DATAMANAGER_DATAPACKETID_INVALID. 
+    bool resetPending; ///< Indicates that the buffer still has to be cleared by a deferred reset before it is accessed. 
 } xme_core_dataHandler_database_dataStore_t;
 
 /**
@@ -535,6 +543,80 @@ checkOverwriteAfterWrite
     xme_core_dataHandler_database_dataStore_t* const dataStore
 );
 
+/**
+ * \brief Computes the attribute table used for transfers from the given source.
+ * \details Stores in each attribute of the sink the attribute of the source with
+ *          the same key, so that transfers do not need to look up attributes by key.
+ *          The table is kept as long as the sink receives its transfers from the
+ *          same source. 
+ *
+ * \param[in,out] sinkDataStore The data store receiving the transfer. 
+ * \param[in] sourceDataStore The data store from which the data is transferred. 
+ *
+ * \retval XME_STATUS_SUCCESS If the attribute table is up to date. 
+ */
+xme_status_t
+updateTransferAttributes
+(
+    xme_core_dataHandler_database_dataStore_t* const sinkDataStore,
+    xme_core_dataHandler_database_dataStore_t* const sourceDataStore
+);
+
+/**
+ * \brief Gets the data store whose buffer holds the data of the given data store.
+ * \details After a shared transfer, this is the source of the transfer. Otherwise
+ *          it is the data store itself. The attributes of the returned data store
+ *          are obtained from the transferSourceAttribute field of the attributes. 
+ *
+ * \param[in] dataStore The data store to read. 
+ * \param[out] bufferDataStore The data store whose buffer should be read. 
+ *
+ * \retval XME_STATUS_SUCCESS If the data store was successfully obtained. 
+ * \retval XME_STATUS_NOT_FOUND If the shared source data store does not exist. 
+ */
+xme_status_t
+getSharedDataStore
+(
+    xme_core_dataHandler_database_dataStore_t* const dataStore,
+    xme_core_dataHandler_database_dataStore_t** const bufferDataStore
+);
+
+/**
+ * \brief Stops sharing the buffer of the source without copying its content. 
+ * \details Used when the whole content of the data store is replaced afterwards. 
+ *
+ * \param[in,out] dataStore The data store which may share the buffer of its source. 
+ *
+ * \retval XME_STATUS_SUCCESS If the data store uses its own buffer. 
+ * \retval XME_STATUS_NOT_FOUND If the shared source data store does not exist. 
+ */
+xme_status_t
+releaseSharedData
+(
+    xme_core_dataHandler_database_dataStore_t* const dataStore
+);
+
+/**
+ * \brief Copies the content of all buffers shared with the given data store. 
+ * \details Implements the copy-on-write of shared transfers. If the data store
+ *          reads the buffer of a source, the content of that buffer is copied into
+ *          its own buffer. If other data stores read the buffer of this data store,
+ *          each of them gets its own copy. A deferred reset of the data store is
+ *          applied afterwards. Then the buffer of the data store can be accessed
+ *          directly and modified. 
+ *
+ * \param[in,out] dataStore The data store which is going to be modified. 
+ *
+ * \retval XME_STATUS_SUCCESS If no buffer is shared with the data store anymore. 
+ * \retval XME_STATUS_NOT_FOUND If a buffer of a shared data store cannot be located. 
+ * \retval XME_STATUS_INTERNAL_ERROR If the content cannot be copied. 
+ */
+xme_status_t
+unshareDataStore
+(
+    xme_core_dataHandler_database_dataStore_t* const dataStore
+);
+
 XME_EXTERN_C_END
 
 #endif /* XME_CORE_DATAHANDLER_DATABASEINTERNALMETHODS_H */
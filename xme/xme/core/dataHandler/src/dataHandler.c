@@ -44,10 +44,26 @@
 /***   Type definitions                                                     ***/
 /******************************************************************************/
 #ifdef XME_MULTITHREAD
+#if XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT < 1 || XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT > 32
+    #error XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT must be between 1 and 32.
+#endif // #if XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT < 1 || XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT > 32
+
 /**
  * \brief Data Handler thread self-locking counter.
  */
 typedef uint8_t xme_core_dataHandler_threadLockCount_t;
+
+/**
+ * \brief Data Handler critical sections held by a thread.
+ * \details Each critical section may be entered several times by the same
+ *          thread, the counters hold the nesting depth.
+ */
+typedef struct
+{
+    xme_core_dataHandler_threadLockCount_t global; ///< Nesting depth of the global critical section.
+    xme_core_dataHandler_threadLockCount_t stripes[XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT]; ///< Nesting depth of the lock stripes.
+    uint32_t companions[XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT]; ///< Bit masks of the stripes entered on behalf of each stripe, left together with it.
+} xme_core_dataHandler_threadLocks_t;
 #endif // #ifdef XME_MULTITHREAD
 
 /******************************************************************************/
@@ -66,6 +82,11 @@ static bool initialized = false;
  */
 static xme_core_dataHandler_databaseBuilder_t* builder = NULL;
 
+/**
+ * \brief Active locking mode.
+ */
+static xme_core_dataHandler_lockingMode_t lockingMode = XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL;
+
 #ifdef XME_MULTITHREAD
 /**
  * \brief Thread-local storage handle for locking of Data Handler.
@@ -76,6 +97,17 @@ static xme_hal_tls_handle_t xme_core_dataHandler_tlsHandle = XME_HAL_TLS_INVALID
  * \brief Critical section handle for locking of Data Handler.
  */
 static xme_hal_sync_criticalSectionHandle_t xme_core_dataHandler_criticalSectionHandle = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+
+/**
+ * \brief Critical section handles of the lock stripes used in striped locking mode.
+ * \details Created on the first switch to striped mode.
+ */
+static xme_hal_sync_criticalSectionHandle_t xme_core_dataHandler_stripeHandles[XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT];
+
+/**
+ * \brief Determines if the lock stripes have been created.
+ */
+static bool stripesCreated = false;
 #endif // #ifdef XME_MULTITHREAD
 
 /******************************************************************************/
@@ -85,25 +117,75 @@ static xme_hal_sync_criticalSectionHandle_t xme_core_dataHandler_criticalSection
 #ifdef XME_MULTITHREAD // #ifdef XME_MULTITHREAD
 
 /**
- * \brief Returns a pointer to the thread-specific lock counter.
+ * \brief Returns a pointer to the thread-specific lock counters.
  *
- * \return Pointer to the thread-specific lock counter for the calling thread.
+ * \return Pointer to the thread-specific lock counters for the calling thread.
  */
-static xme_core_dataHandler_threadLockCount_t*
+static xme_core_dataHandler_threadLocks_t*
 xme_core_dataHandler_getThreadLock(void);
 
 /**
- * \brief Blocks until the calling thread is granted access to the Data Handler.
+ * \brief Returns the lock stripes an operation on the given data packet holds.
+ *
+ * \details Besides the stripe of the data packet, these are the stripes of
+ *          the destinations the broker transfers the data packet to. If the
+ *          data packet has more destinations than lock stripes, all stripes
+ *          are returned.
+ *
+ * \param[in] dataPacketID Data packet to access.
+ *
+ * \return Bit mask with bit i set for every lock stripe i.
+ */
+static uint32_t
+xme_core_dataHandler_getStripeMask
+(
+    xme_core_dataManager_dataPacketId_t dataPacketID
+);
+
+/**
+ * \brief Leaves a lock stripe once, and the stripes entered on its behalf
+ *        when it is no longer held by the calling thread.
  *
- * \details The same thread may call this function multiple times, in which
+ * \param[in] locks Lock counters of the calling thread.
+ * \param[in] stripe Lock stripe to leave.
+ */
+static void
+xme_core_dataHandler_leaveStripe
+(
+    xme_core_dataHandler_threadLocks_t* locks,
+    uint16_t stripe
+);
+
+/**
+ * \brief Blocks until the calling thread is granted access to the given
+ *        data packet.
+ *
+ * \details In global locking mode, access to all data packets is granted at
+ *          once. In striped mode, only the stripe of the data packet is locked.
+ *          The same thread may call this function multiple times, in which
  *          case the seubsequent requests are immediately granted. However, a
  *          matching number of calls to xme_core_dataHandler_leaveCriticalSection()
  *          need to follow in this case.
  *
+ *          In striped mode, the stripes of the transfer destinations of the
+ *          data packet are entered together with its own stripe, all in
+ *          ascending order, and held until the stripe of the data packet is
+ *          left. Nested operations on the destinations, as performed by the
+ *          broker when a write operation is completed, are hence granted
+ *          immediately.
+ *          Only if the thread needs a busy stripe below one it already holds
+ *          for any other reason, it releases the stripes above, waits for the
+ *          needed one and enters the released stripes again.
+ *
+ * \param[in] dataPacketID Data packet to access.
+ *
  * \see xme_core_dataHandler_leaveCriticalSection()
  */
-void
-xme_core_dataHandler_enterCriticalSection(void);
+static void
+xme_core_dataHandler_enterCriticalSection
+(
+    xme_core_dataManager_dataPacketId_t dataPacketID
+);
 
 /**
  * \brief Frees the Data handler lock granted to the calling thread by a
@@ -113,10 +195,15 @@ xme_core_dataHandler_enterCriticalSection(void);
  *          multiple times, a matching number of calls to this function
  *          needs to be made to release the calling thread's lock.
  *
+ * \param[in] dataPacketID Data packet passed to xme_core_dataHandler_enterCriticalSection().
+ *
  * \see xme_core_dataHandler_enterCriticalSection()
  */
-void
-xme_core_dataHandler_leaveCriticalSection(void);
+static void
+xme_core_dataHandler_leaveCriticalSection
+(
+    xme_core_dataManager_dataPacketId_t dataPacketID
+);
 
 #endif // #ifdef XME_MULTITHREAD
 
@@ -154,7 +241,7 @@ xme_core_dataHandler_init(void)
         status = xme_hal_tls_init();
         XME_ASSERT(XME_STATUS_SUCCESS == status);
 
-        xme_core_dataHandler_tlsHandle = xme_hal_tls_alloc(sizeof(xme_core_dataHandler_threadLockCount_t));
+        xme_core_dataHandler_tlsHandle = xme_hal_tls_alloc(sizeof(xme_core_dataHandler_threadLocks_t));
         XME_ASSERT(XME_HAL_TLS_INVALID_TLS_HANDLE != xme_core_dataHandler_tlsHandle);
 
         xme_core_dataHandler_criticalSectionHandle = xme_hal_sync_createCriticalSection();
@@ -184,8 +271,21 @@ xme_core_dataHandler_fini(void)
     xme_core_dataHandler_database_fini();
 
     initialized = false;
+    lockingMode = XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL;
 
 #ifdef XME_MULTITHREAD
+    if (stripesCreated)
+    {
+        uint16_t i;
+
+        for (i = 0U; i < XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT; i++)
+        {
+            xme_hal_sync_destroyCriticalSection(xme_core_dataHandler_stripeHandles[i]);
+            xme_core_dataHandler_stripeHandles[i] = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+        }
+        stripesCreated = false;
+    }
+
     xme_hal_sync_destroyCriticalSection(xme_core_dataHandler_criticalSectionHandle);
     xme_core_dataHandler_criticalSectionHandle = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
 
@@ -407,6 +507,91 @@ xme_core_dataHandler_configure(void)
     return XME_STATUS_SUCCESS;
 }
 
+xme_status_t
+xme_core_dataHandler_setLockingMode
+(
+    xme_core_dataHandler_lockingMode_t mode
+)
+{
+    XME_CHECK
+    (
+        XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL == mode || XME_CORE_DATAHANDLER_LOCKINGMODE_STRIPED == mode,
+        XME_STATUS_INVALID_PARAMETER
+    );
+    XME_CHECK(initialized, XME_STATUS_INVALID_CONFIGURATION);
+
+    // Unsharing a buffer writes to every sink sharing it, but the stripe of the
+    // source does not protect the sinks. Hence both modes exclude each other.
+    XME_CHECK
+    (
+        XME_CORE_DATAHANDLER_LOCKINGMODE_STRIPED != mode || !xme_core_dataHandler_database_isSharedTransfer(),
+        XME_STATUS_INVALID_CONFIGURATION
+    );
+
+#ifdef XME_MULTITHREAD
+    if (XME_CORE_DATAHANDLER_LOCKINGMODE_STRIPED == mode && !stripesCreated)
+    {
+        uint16_t i;
+
+        for (i = 0U; i < XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT; i++)
+        {
+            xme_core_dataHandler_stripeHandles[i] = xme_hal_sync_createCriticalSection();
+            if (XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE == xme_core_dataHandler_stripeHandles[i])
+            {
+                XME_LOG(XME_LOG_WARNING, "[DataHandler] Cannot create critical section for lock stripe %d.\n", i);
+                while (i > 0U)
+                {
+                    i--;
+                    xme_hal_sync_destroyCriticalSection(xme_core_dataHandler_stripeHandles[i]);
+                    xme_core_dataHandler_stripeHandles[i] = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+                }
+                return XME_STATUS_OUT_OF_RESOURCES;
+            }
+        }
+        stripesCreated = true;
+    }
+#endif // #ifdef XME_MULTITHREAD
+
+    lockingMode = mode;
+
+    return XME_STATUS_SUCCESS;
+}
+
+xme_core_dataHandler_lockingMode_t
+xme_core_dataHandler_getLockingMode(void)
+{
+    return lockingMode;
+}
+
+xme_status_t
+xme_core_dataHandler_setTransferMode
+(
+    xme_core_dataHandler_transferMode_t mode
+)
+{
+    XME_CHECK
+    (
+        XME_CORE_DATAHANDLER_TRANSFERMODE_COPY == mode || XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED == mode,
+        XME_STATUS_INVALID_PARAMETER
+    );
+    XME_CHECK(initialized, XME_STATUS_INVALID_CONFIGURATION);
+    XME_CHECK
+    (
+        XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED != mode || XME_CORE_DATAHANDLER_LOCKINGMODE_STRIPED != lockingMode,
+        XME_STATUS_INVALID_CONFIGURATION
+    );
+
+    xme_core_dataHandler_database_setSharedTransfer(XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED == mode);
+
+    return XME_STATUS_SUCCESS;
+}
+
+xme_core_dataHandler_transferMode_t
+xme_core_dataHandler_getTransferMode(void)
+{
+    return xme_core_dataHandler_database_isSharedTransfer() ? XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED : XME_CORE_DATAHANDLER_TRANSFERMODE_COPY;
+}
+
 xme_status_t
 xme_core_dataHandler_writeData
 (
@@ -586,21 +771,38 @@ xme_core_dataHandler_startWriteOperation
 
 #ifdef XME_MULTITHREAD
     XME_LOG(XME_LOG_VERBOSE, "[DataHandler] Entering critical section for data packet %d in startWriteOperation ... ", dataPacketID);
-    xme_core_dataHandler_enterCriticalSection();
+    xme_core_dataHandler_enterCriticalSection(dataPacketID);
     XME_LOG(XME_LOG_VERBOSE, "done\n");
 #endif // #ifdef XME_MULTITHREAD
 
     if (!xme_core_dataHandler_database_isWriteLocked(dataPacketID))
     {
         status = xme_core_dataHandler_database_lockRead(dataPacketID);
+#ifdef XME_MULTITHREAD
+        XME_CHECK_MSG_REC
+        (
+            XME_STATUS_SUCCESS == status,
+            XME_STATUS_INVALID_CONFIGURATION,
+            {
+                xme_core_dataHandler_leaveCriticalSection(dataPacketID);
+            },
+            XME_LOG_WARNING,
+            "[DataHandler] Cannot lock read operation for CompleteWriteOperation in data packet %d.\n", dataPacketID
+        );
+#else // #ifdef XME_MULTITHREAD
         XME_CHECK_MSG(XME_STATUS_SUCCESS == status, XME_STATUS_INVALID_CONFIGURATION,
             XME_LOG_WARNING, "[DataHandler] Cannot lock read operation for CompleteWriteOperation in data packet %d.\n", dataPacketID);
+#endif // #ifdef XME_MULTITHREAD
         return XME_STATUS_SUCCESS;
     }
     else
     {
         XME_LOG(XME_LOG_WARNING, "[DataHandler] Cannot start a write operation on data packet %d while still write locked.\n", dataPacketID);
 
+#ifdef XME_MULTITHREAD
+        xme_core_dataHandler_leaveCriticalSection(dataPacketID);
+#endif // #ifdef XME_MULTITHREAD
+
         return XME_STATUS_PERMISSION_DENIED;
     }
 }
@@ -630,7 +832,7 @@ xme_core_dataHandler_completeWriteOperation
             XME_STATUS_SUCCESS == status, 
             XME_STATUS_INVALID_CONFIGURATION,
             {
-                xme_core_dataHandler_leaveCriticalSection();
+                xme_core_dataHandler_leaveCriticalSection(dataPacketID);
             },
             XME_LOG_WARNING, 
             "[DataHandler] Cannot unlock read operation for data packet %d.\n", dataPacketID
@@ -653,9 +855,9 @@ xme_core_dataHandler_completeWriteOperation
             XME_CHECK_MSG_REC
             (
                 XME_STATUS_SUCCESS == status,
-                XME_STATUS_INVALID_CONFIGURATION,
+                status,
                 {
-                    xme_core_dataHandler_leaveCriticalSection();
+                    xme_core_dataHandler_leaveCriticalSection(dataPacketID);
                 },
                 XME_LOG_DEBUG,
                 "Cannot advance a queue position for data packet %d\n", dataPacketID
@@ -679,7 +881,7 @@ xme_core_dataHandler_completeWriteOperation
             XME_STATUS_SUCCESS == status,
             XME_STATUS_INVALID_CONFIGURATION,
             {
-                xme_core_dataHandler_leaveCriticalSection();
+                xme_core_dataHandler_leaveCriticalSection(dataPacketID);
             },
             XME_LOG_WARNING,
             "[DataHandler] Cannot obtain data availability for completing write operation for data packet %d.\n", dataPacketID
@@ -701,7 +903,7 @@ xme_core_dataHandler_completeWriteOperation
             XME_STATUS_SUCCESS == status || XME_STATUS_NOT_FOUND == status,
             status,
             {
-                xme_core_dataHandler_leaveCriticalSection();
+                xme_core_dataHandler_leaveCriticalSection(dataPacketID);
             },
             XME_LOG_DEBUG,
             "[DataHandler] Cannot change data availability for completing write operation of data packet %d to %d\n", dataPacketID, dataAvailability
@@ -719,7 +921,7 @@ xme_core_dataHandler_completeWriteOperation
 #ifdef XME_MULTITHREAD
         // Leave critical section
         XME_LOG(XME_LOG_VERBOSE, "[DataHandler] Leaving critical section for data packet %d in completeWriteOperation ... ", dataPacketID);
-        xme_core_dataHandler_leaveCriticalSection();
+        xme_core_dataHandler_leaveCriticalSection(dataPacketID);
         XME_LOG(XME_LOG_VERBOSE, "done\n");
 #endif // #ifdef XME_MULTITHREAD
 
@@ -756,6 +958,8 @@ xme_core_dataHandler_startReadOperation
     xme_core_dataManager_dataPacketId_t dataPacketID
 )
 {
+    xme_status_t status;
+
     XME_CHECK(((xme_core_dataManager_dataPacketId_t)XME_CORE_DATAMANAGER_DATAPACKETID_INVALID) != dataPacketID, XME_STATUS_INVALID_HANDLE);
     XME_CHECK(true == xme_core_dataHandler_database_isDataStoreDefined(dataPacketID), XME_STATUS_INVALID_HANDLE);
 
@@ -763,20 +967,38 @@ xme_core_dataHandler_startReadOperation
 
 #ifdef XME_MULTITHREAD
     XME_LOG(XME_LOG_VERBOSE, "[DataHandler] Entering critical section for data packet %d in startReadOperation ...", dataPacketID);
-    xme_core_dataHandler_enterCriticalSection();
+    xme_core_dataHandler_enterCriticalSection(dataPacketID);
     XME_LOG(XME_LOG_VERBOSE, "done\n");
 #endif // #ifdef XME_MULTITHREAD
 
     if (!xme_core_dataHandler_database_isReadLocked(dataPacketID))
     {
-        XME_CHECK_MSG(XME_STATUS_SUCCESS == xme_core_dataHandler_database_lockWrite(dataPacketID), XME_STATUS_INVALID_CONFIGURATION,
+        status = xme_core_dataHandler_database_lockWrite(dataPacketID);
+#ifdef XME_MULTITHREAD
+        XME_CHECK_MSG_REC
+        (
+            XME_STATUS_SUCCESS == status,
+            XME_STATUS_INVALID_CONFIGURATION,
+            {
+                xme_core_dataHandler_leaveCriticalSection(dataPacketID);
+            },
+            XME_LOG_WARNING,
+            "[DataHandler] Cannot lock write operation for CompleteReadOperation for data packet %d.\n", dataPacketID
+        );
+#else // #ifdef XME_MULTITHREAD
+        XME_CHECK_MSG(XME_STATUS_SUCCESS == status, XME_STATUS_INVALID_CONFIGURATION,
             XME_LOG_WARNING, "[DataHandler] Cannot lock write operation for CompleteReadOperation for data packet %d.\n", dataPacketID);
+#endif // #ifdef XME_MULTITHREAD
         return XME_STATUS_SUCCESS;
     }
     else
     {
         XME_LOG(XME_LOG_WARNING, "[DataHandler] Cannot start a read operation on data packet %d while still read locked.\n", dataPacketID);
 
+#ifdef XME_MULTITHREAD
+        xme_core_dataHandler_leaveCriticalSection(dataPacketID);
+#endif // #ifdef XME_MULTITHREAD
+
         return XME_STATUS_PERMISSION_DENIED;
     }
 
@@ -807,7 +1029,7 @@ xme_core_dataHandler_completeReadOperation
             XME_STATUS_SUCCESS == status, 
             XME_STATUS_INVALID_CONFIGURATION,
             {
-                xme_core_dataHandler_leaveCriticalSection();
+                xme_core_dataHandler_leaveCriticalSection(dataPacketID);
             },
             XME_LOG_WARNING, "[DataHandler] Cannot obtain data availability for complete read operation on data packet %d.\n", dataPacketID
         );
@@ -845,7 +1067,7 @@ xme_core_dataHandler_completeReadOperation
                 XME_STATUS_SUCCESS == status, 
                 XME_STATUS_INVALID_CONFIGURATION,
                 {
-                    xme_core_dataHandler_leaveCriticalSection();
+                    xme_core_dataHandler_leaveCriticalSection(dataPacketID);
                 },
                 XME_LOG_WARNING, "[DataHandler] Cannot obtain data availability for completing read operation on data packet %d.\n", dataPacketID
             );
@@ -867,7 +1089,7 @@ xme_core_dataHandler_completeReadOperation
             XME_STATUS_SUCCESS == status || XME_STATUS_NOT_FOUND == status, 
             status,
             {
-                xme_core_dataHandler_leaveCriticalSection();
+                xme_core_dataHandler_leaveCriticalSection(dataPacketID);
             },
             XME_LOG_DEBUG, 
             "[DataHandler] Cannot update data availability for completing read operation on data packet %d and new value to %d.\n", dataPacketID, dataAvailability
@@ -888,7 +1110,7 @@ xme_core_dataHandler_completeReadOperation
 
 #ifdef XME_MULTITHREAD
         XME_LOG(XME_LOG_VERBOSE, "[DataHandler] Leaving critical section for data packet %d in completeReadOperation ... ", dataPacketID);
-        xme_core_dataHandler_leaveCriticalSection();
+        xme_core_dataHandler_leaveCriticalSection(dataPacketID);
         XME_LOG(XME_LOG_VERBOSE, "done\n");
 #endif // #ifdef XME_MULTITHREAD
 
@@ -955,53 +1177,198 @@ xme_core_dataHandler_transferData
 
 #ifdef XME_MULTITHREAD
 
-static xme_core_dataHandler_threadLockCount_t*
+static xme_core_dataHandler_threadLocks_t*
 xme_core_dataHandler_getThreadLock(void)
 {
-    xme_core_dataHandler_threadLockCount_t* tlc;
+    xme_core_dataHandler_threadLocks_t* locks;
 
     XME_ASSERT_RVAL(XME_HAL_TLS_INVALID_TLS_HANDLE != xme_core_dataHandler_tlsHandle, NULL);
 
-    tlc = (xme_core_dataHandler_threadLockCount_t*) xme_hal_tls_get(xme_core_dataHandler_tlsHandle);
-    XME_ASSERT_RVAL(NULL != tlc, NULL);
+    locks = (xme_core_dataHandler_threadLocks_t*) xme_hal_tls_get(xme_core_dataHandler_tlsHandle);
+    XME_ASSERT_RVAL(NULL != locks, NULL);
 
-    return tlc;
+    return locks;
 }
 
-void
-xme_core_dataHandler_enterCriticalSection(void)
+static void
+xme_core_dataHandler_enterCriticalSection
+(
+    xme_core_dataManager_dataPacketId_t dataPacketID
+)
 {
-    xme_core_dataHandler_threadLockCount_t* tlc = xme_core_dataHandler_getThreadLock();
-    XME_ASSERT_NORVAL(NULL != tlc);
+    xme_core_dataHandler_threadLocks_t* locks = xme_core_dataHandler_getThreadLock();
+    xme_core_dataHandler_threadLockCount_t* tlc;
+    uint16_t stripe;
+    uint16_t i;
+
+    XME_ASSERT_NORVAL(NULL != locks);
 
-    if (0U == (*tlc))
+    if (XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL == lockingMode)
     {
-        // This thread has not yet locked the critical section
-        XME_LOG(XME_LOG_DEBUG, "[DataHandler] Entering the critical section ... ");
-        xme_hal_sync_enterCriticalSection(xme_core_dataHandler_criticalSectionHandle);
-        XME_LOG(XME_LOG_DEBUG, "OK\n");
+        tlc = &locks->global;
+        if (0U == (*tlc))
+        {
+            // This thread has not yet locked the critical section
+            XME_LOG(XME_LOG_DEBUG, "[DataHandler] Entering the critical section ... ");
+            xme_hal_sync_enterCriticalSection(xme_core_dataHandler_criticalSectionHandle);
+            XME_LOG(XME_LOG_DEBUG, "OK\n");
+        }
     }
     else
     {
-        XME_ASSERT_NORVAL((*tlc) < (xme_core_dataHandler_threadLockCount_t) -1);
+        uint32_t held = 0U;
+        uint32_t missing;
+
+        stripe = (uint16_t) (dataPacketID % XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT);
+        tlc = &locks->stripes[stripe];
+
+        for (i = 0U; i < XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT; i++)
+        {
+            if (0U != locks->stripes[i])
+            {
+                held |= (uint32_t) 1U << i;
+            }
+        }
+        missing = xme_core_dataHandler_getStripeMask(dataPacketID) & ~held;
+
+        for (i = 0U; i < XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT; i++)
+        {
+            if (0U == (missing & ((uint32_t) 1U << i)))
+            {
+                continue;
+            }
+
+            if (0U == (held >> i))
+            {
+                // No stripe above is held, wait in ascending order
+                xme_hal_sync_enterCriticalSection(xme_core_dataHandler_stripeHandles[i]);
+            }
+            else if (XME_STATUS_SUCCESS != xme_hal_sync_tryEnterCriticalSection(xme_core_dataHandler_stripeHandles[i]))
+            {
+                uint16_t j;
+
+                // The holder of the stripe may be waiting for one of ours.
+                // Give up the stripes above it and take them again together
+                // with the remaining ones in ascending order.
+                XME_LOG(XME_LOG_WARNING, "[DataHandler] Reordering lock stripes for data packet %d\n", dataPacketID);
+                for (j = XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT; j > i + 1U; j--)
+                {
+                    if (0U != (held & ((uint32_t) 1U << (j - 1U))))
+                    {
+                        xme_hal_sync_leaveCriticalSection(xme_core_dataHandler_stripeHandles[j - 1U]);
+                    }
+                }
+
+                for (j = i; j < XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT; j++)
+                {
+                    if (0U != ((held | missing) & ((uint32_t) 1U << j)))
+                    {
+                        xme_hal_sync_enterCriticalSection(xme_core_dataHandler_stripeHandles[j]);
+                    }
+                }
+                break;
+            }
+
+            held |= (uint32_t) 1U << i;
+        }
+
+        // Stripes entered for the destinations are left with the stripe of the data packet
+        for (i = 0U; i < XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT; i++)
+        {
+            if (i != stripe && 0U != (missing & ((uint32_t) 1U << i)))
+            {
+                locks->stripes[i] = 1U;
+                locks->companions[stripe] |= (uint32_t) 1U << i;
+            }
+        }
     }
+
+    XME_ASSERT_NORVAL((*tlc) < (xme_core_dataHandler_threadLockCount_t) -1);
     (*tlc)++;
 }
 
-void
-xme_core_dataHandler_leaveCriticalSection(void)
+static void
+xme_core_dataHandler_leaveCriticalSection
+(
+    xme_core_dataManager_dataPacketId_t dataPacketID
+)
+{
+    xme_core_dataHandler_threadLocks_t* locks = xme_core_dataHandler_getThreadLock();
+
+    XME_ASSERT_NORVAL(NULL != locks);
+
+    if (XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL == lockingMode)
+    {
+        XME_ASSERT_NORVAL(locks->global > 0U);
+
+        locks->global--;
+        if (0U == locks->global)
+        {
+            // This thread is about to unlock the critical section
+            xme_hal_sync_leaveCriticalSection(xme_core_dataHandler_criticalSectionHandle);
+            XME_LOG(XME_LOG_DEBUG, "[DataHandler] Left the critical section\n");
+        }
+    }
+    else
+    {
+        xme_core_dataHandler_leaveStripe(locks, (uint16_t) (dataPacketID % XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT));
+    }
+}
+
+static uint32_t
+xme_core_dataHandler_getStripeMask
+(
+    xme_core_dataManager_dataPacketId_t dataPacketID
+)
+{
+    xme_core_dataManager_dataPacketId_t destinations[XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT];
+    uint32_t mask = (uint32_t) 1U << (dataPacketID % XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT);
+    uint16_t count;
+    uint16_t i;
+
+    count = xme_core_broker_getTransferDestinations(dataPacketID, destinations, XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT);
+    if (count > XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT)
+    {
+        return ((uint32_t) -1) >> (32U - XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT);
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        mask |= (uint32_t) 1U << (destinations[i] % XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT);
+    }
+
+    return mask;
+}
+
+static void
+xme_core_dataHandler_leaveStripe
+(
+    xme_core_dataHandler_threadLocks_t* locks,
+    uint16_t stripe
+)
 {
-    xme_core_dataHandler_threadLockCount_t* tlc = xme_core_dataHandler_getThreadLock();
-    XME_ASSERT_NORVAL(NULL != tlc);
+    uint32_t companions;
+    uint16_t i;
 
-    XME_ASSERT_NORVAL((*tlc) > 0U);
+    XME_ASSERT_NORVAL(locks->stripes[stripe] > 0U);
 
-    (*tlc)--;
-    if (0U == (*tlc))
+    locks->stripes[stripe]--;
+    if (0U != locks->stripes[stripe])
     {
-        // This thread is about to unlock the critical section
-        xme_hal_sync_leaveCriticalSection(xme_core_dataHandler_criticalSectionHandle);
-        XME_LOG(XME_LOG_DEBUG, "[DataHandler] Left the critical section\n");
+        return;
+    }
+
+    xme_hal_sync_leaveCriticalSection(xme_core_dataHandler_stripeHandles[stripe]);
+    XME_LOG(XME_LOG_DEBUG, "[DataHandler] Left lock stripe %d\n", stripe);
+
+    companions = locks->companions[stripe];
+    locks->companions[stripe] = 0U;
+    for (i = 0U; i < XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT; i++)
+    {
+        if (0U != (companions & ((uint32_t) 1U << i)))
+        {
+            xme_core_dataHandler_leaveStripe(locks, i);
+        }
     }
 }
 
@@ -31,10 +31,40 @@
 #include "xme/hal/include/mem.h"
 #include "xme/hal/include/mmap.h"
 
+/******************************************************************************/
+/***   Variables                                                            ***/
+/******************************************************************************/
+
+/**
+ * \brief Determines if transfers let the sinks share the buffer of the source instead of copying it. 
+ */
+static bool sharedTransfer = false;
+
 /******************************************************************************/
 /***   Prototypes                                                           ***/
 /******************************************************************************/
 
+/**
+ * \brief Determines if a transfer can let the sink share the buffer of the source. 
+ * \details This requires the shared transfer mode, that both data stores are located
+ *          in memory regions without further copies, are no queues and are not
+ *          manipulated, and that the transfer would write the complete content of
+ *          the sink: the topic and every attribute of the sink need to be available
+ *          in the source with the same size. 
+ * \note The transfer attributes of the sink must be computed for the source. 
+ *
+ * \param[in] sourceDataStore The data store from which the data is transferred. 
+ * \param[in] sinkDataStore The data store receiving the transfer. 
+ *
+ * \return true if the sink can share the buffer of the source, false otherwise. 
+ */
+static bool
+isSharedTransferPossible
+(
+    const xme_core_dataHandler_database_dataStore_t* const sourceDataStore,
+    xme_core_dataHandler_database_dataStore_t* const sinkDataStore
+);
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
@@ -49,6 +79,49 @@ void
 xme_core_dataHandler_database_fini(void)
 {
     xme_core_dataHandler_databaseInternal_fini();
+
+    sharedTransfer = false;
+}
+
+void
+xme_core_dataHandler_database_setSharedTransfer
+(
+    bool shared
+)
+{
+    sharedTransfer = shared;
+}
+
+bool
+xme_core_dataHandler_database_isSharedTransfer(void)
+{
+    return sharedTransfer;
+}
+
+static bool
+isSharedTransferPossible
+(
+    const xme_core_dataHandler_database_dataStore_t* const sourceDataStore,
+    xme_core_dataHandler_database_dataStore_t* const sinkDataStore
+)
+{
+    XME_CHECK(sharedTransfer, (bool) false);
+    XME_CHECK(sinkDataStore->transferShareable, (bool) false);
+    XME_CHECK(sourceDataStore->dataAvailable, (bool) false);
+    XME_CHECK(1U == sourceDataStore->queueSize && 1U == sinkDataStore->queueSize, (bool) false);
+    XME_CHECK(1U == sourceDataStore->memoryRegion->numOfCopies && 1U == sinkDataStore->memoryRegion->numOfCopies, (bool) false);
+    XME_CHECK(!sourceDataStore->manipulated && !sinkDataStore->manipulated, (bool) false);
+
+    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(sinkDataStore->attributes, xme_core_dataHandler_database_attribute_t, sinkAttribute);
+    {
+        if (!sinkAttribute->transferSourceAttribute->dataAvailable)
+        {
+            return (bool) false;
+        }
+    }
+    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
+
+    return (bool) true;
 }
 
 xme_status_t
@@ -103,6 +176,16 @@ xme_core_dataHandler_database_writeData
     // Get the number of bytes to use in the write operation.
     dataSizeInBytes = getBytesToCopy(dataStore->topicSize, sourceBufferSizeInBytes, offsetInBytes);
 
+    // Copy-on-write of buffers shared by transfers. 
+    status = unshareDataStore(dataStore);
+    XME_CHECK_REC(
+        XME_STATUS_SUCCESS == status,
+        status,
+        {
+            *writtenBytes = 0U;
+        }
+    );
+
     // The write should always be performed in master database. 
     // Get database address. 
     databaseAddress = getAddressFromMemoryCopy(dataStore->memoryRegion, XME_CORE_DATAHANDLER_DATABASE_INDEX_MASTER - 1U);
@@ -198,6 +281,16 @@ xme_core_dataHandler_database_writeAttribute
     // Get the number of bytes to use in the write operation.
     attributeSizeInBytes = getBytesToCopy(attribute->attributeValueSize, sourceBufferSizeInBytes, offsetInBytes);
 
+    // Copy-on-write of buffers shared by transfers. 
+    status = unshareDataStore(dataStore);
+    XME_CHECK_REC(
+        XME_STATUS_SUCCESS == status,
+        status,
+        {
+            *writtenBytes = 0U;
+        }
+    );
+
     // The write should always be performed in master database. 
     // Get database address. 
     databaseAddress = getAddressFromMemoryCopy(dataStore->memoryRegion, XME_CORE_DATAHANDLER_DATABASE_INDEX_MASTER - 1U);
@@ -250,6 +343,7 @@ xme_core_dataHandler_database_readData
     uintptr_t dataAddress;
     size_t dataSizeInBytes;
     xme_core_dataHandler_database_dataStore_t* dataStore;
+    xme_core_dataHandler_database_dataStore_t* bufferDataStore;
     size_t totalOffset;
     void* returnAddress;
     void* databaseAddress;
@@ -271,8 +365,11 @@ xme_core_dataHandler_database_readData
         return XME_STATUS_INVALID_PARAMETER;
     }
 
+    // After a shared transfer, the data is located in the buffer of the source. 
+    XME_CHECK(XME_STATUS_SUCCESS == getSharedDataStore(dataStore, &bufferDataStore), XME_STATUS_NOT_FOUND);
+
     // Calculate the total offset to add.
-    totalOffset = dataStore->topicOffset + offsetInBytes;
+    totalOffset = bufferDataStore->topicOffset + offsetInBytes;
 
     // Add queue write position. 
     if (dataStore->queueSize > 1)
@@ -284,7 +381,7 @@ xme_core_dataHandler_database_readData
     dataSizeInBytes = getBytesToCopy(dataStore->topicSize, targetBufferSizeInBytes, offsetInBytes);
 
     // Get database address from the active database in the data packet. 
-    databaseAddress = getAddressFromMemoryCopy(dataStore->memoryRegion, dataStore->activeDatabaseIndex - 1U);
+    databaseAddress = getAddressFromMemoryCopy(bufferDataStore->memoryRegion, dataStore->activeDatabaseIndex - 1U);
 
     // Check that the database address and size contains correct values. 
     XME_CHECK(0U != databaseAddress, XME_STATUS_NOT_FOUND);
@@ -327,7 +424,9 @@ xme_core_dataHandler_database_readAttribute
     uintptr_t attributeAddress;
     size_t attributeSizeInBytes;
     xme_core_dataHandler_database_dataStore_t* dataStore;
+    xme_core_dataHandler_database_dataStore_t* bufferDataStore;
     xme_core_dataHandler_database_attribute_t* attribute;
+    xme_core_dataHandler_database_attribute_t* bufferAttribute;
     size_t totalOffset;
     void* returnAddress;
     void* databaseAddress;
@@ -346,8 +445,12 @@ xme_core_dataHandler_database_readAttribute
     // Return an error if an attempt is made to read outside the bounds of the data packet
     XME_CHECK(offsetInBytes < attribute->attributeValueSize, XME_STATUS_INVALID_PARAMETER);
 
+    // After a shared transfer, the attribute is located in the buffer of the source. 
+    XME_CHECK(XME_STATUS_SUCCESS == getSharedDataStore(dataStore, &bufferDataStore), XME_STATUS_NOT_FOUND);
+    bufferAttribute = (bufferDataStore == dataStore) ? attribute : attribute->transferSourceAttribute;
+
     // Calculate the total offset to add.
-    totalOffset = attribute->attributeOffset + offsetInBytes;
+    totalOffset = bufferAttribute->attributeOffset + offsetInBytes;
 
     // Add queue write position. 
     if (dataStore->queueSize > 1)
@@ -359,7 +462,7 @@ xme_core_dataHandler_database_readAttribute
     attributeSizeInBytes = getBytesToCopy(attribute->attributeValueSize, targetBufferSizeInBytes, offsetInBytes);
 
     // Get database address from the active database in the data packet. 
-    databaseAddress = getAddressFromMemoryCopy(dataStore->memoryRegion, dataStore->activeDatabaseIndex - 1U);
+    databaseAddress = getAddressFromMemoryCopy(bufferDataStore->memoryRegion, dataStore->activeDatabaseIndex - 1U);
 
     // Check that the database address and size contains correct values. 
     XME_CHECK(0U != databaseAddress, XME_STATUS_NOT_FOUND);
@@ -425,6 +528,66 @@ xme_core_dataHandler_database_transfer
     // Make the comparations between source and destination size. 
     XME_CHECK(sourceDataStore->topicSize == sinkDataStore->topicSize, XME_STATUS_INVALID_CONFIGURATION);
 
+    // The buffer of the source is accessed directly, so it must not be shared from another data store. 
+    if (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != sourceDataStore->sharedSourceID)
+    {
+        status = unshareDataStore(sourceDataStore);
+        XME_CHECK(XME_STATUS_SUCCESS == status, status);
+    }
+
+    // The attribute table of a sink sharing the buffer of another source is still in use. 
+    if (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != sinkDataStore->sharedSourceID &&
+        sinkDataStore->sharedSourceID != sourceDataStore->dataStoreID)
+    {
+        status = unshareDataStore(sinkDataStore);
+        XME_CHECK(XME_STATUS_SUCCESS == status, status);
+    }
+
+    status = updateTransferAttributes(sinkDataStore, sourceDataStore);
+    XME_CHECK(XME_STATUS_SUCCESS == status, status);
+
+    if (isSharedTransferPossible(sourceDataStore, sinkDataStore))
+    {
+        // Sinks sharing the buffer of this sink get their own copy before the sink changes. 
+        if (sinkDataStore->sharedReferenceCount > 0U)
+        {
+            status = unshareDataStore(sinkDataStore);
+            XME_CHECK(XME_STATUS_SUCCESS == status, status);
+        }
+
+        // Let the sink read the buffer of the source until one of them is modified. 
+        if (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID == sinkDataStore->sharedSourceID)
+        {
+            sinkDataStore->sharedSourceID = sourceDataStore->dataStoreID;
+            sinkDataStore->nextSharerID = sourceDataStore->firstSharerID;
+            sourceDataStore->firstSharerID = sinkDataStore->dataStoreID;
+            sourceDataStore->sharedReferenceCount++;
+        }
+
+        // The own buffer of the sink is completely overwritten before it is used again. 
+        sinkDataStore->resetPending = (bool) false;
+
+        XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(sinkDataStore->attributes, xme_core_dataHandler_database_attribute_t, sinkAttribute);
+        {
+            XME_CHECK(XME_STATUS_SUCCESS == setAttributeAvailability(sinkAttribute, (bool) true), XME_STATUS_INTERNAL_ERROR);
+        }
+        XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
+
+        XME_CHECK(XME_STATUS_SUCCESS == setDataAvailability(sinkDataStore, (bool) true), XME_STATUS_INVALID_CONFIGURATION);
+
+        if (isOverwrite == true)
+        {
+            status = checkOverwriteAfterWrite(sinkDataStore);
+            XME_CHECK(XME_STATUS_SUCCESS == status, status);
+        }
+
+        return XME_STATUS_SUCCESS;
+    }
+
+    // The sink is only partially overwritten by the copy below. 
+    status = unshareDataStore(sinkDataStore);
+    XME_CHECK(XME_STATUS_SUCCESS == status, status);
+
     // Calculate the total offsets to add.
     totalSourceOffset = sourceDataStore->topicOffset;
     totalSinkOffset = sinkDataStore->topicOffset;
@@ -471,8 +634,8 @@ xme_core_dataHandler_database_transfer
         {
             xme_core_dataHandler_database_attribute_t* sourceAttribute;
 
-            status = getAttribute(sourceDataStore, sinkAttribute->key, &sourceAttribute);
-            if ((XME_STATUS_SUCCESS == status) && sourceAttribute->dataAvailable)
+            sourceAttribute = sinkAttribute->transferSourceAttribute;
+            if ((NULL != sourceAttribute) && sourceAttribute->dataAvailable)
             {
                 // If the attribute exists in the target data packet.
                 size_t totalSourceAttributeOffset;
@@ -538,12 +701,40 @@ xme_core_dataHandler_database_resetData
     xme_core_dataHandler_database_dataStore_t* dataStore;
     void* returnAddress;
     void* databaseAddress;
+    xme_status_t status;
 
     XME_ASSERT(NULL != xme_core_dataHandler_database);
 
     // Get the data packet information. 
     XME_CHECK(XME_STATUS_SUCCESS == getDataStore(dataStoreID, &dataStore), XME_STATUS_INVALID_HANDLE);
 
+    // The whole content is cleared, so a buffer shared from a source does not need to be copied. 
+    status = releaseSharedData(dataStore);
+    XME_CHECK(XME_STATUS_SUCCESS == status, status);
+
+    if (sharedTransfer && !dataStore->persistency && 1U == dataStore->queueSize &&
+        1U == dataStore->memoryRegion->numOfCopies && !dataStore->manipulated)
+    {
+        // The cleared content cannot be read until the data store is written again. 
+        // Clear the buffer only before the next access, so that sinks which still share 
+        // it do not need their own copy and consuming the data of a sink costs nothing. 
+        dataStore->resetPending = (bool) true;
+
+        XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(dataStore->attributes, xme_core_dataHandler_database_attribute_t, attribute);
+        {
+            attribute->dataAvailable = (bool) false;
+        }
+        XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
+
+        dataStore->dataAvailable = (bool) false;
+
+        return XME_STATUS_SUCCESS;
+    }
+
+    // Sinks sharing the buffer of this data store get their own copy. 
+    status = unshareDataStore(dataStore);
+    XME_CHECK(XME_STATUS_SUCCESS == status, status);
+
     // Get database address. 
     databaseAddress = getAddressFromMemoryCopy(dataStore->memoryRegion, dataStore->activeDatabaseIndex - 1U);
 
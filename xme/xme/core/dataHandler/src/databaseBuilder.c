@@ -980,6 +980,15 @@ createDataStoreInDatabase
     databaseDataStore->statusOnOverwrite = builderDataStore->statusOnOverwrite;
     databaseDataStore->displayWarningOnOverwrite =  builderDataStore->displayWarningOnOverwrite;
 
+    // No transfer took place yet. 
+    databaseDataStore->transferSourceID = XME_CORE_DATAMANAGER_DATAPACKETID_INVALID;
+    databaseDataStore->transferShareable = (bool) false;
+    databaseDataStore->sharedSourceID = XME_CORE_DATAMANAGER_DATAPACKETID_INVALID;
+    databaseDataStore->sharedReferenceCount = 0U;
+    databaseDataStore->firstSharerID = XME_CORE_DATAMANAGER_DATAPACKETID_INVALID;
+    databaseDataStore->nextSharerID = XME_CORE_DATAMANAGER_DATAPACKETID_INVALID;
+    databaseDataStore->resetPending = (bool) false;
+
     // Initialize attributes. 
     XME_HAL_SINGLYLINKEDLIST_INIT(databaseDataStore->attributes);
 
@@ -1023,6 +1032,7 @@ addAttributesToDataStoreInDatabase
     newAttribute->attributeValueSize = builderAttribute->attributeValueSize;
     newAttribute->attributeOffset = 0U; 
     newAttribute->dataAvailable = (bool) false;
+    newAttribute->transferSourceAttribute = NULL;
 
     // This is the right place to include the attribute. 
     XME_CHECK(XME_STATUS_SUCCESS == xme_hal_singlyLinkedList_addItem(&dataStore->attributes, newAttribute), XME_STATUS_INVALID_CONFIGURATION);
@@ -42,6 +42,26 @@ xme_core_dataHandler_database_t* xme_core_dataHandler_database =  NULL;
  */
 xme_core_dataHandler_database_manipulationTable_t manipulationsTable;
 
+/******************************************************************************/
+/***   Prototypes                                                           ***/
+/******************************************************************************/
+
+/**
+ * \brief Copies the content of the buffer shared by a sink into its own buffer
+ *        and stops sharing it. 
+ *
+ * \param[in,out] dataStore The data store which may share the buffer of its source. 
+ *
+ * \retval XME_STATUS_SUCCESS If the data store uses its own buffer. 
+ * \retval XME_STATUS_NOT_FOUND If a buffer cannot be located. 
+ * \retval XME_STATUS_INTERNAL_ERROR If the content cannot be copied. 
+ */
+static xme_status_t
+copySharedData
+(
+    xme_core_dataHandler_database_dataStore_t* const dataStore
+);
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
@@ -651,3 +671,192 @@ checkOverwriteAfterWrite
     return dataStore->statusOnOverwrite;
 }
 
+xme_status_t
+updateTransferAttributes
+(
+    xme_core_dataHandler_database_dataStore_t* const sinkDataStore,
+    xme_core_dataHandler_database_dataStore_t* const sourceDataStore
+)
+{
+    bool shareable = (bool) true;
+
+    if (sinkDataStore->transferSourceID == sourceDataStore->dataStoreID)
+    {
+        return XME_STATUS_SUCCESS;
+    }
+
+    // A shared buffer is interpreted through the table of its source. 
+    XME_ASSERT(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID == sinkDataStore->sharedSourceID);
+
+    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(sinkDataStore->attributes, xme_core_dataHandler_database_attribute_t, sinkAttribute);
+    {
+        xme_core_dataHandler_database_attribute_t* sourceAttribute;
+
+        if (XME_STATUS_SUCCESS != getAttribute(sourceDataStore, sinkAttribute->key, &sourceAttribute))
+        {
+            sourceAttribute = NULL;
+            shareable = (bool) false;
+        }
+        else if (sourceAttribute->attributeValueSize != sinkAttribute->attributeValueSize)
+        {
+            shareable = (bool) false;
+        }
+
+        sinkAttribute->transferSourceAttribute = sourceAttribute;
+    }
+    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
+
+    sinkDataStore->transferSourceID = sourceDataStore->dataStoreID;
+    sinkDataStore->transferShareable = shareable;
+
+    return XME_STATUS_SUCCESS;
+}
+
+xme_status_t
+getSharedDataStore
+(
+    xme_core_dataHandler_database_dataStore_t* const dataStore,
+    xme_core_dataHandler_database_dataStore_t** const bufferDataStore
+)
+{
+    if (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID == dataStore->sharedSourceID)
+    {
+        *bufferDataStore = dataStore;
+        return XME_STATUS_SUCCESS;
+    }
+
+    return getDataStore(dataStore->sharedSourceID, bufferDataStore);
+}
+
+xme_status_t
+releaseSharedData
+(
+    xme_core_dataHandler_database_dataStore_t* const dataStore
+)
+{
+    xme_core_dataHandler_database_dataStore_t* sourceDataStore;
+    xme_core_dataManager_dataStoreID_t* sharerID;
+
+    if (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID == dataStore->sharedSourceID)
+    {
+        return XME_STATUS_SUCCESS;
+    }
+
+    XME_CHECK(XME_STATUS_SUCCESS == getDataStore(dataStore->sharedSourceID, &sourceDataStore), XME_STATUS_NOT_FOUND);
+    XME_ASSERT(sourceDataStore->sharedReferenceCount > 0U);
+
+    // Unlink the data store from the sharers of the source. 
+    sharerID = &sourceDataStore->firstSharerID;
+    while (*sharerID != dataStore->dataStoreID)
+    {
+        xme_core_dataHandler_database_dataStore_t* sharerDataStore;
+
+        XME_CHECK(XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != *sharerID, XME_STATUS_NOT_FOUND);
+        XME_CHECK(XME_STATUS_SUCCESS == getDataStore(*sharerID, &sharerDataStore), XME_STATUS_NOT_FOUND);
+        sharerID = &sharerDataStore->nextSharerID;
+    }
+    *sharerID = dataStore->nextSharerID;
+
+    sourceDataStore->sharedReferenceCount--;
+    dataStore->sharedSourceID = XME_CORE_DATAMANAGER_DATAPACKETID_INVALID;
+    dataStore->nextSharerID = XME_CORE_DATAMANAGER_DATAPACKETID_INVALID;
+
+    return XME_STATUS_SUCCESS;
+}
+
+static xme_status_t
+copySharedData
+(
+    xme_core_dataHandler_database_dataStore_t* const dataStore
+)
+{
+    xme_core_dataHandler_database_dataStore_t* sourceDataStore;
+    void* sourceDatabaseAddress;
+    void* sinkDatabaseAddress;
+    uintptr_t sinkAddress;
+    void* returnAddress;
+
+    XME_CHECK(XME_STATUS_SUCCESS == getSharedDataStore(dataStore, &sourceDataStore), XME_STATUS_NOT_FOUND);
+
+    if (sourceDataStore == dataStore)
+    {
+        return XME_STATUS_SUCCESS;
+    }
+
+    // A reset ends the sharing, so its buffer cannot be cleared later. 
+    XME_ASSERT(!dataStore->resetPending);
+
+    // Shared transfers only take place between data stores in memory regions without further copies. 
+    sourceDatabaseAddress = getAddressFromMemoryCopy(sourceDataStore->memoryRegion, XME_CORE_DATAHANDLER_DATABASE_INDEX_MASTER - 1U);
+    sinkDatabaseAddress = getAddressFromMemoryCopy(dataStore->memoryRegion, XME_CORE_DATAHANDLER_DATABASE_INDEX_MASTER - 1U);
+    XME_CHECK(NULL != sourceDatabaseAddress, XME_STATUS_NOT_FOUND);
+    XME_CHECK(NULL != sinkDatabaseAddress, XME_STATUS_NOT_FOUND);
+
+    sinkAddress = (uintptr_t) sinkDatabaseAddress + dataStore->topicOffset;
+    returnAddress = xme_hal_mem_copy((void*) sinkAddress, (void*) ((uintptr_t) sourceDatabaseAddress + sourceDataStore->topicOffset), dataStore->topicSize);
+    XME_CHECK(returnAddress == (void*) sinkAddress, XME_STATUS_INTERNAL_ERROR);
+
+    XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(dataStore->attributes, xme_core_dataHandler_database_attribute_t, attribute);
+    {
+        // The data store only shares the buffer if every attribute has a counterpart of the same size. 
+        XME_ASSERT(NULL != attribute->transferSourceAttribute);
+
+        sinkAddress = (uintptr_t) sinkDatabaseAddress + attribute->attributeOffset;
+        returnAddress = xme_hal_mem_copy((void*) sinkAddress, (void*) ((uintptr_t) sourceDatabaseAddress + attribute->transferSourceAttribute->attributeOffset), attribute->attributeValueSize);
+        XME_CHECK(returnAddress == (void*) sinkAddress, XME_STATUS_INTERNAL_ERROR);
+    }
+    XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
+
+    return releaseSharedData(dataStore);
+}
+
+xme_status_t
+unshareDataStore
+(
+    xme_core_dataHandler_database_dataStore_t* const dataStore
+)
+{
+    xme_status_t status;
+
+    status = copySharedData(dataStore);
+    XME_CHECK(XME_STATUS_SUCCESS == status, status);
+
+    // Give every sink reading the buffer of this data store its own copy. 
+    // Copying unlinks the sink, so the list is always processed from its head. 
+    while (XME_CORE_DATAMANAGER_DATAPACKETID_INVALID != dataStore->firstSharerID)
+    {
+        xme_core_dataHandler_database_dataStore_t* sinkDataStore;
+
+        XME_CHECK(XME_STATUS_SUCCESS == getDataStore(dataStore->firstSharerID, &sinkDataStore), XME_STATUS_NOT_FOUND);
+        status = copySharedData(sinkDataStore);
+        XME_CHECK(XME_STATUS_SUCCESS == status, status);
+    }
+    XME_ASSERT(0U == dataStore->sharedReferenceCount);
+
+    if (dataStore->resetPending)
+    {
+        void* databaseAddress;
+        uintptr_t dataAddress;
+        void* returnAddress;
+
+        // Deferred resets only take place in memory regions without further copies. 
+        databaseAddress = getAddressFromMemoryCopy(dataStore->memoryRegion, XME_CORE_DATAHANDLER_DATABASE_INDEX_MASTER - 1U);
+        XME_CHECK(NULL != databaseAddress, XME_STATUS_NOT_FOUND);
+
+        dataAddress = (uintptr_t) databaseAddress + dataStore->topicOffset;
+        returnAddress = xme_hal_mem_set((void*) dataAddress, 0U, dataStore->topicSize);
+        XME_CHECK(returnAddress == (void*) dataAddress, XME_STATUS_INTERNAL_ERROR);
+
+        XME_HAL_SINGLYLINKEDLIST_ITERATE_BEGIN(dataStore->attributes, xme_core_dataHandler_database_attribute_t, attribute);
+        {
+            dataAddress = (uintptr_t) databaseAddress + attribute->attributeOffset;
+            returnAddress = xme_hal_mem_set((void*) dataAddress, 0U, attribute->attributeValueSize);
+            XME_CHECK(returnAddress == (void*) dataAddress, XME_STATUS_INTERNAL_ERROR);
+        }
+        XME_HAL_SINGLYLINKEDLIST_ITERATE_END();
+
+        dataStore->resetPending = (bool) false;
+    }
+
+    return XME_STATUS_SUCCESS;
+}
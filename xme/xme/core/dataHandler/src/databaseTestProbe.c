@@ -136,6 +136,9 @@ xme_core_dataHandler_databaseTestProbe_writeData
 
     XME_CHECK(XME_STATUS_SUCCESS == getDataStore(dataStoreID, &dataStore), XME_STATUS_INVALID_HANDLE);
 
+    // The test probe accesses the buffer of the data store directly. 
+    XME_CHECK(XME_STATUS_SUCCESS == unshareDataStore(dataStore), XME_STATUS_INTERNAL_ERROR);
+
     XME_CHECK(databaseIndex <= dataStore->memoryRegion->numOfCopies, XME_STATUS_INVALID_CONFIGURATION);
 
     if (offsetInBytes >= dataStore->topicSize)
@@ -220,6 +223,9 @@ xme_core_dataHandler_databaseTestProbe_writeAttribute
     // Obtain first the data packet and then the attribute.  
     XME_CHECK(XME_STATUS_SUCCESS == getDataStore(dataStoreID, &dataStore), XME_STATUS_INVALID_HANDLE);
 
+    // The test probe accesses the buffer of the data store directly. 
+    XME_CHECK(XME_STATUS_SUCCESS == unshareDataStore(dataStore), XME_STATUS_INTERNAL_ERROR);
+
     XME_CHECK(XME_STATUS_SUCCESS == getAttribute(dataStore, attributeKey, &attribute), XME_STATUS_INVALID_PARAMETER);
 
     XME_CHECK(databaseIndex <= dataStore->memoryRegion->numOfCopies, XME_STATUS_INVALID_CONFIGURATION);
@@ -303,6 +309,9 @@ xme_core_dataHandler_databaseTestProbe_readData
 
     XME_CHECK(XME_STATUS_SUCCESS == getDataStore(dataStoreID, &dataStore), XME_STATUS_INVALID_HANDLE);
 
+    // The test probe accesses the buffer of the data store directly. 
+    XME_CHECK(XME_STATUS_SUCCESS == unshareDataStore(dataStore), XME_STATUS_INTERNAL_ERROR);
+
     XME_CHECK(databaseIndex <= dataStore->memoryRegion->numOfCopies, XME_STATUS_INVALID_CONFIGURATION);
 
     if (!dataStore->dataAvailable)
@@ -395,6 +404,9 @@ xme_core_dataHandler_databaseTestProbe_readAttribute
 
     // Obtain first the data packet and then the attribute.  
     XME_CHECK(XME_STATUS_SUCCESS == getDataStore(dataStoreID, &dataStore), XME_STATUS_INVALID_HANDLE);
+
+    // The test probe accesses the buffer of the data store directly. 
+    XME_CHECK(XME_STATUS_SUCCESS == unshareDataStore(dataStore), XME_STATUS_INTERNAL_ERROR);
     XME_CHECK(XME_STATUS_SUCCESS == getAttribute(dataStore, attributeKey, &attribute), XME_STATUS_INVALID_PARAMETER);
 
     XME_CHECK(databaseIndex <= dataStore->memoryRegion->numOfCopies, XME_STATUS_INVALID_CONFIGURATION);
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2011-2014, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Data Handler shared transfer test.
+ *
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "xme/core/dataHandler/include/dataHandlerConfigurator.h"
+#include "xme/core/dataHandler/include/dataHandler.h"
+#include "xme/core/dataHandler/internal/databaseInternalMethods.h"
+#include "xme/core/broker/include/broker.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define SHAREDTRANSFER_TEST_TOPIC_SIZE 4096U
+
+/******************************************************************************/
+/***   Classes                                                              ***/
+/******************************************************************************/
+class DataHandlerSharedTransferInterfaceTest : public ::testing::TestWithParam<xme_core_dataHandler_transferMode_t>
+{
+    protected:
+        DataHandlerSharedTransferInterfaceTest()
+            : attributeKey1(1U)
+            , attributeKey2(2U)
+            , attributeKey3(3U)
+        {
+            setUpDataPackets();
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setTransferMode(GetParam()));
+        }
+
+        virtual
+        ~DataHandlerSharedTransferInterfaceTest()
+        {
+            tearDownDataPackets();
+        }
+
+        //
+        // Publisher:             | topic | a1 | a2 |
+        // Subscriber:            | topic | a1 | a2 | (same layout)
+        // Persistent subscriber: | topic | a2 |      (persistent, subset of the attributes)
+        // Foreign subscriber:    | topic | a3 |      (attribute not provided, always copied)
+        // Queue subscriber:      | topic | a1 |      (queue, always copied)
+        //
+        void
+        setUpDataPackets()
+        {
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_init(NULL));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_init());
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createDataPacket(SHAREDTRANSFER_TEST_TOPIC_SIZE, &publisher));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createAttribute(sizeof(uint32_t), attributeKey1, publisher));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createAttribute(sizeof(uint64_t), attributeKey2, publisher));
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createDataPacket(SHAREDTRANSFER_TEST_TOPIC_SIZE, &subscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createAttribute(sizeof(uint32_t), attributeKey1, subscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createAttribute(sizeof(uint64_t), attributeKey2, subscriber));
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createDataPacket(SHAREDTRANSFER_TEST_TOPIC_SIZE, &persistentSubscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createAttribute(sizeof(uint64_t), attributeKey2, persistentSubscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setDataPacketPersistency(persistentSubscriber, true));
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createDataPacket(SHAREDTRANSFER_TEST_TOPIC_SIZE, &foreignSubscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createAttribute(sizeof(uint32_t), attributeKey3, foreignSubscriber));
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createDataPacket(SHAREDTRANSFER_TEST_TOPIC_SIZE, &queueSubscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createAttribute(sizeof(uint32_t), attributeKey1, queueSubscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setDataPacketQueueSize(queueSubscriber, 2U));
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_configure());
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(publisher, subscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(publisher, persistentSubscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(publisher, foreignSubscriber));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(publisher, queueSubscriber));
+        }
+
+        void
+        tearDownDataPackets()
+        {
+            xme_core_dataHandler_fini();
+            xme_core_broker_fini();
+        }
+
+        void
+        writeTopic(xme_core_dataManager_dataPacketId_t dataPacketID, uint8_t pattern, size_t size)
+        {
+            std::vector<uint8_t> buffer(size);
+
+            for (size_t i = 0U; i < size; i++)
+            {
+                buffer[i] = (uint8_t) (pattern + i);
+            }
+
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeData(dataPacketID, &buffer[0], size));
+        }
+
+        // Publishes a complete sample, which the broker transfers to all subscribers.
+        void
+        publish(uint8_t pattern, uint32_t attribute1, uint64_t attribute2)
+        {
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startWriteOperation(publisher));
+            writeTopic(publisher, pattern, SHAREDTRANSFER_TEST_TOPIC_SIZE);
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeAttribute(publisher, attributeKey1, &attribute1, sizeof(attribute1)));
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeAttribute(publisher, attributeKey2, &attribute2, sizeof(attribute2)));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeWriteOperation(publisher));
+        }
+
+        // Reads the topic and the given attributes and appends everything a reader can observe.
+        void
+        observe(xme_core_dataManager_dataPacketId_t dataPacketID, const std::vector<uint32_t>& keys)
+        {
+            std::vector<uint8_t> buffer(SHAREDTRANSFER_TEST_TOPIC_SIZE, 0xAAU);
+            uint32_t bytesRead = 0U;
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startReadOperation(dataPacketID));
+
+            observations.push_back(xme_core_dataHandler_readData(dataPacketID, &buffer[0], buffer.size(), &bytesRead));
+            observations.push_back(bytesRead);
+            observations.insert(observations.end(), buffer.begin(), buffer.end());
+
+            for (size_t i = 0U; i < keys.size(); i++)
+            {
+                uint64_t value = 0xAAAAAAAAAAAAAAAAULL;
+                size_t size = (attributeKey2 == keys[i]) ? sizeof(uint64_t) : sizeof(uint32_t);
+
+                bytesRead = 0U;
+                observations.push_back(xme_core_dataHandler_readAttribute(dataPacketID, keys[i], &value, size, &bytesRead));
+                observations.push_back(bytesRead);
+                observations.push_back((uint32_t) value);
+                observations.push_back((uint32_t) (value >> 32));
+            }
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeReadOperation(dataPacketID));
+        }
+
+        void
+        observeSubscribers()
+        {
+            std::vector<uint32_t> keys;
+
+            keys.push_back(attributeKey1);
+            keys.push_back(attributeKey2);
+            observe(subscriber, keys);
+            observe(persistentSubscriber, std::vector<uint32_t>(1U, attributeKey2));
+            observe(foreignSubscriber, std::vector<uint32_t>(1U, attributeKey3));
+            observe(queueSubscriber, std::vector<uint32_t>(1U, attributeKey1));
+        }
+
+        // Returns the first byte of the topic, or 0 if no data is available.
+        uint8_t
+        firstByte(xme_core_dataManager_dataPacketId_t dataPacketID)
+        {
+            uint8_t buffer[SHAREDTRANSFER_TEST_TOPIC_SIZE];
+            uint32_t bytesRead = 0U;
+            xme_status_t status;
+
+            buffer[0] = 0U;
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startReadOperation(dataPacketID));
+            status = xme_core_dataHandler_readData(dataPacketID, buffer, sizeof(buffer), &bytesRead);
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeReadOperation(dataPacketID));
+
+            return (XME_STATUS_SUCCESS == status) ? buffer[0] : 0U;
+        }
+
+        // Runs a sequence of writes and reads covering copy-on-write of publishers and subscribers.
+        void
+        runScenario()
+        {
+            uint32_t attribute1 = 0x33333333U;
+            uint64_t attribute2 = 0x4444444444444444ULL;
+
+            publish(0x10U, 0x11111111U, 0x2222222222222222ULL);
+            observeSubscribers();
+
+            // Modifying the publisher must not change what the persistent subscriber sees.
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startWriteOperation(publisher));
+            writeTopic(publisher, 0x50U, 16U);
+            EXPECT_EQ(0x10U, firstByte(persistentSubscriber));
+            observe(persistentSubscriber, std::vector<uint32_t>(1U, attributeKey2));
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeAttribute(publisher, attributeKey1, &attribute1, sizeof(attribute1)));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeWriteOperation(publisher));
+            observeSubscribers();
+
+            // Modifying a subscriber must not change the publisher.
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startWriteOperation(persistentSubscriber));
+            writeTopic(persistentSubscriber, 0x90U, 8U);
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeWriteOperation(persistentSubscriber));
+            observe(persistentSubscriber, std::vector<uint32_t>(1U, attributeKey2));
+
+            // The subscriber keeps the sample while the next one is written.
+            publish(0x20U, 0x55555555U, 0x6666666666666666ULL);
+            observe(persistentSubscriber, std::vector<uint32_t>(1U, attributeKey2));
+            observe(foreignSubscriber, std::vector<uint32_t>(1U, attributeKey3));
+            observe(queueSubscriber, std::vector<uint32_t>(1U, attributeKey1));
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startWriteOperation(publisher));
+            writeTopic(publisher, 0x30U, SHAREDTRANSFER_TEST_TOPIC_SIZE);
+            EXPECT_EQ(0x20U, firstByte(subscriber));
+            observe(persistentSubscriber, std::vector<uint32_t>(1U, attributeKey2));
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeAttribute(publisher, attributeKey2, &attribute2, sizeof(attribute2)));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeWriteOperation(publisher));
+            observeSubscribers();
+
+            publish(0x40U, 0x77777777U, 0x8888888888888888ULL);
+            observeSubscribers();
+            observeSubscribers();
+        }
+
+        bool
+        isSharing(xme_core_dataManager_dataPacketId_t sink)
+        {
+            xme_core_dataHandler_database_dataStore_t* dataStore;
+
+            EXPECT_EQ(XME_STATUS_SUCCESS, getDataStore(sink, &dataStore));
+
+            return dataStore->sharedSourceID == publisher;
+        }
+
+        xme_core_dataManager_dataPacketId_t publisher;
+        xme_core_dataManager_dataPacketId_t subscriber;
+        xme_core_dataManager_dataPacketId_t persistentSubscriber;
+        xme_core_dataManager_dataPacketId_t foreignSubscriber;
+        xme_core_dataManager_dataPacketId_t queueSubscriber;
+
+        uint32_t attributeKey1;
+        uint32_t attributeKey2;
+        uint32_t attributeKey3;
+
+        std::vector<uint32_t> observations;
+};
+
+/******************************************************************************/
+/***   Tests                                                                ***/
+/******************************************************************************/
+
+TEST(DataHandlerSharedTransferSimpleTest, SetTransferModeWithoutInitialization)
+{
+    EXPECT_EQ(XME_STATUS_INVALID_CONFIGURATION, xme_core_dataHandler_setTransferMode(XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED));
+    EXPECT_EQ(XME_CORE_DATAHANDLER_TRANSFERMODE_COPY, xme_core_dataHandler_getTransferMode());
+}
+
+TEST(DataHandlerSharedTransferSimpleTest, SetTransferModeWithInvalidMode)
+{
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_init());
+    EXPECT_EQ(XME_STATUS_INVALID_PARAMETER, xme_core_dataHandler_setTransferMode((xme_core_dataHandler_transferMode_t) 7));
+    EXPECT_EQ(XME_CORE_DATAHANDLER_TRANSFERMODE_COPY, xme_core_dataHandler_getTransferMode());
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setTransferMode(XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED));
+    EXPECT_EQ(XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED, xme_core_dataHandler_getTransferMode());
+    xme_core_dataHandler_fini();
+
+    // The finalization restores the default.
+    EXPECT_EQ(XME_CORE_DATAHANDLER_TRANSFERMODE_COPY, xme_core_dataHandler_getTransferMode());
+}
+
+TEST(DataHandlerSharedTransferSimpleTest, SharedTransferExcludesStripedLocking)
+{
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_init());
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setTransferMode(XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED));
+    EXPECT_EQ(XME_STATUS_INVALID_CONFIGURATION, xme_core_dataHandler_setLockingMode(XME_CORE_DATAHANDLER_LOCKINGMODE_STRIPED));
+    EXPECT_EQ(XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL, xme_core_dataHandler_getLockingMode());
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setTransferMode(XME_CORE_DATAHANDLER_TRANSFERMODE_COPY));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setLockingMode(XME_CORE_DATAHANDLER_LOCKINGMODE_STRIPED));
+    EXPECT_EQ(XME_STATUS_INVALID_CONFIGURATION, xme_core_dataHandler_setTransferMode(XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED));
+    EXPECT_EQ(XME_CORE_DATAHANDLER_TRANSFERMODE_COPY, xme_core_dataHandler_getTransferMode());
+
+    xme_core_dataHandler_fini();
+}
+
+TEST_P(DataHandlerSharedTransferInterfaceTest, ReadersObserveTheSameDataAsInCopyMode)
+{
+    std::vector<uint32_t> modeObservations;
+
+    runScenario();
+    modeObservations.swap(observations);
+
+    // Repeat the scenario with fresh data packets in copy mode.
+    tearDownDataPackets();
+    setUpDataPackets();
+    ASSERT_EQ(XME_CORE_DATAHANDLER_TRANSFERMODE_COPY, xme_core_dataHandler_getTransferMode());
+
+    runScenario();
+
+    ASSERT_EQ(observations.size(), modeObservations.size());
+    for (size_t i = 0U; i < observations.size(); i++)
+    {
+        ASSERT_EQ(observations[i], modeObservations[i]) << "Observation " << i << " differs";
+    }
+}
+
+TEST_P(DataHandlerSharedTransferInterfaceTest, SinksShareTheBufferOnlyInSharedMode)
+{
+    bool shared = (XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED == GetParam());
+
+    publish(0x10U, 0x11111111U, 0x2222222222222222ULL);
+
+    // The publisher has been consumed after the transfer, its sample stays shared.
+    EXPECT_EQ(shared, isSharing(subscriber));
+    EXPECT_EQ(shared, isSharing(persistentSubscriber));
+    EXPECT_FALSE(isSharing(foreignSubscriber));
+    EXPECT_FALSE(isSharing(queueSubscriber));
+
+    // Consuming a subscriber ends its sharing.
+    EXPECT_EQ(0x10U, firstByte(subscriber));
+    EXPECT_FALSE(isSharing(subscriber));
+    EXPECT_EQ(shared, isSharing(persistentSubscriber));
+
+    // Writing the publisher copies the sample for the persistent subscriber.
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startWriteOperation(publisher));
+    writeTopic(publisher, 0x20U, SHAREDTRANSFER_TEST_TOPIC_SIZE);
+    EXPECT_FALSE(isSharing(persistentSubscriber));
+    EXPECT_EQ(0x10U, firstByte(persistentSubscriber));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeWriteOperation(publisher));
+    EXPECT_EQ(0x20U, firstByte(persistentSubscriber));
+}
+
+INSTANTIATE_TEST_CASE_P
+(
+    TransferModes,
+    DataHandlerSharedTransferInterfaceTest,
+    ::testing::Values(XME_CORE_DATAHANDLER_TRANSFERMODE_COPY, XME_CORE_DATAHANDLER_TRANSFERMODE_SHARED)
+);
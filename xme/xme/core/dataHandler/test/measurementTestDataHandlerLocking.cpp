@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2011-2014, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Data Handler lock contention measurement test.
+ *
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "xme/core/dataHandler/include/dataHandlerConfigurator.h"
+#include "xme/core/dataHandler/include/dataHandler.h"
+#include "xme/core/broker/include/broker.h"
+#include "xme/core/log.h"
+#include "xme/hal/include/sched.h"
+#include "xme/hal/include/sleep.h"
+#include "xme/hal/include/sync.h"
+#include "xme/hal/include/time.h"
+
+#include <stdint.h>
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define MAXTHREADS 4U
+#define OPERATIONSPERTHREAD 20000U
+#define TRANSFERSPERTHREAD 5000U
+
+/******************************************************************************/
+/***   Type definitions                                                     ***/
+/******************************************************************************/
+typedef struct
+{
+    xme_core_dataManager_dataPacketId_t dataPacketID; ///< Data packet exclusively used by the thread.
+    xme_core_dataManager_dataPacketId_t sinkDataPacketID; ///< Data packet read by the thread in the transfer test.
+    uint32_t index; ///< Index of the thread.
+    uint32_t failures; ///< Number of operations that did not succeed.
+}
+lockingMeasurementThread_t;
+
+/******************************************************************************/
+/***   Variables                                                            ***/
+/******************************************************************************/
+static xme_hal_sync_criticalSectionHandle_t finishedCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+static uint16_t finishedThreads = 0U;
+static xme_core_dataManager_dataPacketId_t sharedDataPacketID = XME_CORE_DATAMANAGER_DATAPACKETID_INVALID;
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+static void
+lockingMeasurementTask(void* userData)
+{
+    lockingMeasurementThread_t* thread = (lockingMeasurementThread_t*) userData;
+    uint32_t writeBuffer;
+    uint32_t readBuffer;
+    uint32_t bytesRead;
+    uint32_t i;
+
+    for (i = 0U; i < OPERATIONSPERTHREAD; i++)
+    {
+        writeBuffer = i;
+        if (XME_STATUS_SUCCESS != xme_core_dataHandler_startWriteOperation(thread->dataPacketID))
+        {
+            thread->failures++;
+            continue;
+        }
+        (void) xme_core_dataHandler_writeData(thread->dataPacketID, &writeBuffer, sizeof(writeBuffer));
+        (void) xme_core_dataHandler_completeWriteOperation(thread->dataPacketID);
+
+        if (XME_STATUS_SUCCESS != xme_core_dataHandler_startReadOperation(thread->dataPacketID))
+        {
+            thread->failures++;
+            continue;
+        }
+        (void) xme_core_dataHandler_readData(thread->dataPacketID, &readBuffer, sizeof(readBuffer), &bytesRead);
+        (void) xme_core_dataHandler_completeReadOperation(thread->dataPacketID);
+
+        if (readBuffer != writeBuffer)
+        {
+            thread->failures++;
+        }
+    }
+
+    xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+    finishedThreads++;
+    xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+}
+
+static void
+transferMeasurementTask(void* userData)
+{
+    lockingMeasurementThread_t* thread = (lockingMeasurementThread_t*) userData;
+    uint32_t writeBuffer;
+    uint32_t readBuffer;
+    uint32_t bytesRead;
+    uint32_t i;
+
+    for (i = 0U; i < TRANSFERSPERTHREAD; i++)
+    {
+        // Completing the write transfers the sample to the sinks of all
+        // threads, some of which are in lower stripes than the source.
+        writeBuffer = (thread->index << 24) | i;
+        if (XME_STATUS_SUCCESS != xme_core_dataHandler_startWriteOperation(thread->dataPacketID))
+        {
+            thread->failures++;
+            continue;
+        }
+        (void) xme_core_dataHandler_writeData(thread->dataPacketID, &writeBuffer, sizeof(writeBuffer));
+        if (XME_STATUS_SUCCESS != xme_core_dataHandler_completeWriteOperation(thread->dataPacketID))
+        {
+            thread->failures++;
+        }
+
+        if (XME_STATUS_SUCCESS != xme_core_dataHandler_startReadOperation(thread->sinkDataPacketID))
+        {
+            thread->failures++;
+            continue;
+        }
+        bytesRead = 0U;
+        (void) xme_core_dataHandler_readData(thread->sinkDataPacketID, &readBuffer, sizeof(readBuffer), &bytesRead);
+        (void) xme_core_dataHandler_completeReadOperation(thread->sinkDataPacketID);
+
+        if (sizeof(readBuffer) != bytesRead || (readBuffer >> 24) >= MAXTHREADS)
+        {
+            thread->failures++;
+        }
+    }
+
+    xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+    finishedThreads++;
+    xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+}
+
+static void
+sharedSourceMeasurementTask(void* userData)
+{
+    lockingMeasurementThread_t* thread = (lockingMeasurementThread_t*) userData;
+    uint32_t writeBuffer;
+    uint32_t readBuffer;
+    uint32_t bytesRead;
+    uint32_t i;
+
+    for (i = 0U; i < TRANSFERSPERTHREAD; i++)
+    {
+        // A write that is denied because another thread's transfer from the
+        // same source is still in progress would lose the sample.
+        writeBuffer = (thread->index << 24) | i;
+        if (XME_STATUS_SUCCESS != xme_core_dataHandler_startWriteOperation(sharedDataPacketID))
+        {
+            thread->failures++;
+            continue;
+        }
+        (void) xme_core_dataHandler_writeData(sharedDataPacketID, &writeBuffer, sizeof(writeBuffer));
+        if (XME_STATUS_SUCCESS != xme_core_dataHandler_completeWriteOperation(sharedDataPacketID))
+        {
+            thread->failures++;
+        }
+
+        // Reading the own sink keeps its stripe busy for the transfers of
+        // the other threads.
+        if (XME_STATUS_SUCCESS != xme_core_dataHandler_startReadOperation(thread->sinkDataPacketID))
+        {
+            thread->failures++;
+            continue;
+        }
+        (void) xme_core_dataHandler_readData(thread->sinkDataPacketID, &readBuffer, sizeof(readBuffer), &bytesRead);
+        (void) xme_core_dataHandler_completeReadOperation(thread->sinkDataPacketID);
+    }
+
+    xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+    finishedThreads++;
+    xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+}
+
+class DataHandlerLockingMeasurementTest : public ::testing::TestWithParam<xme_core_dataHandler_lockingMode_t>
+{
+    protected:
+        DataHandlerLockingMeasurementTest()
+        {
+            uint16_t i;
+
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_init());
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sched_init());
+            finishedCriticalSection = xme_hal_sync_createCriticalSection();
+            EXPECT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, finishedCriticalSection);
+
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_broker_init(NULL));
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_init());
+
+            // One persistent internal data packet per thread and one
+            // persistent sink per thread, consecutive identifiers end up in
+            // different lock stripes.
+            for (i = 0U; i < MAXTHREADS; i++)
+            {
+                threads[i].index = i;
+                threads[i].failures = 0U;
+                EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createDataPacket(sizeof(uint32_t), &threads[i].dataPacketID));
+                EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setDataPacketPersistent(threads[i].dataPacketID));
+            }
+            for (i = 0U; i < MAXTHREADS; i++)
+            {
+                EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_createDataPacket(sizeof(uint32_t), &threads[i].sinkDataPacketID));
+                EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setDataPacketPersistent(threads[i].sinkDataPacketID));
+            }
+
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_configure());
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_setLockingMode(GetParam()));
+        }
+
+        virtual
+        ~DataHandlerLockingMeasurementTest()
+        {
+            xme_core_dataHandler_fini();
+            xme_core_broker_fini();
+
+            xme_hal_sync_destroyCriticalSection(finishedCriticalSection);
+            finishedCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+            xme_hal_sched_fini();
+            xme_hal_sync_fini();
+        }
+
+        // Starts numOfThreads one-shot tasks and waits until all of them are done.
+        void
+        runTasks(xme_hal_sched_taskCallback_t task, uint16_t numOfThreads)
+        {
+            uint16_t i;
+
+            finishedThreads = 0U;
+            for (i = 0U; i < numOfThreads; i++)
+            {
+                ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, task, &threads[i]));
+            }
+
+            while (getFinishedThreads() < numOfThreads)
+            {
+                xme_hal_sleep_sleep(((xme_hal_time_timeInterval_t)1000)*100); // 0.1 ms
+            }
+        }
+
+        uint16_t
+        getFinishedThreads(void)
+        {
+            uint16_t finished;
+
+            xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+            finished = finishedThreads;
+            xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+
+            return finished;
+        }
+
+        lockingMeasurementThread_t threads[MAXTHREADS];
+};
+
+/******************************************************************************/
+/***   Unit Tests                                                           ***/
+/******************************************************************************/
+
+INSTANTIATE_TEST_CASE_P
+(
+    DataHandlerLockingMeasurementTestInstance,
+    DataHandlerLockingMeasurementTest,
+    ::testing::Values(XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL, XME_CORE_DATAHANDLER_LOCKINGMODE_STRIPED)
+);
+
+TEST_P(DataHandlerLockingMeasurementTest, MeasureThroughputWithConcurrentThreads)
+{
+    uint16_t numOfThreads;
+    uint16_t i;
+
+    EXPECT_EQ(GetParam(), xme_core_dataHandler_getLockingMode());
+
+    for (numOfThreads = 1U; numOfThreads <= MAXTHREADS; numOfThreads = numOfThreads * 2U)
+    {
+        xme_hal_time_timeHandle_t startTime;
+        uint64_t microSeconds;
+        uint64_t operations = ((uint64_t) numOfThreads) * OPERATIONSPERTHREAD * 2U;
+
+        startTime = xme_hal_time_getCurrentTime();
+        runTasks(lockingMeasurementTask, numOfThreads);
+        microSeconds = xme_hal_time_timeIntervalInMicroseconds(xme_hal_time_getTimeInterval(&startTime, false));
+
+        for (i = 0U; i < numOfThreads; i++)
+        {
+            EXPECT_EQ(0U, threads[i].failures);
+        }
+
+        XME_LOG
+        (
+            XME_LOG_NOTE,
+            "[DataHandlerLockingMeasurementTest] %s locking, %d threads: %d read/write operations in %d us (%d operations/s).\n",
+            (XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL == GetParam()) ? "global" : "striped",
+            numOfThreads, (uint32_t) operations, (uint32_t) microSeconds,
+            (uint32_t) ((0U == microSeconds) ? 0U : (operations * 1000000U) / microSeconds)
+        );
+    }
+}
+
+TEST_P(DataHandlerLockingMeasurementTest, TransfersAcrossStripesUnderContention)
+{
+    xme_hal_time_timeHandle_t startTime;
+    uint64_t microSeconds;
+    uint16_t i;
+    uint16_t j;
+
+    // Every source is routed to the sinks of all threads, hence each write
+    // transfers to data packets in lower and higher stripes while the other
+    // threads hold these stripes for their own transfers and reads.
+    for (i = 0U; i < MAXTHREADS; i++)
+    {
+        for (j = 0U; j < MAXTHREADS; j++)
+        {
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(threads[i].dataPacketID, threads[j].sinkDataPacketID));
+        }
+    }
+
+    startTime = xme_hal_time_getCurrentTime();
+    runTasks(transferMeasurementTask, MAXTHREADS);
+    microSeconds = xme_hal_time_timeIntervalInMicroseconds(xme_hal_time_getTimeInterval(&startTime, false));
+
+    for (i = 0U; i < MAXTHREADS; i++)
+    {
+        EXPECT_EQ(0U, threads[i].failures);
+    }
+
+    XME_LOG
+    (
+        XME_LOG_NOTE,
+        "[DataHandlerLockingMeasurementTest] %s locking, %d threads: %d writes with %d transfers each in %d us.\n",
+        (XME_CORE_DATAHANDLER_LOCKINGMODE_GLOBAL == GetParam()) ? "global" : "striped",
+        MAXTHREADS, MAXTHREADS * TRANSFERSPERTHREAD, MAXTHREADS, (uint32_t) microSeconds
+    );
+}
+
+TEST_P(DataHandlerLockingMeasurementTest, SharedSourceWritesAcrossStripesUnderContention)
+{
+    uint32_t readBuffer;
+    uint32_t bytesRead;
+    uint16_t i;
+
+    // Use the source in the highest stripe, so that all other sinks are in
+    // lower stripes than the one the writers contend for.
+    sharedDataPacketID = threads[0].dataPacketID;
+    for (i = 1U; i < MAXTHREADS; i++)
+    {
+        if ((threads[i].dataPacketID % XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT) > (sharedDataPacketID % XME_CORE_DATAHANDLER_LOCKSTRIPE_COUNT))
+        {
+            sharedDataPacketID = threads[i].dataPacketID;
+        }
+    }
+    for (i = 0U; i < MAXTHREADS; i++)
+    {
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(sharedDataPacketID, threads[i].sinkDataPacketID));
+    }
+
+    runTasks(sharedSourceMeasurementTask, MAXTHREADS);
+
+    for (i = 0U; i < MAXTHREADS; i++)
+    {
+        EXPECT_EQ(0U, threads[i].failures);
+    }
+
+    // Every sink holds the last sample written to the source
+    for (i = 0U; i < MAXTHREADS; i++)
+    {
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startReadOperation(threads[i].sinkDataPacketID));
+        bytesRead = 0U;
+        EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_readData(threads[i].sinkDataPacketID, &readBuffer, sizeof(readBuffer), &bytesRead));
+        EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeReadOperation(threads[i].sinkDataPacketID));
+        EXPECT_EQ(sizeof(readBuffer), bytesRead);
+        EXPECT_EQ(TRANSFERSPERTHREAD - 1U, readBuffer & 0x00FFFFFFU);
+    }
+}
+
+int
+main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -20,3 +20,5 @@ xme_build_option(XME_CORE_DIRECTORY_ATTRIBUTE_MAX_REGISTRY_SIZE 255 "xme/xme_opt
 xme_build_option(XME_CORE_DIRECTORY_ATTRIBUTE_MAX_TOPIC_ATTRIBUTE_ITEMS 16 "xme/xme_opt.h" "Maximum number of attributes associated to a given topic.")
 xme_build_option(XME_CORE_DIRECTORY_ATTRIBUTE_MAX_ATTRIBUTE_SETS 16 "xme/xme_opt.h" "Maximum number of attribute sets in a given node. Note that the attribute storage is targeted for Plug and Play Manager.")
 xme_build_option(XME_CORE_DIRECTORY_ATTRIBUTE_MAX_ATTRIBUTE_KEYS 16 "xme/xme_opt.h" "The maximum number of keys allowed in the keymap.")
+xme_build_option(XME_CORE_DIRECTORY_TOPICREGISTRY_INDEX_SIZE 256 "xme/xme_opt.h" "Number of buckets of the hash index of the topic registry by topic.")
+xme_build_option(XME_CORE_DIRECTORY_ATTRIBUTE_INDEX_SIZE 256 "xme/xme_opt.h" "Number of buckets of the hash indices of the attribute descriptor list registry by topic and of the key map by key.")
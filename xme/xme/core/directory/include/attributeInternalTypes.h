@@ -140,11 +140,12 @@ typedef XME_HAL_TABLE
 /**
  * \brief The structure for storing the key map with all associated fields.
  */
-typedef struct
+typedef struct xme_core_directory_attribute_keyMapEntry_s
 {
     xme_core_attribute_key_t key; ///< The key. 
     xme_core_directory_attribute_datatype_t datatype; ///< The datatype associated to the key. 
     void* name; ///< The associated displayed name for the given key. 
+    struct xme_core_directory_attribute_keyMapEntry_s* nextByKey; ///< Next entry in the same bucket of the key map index.
 } xme_core_directory_attribute_keyMapEntry_t;
 
 /**
@@ -30,6 +30,18 @@
 
 #include <float.h>
 
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+/**
+ * \def ATTRIBUTE_INDEX_BUCKET
+ *
+ * \brief Returns the bucket of the given topic or attribute key in
+ *        attributeDescriptorListIndex or keyMapIndex.
+ */
+#define ATTRIBUTE_INDEX_BUCKET(topicOrKey) \
+    ((uint16_t)(((uint32_t)(topicOrKey)) % ((uint32_t)XME_CORE_DIRECTORY_ATTRIBUTE_INDEX_SIZE)))
+
 /******************************************************************************/
 /***   Type definitions                                                     ***/
 /******************************************************************************/
@@ -38,12 +50,13 @@
  *
  * \details Entry for table attributeDescriptorListRegistry.
  */
-typedef struct
+typedef struct attributeDescriptorListRegistry_s
 {
     xme_core_topic_t topic; ///< Topic for which attributeDescriptorList is registered.
     xme_core_attribute_descriptor_list_t attributeDescriptorList; ///< The attribute descriptor list itself.
     xme_core_attribute_descriptor_t attributeDescriptors[255]; ///< Storage for attribute descriptors referenced by attributeDescriptorList.
     // TODO: How can we dynamically allocate only the necessary amount of memory fo attributeDescriptors (when dynamic allocation is available?)
+    struct attributeDescriptorListRegistry_s* nextByTopic; ///< Next entry in the same bucket of attributeDescriptorListIndex.
 } attributeDescriptorListRegistry_t;
 
 /******************************************************************************/
@@ -61,6 +74,14 @@ static XME_HAL_TABLE
     XME_CORE_DIRECTORY_ATTRIBUTE_MAX_REGISTRY_SIZE
 );
 
+/**
+ * \brief Entries of attributeDescriptorListRegistry hashed by topic.
+ *
+ * \details Each bucket is the head of a chain of entries whose topic maps to
+ *          that bucket, linked through the nextByTopic member.
+ */
+static attributeDescriptorListRegistry_t* attributeDescriptorListIndex[XME_CORE_DIRECTORY_ATTRIBUTE_INDEX_SIZE];
+
 /**
  * \var xme_core_directory_attributes
  *
@@ -75,9 +96,85 @@ xme_core_directory_attributes_t xme_core_directory_attributes;
  */
 xme_core_directory_attribute_keymap_t xme_core_directory_attribute_keymap;
 
+/**
+ * \brief Entries of xme_core_directory_attribute_keymap hashed by key.
+ *
+ * \details Each bucket is the head of a chain of entries whose key maps to
+ *          that bucket, linked through the nextByKey member.
+ */
+static xme_core_directory_attribute_keyMapEntry_t* keyMapIndex[XME_CORE_DIRECTORY_ATTRIBUTE_INDEX_SIZE];
+
+/******************************************************************************/
+/***   Prototypes                                                           ***/
+/******************************************************************************/
+/**
+ * \brief Finds the attribute descriptor list registry entry of the given topic.
+ *
+ * \param[in] topic Topic identifier.
+ *
+ * \return Returns the entry of the topic or NULL if no attribute descriptor
+ *         list is registered for the topic.
+ */
+static attributeDescriptorListRegistry_t*
+findAttributeDescriptorListRegistryEntry
+(
+    xme_core_topic_t topic
+);
+
+/**
+ * \brief Finds the key map entry of the given attribute key.
+ *
+ * \param[in] key Attribute key.
+ *
+ * \return Returns the entry of the key or NULL if the key is not registered.
+ */
+static xme_core_directory_attribute_keyMapEntry_t*
+findKeyMapEntry
+(
+    xme_core_attribute_key_t key
+);
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
+static attributeDescriptorListRegistry_t*
+findAttributeDescriptorListRegistryEntry
+(
+    xme_core_topic_t topic
+)
+{
+    attributeDescriptorListRegistry_t* item;
+
+    for (item = attributeDescriptorListIndex[ATTRIBUTE_INDEX_BUCKET(topic)]; NULL != item; item = item->nextByTopic)
+    {
+        if (topic == item->topic)
+        {
+            return item;
+        }
+    }
+
+    return NULL;
+}
+
+static xme_core_directory_attribute_keyMapEntry_t*
+findKeyMapEntry
+(
+    xme_core_attribute_key_t key
+)
+{
+    xme_core_directory_attribute_keyMapEntry_t* keyMapEntry;
+
+    for (keyMapEntry = keyMapIndex[ATTRIBUTE_INDEX_BUCKET(key)]; NULL != keyMapEntry; keyMapEntry = keyMapEntry->nextByKey)
+    {
+        if (key == keyMapEntry->key)
+        {
+            return keyMapEntry;
+        }
+    }
+
+    return NULL;
+}
+
 xme_status_t
 xme_core_directory_attribute_init(void)
 {
@@ -90,6 +187,9 @@ xme_core_directory_attribute_init(void)
 
     XME_HAL_TABLE_INIT(attributeDescriptorListRegistry);
 
+    (void) xme_hal_mem_set(attributeDescriptorListIndex, 0, sizeof(attributeDescriptorListIndex));
+    (void) xme_hal_mem_set(keyMapIndex, 0, sizeof(keyMapIndex));
+
     return XME_STATUS_SUCCESS;
 }
 
@@ -99,6 +199,9 @@ xme_core_directory_attribute_fini(void)
     XME_HAL_TABLE_FINI(xme_core_directory_attributes);
     XME_HAL_TABLE_FINI(xme_core_directory_attribute_keymap);
     XME_HAL_TABLE_FINI(attributeDescriptorListRegistry);
+
+    (void) xme_hal_mem_set(attributeDescriptorListIndex, 0, sizeof(attributeDescriptorListIndex));
+    (void) xme_hal_mem_set(keyMapIndex, 0, sizeof(keyMapIndex));
 }
 
 xme_status_t
@@ -118,15 +221,7 @@ xme_core_directory_attribute_registerAttributeDescriptorList
     XME_CHECK(XME_CORE_TOPIC_INVALID_TOPIC != topic, XME_STATUS_INVALID_PARAMETER);
     XME_CHECK(NULL != attributeDescriptorList, XME_STATUS_INVALID_PARAMETER);
 
-    XME_HAL_TABLE_GET_NEXT
-    (
-        attributeDescriptorListRegistry,
-        xme_hal_table_rowHandle_t,
-        handle,
-        attributeDescriptorListRegistry_t,
-        item,
-        (topic == item->topic)
-    );
+    item = findAttributeDescriptorListRegistryEntry(topic);
 
     XME_CHECK(NULL == item || overwrite, XME_STATUS_ALREADY_EXIST);
 
@@ -138,10 +233,12 @@ xme_core_directory_attribute_registerAttributeDescriptorList
  
         item = XME_HAL_TABLE_ITEM_FROM_HANDLE(attributeDescriptorListRegistry, handle);
         XME_ASSERT(NULL != item);
-    }
 
-    // Item is not NULL here
-    item->topic = topic;
+        // Items of the table do not move, so the index can refer to them
+        item->topic = topic;
+        item->nextByTopic = attributeDescriptorListIndex[ATTRIBUTE_INDEX_BUCKET(topic)];
+        attributeDescriptorListIndex[ATTRIBUTE_INDEX_BUCKET(topic)] = item;
+    }
 
     // Copy attribute descriptors
     (void) xme_hal_mem_copy
@@ -164,12 +261,8 @@ xme_core_directory_attribute_getAttributeDescriptorList
     xme_core_attribute_descriptor_list_t* attributeDescriptorList
 )
 {
-    xme_hal_table_rowHandle_t handle;
     attributeDescriptorListRegistry_t* item;
 
-    handle = XME_HAL_TABLE_INVALID_ROW_HANDLE;
-    item = NULL;
-
     XME_CHECK(NULL != attributeDescriptorList, XME_STATUS_INVALID_PARAMETER);
     
     attributeDescriptorList->element = NULL;
@@ -177,15 +270,7 @@ xme_core_directory_attribute_getAttributeDescriptorList
 
     XME_CHECK(XME_CORE_TOPIC_INVALID_TOPIC != topic, XME_STATUS_INVALID_PARAMETER);
 
-    XME_HAL_TABLE_GET_NEXT
-    (
-        attributeDescriptorListRegistry,
-        xme_hal_table_rowHandle_t,
-        handle,
-        attributeDescriptorListRegistry_t,
-        item,
-        (topic == item->topic)
-    );
+    item = findAttributeDescriptorListRegistryEntry(topic);
 
     XME_CHECK(NULL != item, XME_STATUS_NOT_FOUND);
 
@@ -669,25 +754,13 @@ xme_core_directory_attribute_getAttributeKeyDatatype
 )
 {
     xme_core_directory_attribute_keyMapEntry_t* keyMapEntry;
-    xme_hal_table_rowHandle_t internalHandle;
-
-    internalHandle = XME_HAL_TABLE_INVALID_ROW_HANDLE;
-    keyMapEntry = NULL;
     
     XME_CHECK(XME_CORE_ATTRIBUTE_KEY_UNDEFINED != key, XME_STATUS_INVALID_PARAMETER);
     XME_CHECK(NULL != datatype, XME_STATUS_INVALID_PARAMETER);
 
-    XME_HAL_TABLE_GET_NEXT
-    (
-        xme_core_directory_attribute_keymap, 
-        xme_hal_table_rowHandle_t, 
-        internalHandle, 
-        xme_core_directory_attribute_keyMapEntry_t, 
-        keyMapEntry,
-        keyMapEntry->key == key
-    );
+    keyMapEntry = findKeyMapEntry(key);
 
-    XME_CHECK(XME_HAL_TABLE_INVALID_ROW_HANDLE != internalHandle, XME_STATUS_INVALID_PARAMETER);
+    XME_CHECK(NULL != keyMapEntry, XME_STATUS_INVALID_PARAMETER);
 
     *datatype = keyMapEntry->datatype;
 
@@ -1368,28 +1441,9 @@ xme_core_directory_attribute_isKeyRegistered
     xme_core_attribute_key_t key
 )
 {
-    xme_core_directory_attribute_keyMapEntry_t* keyMapEntry;
-    xme_hal_table_rowHandle_t internalHandle;
-
-    internalHandle = XME_HAL_TABLE_INVALID_ROW_HANDLE;
-    keyMapEntry = NULL;
-    
     XME_CHECK(XME_CORE_ATTRIBUTE_KEY_UNDEFINED != key, false);
 
-    XME_HAL_TABLE_GET_NEXT
-    (
-        xme_core_directory_attribute_keymap, 
-        xme_hal_table_rowHandle_t, 
-        internalHandle, 
-        xme_core_directory_attribute_keyMapEntry_t, 
-        keyMapEntry,
-        keyMapEntry->key == key
-    );
-
-    XME_CHECK(XME_HAL_TABLE_INVALID_ROW_HANDLE != internalHandle, false);
-
-    // if the row handle is not invalid, then it exists at least an entry. 
-    return true;
+    return NULL != findKeyMapEntry(key);
 }
 
 xme_status_t
@@ -1408,20 +1462,11 @@ xme_core_directory_registerKey
     XME_CHECK(XME_CORE_ATTRIBUTE_KEY_UNDEFINED != attributeKey, XME_STATUS_INVALID_PARAMETER);
     XME_CHECK(XME_CORE_DIRECTORY_ATTRIBUTE_DATATYPE_INVALID != datatype, XME_STATUS_INVALID_PARAMETER);
 
-    XME_HAL_TABLE_GET_NEXT
-    (
-        xme_core_directory_attribute_keymap, 
-        xme_hal_table_rowHandle_t, 
-        handle, 
-        xme_core_directory_attribute_keyMapEntry_t, 
-        keyMapEntry,
-        keyMapEntry->key == attributeKey
-    );
-
-    XME_CHECK(XME_HAL_TABLE_INVALID_ROW_HANDLE == handle, XME_STATUS_ALREADY_EXIST);
+    XME_CHECK(NULL == findKeyMapEntry(attributeKey), XME_STATUS_ALREADY_EXIST);
 
     // Create a new entry for the key map. 
     handle = XME_HAL_TABLE_ADD_ITEM(xme_core_directory_attribute_keymap);
+    XME_CHECK(XME_HAL_TABLE_INVALID_ROW_HANDLE != handle, XME_STATUS_OUT_OF_RESOURCES);
 
     // Initialize the recently created attribute set. 
     keyMapEntry = XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_core_directory_attribute_keymap, handle);
@@ -1429,6 +1474,8 @@ xme_core_directory_registerKey
     keyMapEntry->key = attributeKey;
     keyMapEntry->datatype = datatype;
     keyMapEntry->name = NULL; // TODO: Add comment that we currently are not using names for keys are we?)
+    keyMapEntry->nextByKey = keyMapIndex[ATTRIBUTE_INDEX_BUCKET(attributeKey)];
+    keyMapIndex[ATTRIBUTE_INDEX_BUCKET(attributeKey)] = keyMapEntry;
 
     return XME_STATUS_SUCCESS;
 }
@@ -22,20 +22,33 @@
 /******************************************************************************/
 #include "xme/core/directory/include/topicRegistry.h"
 
+#include "xme/hal/include/mem.h"
 #include "xme/hal/include/table.h"
 
 #include <limits.h>
 
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+/**
+ * \def TOPICREGISTRY_INDEX_BUCKET
+ *
+ * \brief Returns the bucket of the given topic in topicSizeIndex.
+ */
+#define TOPICREGISTRY_INDEX_BUCKET(topic) \
+    ((uint16_t)(((uint32_t)(topic)) % ((uint32_t)XME_CORE_DIRECTORY_TOPICREGISTRY_INDEX_SIZE)))
+
 /******************************************************************************/
 /***   Type definitions                                                     ***/
 /******************************************************************************/
 /**
  * \brief Data structure for an entry in the topicSizeRegistry.
  */
-typedef struct
+typedef struct topicSizeRegistryEntry_s
 {
     xme_core_topic_t topic; ///< Topic identifier.
     uint16_t size; ///< Maximum data size of the topic in bytes.
+    struct topicSizeRegistryEntry_s* nextByTopic; ///< Next entry in the same bucket of topicSizeIndex.
 } topicSizeRegistryEntry_t;
 
 /******************************************************************************/
@@ -51,13 +64,58 @@ static XME_HAL_TABLE
     (USHRT_MAX - 1) // Maximum number of possible topics (xme_core_topic_t is uint16_t, -1 because 0 is not a valid topic)
 );
 
+/**
+ * \brief Entries of topicSizeRegistry hashed by topic.
+ *
+ * \details Each bucket is the head of a chain of entries whose topic maps to
+ *          that bucket, linked through the nextByTopic member.
+ */
+static topicSizeRegistryEntry_t* topicSizeIndex[XME_CORE_DIRECTORY_TOPICREGISTRY_INDEX_SIZE];
+
+/******************************************************************************/
+/***   Prototypes                                                           ***/
+/******************************************************************************/
+/**
+ * \brief Finds the registry entry of the given topic.
+ *
+ * \param[in] topic Topic identifier.
+ *
+ * \return Returns the entry of the topic or NULL if the topic is not
+ *         registered.
+ */
+static topicSizeRegistryEntry_t*
+findTopicSizeRegistryEntry
+(
+    xme_core_topic_t topic
+);
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
+static topicSizeRegistryEntry_t*
+findTopicSizeRegistryEntry
+(
+    xme_core_topic_t topic
+)
+{
+    topicSizeRegistryEntry_t* item;
+
+    for (item = topicSizeIndex[TOPICREGISTRY_INDEX_BUCKET(topic)]; NULL != item; item = item->nextByTopic)
+    {
+        if (topic == item->topic)
+        {
+            return item;
+        }
+    }
+
+    return NULL;
+}
+
 xme_status_t
 xme_core_directory_topicRegistry_init(void)
 {
     XME_HAL_TABLE_INIT(topicSizeRegistry);
+    (void) xme_hal_mem_set(topicSizeIndex, 0, sizeof(topicSizeIndex));
 
     return XME_STATUS_SUCCESS;
 }
@@ -69,24 +127,12 @@ xme_core_directory_topicRegistry_getTopicSize
     uint16_t* const size
 )
 {
-    xme_hal_table_rowHandle_t handle;
     topicSizeRegistryEntry_t* item;
 
-    handle = XME_HAL_TABLE_INVALID_ROW_HANDLE;
-    item = NULL;
-
     XME_CHECK(XME_CORE_TOPIC_INVALID_TOPIC != topic, XME_STATUS_INVALID_PARAMETER);
     XME_CHECK(NULL != size, XME_STATUS_INVALID_PARAMETER);
 
-    XME_HAL_TABLE_GET_NEXT
-    (
-        topicSizeRegistry,
-        xme_hal_table_rowHandle_t,
-        handle,
-        topicSizeRegistryEntry_t,
-        item,
-        (topic == item->topic)
-    );
+    item = findTopicSizeRegistryEntry(topic);
 
     XME_CHECK(NULL != item, XME_STATUS_NOT_FOUND);
 
@@ -111,15 +157,7 @@ xme_core_directory_topicRegistry_registerTopicSize
 
     XME_CHECK(XME_CORE_TOPIC_INVALID_TOPIC != topic, XME_STATUS_INVALID_PARAMETER);
 
-    XME_HAL_TABLE_GET_NEXT
-    (
-        topicSizeRegistry,
-        xme_hal_table_rowHandle_t,
-        handle,
-        topicSizeRegistryEntry_t,
-        item,
-        (topic == item->topic)
-    );
+    item = findTopicSizeRegistryEntry(topic);
 
     XME_CHECK(NULL == item || overwrite, XME_STATUS_ALREADY_EXIST);
 
@@ -131,10 +169,14 @@ xme_core_directory_topicRegistry_registerTopicSize
  
         item = XME_HAL_TABLE_ITEM_FROM_HANDLE(topicSizeRegistry, handle);
         XME_ASSERT(NULL != item);
+
+        // Items of the table do not move, so the index can refer to them
+        item->topic = topic;
+        item->nextByTopic = topicSizeIndex[TOPICREGISTRY_INDEX_BUCKET(topic)];
+        topicSizeIndex[TOPICREGISTRY_INDEX_BUCKET(topic)] = item;
     }
 
     // Item is not NULL here
-    item->topic = topic;
     item->size = size;
 
     return XME_STATUS_SUCCESS;
@@ -144,4 +186,5 @@ void
 xme_core_directory_topicRegistry_fini(void)
 {
     XME_HAL_TABLE_FINI(topicSizeRegistry);
+    (void) xme_hal_mem_set(topicSizeIndex, 0, sizeof(topicSizeIndex));
 }
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2011-2014, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Attribute measurement tests, measuring the lookup cost of attribute
+ *         descriptor lists and attribute keys for registries of different
+ *         sizes.
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "xme/core/directory/include/attributeInternalMethods.h"
+
+#include "xme/core/log.h"
+
+#include "xme/hal/include/time.h"
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define LOOKUPS 1000000U ///< Number of lookups per measurement.
+
+/******************************************************************************/
+/***   Classes                                                              ***/
+/******************************************************************************/
+
+class AttributeMeasurementTest: public ::testing::Test
+{
+protected:
+    AttributeMeasurementTest()
+    {
+    }
+
+    virtual ~AttributeMeasurementTest()
+    {
+    }
+
+    static void
+    measure(uint16_t count)
+    {
+        xme_core_attribute_descriptor_t descriptors[2];
+        xme_core_attribute_descriptor_list_t descriptorList;
+        xme_core_directory_attribute_datatype_t datatype;
+        xme_hal_time_timeHandle_t startTimeHandle;
+        xme_hal_time_timeInterval_t listWallTime;
+        xme_hal_time_timeInterval_t keyWallTime;
+        uint64_t expectedSum = 0U;
+        uint64_t sum = 0U;
+        uint32_t i;
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_directory_attribute_init());
+
+        descriptorList.length = 2U;
+        descriptorList.element = descriptors;
+        descriptors[1].key = XME_CORE_ATTRIBUTE_KEY_CHANNELID;
+        descriptors[1].size = sizeof(uint32_t);
+
+        for (i = 1U; i <= count; i++)
+        {
+            descriptors[0].key = (xme_core_attribute_key_t) (XME_CORE_ATTRIBUTE_KEY_USER + i);
+            descriptors[0].size = i;
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_directory_attribute_registerAttributeDescriptorList((xme_core_topic_t) i, &descriptorList, false));
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_directory_registerKey((xme_core_attribute_key_t) (XME_CORE_ATTRIBUTE_KEY_USER + i), XME_CORE_DIRECTORY_ATTRIBUTE_DATATYPE_UNSIGNED));
+        }
+
+        // Look up the descriptor lists of all topics in turn, like the
+        // waypoints do for every message
+        startTimeHandle = xme_hal_time_getCurrentTime();
+        for (i = 0U; i < LOOKUPS; i++)
+        {
+            xme_core_topic_t topic = (xme_core_topic_t) ((i % count) + 1U);
+
+            (void) xme_core_directory_attribute_getAttributeDescriptorList(topic, &descriptorList);
+            sum += descriptorList.element[0].size;
+            expectedSum += topic;
+        }
+        listWallTime = xme_hal_time_getTimeInterval(&startTimeHandle, false);
+
+        EXPECT_EQ(expectedSum, sum) << count << " topics";
+
+        // Look up the datatypes of all keys in turn
+        sum = 0U;
+        startTimeHandle = xme_hal_time_getCurrentTime();
+        for (i = 0U; i < LOOKUPS; i++)
+        {
+            datatype = XME_CORE_DIRECTORY_ATTRIBUTE_DATATYPE_INVALID;
+            (void) xme_core_directory_attribute_getAttributeKeyDatatype((xme_core_attribute_key_t) (XME_CORE_ATTRIBUTE_KEY_USER + (i % count) + 1U), &datatype);
+            sum += (XME_CORE_DIRECTORY_ATTRIBUTE_DATATYPE_UNSIGNED == datatype) ? 1U : 0U;
+        }
+        keyWallTime = xme_hal_time_getTimeInterval(&startTimeHandle, false);
+
+        EXPECT_EQ(LOOKUPS, sum) << count << " keys";
+
+        XME_LOG
+        (
+            XME_LOG_NOTE,
+            "%5d entries %8.2f ns per getAttributeDescriptorList %8.2f ns per getAttributeKeyDatatype\n",
+            count,
+            (double) listWallTime / LOOKUPS,
+            (double) keyWallTime / LOOKUPS
+        );
+
+        xme_core_directory_attribute_fini();
+    }
+};
+
+/******************************************************************************/
+/***   Tests                                                                ***/
+/******************************************************************************/
+
+//----------------------------------------------------------------------------//
+//     AttributeMeasurementTest                                               //
+//----------------------------------------------------------------------------//
+
+TEST_F(AttributeMeasurementTest, getAttributeDescriptorListAndKeyDatatype)
+{
+    // The lookup cost should hardly depend on the number of entries
+    measure(16U);
+    measure(256U);
+    measure(4096U);
+}
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2011-2014, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Topic registry measurement tests, measuring the lookup cost for
+ *         registries of different sizes.
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "xme/core/directory/include/topicRegistry.h"
+
+#include "xme/core/log.h"
+
+#include "xme/hal/include/time.h"
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define LOOKUPS 1000000U ///< Number of lookups per measurement.
+
+/******************************************************************************/
+/***   Classes                                                              ***/
+/******************************************************************************/
+
+class TopicRegistryMeasurementTest: public ::testing::Test
+{
+protected:
+    TopicRegistryMeasurementTest()
+    {
+    }
+
+    virtual ~TopicRegistryMeasurementTest()
+    {
+    }
+
+    static void
+    measure(uint16_t topicCount)
+    {
+        xme_hal_time_timeHandle_t startTimeHandle;
+        xme_hal_time_timeInterval_t wallTime;
+        uint64_t expectedSum = 0U;
+        uint64_t sum = 0U;
+        uint16_t size;
+        uint32_t i;
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_directory_topicRegistry_init());
+
+        for (i = 1U; i <= topicCount; i++)
+        {
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_directory_topicRegistry_registerTopicSize((xme_core_topic_t) i, (uint16_t) i, false));
+        }
+
+        // Look up all topics in turn
+        startTimeHandle = xme_hal_time_getCurrentTime();
+        for (i = 0U; i < LOOKUPS; i++)
+        {
+            xme_core_topic_t topic = (xme_core_topic_t) ((i % topicCount) + 1U);
+
+            (void) xme_core_directory_topicRegistry_getTopicSize(topic, &size);
+            sum += size;
+            expectedSum += topic;
+        }
+        wallTime = xme_hal_time_getTimeInterval(&startTimeHandle, false);
+
+        EXPECT_EQ(expectedSum, sum) << topicCount << " topics";
+
+        XME_LOG
+        (
+            XME_LOG_NOTE,
+            "%5d topics %8.2f ns per getTopicSize\n",
+            topicCount,
+            (double) wallTime / LOOKUPS
+        );
+
+        xme_core_directory_topicRegistry_fini();
+    }
+};
+
+/******************************************************************************/
+/***   Tests                                                                ***/
+/******************************************************************************/
+
+//----------------------------------------------------------------------------//
+//     TopicRegistryMeasurementTest                                           //
+//----------------------------------------------------------------------------//
+
+TEST_F(TopicRegistryMeasurementTest, getTopicSize)
+{
+    // The lookup cost should hardly depend on the number of topics
+    measure(16U);
+    measure(256U);
+    measure(4096U);
+}
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
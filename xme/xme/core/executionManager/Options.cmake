@@ -22,5 +22,7 @@ xme_build_option(XME_CORE_EXEC_MAX_FUNCTIONS_PER_CHUNK 100 "xme/xme_opt.h" "Maxi
 xme_build_option(XME_CORE_EXEC_MAX_FUNCTIONS_PER_COMPONENT 5 "xme/xme_opt.h" "Maximum number of functions per component; on platforms with non-dynamic memory management")
 xme_build_option(XME_CORE_EXEC_MAX_RTE_FUNCTIONS 256 "xme/xme_opt.h" "Maximum number of functions in RTE; on platforms with non-dynamic memory management")
 
+xme_build_option(XME_CORE_EXEC_DISPATCHER_WORKERS 1 "xme/xme_opt.h" "Maximum number of schedule slots the dispatcher runs in parallel, typically the number of processor cores; 1 runs all slots strictly one after another")
+
 xme_build_option(XME_CORE_EXEC_SCHEDULER_MAX_SCHEDULES 100 "xme/xme_opt.h" "Maximum number of schedules; on platforms with non-dynamic memory management")
 xme_build_option(XME_CORE_EXEC_REPOSITORY_MAX_COMPONENTS 64 "xme/xme_opt.h" "Maximum number of components; on platforms with non-dynamic memory management")
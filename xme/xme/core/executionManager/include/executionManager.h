@@ -126,6 +126,51 @@ xme_core_exec_dispatcher_createFunctionExecutionUnit
     bool eventTriggered
 );
 
+/*-------------------------------------------------------------------------*/
+/**
+ * \brief Retrieves the slot timing statistics of a function.
+ *
+ * \details The statistics are updated by the dispatcher whenever the
+ *          function is dispatched and may be inspected while the execution
+ *          manager is running.
+ *
+ * \param[in]   componentId     ID of the component
+ * \param[in]   functionId      ID of the function
+ * \param[out]  statistics      where to store the statistics
+ *
+ * \return Returns one of the following status codes:
+ *          - XME_STATUS_SUCCESS if the statistics have been retrieved.
+ *          - XME_STATUS_INVALID_PARAMETER if statistics is NULL.
+ *          - XME_STATUS_NOT_FOUND if there is no such function.
+ *          - XME_STATUS_UNEXPECTED if operation is performed on an uninitialized component
+ */
+extern xme_status_t
+xme_core_exec_dispatcher_getSlotStatistics
+(
+    xme_core_component_t componentId,
+    xme_core_component_functionId_t functionId,
+    xme_core_exec_slotStatistics_t* statistics
+);
+
+/*-------------------------------------------------------------------------*/
+/**
+ * \brief Resets the slot timing statistics of a function.
+ *
+ * \param[in]   componentId     ID of the component
+ * \param[in]   functionId      ID of the function
+ *
+ * \return Returns one of the following status codes:
+ *          - XME_STATUS_SUCCESS if the statistics have been reset.
+ *          - XME_STATUS_NOT_FOUND if there is no such function.
+ *          - XME_STATUS_UNEXPECTED if operation is performed on an uninitialized component
+ */
+extern xme_status_t
+xme_core_exec_dispatcher_resetSlotStatistics
+(
+    xme_core_component_t componentId,
+    xme_core_component_functionId_t functionId
+);
+
 XME_EXTERN_C_END
 
 /**
@@ -108,6 +108,28 @@ typedef struct xme_core_exec_functionDescriptor_s
 }
 xme_core_exec_functionDescriptor_t;
 
+/*-------------------------------------------------------------------------*/
+/**
+ * \struct xme_core_exec_slotStatistics_t
+ * \brief Timing statistics of the slots in which a function was dispatched.
+ *
+ * \details The jitter is the delay between the planned start of a slot
+ *          (start of cycle plus slot start) and the actual activation of the
+ *          function. An overrun is counted whenever the function completes
+ *          after the end of its slot.
+ */
+typedef struct xme_core_exec_slotStatistics_s
+{
+    uint32_t activations; ///< Number of times the function has been started in one of its slots.
+    uint32_t skipped; ///< Number of slots in which an event triggered function was not started because its inputs were not ready.
+    uint32_t overruns; ///< Number of activations that completed after the end of the slot.
+    xme_hal_time_timeInterval_t minJitter_ns; ///< Smallest start jitter observed.
+    xme_hal_time_timeInterval_t maxJitter_ns; ///< Largest start jitter observed.
+    xme_hal_time_timeInterval_t totalJitter_ns; ///< Sum of the start jitter of all activations, divide by activations for the mean.
+    xme_hal_time_timeInterval_t maxExecutionTime_ns; ///< Longest time from activation to completion.
+}
+xme_core_exec_slotStatistics_t;
+
 /*-------------------------------------------------------------------------*/
 /**
  * \struct xme_core_exec_componentDescriptor_t
@@ -30,6 +30,7 @@
 #include "xme/hal/include/linkedList.h"
 #include "xme/hal/include/sync.h"
 #include "xme/hal/include/sched.h"
+#include "xme/hal/include/time.h"
 #include "xme/defines.h"
 
 #include "xme/core/dataManagerTypes.h"
@@ -174,7 +175,8 @@ xme_core_exec_dispatcher_pauseFunction
 /** \brief  Returns a valid pointer to the task scheduler record to be executed
  *          in the next slot and delay to wait before starting this task.
  *
- * \note    Multiple CPU's are currently not supported.
+ * \note    The scheduler hands out the slots in the order of the schedule,
+ *          running slots in parallel is up to the dispatcher.
  *
  * \param   entry A pointer to the scheduler record of the next function to be
  *                  executed.
@@ -197,6 +199,20 @@ xme_core_exec_scheduler_calculateNextComponent
     xme_hal_time_timeInterval_t*    startDelay_ns
 );
 
+/** \brief  Returns the point in time at which the given slot of the current
+ *          cycle starts.
+ *
+ * \param   entry Scheduler record of the slot, as returned by
+ *                  xme_core_exec_scheduler_calculateNextComponent().
+ *
+ * \return Returns the absolute start time of the slot.
+ */
+extern xme_hal_time_timeHandle_t
+xme_core_exec_scheduler_getSlotStartTime
+(
+    const xme_core_exec_schedule_table_entry_t* entry
+);
+
 /** todo: document */
 xme_status_t
 xme_core_exec_scheduler_getScheduleSetPointer
@@ -240,16 +256,37 @@ xme_core_exec_scheduler_printSchedule
  * Called exclusively by xme_core_exec_executionManager_step(),
  * so is not listed under public API.
  *
+ * \details Sleeps until the start of the slot and activates the function.
+ *          If XME_CORE_EXEC_DISPATCHER_WORKERS is larger than one, the
+ *          function keeps running when this function returns if the slot may
+ *          run in parallel with the following slots, see
+ *          xme_core_exec_dispatcher_completeRunningSlots().
+ *
  * \return Returns one of the following status codes:
- *          - XME_CORE_STATUS_SUCCESS in any case.
+ *          - XME_CORE_STATUS_SUCCESS if the slot has been dispatched.
+ *          - XME_STATUS_NOT_FOUND if the function of the slot is unknown.
+ *          - XME_STATUS_TIMEOUT if a function exceeded its WCET.
+ *          - XME_STATUS_INTERNAL_ERROR if the function could not be activated.
  */
 extern xme_status_t
 xme_core_exec_dispatcher_executeStep
 (
     const xme_core_exec_schedule_table_entry_t* const nextSlot, ///< Schedule table entry for the next slot
-    xme_hal_time_timeInterval_t slack               ///< Current slack
+    xme_hal_time_timeHandle_t slotStartTime        ///< Absolute start time of the slot
 );
 
+/**
+ * \brief Waits for the completion of all slots that are still running in
+ *          parallel. Called by the scheduler at the end of each cycle.
+ *
+ * \return Returns one of the following status codes:
+ *          - XME_CORE_STATUS_SUCCESS if all slots have completed.
+ *          - XME_STATUS_TIMEOUT if a function exceeded its WCET.
+ *          - XME_STATUS_INTERNAL_ERROR if a function could not be recaptured.
+ */
+extern xme_status_t
+xme_core_exec_dispatcher_completeRunningSlots( void );
+
 xme_core_exec_state_value_t
 xme_core_exec_getState( void );
 
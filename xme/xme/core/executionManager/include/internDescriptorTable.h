@@ -53,11 +53,16 @@ typedef struct xme_core_exec_task_descriptor_
     xme_hal_sched_taskHandle_t handle; ///< A handle to the thread/task object allocated for the function execution
     xme_hal_sync_criticalSectionHandle_t execLock; ///< The gate for enabling / locking function execution
     xme_hal_sync_criticalSectionHandle_t waitLock; ///< The gate for waiting / inverse locking function execution
+    xme_hal_sync_criticalSectionHandle_t cpuToken; ///< The CPU resource of the function if slots are dispatched in parallel, created on its first activation
 
     bool eventTriggered; ///< Indicates, whether a function will be "gated" by executionReady() calls
     bool running; ///< identifies if the function is being executed at the moment (execLock?)
     xme_core_exec_functionState_t state;
     xme_hal_time_timeHandle_t startTime; ///< Timestamp of start for monitoring
+    xme_hal_time_timeHandle_t completionTime; ///< Timestamp of the completion of the last activation, set by the task
+    xme_hal_time_timeHandle_t slotEndTime; ///< End of the slot of the current activation
+    void* startData; ///< Arguments of the current activation
+    xme_core_exec_slotStatistics_t statistics; ///< Timing statistics of all activations
 } xme_core_exec_taskDescriptor_t;
 
 
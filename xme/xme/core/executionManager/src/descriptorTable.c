@@ -28,6 +28,7 @@
 /* Components that we use or interface */
 
 /* Basic structures */
+#include "xme/hal/include/mem.h"
 #include "xme/hal/include/table.h"
 
 /* Chromosome logging */
@@ -396,10 +397,13 @@ xme_core_exec_dispatcher_initializeTaskDescriptor
                XME_LOG(XME_LOG_WARNING, MODULE_ACRONYM "could not destruct execution token while recovering\n");
        });
 
+    taskDescriptor->cpuToken = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
     taskDescriptor->eventTriggered = eventTriggered;
     taskDescriptor->running = false;
     taskDescriptor->wrapper = functionDescriptor;
     taskDescriptor->state = XME_CORE_EXEC_FUNCTION_STATE_INVALID_STATE;
+    taskDescriptor->startData = NULL;
+    (void) xme_hal_mem_set(&taskDescriptor->statistics, 0U, sizeof(taskDescriptor->statistics));
 
     XME_LOG(XME_LOG_DEBUG,
        MODULE_ACRONYM "[%d|%d] received a dispatcher structure\n",
@@ -37,6 +37,21 @@
 
 #include <inttypes.h>
 
+/****************************************************************************/
+/**   Type definitions                                                     **/
+/****************************************************************************/
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+/**
+ * \struct xme_core_exec_dispatcher_runningSlot_t
+ * \brief A slot whose function has been activated, but not recaptured yet.
+ */
+typedef struct
+{
+    xme_core_exec_taskDescriptor_t* task; ///< Descriptor of the activated task
+    bool completion; ///< Whether the function has to complete within its WCET
+} xme_core_exec_dispatcher_runningSlot_t;
+#endif
+
 /****************************************************************************/
 /**   Variables                                                            **/
 /****************************************************************************/
@@ -51,7 +66,17 @@ uint32_t dispatcherCycleCounter;
 
 // XXX these were statics, think of implications
 xme_hal_sync_criticalSectionHandle_t cpuToken;
-void* startData;
+
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+/**
+ * \var runningSlots
+ * \brief Slots that run in parallel to the slot being dispatched, in the order
+ *          of their activation.
+ */
+static xme_core_exec_dispatcher_runningSlot_t runningSlots[XME_CORE_EXEC_DISPATCHER_WORKERS];
+
+static uint16_t runningSlotCount; ///< Number of valid items in runningSlots.
+#endif
 
 
 /****************************************************************************/
@@ -130,6 +155,48 @@ xme_core_exec_dispatcher_checkWCETConformance(
     xme_core_component_t componentId,
     xme_core_component_functionId_t functionId);
 
+/**
+ * \brief Updates the start jitter statistics of a task that has just been
+ *          activated in the slot starting at slotStartTime.
+ */
+static void
+xme_core_exec_dispatcher_recordActivation
+(
+    xme_core_exec_taskDescriptor_t* task,
+    xme_hal_time_timeHandle_t slotStartTime
+);
+
+/**
+ * \brief Completes the activation of a recaptured task: notifies the
+ *          configured callback, updates the overrun statistics and checks
+ *          the WCET if requested.
+ */
+static xme_status_t
+xme_core_exec_dispatcher_completeActivation
+(
+    xme_core_exec_taskDescriptor_t* task,
+    bool completion
+);
+
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+/**
+ * \brief Determines whether a slot may run in parallel with all running slots.
+ *
+ * \details A slot is independent of a running slot if their functions do not
+ *          exchange data according to the broker (see
+ *          xme_core_broker_areFunctionsIndependent()) and belong to different
+ *          components, as functions of the same component share its state.
+ *          A function consuming the outputs of a running one is therefore
+ *          only started after the other one completed, so the schedule order
+ *          still expresses the data dependencies.
+ */
+static bool
+xme_core_exec_dispatcher_isIndependentSlot
+(
+    xme_core_exec_taskDescriptor_t* task
+);
+#endif
+
 
 /** \brief This function is executed during final iteration through the task
  *          descriptor table to stop the function execution correctly
@@ -187,6 +254,9 @@ xme_core_exec_dispatcher_fini( void )
 
     XME_LOG(XME_LOG_DEBUG, MODULE_ACRONYM "terminating all tasks...\n");
 
+    if(XME_STATUS_SUCCESS != xme_core_exec_dispatcher_completeRunningSlots())
+        XME_LOG(XME_LOG_ERROR, MODULE_ACRONYM "error completing running functions\n");
+
     /* Terminate all registered tasks */
     if(XME_STATUS_SUCCESS != xme_core_exec_descriptorTable_forEach(terminationCallback))
         XME_LOG(XME_LOG_ERROR, MODULE_ACRONYM "error terminating functions\n");
@@ -248,6 +318,17 @@ terminationCallback(xme_core_exec_taskDescriptor_t* task)
                 (int)(task->handle));
     }
 
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+    /* The task does not wait for its CPU resource any more */
+    xme_core_exec_unlockMutex("R/m", task->cpuToken, function->componentId, function->functionId);
+    if(XME_STATUS_SUCCESS != xme_hal_sync_destroyCriticalSection(task->cpuToken))
+    {
+        XME_LOG(XME_LOG_WARNING, MODULE_ACRONYM "could not destroy the CPU resource of task %d\n",
+                (int)(task->handle));
+    }
+    task->cpuToken = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+#endif
+
 #ifdef TMP_FINI_SLEEP
     xme_hal_sleep_sleep(((xme_hal_time_timeInterval_t)1000)*100); // 0.1 ms
 #endif
@@ -268,7 +349,7 @@ xme_status_t
 xme_core_exec_dispatcher_executeStep
 (
     const xme_core_exec_schedule_table_entry_t* const nextSlot, ///< Schedule table entry for the next slot
-    xme_hal_time_timeInterval_t slack               ///< Current slack
+    xme_hal_time_timeHandle_t slotStartTime        ///< Absolute start time of the slot
 )
 {
     /* Descriptor of the task to be executed */
@@ -277,34 +358,45 @@ xme_core_exec_dispatcher_executeStep
     /* Determines if the task will be executed at all */
     bool executeTask = true;
 
+    xme_hal_time_timeHandle_t timeNow;
+    xme_status_t status;
+
     XME_LOG(XME_LOG_DEBUG,
         MODULE_ACRONYM "(m): nextSlot = [%d|%d]\n",
         nextSlot->componentId, nextSlot->functionId);
 
-    // XXX: Code review: maybe merge the branches???
+    /* Get descriptor of the next task that scheduler told us */
+    XME_CHECK(XME_STATUS_SUCCESS == xme_core_exec_descriptorTable_getTaskDescriptor(nextSlot->componentId,
+                                                                                    nextSlot->functionId,
+                                                                                    &executedTask),
+              XME_STATUS_NOT_FOUND);
+
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+    /* A slot that may not run in parallel waits for the running ones */
+    if (!xme_core_exec_dispatcher_isIndependentSlot(executedTask))
+    {
+        status = xme_core_exec_dispatcher_completeRunningSlots();
+        XME_CHECK(XME_STATUS_SUCCESS == status, status);
+    }
+#endif
 
-    /* Scheduler tells us also the slack that we have; we either sleep or immediately execute */
-    if (slack > 0)
+    /* Sleep until the absolute start of the slot, so that the time spent in
+     * the scheduler and the dispatcher does not accumulate as drift */
+    timeNow = xme_hal_time_getCurrentTime();
+    if (xme_hal_time_compareTime(timeNow, slotStartTime) < 0)
     {
         XME_LOG(XME_LOG_DEBUG,
             MODULE_ACRONYM "Schedule slack: [%" PRIu64 "] us\n",
-            xme_hal_time_timeIntervalInMicroseconds(slack));
-        xme_hal_sleep_sleep(slack);
+            xme_hal_time_timeIntervalInMicroseconds(xme_hal_time_getTimeIntervalBetween(timeNow, slotStartTime)));
+        xme_hal_sleep_sleepUntil(slotStartTime);
     }
     else
     {
         // XXX: Code review : remove sleep(0)
-        // XXX incorrect context for the comment (we don't see the negative slack)
         XME_LOG(XME_LOG_DEBUG, MODULE_ACRONYM "[Negative slack in schedule]\n");
         xme_hal_sleep_sleep(0ULL);
     }
 
-    /* Get descriptor of the next task that scheduler told us */
-    XME_CHECK(XME_STATUS_SUCCESS == xme_core_exec_descriptorTable_getTaskDescriptor(nextSlot->componentId,
-                                                                                    nextSlot->functionId,
-                                                                                    &executedTask),
-              XME_STATUS_NOT_FOUND);
-
     if (executedTask->eventTriggered)
     {
 
@@ -316,41 +408,221 @@ xme_core_exec_dispatcher_executeStep
                                                         nextSlot->functionId,
                                                         nextSlot->functionArgs);
         if(XME_STATUS_SUCCESS != functionReady)
+        {
             //  XXX Code Review: RETURN from here
             executeTask = false;
+            executedTask->statistics.skipped++;
+        }
     }
 
     if( executeTask )
     {
+        executedTask->slotEndTime = xme_hal_time_offsetTime(slotStartTime,
+                                                            XME_HAL_TIME_OFFSET_OPERATION_ADD,
+                                                            nextSlot->slotLength_ns);
+
         XME_CHECK(XME_STATUS_SUCCESS ==
                    xme_core_exec_dispatcher_startFunction(nextSlot->componentId,
                                                           nextSlot->functionId,
                                                           nextSlot->functionArgs),
                    XME_STATUS_INTERNAL_ERROR);
 
+        xme_core_exec_dispatcher_recordActivation(executedTask, slotStartTime);
+
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+        /* The task is recaptured as soon as a slot follows that may not run in parallel */
+        runningSlots[runningSlotCount].task = executedTask;
+        runningSlots[runningSlotCount].completion = nextSlot->completion;
+        runningSlotCount++;
+#else
         /* If we have started a task, we have to catch its S-lock before we exit, and check the runtime */
         XME_CHECK(XME_STATUS_SUCCESS == xme_core_exec_dispatcher_recaptureExecutionToken(executedTask),
                   XME_STATUS_INTERNAL_ERROR);
 
-        if(NULL != xme_core_exec_intConfig.onFunctionReturned)
+        status = xme_core_exec_dispatcher_completeActivation(executedTask, nextSlot->completion);
+        XME_CHECK(XME_STATUS_SUCCESS == status, status);
+#endif
+    }
+
+    XME_LOG(XME_LOG_DEBUG,
+        MODULE_ACRONYM "(m): < dispatcher_executeStep()\n");
+
+    return XME_STATUS_SUCCESS;
+}
+
+/****************************************************************************/
+xme_status_t
+xme_core_exec_dispatcher_completeRunningSlots( void )
+{
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+    xme_status_t status = XME_STATUS_SUCCESS;
+    uint16_t i;
+
+    for (i = 0U; i < runningSlotCount; i++)
+    {
+        if (XME_STATUS_SUCCESS != xme_core_exec_dispatcher_recaptureExecutionToken(runningSlots[i].task))
+        {
+            status = XME_STATUS_INTERNAL_ERROR;
+        }
+        else if (XME_STATUS_SUCCESS != xme_core_exec_dispatcher_completeActivation(runningSlots[i].task, runningSlots[i].completion))
         {
-            xme_core_exec_intConfig.onFunctionReturned(nextSlot->componentId, nextSlot->functionId);
+            status = XME_STATUS_TIMEOUT;
         }
+    }
+    runningSlotCount = 0U;
+
+    return status;
+#else
+    /* Every slot completes before the next one is dispatched */
+    return XME_STATUS_SUCCESS;
+#endif
+}
+
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+/****************************************************************************/
+static bool
+xme_core_exec_dispatcher_isIndependentSlot
+(
+    xme_core_exec_taskDescriptor_t* task
+)
+{
+    xme_core_exec_functionDescriptor_t* function = task->wrapper;
+    uint16_t i;
+
+    XME_CHECK(runningSlotCount < XME_CORE_EXEC_DISPATCHER_WORKERS, false);
 
-        if( nextSlot->completion )
-            XME_CHECK(XME_STATUS_SUCCESS ==
-                xme_core_exec_dispatcher_checkWCETConformance(nextSlot->componentId,
-                                                              nextSlot->functionId),
-                    XME_STATUS_TIMEOUT);
+    for (i = 0U; i < runningSlotCount; i++)
+    {
+        xme_core_exec_functionDescriptor_t* runningFunction = runningSlots[i].task->wrapper;
+
+        XME_CHECK(runningFunction->componentId != function->componentId, false);
+        XME_CHECK
+        (
+            xme_core_broker_areFunctionsIndependent(runningFunction->componentId, runningFunction->functionId,
+                                                    function->componentId, function->functionId),
+            false
+        );
     }
 
-    XME_LOG(XME_LOG_DEBUG,
-        MODULE_ACRONYM "(m): < dispatcher_executeStep()\n");
+    return true;
+}
+#endif
+
+/****************************************************************************/
+static void
+xme_core_exec_dispatcher_recordActivation
+(
+    xme_core_exec_taskDescriptor_t* task,
+    xme_hal_time_timeHandle_t slotStartTime
+)
+{
+    xme_core_exec_slotStatistics_t* statistics = &task->statistics;
+    xme_hal_time_timeInterval_t jitter = 0U;
+
+    if (xme_hal_time_compareTime(slotStartTime, task->startTime) < 0)
+    {
+        jitter = xme_hal_time_getTimeIntervalBetween(slotStartTime, task->startTime);
+    }
+
+    if (0U == statistics->activations || jitter < statistics->minJitter_ns)
+    {
+        statistics->minJitter_ns = jitter;
+    }
+    if (jitter > statistics->maxJitter_ns)
+    {
+        statistics->maxJitter_ns = jitter;
+    }
+    statistics->totalJitter_ns += jitter;
+    statistics->activations++;
+}
+
+/****************************************************************************/
+static xme_status_t
+xme_core_exec_dispatcher_completeActivation
+(
+    xme_core_exec_taskDescriptor_t* task,
+    bool completion
+)
+{
+    xme_core_exec_functionDescriptor_t* function = task->wrapper;
+    xme_hal_time_timeInterval_t executionTime = 0U;
+
+    if(NULL != xme_core_exec_intConfig.onFunctionReturned)
+    {
+        xme_core_exec_intConfig.onFunctionReturned(function->componentId, function->functionId);
+    }
+
+    /* The task has set its completion time before returning the token */
+    if (xme_hal_time_compareTime(task->startTime, task->completionTime) < 0)
+    {
+        executionTime = xme_hal_time_getTimeIntervalBetween(task->startTime, task->completionTime);
+    }
+    if (executionTime > task->statistics.maxExecutionTime_ns)
+    {
+        task->statistics.maxExecutionTime_ns = executionTime;
+    }
+
+    if (xme_hal_time_compareTime(task->completionTime, task->slotEndTime) > 0)
+    {
+        task->statistics.overruns++;
+        XME_LOG(XME_LOG_DEBUG, MODULE_ACRONYM "[%d|%d] completed after the end of its slot\n",
+                function->componentId, function->functionId);
+    }
+
+    if( completion )
+        XME_CHECK(XME_STATUS_SUCCESS ==
+            xme_core_exec_dispatcher_checkWCETConformance(function->componentId,
+                                                          function->functionId),
+                XME_STATUS_TIMEOUT);
 
     return XME_STATUS_SUCCESS;
 }
 
+/****************************************************************************/
+xme_status_t
+xme_core_exec_dispatcher_getSlotStatistics
+(
+    xme_core_component_t componentId,
+    xme_core_component_functionId_t functionId,
+    xme_core_exec_slotStatistics_t* statistics
+)
+{
+    xme_core_exec_taskDescriptor_t* task = NULL;
 
+    /* We only deal with an initialized component */
+    if (!xme_core_exec_isInitialized())
+            return XME_STATUS_UNEXPECTED;
+
+    XME_CHECK(NULL != statistics, XME_STATUS_INVALID_PARAMETER);
+    XME_CHECK(XME_STATUS_SUCCESS == xme_core_exec_descriptorTable_getTaskDescriptor(componentId, functionId, &task),
+              XME_STATUS_NOT_FOUND);
+
+    *statistics = task->statistics;
+
+    return XME_STATUS_SUCCESS;
+}
+
+/****************************************************************************/
+xme_status_t
+xme_core_exec_dispatcher_resetSlotStatistics
+(
+    xme_core_component_t componentId,
+    xme_core_component_functionId_t functionId
+)
+{
+    xme_core_exec_taskDescriptor_t* task = NULL;
+
+    /* We only deal with an initialized component */
+    if (!xme_core_exec_isInitialized())
+            return XME_STATUS_UNEXPECTED;
+
+    XME_CHECK(XME_STATUS_SUCCESS == xme_core_exec_descriptorTable_getTaskDescriptor(componentId, functionId, &task),
+              XME_STATUS_NOT_FOUND);
+
+    (void) xme_hal_mem_set(&task->statistics, 0U, sizeof(task->statistics));
+
+    return XME_STATUS_SUCCESS;
+}
 
 /****************************************************************************/
 /*          Dispatcher                                                      */
@@ -381,7 +653,7 @@ xme_core_exec_dispatcher_startFunction
     /* XXX should the descriptor table not bbe locked? */
     task->running = true;
     task->startTime = xme_hal_time_getCurrentTime();
-    startData = functionArgs;
+    task->startData = functionArgs;
 
     /*  */
 
@@ -463,9 +735,25 @@ xme_core_exec_dispatcher_grantExecutionToken
     XME_LOG(XME_LOG_DEBUG, MODULE_ACRONYM "[%d|%d] dispatcher_grantExecutionToken()\n",
             function->componentId, function->functionId);
 
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+    /* Slots dispatched in parallel do not share the CPU resource. The task
+     * only waits for its own one after it has been granted the first time. */
+    if (XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE == task->cpuToken)
+    {
+        task->cpuToken = xme_hal_sync_createCriticalSection();
+        XME_CHECK(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE != task->cpuToken,
+                  XME_STATUS_OUT_OF_RESOURCES);
+        xme_core_exec_lockMutex("R/m", task->cpuToken, function->componentId, function->functionId);
+    }
+#endif
+
     xme_core_exec_unlockMutex("T/m", task->execLock, function->componentId, function->functionId);
     xme_core_exec_lockMutex("S/m", task->waitLock, function->componentId, function->functionId);
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+    xme_core_exec_unlockMutex("R/m", task->cpuToken, function->componentId, function->functionId);
+#else
     xme_core_exec_unlockMutex("R/m", cpuToken, function->componentId, function->functionId);
+#endif
 
     XME_LOG(XME_LOG_DEBUG, MODULE_ACRONYM "[%d|%d] /dispatcher_grantExecutionToken()\n",
             function->componentId, function->functionId);
@@ -490,7 +778,11 @@ xme_core_exec_dispatcher_recaptureExecutionToken
             function->componentId, function->functionId);
 
     xme_core_exec_lockMutex("T/m", task->execLock, function->componentId, function->functionId);
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+    xme_core_exec_lockMutex("R/m", task->cpuToken, function->componentId, function->functionId);
+#else
     xme_core_exec_lockMutex("R/m", cpuToken, function->componentId, function->functionId);
+#endif
     xme_core_exec_unlockMutex("S/m", task->waitLock, function->componentId, function->functionId);
 
     XME_LOG(XME_LOG_DEBUG, MODULE_ACRONYM "[%d|%d] /dispatcher_recaptureExecutionToken()\n",
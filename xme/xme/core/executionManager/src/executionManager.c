@@ -177,7 +177,7 @@ xme_core_exec_step
     /* Schedule table entry for the next slot */
     xme_core_exec_schedule_table_entry_t* nextSlot;
 
-    /* Current slack */
+    /* Delay till the start of the next slot */
     xme_hal_time_timeInterval_t slack = 0U;
 
     /* Ask the scheduler to provide the next component to be executed */
@@ -193,7 +193,7 @@ xme_core_exec_step
         return XME_STATUS_SUCCESS;
     }
 
-    return xme_core_exec_dispatcher_executeStep(nextSlot, slack);
+    return xme_core_exec_dispatcher_executeStep(nextSlot, xme_core_exec_scheduler_getSlotStartTime(nextSlot));
 }
 
 //******************************************************************************//
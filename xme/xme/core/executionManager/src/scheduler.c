@@ -359,7 +359,11 @@ xme_core_exec_scheduler_calculateNextComponent
 			XME_CHECK(XME_STATUS_SUCCESS ==  xme_core_exec_scheduler_incrementCycleCounter(),
 										  XME_STATUS_INTERNAL_ERROR);
 
-			/* We are at the end of previous cycle */
+			/* We are at the end of previous cycle, no slot of it may still be running */
+			status = xme_core_exec_dispatcher_completeRunningSlots();
+			XME_CHECK(XME_STATUS_SUCCESS == status,
+					  status);
+
 			if(NULL != xme_core_exec_intConfig.onEndOfCycle)
 			{
 				XME_CHECK(XME_STATUS_SUCCESS == xme_core_exec_intConfig.onEndOfCycle(NULL),
@@ -388,10 +392,7 @@ xme_core_exec_scheduler_calculateNextComponent
     while((NULL == tableEntry)&&(XME_CORE_EXEC_SHUTDOWN != xme_core_exec_getState()));
 
     timeNow = xme_hal_time_getCurrentTime();
-    startTime = xme_hal_time_offsetTime(
-        xme_core_exec_scheduler_internalState.startOfCycle_ns,
-        XME_HAL_TIME_OFFSET_OPERATION_ADD,
-        tableEntry->slotStart_ns);
+    startTime = xme_core_exec_scheduler_getSlotStartTime(tableEntry);
 
     *entry = tableEntry;
     *startDelay_ns = getStartDelay(timeNow, startTime);
@@ -399,6 +400,19 @@ xme_core_exec_scheduler_calculateNextComponent
     return XME_STATUS_SUCCESS;
 }
 
+/****************************************************************************/
+xme_hal_time_timeHandle_t
+xme_core_exec_scheduler_getSlotStartTime
+(
+    const xme_core_exec_schedule_table_entry_t* entry
+)
+{
+    return xme_hal_time_offsetTime(
+        xme_core_exec_scheduler_internalState.startOfCycle_ns,
+        XME_HAL_TIME_OFFSET_OPERATION_ADD,
+        entry->slotStart_ns);
+}
+
 static void
 calculateNewStartOfCycle(void)
 {
@@ -37,7 +37,6 @@
 /***********/
 /* Statics */
 extern xme_hal_sync_criticalSectionHandle_t cpuToken;
-extern void* startData;
 
 /** \brief This utility function is called by the task to get access to
  *          "cpu" resource
@@ -197,10 +196,10 @@ xme_core_exec_dispatcher_waitForStart
 
     XME_LOG(XME_LOG_DEBUG,
             MODULE_ACRONYM "passing %" PRIu32 " to function [%d|%d]\n",
-            (uint32_t)(uintptr_t)startData, componentId, functionId);
+            (uint32_t)(uintptr_t)thisTask->startData, componentId, functionId);
 
     if (NULL != functionArguments)
-        *functionArguments = startData;
+        *functionArguments = thisTask->startData;
 
     /* XXX temporary workaround to allow smooth transition to xme_core_exec_getTaskState() */
     thisTask->wrapper->state = thisTask->state;
@@ -236,6 +235,7 @@ xme_core_exec_dispatcher_executionCompleted
         XME_STATUS_NOT_FOUND);
 
     /* Stop monitoring the task */
+    thisTask->completionTime = xme_hal_time_getCurrentTime();
     thisTask->running = false;
 
     XME_LOG(XME_LOG_DEBUG,
@@ -274,7 +274,12 @@ xme_core_exec_dispatcher_requestExecutionToken
 
     xme_core_exec_lockMutex("T/t", task->execLock, function->componentId, function->functionId);
     xme_core_exec_unlockMutex("S/t", task->waitLock, function->componentId, function->functionId);
+    /* Slots dispatched in parallel do not share the CPU resource */
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+    xme_core_exec_lockMutex("R/t", task->cpuToken, function->componentId, function->functionId);
+#else
     xme_core_exec_lockMutex("R/t", cpuToken, function->componentId, function->functionId);
+#endif
 
     XME_LOG(XME_LOG_DEBUG, MODULE_ACRONYM "[%d|%d] /dispatcher_requestExecutionToken()\n",
             function->componentId, function->functionId);
@@ -299,7 +304,11 @@ xme_core_exec_dispatcher_returnExecutionToken
             function->componentId, function->functionId);
 
     xme_core_exec_unlockMutex("T/t", task->execLock, function->componentId, function->functionId);
+#if XME_CORE_EXEC_DISPATCHER_WORKERS > 1
+    xme_core_exec_unlockMutex("R/t", task->cpuToken, function->componentId, function->functionId);
+#else
     xme_core_exec_unlockMutex("R/t", cpuToken, function->componentId, function->functionId);
+#endif
     xme_core_exec_lockMutex("S/t", task->waitLock, function->componentId, function->functionId);
 
     XME_LOG(XME_LOG_DEBUG, MODULE_ACRONYM "[%d|%d] /dispatcher_returnExecutionToken()\n",
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2011-2013, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Execution Manager dispatcher interface tests.
+ */
+
+#include <gtest/gtest.h>
+#include "xme/core/executionManager/test/testHelper_executionManager.h"
+#include "xme/core/executionManager/include/executionManager.h"
+#include "xme/core/executionManager/include/executionManagerComponentRepositoryInterface.h"
+#include "xme/core/executionManager/include/executionManagerScheduleManagementInterface.h"
+#include "xme/hal/include/sleep.h"
+#include "xme/hal/include/time.h"
+
+#define CYCLES 5U ///< Number of cycles each schedule is run for.
+#define CYCLE_LENGTH_MS 10U ///< Length of the cycle of each schedule.
+#define SLOT_LENGTH_MS 2U ///< Length of each slot.
+#define WCET_NS 1000U ///< Worst case execution time of the helper functions.
+
+static const xme_core_component_t punctualComponent = (xme_core_component_t) 11; ///< Completes within its slot.
+static const xme_core_component_t overrunningComponent = (xme_core_component_t) 12; ///< Completes after the end of its slot.
+static const xme_core_component_t eventTriggeredComponent = (xme_core_component_t) 13; ///< Event triggered without any inputs.
+static const xme_core_component_functionId_t functionId = (xme_core_component_functionId_t) 1;
+
+static xme_status_t
+overrunSlot(void* arg)
+{
+    XME_UNUSED_PARAMETER(arg);
+
+    xme_hal_sleep_sleep(xme_hal_time_timeIntervalFromMilliseconds(2U * SLOT_LENGTH_MS));
+
+    return XME_STATUS_SUCCESS;
+}
+
+class ExecutionManagerDispatcherInterfaceTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase(void)
+    {
+        xme_core_exec_componentDescriptor_t* component;
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_init(&testConfig));
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, createHelperInstance(punctualComponent, functionId, WCET_NS));
+        ASSERT_EQ(XME_STATUS_SUCCESS, createHelperInstance(overrunningComponent, functionId, WCET_NS));
+
+        component = createHelper(eventTriggeredComponent, functionId, WCET_NS);
+        ASSERT_TRUE(NULL != component);
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_componentRepository_registerComponent(component));
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_dispatcher_createFunctionExecutionUnit(
+            (xme_core_exec_functionDescriptor_t*) xme_hal_singlyLinkedList_itemFromIndex(&component->functions, 0), true));
+
+        // The helper functions reset their callbacks when they initialize in their own threads.
+        // Running them once makes sure that this has happened before the tests install callbacks.
+        runSlot(punctualComponent, 1U);
+        runSlot(overrunningComponent, 1U);
+    }
+
+    static void TearDownTestCase(void)
+    {
+        EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_exec_fini());
+    }
+
+    virtual void SetUp(void)
+    {
+        clearExecutionCounters();
+    }
+
+    virtual void TearDown(void)
+    {
+        functionPointers[overrunningComponent + functionId] = NULL;
+    }
+
+    static void
+    runSlot(xme_core_component_t componentId, uint32_t cycles)
+    {
+        xme_core_exec_schedule_table_t* table;
+        xme_core_exec_schedule_handle_t schedule;
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_scheduler_createScheduleTable(&table,
+            xme_hal_time_timeIntervalFromMilliseconds(CYCLE_LENGTH_MS)));
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_scheduler_addElementToScheduleTable(table, componentId, functionId, NULL,
+            0U, xme_hal_time_timeIntervalFromMilliseconds(SLOT_LENGTH_MS), 0, 0, true));
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_scheduler_registerSchedule(table, &schedule));
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_dispatcher_resetSlotStatistics(componentId, functionId));
+        xme_core_exec_scheduler_activateSchedule(schedule);
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_run(cycles, false));
+    }
+};
+
+TEST_F(ExecutionManagerDispatcherInterfaceTest, SlotStatisticsWithInvalidParameters)
+{
+    xme_core_exec_slotStatistics_t statistics;
+
+    EXPECT_EQ(XME_STATUS_INVALID_PARAMETER, xme_core_exec_dispatcher_getSlotStatistics(punctualComponent, functionId, NULL));
+    EXPECT_EQ(XME_STATUS_NOT_FOUND, xme_core_exec_dispatcher_getSlotStatistics((xme_core_component_t) 42, functionId, &statistics));
+    EXPECT_EQ(XME_STATUS_NOT_FOUND, xme_core_exec_dispatcher_resetSlotStatistics((xme_core_component_t) 42, functionId));
+}
+
+TEST_F(ExecutionManagerDispatcherInterfaceTest, StatisticsOfPunctualSlots)
+{
+    xme_core_exec_slotStatistics_t statistics;
+
+    runSlot(punctualComponent, CYCLES);
+    ASSERT_EQ(CYCLES, getExecutionCount(punctualComponent, functionId));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_dispatcher_getSlotStatistics(punctualComponent, functionId, &statistics));
+    EXPECT_EQ(CYCLES, statistics.activations);
+    EXPECT_EQ(0U, statistics.skipped);
+    EXPECT_LE(statistics.minJitter_ns, statistics.maxJitter_ns);
+    EXPECT_LE(statistics.minJitter_ns * CYCLES, statistics.totalJitter_ns);
+    EXPECT_GE(statistics.maxJitter_ns * CYCLES, statistics.totalJitter_ns);
+
+    // The function only overruns its slot if it has been activated late
+    if (statistics.overruns > 0U)
+    {
+        EXPECT_LT(xme_hal_time_timeIntervalFromMilliseconds(SLOT_LENGTH_MS), statistics.maxJitter_ns + statistics.maxExecutionTime_ns);
+    }
+
+    // Resetting clears all counters
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_dispatcher_resetSlotStatistics(punctualComponent, functionId));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_dispatcher_getSlotStatistics(punctualComponent, functionId, &statistics));
+    EXPECT_EQ(0U, statistics.activations);
+    EXPECT_EQ(0U, statistics.maxJitter_ns);
+    EXPECT_EQ(0U, statistics.totalJitter_ns);
+    EXPECT_EQ(0U, statistics.maxExecutionTime_ns);
+}
+
+TEST_F(ExecutionManagerDispatcherInterfaceTest, OverrunsAreCounted)
+{
+    xme_core_exec_slotStatistics_t statistics;
+
+    functionPointers[overrunningComponent + functionId] = overrunSlot;
+    runSlot(overrunningComponent, CYCLES);
+    ASSERT_EQ(CYCLES, getExecutionCount(overrunningComponent, functionId));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_dispatcher_getSlotStatistics(overrunningComponent, functionId, &statistics));
+    EXPECT_EQ(CYCLES, statistics.activations);
+    EXPECT_EQ(CYCLES, statistics.overruns);
+    EXPECT_LE(xme_hal_time_timeIntervalFromMilliseconds(2U * SLOT_LENGTH_MS), statistics.maxExecutionTime_ns);
+}
+
+TEST_F(ExecutionManagerDispatcherInterfaceTest, EventTriggeredSlotsWithoutInputsAreSkipped)
+{
+    xme_core_exec_slotStatistics_t statistics;
+
+    runSlot(eventTriggeredComponent, CYCLES);
+    ASSERT_EQ(0U, getExecutionCount(eventTriggeredComponent, functionId));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_dispatcher_getSlotStatistics(eventTriggeredComponent, functionId, &statistics));
+    EXPECT_EQ(0U, statistics.activations);
+    EXPECT_EQ(CYCLES, statistics.skipped);
+    EXPECT_EQ(0U, statistics.overruns);
+}
+
+TEST(ExecutionManagerSleepTest, SleepUntil)
+{
+    xme_hal_time_timeHandle_t startTime = xme_hal_time_getCurrentTime();
+    xme_hal_time_timeHandle_t wakeUpTime;
+
+    // Sleeps until the given point in time
+    wakeUpTime = xme_hal_time_offsetTime(startTime, XME_HAL_TIME_OFFSET_OPERATION_ADD,
+        xme_hal_time_timeIntervalFromMilliseconds(SLOT_LENGTH_MS));
+    xme_hal_sleep_sleepUntil(wakeUpTime);
+    EXPECT_LE(0, xme_hal_time_compareTime(xme_hal_time_getCurrentTime(), wakeUpTime));
+
+    // Returns immediately if the point in time has passed
+    startTime = xme_hal_time_getCurrentTime();
+    xme_hal_sleep_sleepUntil(wakeUpTime);
+    EXPECT_GT(xme_hal_time_timeIntervalFromMilliseconds(CYCLE_LENGTH_MS), xme_hal_time_getTimeInterval(&startTime, false));
+}
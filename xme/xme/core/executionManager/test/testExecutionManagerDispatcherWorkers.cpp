@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2011-2013, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Execution Manager tests of slots dispatched in parallel.
+ *
+ * \details Built against xme_core_executionManagerWorkers, where XME_CORE_EXEC_DISPATCHER_WORKERS is 2.
+ */
+
+#include <gtest/gtest.h>
+#include "xme/core/executionManager/test/testHelper_executionManager.h"
+#include "xme/core/executionManager/include/executionManager.h"
+#include "xme/core/executionManager/include/executionManagerScheduleManagementInterface.h"
+#include "xme/core/broker/include/broker.h"
+#include "xme/core/broker/include/brokerPnpManagerInterface.h"
+#include "xme/hal/include/sleep.h"
+#include "xme/hal/include/time.h"
+
+#define CYCLES 3U ///< Number of cycles each schedule is run for.
+#define CYCLE_LENGTH_MS 50U ///< Length of the cycle of each schedule.
+#define SLOT_LENGTH_MS 4U ///< Length of each slot.
+#define WAIT_MS 30U ///< Time the function of the first slot waits for the one of the second slot.
+#define WCET_NS 1000U ///< Worst case execution time of the helper functions.
+
+static const xme_core_component_t independentFirstComponent = (xme_core_component_t) 21; ///< Exchanges no data with independentSecondComponent.
+static const xme_core_component_t independentSecondComponent = (xme_core_component_t) 22;
+static const xme_core_component_t producerComponent = (xme_core_component_t) 23; ///< Writes the data read by consumerComponent.
+static const xme_core_component_t consumerComponent = (xme_core_component_t) 24;
+static const xme_core_component_functionId_t functionId = (xme_core_component_functionId_t) 1;
+
+static const xme_core_dataManager_dataPacketId_t producerDataPacket = (xme_core_dataManager_dataPacketId_t) 1;
+static const xme_core_dataManager_dataPacketId_t consumerDataPacket = (xme_core_dataManager_dataPacketId_t) 2;
+
+static uint32_t secondSlotStarts = 0U; ///< Incremented atomically by the function of the second slot.
+static uint32_t overlappingSlots = 0U; ///< Activations of the first slot during which the second one started.
+
+static xme_status_t
+waitForSecondSlot(void* arg)
+{
+    uint32_t starts = __sync_add_and_fetch(&secondSlotStarts, 0U);
+    xme_hal_time_timeHandle_t startTime = xme_hal_time_getCurrentTime();
+
+    XME_UNUSED_PARAMETER(arg);
+
+    while (xme_hal_time_getTimeInterval(&startTime, false) < xme_hal_time_timeIntervalFromMilliseconds(WAIT_MS))
+    {
+        if (__sync_add_and_fetch(&secondSlotStarts, 0U) != starts)
+        {
+            (void) __sync_add_and_fetch(&overlappingSlots, 1U);
+            break;
+        }
+        xme_hal_sleep_sleep(xme_hal_time_timeIntervalFromMilliseconds(1U));
+    }
+
+    return XME_STATUS_SUCCESS;
+}
+
+static xme_status_t
+startSecondSlot(void* arg)
+{
+    XME_UNUSED_PARAMETER(arg);
+
+    (void) __sync_add_and_fetch(&secondSlotStarts, 1U);
+
+    return XME_STATUS_SUCCESS;
+}
+
+class ExecutionManagerDispatcherWorkersTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase(void)
+    {
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_init(&testConfig));
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, createHelperInstance(independentFirstComponent, functionId, WCET_NS));
+        ASSERT_EQ(XME_STATUS_SUCCESS, createHelperInstance(independentSecondComponent, functionId, WCET_NS));
+        ASSERT_EQ(XME_STATUS_SUCCESS, createHelperInstance(producerComponent, functionId, WCET_NS));
+        ASSERT_EQ(XME_STATUS_SUCCESS, createHelperInstance(consumerComponent, functionId, WCET_NS));
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketToFunction(producerDataPacket, producerComponent, functionId,
+            (xme_core_component_functionVariantId_t) 0, false));
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketToFunction(consumerDataPacket, consumerComponent, functionId,
+            (xme_core_component_functionVariantId_t) 0, false));
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_broker_addDataPacketTransferEntry(producerDataPacket, consumerDataPacket));
+
+        // The helper functions reset their callbacks when they initialize in their own threads.
+        // Running them once makes sure that this has happened before the tests install callbacks.
+        runSlots(independentFirstComponent, independentSecondComponent, 1U);
+        runSlots(producerComponent, consumerComponent, 1U);
+    }
+
+    static void TearDownTestCase(void)
+    {
+        EXPECT_EQ(XME_STATUS_SUCCESS, xme_core_exec_fini());
+    }
+
+    virtual void SetUp(void)
+    {
+        clearExecutionCounters();
+        overlappingSlots = 0U;
+    }
+
+    static void
+    runSlots(xme_core_component_t firstComponentId, xme_core_component_t secondComponentId, uint32_t cycles)
+    {
+        xme_core_exec_schedule_table_t* table;
+        xme_core_exec_schedule_handle_t schedule;
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_scheduler_createScheduleTable(&table,
+            xme_hal_time_timeIntervalFromMilliseconds(CYCLE_LENGTH_MS)));
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_scheduler_addElementToScheduleTable(table, firstComponentId, functionId, NULL,
+            0U, xme_hal_time_timeIntervalFromMilliseconds(SLOT_LENGTH_MS), 0, 0, true));
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_scheduler_addElementToScheduleTable(table, secondComponentId, functionId, NULL,
+            xme_hal_time_timeIntervalFromMilliseconds(SLOT_LENGTH_MS), xme_hal_time_timeIntervalFromMilliseconds(SLOT_LENGTH_MS), 0, 0, true));
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_scheduler_registerSchedule(table, &schedule));
+
+        xme_core_exec_scheduler_activateSchedule(schedule);
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_exec_run(cycles, false));
+    }
+
+    void
+    runWithCallbacks(xme_core_component_t firstComponentId, xme_core_component_t secondComponentId)
+    {
+        functionPointers[firstComponentId + functionId] = waitForSecondSlot;
+        functionPointers[secondComponentId + functionId] = startSecondSlot;
+
+        runSlots(firstComponentId, secondComponentId, CYCLES);
+
+        functionPointers[firstComponentId + functionId] = NULL;
+        functionPointers[secondComponentId + functionId] = NULL;
+    }
+};
+
+TEST_F(ExecutionManagerDispatcherWorkersTest, IndependentSlotsRunInParallel)
+{
+    runWithCallbacks(independentFirstComponent, independentSecondComponent);
+
+    EXPECT_EQ(CYCLES, getExecutionCount(independentFirstComponent, functionId));
+    EXPECT_EQ(CYCLES, getExecutionCount(independentSecondComponent, functionId));
+
+    // The second slot started while the function of the first one was still waiting
+    EXPECT_EQ(CYCLES, overlappingSlots);
+}
+
+TEST_F(ExecutionManagerDispatcherWorkersTest, DependentSlotsRunOneAfterAnother)
+{
+    runWithCallbacks(producerComponent, consumerComponent);
+
+    EXPECT_EQ(CYCLES, getExecutionCount(producerComponent, functionId));
+    EXPECT_EQ(CYCLES, getExecutionCount(consumerComponent, functionId));
+
+    // The consumer only started after the producer completed
+    EXPECT_EQ(0U, overlappingSlots);
+}
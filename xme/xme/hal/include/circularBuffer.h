@@ -31,6 +31,13 @@
  *          are read in the order that they have been written. A read operation
  *          on an empty buffer and a write operation to a full buffer result in
  *          an error.
+ *
+ *          A buffer initialized with xme_hal_circularBuffer_init() has to be
+ *          protected by the caller if it is accessed by several threads.
+ *          xme_hal_circularBuffer_initLockFree() creates a buffer that may be
+ *          accessed concurrently without further locking, either by one
+ *          producer and one consumer thread or by any number of producer and
+ *          consumer threads.
  */
 
 //******************************************************************************//
@@ -63,6 +70,17 @@
 //***   Type definitions                                                     ***//
 //******************************************************************************//
 
+/**
+ * \enum xme_hal_circularBuffer_concurrency_t
+ * \brief Which threads may access a circular buffer concurrently.
+ */
+typedef enum
+{
+    XME_HAL_CIRCULARBUFFER_CONCURRENCY_EXTERNAL_LOCKING = 0, ///< Any access has to be synchronized by the caller.
+    XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC, ///< Lock-free, a single thread pushes and a single thread pops.
+    XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC ///< Lock-free, any number of threads push and pop.
+} xme_hal_circularBuffer_concurrency_t;
+
 /**
  * \struct xme_hal_circularBuffer_t
  * \brief The struct storing the circular buffer. 
@@ -77,6 +95,8 @@ typedef struct
     void* writeHead;               ///< Pointer to write head.
     void* readTail;                ///< Pointer to read tail.
     bool overwrite;                ///< Establish if the push operation overwrites. 
+    xme_hal_circularBuffer_concurrency_t concurrency; ///< Which threads may access the buffer concurrently.
+    void* lockFreeState;           ///< Positions of the lock-free variants, NULL for external locking. Count, write head and read tail are not used by the lock-free variants.
 } xme_hal_circularBuffer_t;
 
 //******************************************************************************//
@@ -114,6 +134,37 @@ xme_hal_circularBuffer_init
     bool overwrite
 );
 
+/**
+ * \brief Initializes a circular buffer that may be accessed concurrently
+ *        without locking.
+ *
+ * \details Pushing to a full buffer fails, items are never overwritten.
+ *          With XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC the number of items
+ *          the buffer can hold is rounded up to the next power of two (at
+ *          least two). XME_HAL_CIRCULARBUFFER_CONCURRENCY_EXTERNAL_LOCKING
+ *          yields the same buffer as xme_hal_circularBuffer_init() without
+ *          overwriting.
+ *
+ * \param[in] circularBuffer The circular buffer to create.
+ * \param[in] maximumSize The maximum size of the queue.
+ * \param[in] itemSizeInBytes The size of each individual item.
+ * \param[in] concurrency Which threads may access the buffer concurrently.
+ *
+ * \retval XME_STATUS_SUCCESS If the circular buffer is successfully created.
+ * \retval XME_STATUS_INVALID_PARAMETER If the size of the buffer or of the
+ *         items is zero or concurrency is invalid.
+ * \retval XME_STATUS_OUT_OF_RESOURCES When there is no more free space for
+ *         creating the circular buffer.
+ */
+xme_status_t
+xme_hal_circularBuffer_initLockFree
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    uint32_t maximumSize,
+    size_t itemSizeInBytes,
+    xme_hal_circularBuffer_concurrency_t concurrency
+);
+
 /**
  * \brief Frees the resources occupied by the circular buffer. 
  *
@@ -170,6 +221,74 @@ xme_hal_circularBuffer_popFront
 
 /* ----- END cc-by-sa 3.0 ----- */
 
+/**
+ * \brief Adds several elements to the end of the circular buffer.
+ *
+ * \details The items are written in the given order, as if pushed one after
+ *          another with xme_hal_circularBuffer_pushBack(), but the positions
+ *          are updated only once. If the buffer cannot take all items and
+ *          does not overwrite, as many items as fit are written. Items
+ *          pushed concurrently by other producers to an MPMC buffer never
+ *          end up between the written items.
+ *
+ * \param[in] circularBuffer The circular buffer.
+ * \param[in] items Array of itemCount items to write.
+ * \param[in] itemCount Number of items to write.
+ * \param[out] pushedCount Number of items that have been written. May be
+ *             NULL.
+ *
+ * \retval XME_STATUS_SUCCESS If all items have been written.
+ * \retval XME_STATUS_PERMISSION_DENIED If not all items have been written,
+ *         because the circular buffer is full.
+ */
+xme_status_t
+xme_hal_circularBuffer_pushBackN
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    const void* items,
+    uint32_t itemCount,
+    uint32_t* const pushedCount
+);
+
+/**
+ * \brief Reads several elements from the tail of the circular buffer.
+ *
+ * \param[in] circularBuffer The circular buffer.
+ * \param[out] items Array that can store maxItemCount items.
+ * \param[in] maxItemCount Maximum number of items to read.
+ * \param[out] poppedCount Number of items that have been read, in the order
+ *             they have been pushed.
+ *
+ * \retval XME_STATUS_SUCCESS If at least one item has been read.
+ * \retval XME_STATUS_PERMISSION_DENIED If there are no items to pop from the
+ *         front of the circular buffer.
+ */
+xme_status_t
+xme_hal_circularBuffer_popFrontN
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    void* items,
+    uint32_t maxItemCount,
+    uint32_t* const poppedCount
+);
+
+/**
+ * \brief Gets the number of items stored in the circular buffer.
+ *
+ * \note For the lock-free variants the result is a snapshot that may be
+ *       outdated as soon as it is returned if other threads access the
+ *       buffer.
+ *
+ * \param[in] circularBuffer The circular buffer.
+ *
+ * \return Number of items stored in the circular buffer.
+ */
+uint32_t
+xme_hal_circularBuffer_getCount
+(
+    xme_hal_circularBuffer_t* circularBuffer
+);
+
 /**
  * \brief Gets the relative position of the tail item in the circular buffer. 
  *
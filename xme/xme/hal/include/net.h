@@ -109,6 +109,57 @@ typedef enum
 }
 xme_hal_net_socketHandle_t;
 
+/**
+ * \struct xme_hal_net_datagramDestination_t
+ *
+ * \brief  Destination of datagrams that has been resolved once with
+ *         xme_hal_net_resolveDatagramDestination().
+ *
+ * \details The structure caches the platform specific socket descriptor
+ *          and socket address, so sending to it requires neither an address
+ *          translation nor a lookup in the socket table. It stays valid until
+ *          the socket it has been resolved for is closed. The members are
+ *          private to the network abstraction.
+ */
+typedef struct
+{
+    xme_hal_net_socketHandle_t socketHandle; ///< Socket the destination has been resolved for.
+    uintptr_t nativeSocket; ///< Platform specific socket descriptor.
+    uint16_t addressLength; ///< Length of the platform specific address in bytes, zero if the destination has not been resolved.
+    union
+    {
+        uint64_t alignment; ///< Enforces the alignment required by the platform specific address.
+        uint8_t bytes[32]; ///< Platform specific socket address (large enough for IPv4 and IPv6).
+    } address; ///< Platform specific socket address.
+}
+xme_hal_net_datagramDestination_t;
+
+/**
+ * \struct xme_hal_net_datagram_t
+ *
+ * \brief  Datagram to be sent with xme_hal_net_writeDatagrams().
+ */
+typedef struct
+{
+    const xme_hal_net_datagramDestination_t* destination; ///< Resolved destination of the datagram.
+    const void* buffer; ///< Datagram data.
+    uint16_t count; ///< Number of bytes to send.
+}
+xme_hal_net_datagram_t;
+
+/**
+ * \struct xme_hal_net_receivedDatagram_t
+ *
+ * \brief  Datagram to be received with xme_hal_net_readDatagrams().
+ */
+typedef struct
+{
+    void* buffer; ///< Buffer to place the datagram in.
+    uint16_t size; ///< Size of the buffer. Longer datagrams are truncated.
+    uint16_t count; ///< Number of bytes received.
+}
+xme_hal_net_receivedDatagram_t;
+
 /**
  * \enum xme_hal_net_byteOrder_t
  *
@@ -449,6 +500,96 @@ xme_hal_net_writeDatagram
     uint16_t count
 );
 
+/**
+ * \brief  Receives the datagrams that are queued on the given socket
+ *         without waiting for further datagrams.
+ *
+ * \details Where the platform supports it, the datagrams are fetched from
+ *          the operating system with a single call. In contrast to
+ *          xme_hal_net_readSocket(), the address of the last reception is
+ *          not updated.
+ *
+ * \param[in] socketHandle Socket to receive from.
+ * \param[in,out] datagrams Buffers to receive the datagrams in. The count
+ *                member of the first datagrams is set to the number of
+ *                received bytes.
+ * \param[in] count Number of buffers.
+ * \param[out] droppedCount If not NULL and the platform reports it, set to
+ *             the total number of datagrams the operating system dropped
+ *             for this socket because its receive queue was full.
+ *             Left unchanged otherwise.
+ * \return Number of datagrams received.
+ */
+uint16_t
+xme_hal_net_readDatagrams
+(
+    xme_hal_net_socketHandle_t socketHandle,
+    xme_hal_net_receivedDatagram_t* datagrams,
+    uint16_t count,
+    uint32_t* droppedCount
+);
+
+/**
+ * \brief  Resolves the destination of datagrams sent over the given socket.
+ *
+ * \details Performs the address translation of xme_hal_net_writeDatagram()
+ *          once, so that subsequent datagrams can be sent with
+ *          xme_hal_net_writeDatagramTo() or xme_hal_net_writeDatagrams().
+ *
+ * \param[in] socketHandle Socket to use for sending.
+ * \param[in] remoteAddress Address of destination.
+ * \param[out] destination Resolved destination.
+ *
+ * \retval XME_STATUS_SUCCESS if the destination has been resolved.
+ * \retval XME_STATUS_INVALID_HANDLE if the socket handle is invalid.
+ * \retval XME_STATUS_INVALID_PARAMETER if the remote address is invalid.
+ * \retval XME_STATUS_INVALID_CONFIGURATION if the socket is connected and
+ *         hence can not send datagrams to arbitrary destinations.
+ */
+xme_status_t
+xme_hal_net_resolveDatagramDestination
+(
+    xme_hal_net_socketHandle_t socketHandle,
+    xme_com_interface_address_t* remoteAddress,
+    xme_hal_net_datagramDestination_t* destination
+);
+
+/**
+ * \brief  Sends a datagram to a destination resolved with
+ *         xme_hal_net_resolveDatagramDestination().
+ *
+ * \param destination Resolved destination.
+ * \param buffer Buffer with data to send. Must be at least of size count.
+ * \param count Number of bytes to send.
+ * \return Number of bytes actually sent.
+ */
+uint16_t
+xme_hal_net_writeDatagramTo
+(
+    const xme_hal_net_datagramDestination_t* destination,
+    const void* buffer,
+    uint16_t count
+);
+
+/**
+ * \brief  Sends the given datagrams in order.
+ *
+ * \details Where the platform supports it, consecutive datagrams that use
+ *          the same socket are passed to the operating system with a single
+ *          call.
+ *
+ * \param datagrams Datagrams to send.
+ * \param count Number of datagrams.
+ * \return Number of datagrams actually sent. Sending stops at the first
+ *         datagram that could not be sent.
+ */
+uint16_t
+xme_hal_net_writeDatagrams
+(
+    const xme_hal_net_datagram_t* datagrams,
+    uint16_t count
+);
+
 /**
  * \brief Get the IP address of the networking interface.
  *        If no interface is provided it returns the first valid IP address.
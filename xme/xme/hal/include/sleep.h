@@ -33,6 +33,8 @@
 /******************************************************************************/
 #include "xme/defines.h"
 
+#include "xme/hal/include/time.h"
+
 #include <stdint.h>
 
 /******************************************************************************/
@@ -52,6 +54,25 @@ xme_hal_sleep_sleep
     xme_hal_time_timeInterval_t sleepTime
 );
 
+/**
+ * \brief  Halts execution of the current task until the given point in time.
+ *
+ * \details In contrast to xme_hal_sleep_sleep(), the deadline is absolute, so
+ *          the time that passes between calculating the deadline and going
+ *          to sleep (for example due to preemption) does not delay the
+ *          wake up. Returns immediately if the given point in time already
+ *          passed.
+ *
+ * \param  wakeUpTime Point in time (as returned by
+ *         xme_hal_time_getCurrentTime() or derived from such a value) at
+ *         which execution of the current task shall continue.
+ */
+void
+xme_hal_sleep_sleepUntil
+(
+    xme_hal_time_timeHandle_t wakeUpTime
+);
+
 XME_EXTERN_C_END
 
 /**
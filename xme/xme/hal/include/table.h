@@ -271,6 +271,156 @@
  *            is "smaller" than element2.
  */
 
+/**
+ * \def XME_HAL_SLABTABLE
+ *
+ * \brief Defines a slab table, a table variant that keeps its items in one
+ *        contiguous block of memory.
+ *
+ * \details A slab table is selected per table as an alternative to
+ *          XME_HAL_TABLE() for tables that are mostly looked up and iterated.
+ *          Its items are stored densely, without holes, so that iteration
+ *          only touches the items actually in the table. Items are addressed
+ *          by xme_hal_table_slabHandle_t handles, which are resolved in
+ *          constant time and carry a generation counter, so that a handle of
+ *          a removed item is detected as invalid even if its slot has been
+ *          reused in the meantime.
+ *
+ * \warning Adding an item may move all items of the table and removing an
+ *          item moves the last item into the place of the removed one. Hence,
+ *          pointers to slab table items are only valid until the next
+ *          addition or removal. Store handles instead.
+ *
+ * \note Slab tables are only available on platforms with dynamic memory
+ *       allocation.
+ *
+ * \param[in] itemType Type of the items in the table.
+ * \param[in] name Name of the table.
+ * \param[in] maxElements Maximum number of elements in the table. Only used
+ *            for consistency with XME_HAL_TABLE(), at most
+ *            XME_HAL_TABLE_MAX_ROW_HANDLE items can be stored.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_INIT
+ *
+ * \brief Initializes the given slab table.
+ *        This macro must be called for a slab table before it can be used.
+ *
+ * \param[in] name Name of the slab table to initialize.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_FINI
+ *
+ * \brief Destroys the given slab table and frees the memory occupied by it.
+ *
+ * \param[in] name Name of the slab table to finalize.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_CLEAR
+ *
+ * \brief Removes all items from the given slab table.
+ *
+ * \details The memory of the table is kept for subsequent additions. Handles
+ *          of the removed items remain invalid.
+ *
+ * \param[in] name Name of the slab table to clear.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_ADD_ITEM
+ *
+ * \brief Adds a new item, initialized with all zeros, to the given slab
+ *        table.
+ *
+ * \param[in] name Name of the slab table to add an item to.
+ *
+ * \return Returns the handle of the newly created item or
+ *         XME_HAL_TABLE_INVALID_SLAB_HANDLE if memory allocation failed or
+ *         the table is full.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_REMOVE_ITEM
+ *
+ * \brief Removes the item corresponding to the given handle from the slab
+ *        table.
+ *
+ * \param[in] name Name of the slab table.
+ * \param[in] handle Handle of the item to remove.
+ *
+ * \retval XME_STATUS_SUCCESS if the item has been successfully removed.
+ * \retval XME_STATUS_INVALID_HANDLE if the given handle was invalid or the
+ *         item has already been removed.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_ITEM_COUNT
+ *
+ * \brief Returns the number of items in the given slab table.
+ *
+ * \param[in] name Name of the slab table.
+ *
+ * \return Number of items in the given slab table.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_ITEM_FROM_HANDLE
+ *
+ * \brief Returns a pointer to the slab table item for the given handle or
+ *        NULL if no such item exists (any more).
+ *
+ * \param[in] name Name of the slab table.
+ * \param[in] handle Handle of the item to retrieve.
+ *
+ * \return Returns a pointer to the item corresponding to the given handle
+ *         or NULL if no such item exists.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_ITERATE_BEGIN
+ *
+ * \brief Begins a block for iterating over all items of the given slab
+ *        table.
+ *
+ * \details The order of iteration is unspecified.
+ *
+ * \note A block started with XME_HAL_SLABTABLE_ITERATE_BEGIN() must be ended
+ *       with XME_HAL_SLABTABLE_ITERATE_END() at the same scope.
+ *
+ * \warning The current item may be removed from within the iterator body,
+ *          but no other item. Items added from within the iterator body do
+ *          not appear in subsequent iterations.
+ *
+ * \param[in] name Name of the slab table to iterate over.
+ * \param[in] loopHandle Name of the loop handle variable of type
+ *            xme_hal_table_slabHandle_t.
+ *            This variable can be used from within the iterator body.
+ * \param[in] loopItemType Base type of the items that are iterated over.
+ *            This parameter should be the type of the table items, not a
+ *            pointer to them.
+ * \param[in] loopItem Name of the loop item variable.
+ *            This variable can be used from within the iterator body.
+ */
+
+/**
+ * \def XME_HAL_SLABTABLE_ITERATE_END
+ *
+ * \brief Ends a block for iterating over all items of the given slab table.
+ *
+ * \note A block ended with XME_HAL_SLABTABLE_ITERATE_END() must be started
+ *       with XME_HAL_SLABTABLE_ITERATE_BEGIN() at the same scope.
+ */
+
+/**
+ * \def XME_HAL_TABLE_INVALID_SLAB_HANDLE
+ *
+ * \brief Invalid slab table handle.
+ */
+#define XME_HAL_TABLE_INVALID_SLAB_HANDLE ((xme_hal_table_slabHandle_t) 0U)
+
 /******************************************************************************/
 /***   Type definitions                                                     ***/
 /******************************************************************************/
@@ -301,6 +451,19 @@ xme_hal_table_rowHandle_t;
 // TODO: This type will vanish after we replace the above enum by #define statements (compare Issue #3455)
 typedef uint16_t xme_hal_table_rowHandleBaseType_t;
 
+/**
+ * \typedef xme_hal_table_slabHandle_t
+ *
+ * \brief  Slab table item handle.
+ *
+ * \details The lower 16 bits are the one-based number of the slot of the
+ *          item, the upper 16 bits are the generation of the slot when the
+ *          item has been added. Valid handles are non-zero.
+ *
+ * \see XME_HAL_SLABTABLE
+ */
+typedef uint32_t xme_hal_table_slabHandle_t;
+
 /**
  * \typedef xme_hal_table_iterator_t
  *
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2011-2014, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Circular Buffer integration test, accessing the lock-free variants
+ *         from concurrent threads.
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "xme/hal/include/circularBuffer.h"
+#include "xme/hal/include/sched.h"
+#include "xme/hal/include/sleep.h"
+#include "xme/hal/include/sync.h"
+#include "xme/hal/include/time.h"
+
+#include <stdint.h>
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define MAXPRODUCERS 2U ///< Maximum number of producer threads.
+#define MAXCONSUMERS 2U ///< Maximum number of consumer threads.
+#define ITEMSPERPRODUCER 200000U ///< Number of items each producer pushes.
+#define BUFFERSIZE 16U ///< Small, such that the buffer is often full or empty.
+#define MAXBATCH 7U ///< Maximum number of items per batch operation.
+#define TIMEOUT_S 60U ///< Time after which the threads are aborted.
+
+/******************************************************************************/
+/***   Type definitions                                                     ***/
+/******************************************************************************/
+/**
+ * \brief Data of a producer or consumer thread.
+ */
+typedef struct
+{
+    uint32_t id; ///< Index of the thread among the producers or consumers.
+    uint32_t lastSequence[MAXPRODUCERS]; ///< Consumer: sequence number of the last item received from each producer, plus one.
+    uint32_t received[MAXPRODUCERS]; ///< Consumer: number of items received from each producer.
+    uint32_t reorderings; ///< Consumer: number of items received out of order.
+}
+stressTestThread_t;
+
+/******************************************************************************/
+/***   Variables                                                            ***/
+/******************************************************************************/
+static xme_hal_circularBuffer_t circularBuffer;
+static xme_hal_sync_criticalSectionHandle_t stateCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+static uint16_t finishedThreads = 0U;
+static uint32_t remainingItems = 0U; ///< Number of items the consumers still have to pop.
+static volatile bool abortThreads = false;
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+static void
+finishThread(void)
+{
+    xme_hal_sync_enterCriticalSection(stateCriticalSection);
+    finishedThreads++;
+    xme_hal_sync_leaveCriticalSection(stateCriticalSection);
+}
+
+static void
+producerTask(void* userData)
+{
+    stressTestThread_t* thread = (stressTestThread_t*) userData;
+    uint32_t batch[MAXBATCH];
+    uint32_t sequence = 0U;
+    uint32_t batchSize = 1U;
+    uint32_t pushed;
+    uint32_t i;
+
+    while (sequence < ITEMSPERPRODUCER && !abortThreads)
+    {
+        // Vary the batch size between single items and MAXBATCH items
+        batchSize = (batchSize % MAXBATCH) + 1U;
+        if (batchSize > ITEMSPERPRODUCER - sequence)
+        {
+            batchSize = ITEMSPERPRODUCER - sequence;
+        }
+
+        for (i = 0U; i < batchSize; i++)
+        {
+            batch[i] = (thread->id << 24) | (sequence + i);
+        }
+
+        if (1U == batchSize)
+        {
+            pushed = (XME_STATUS_SUCCESS == xme_hal_circularBuffer_pushBack(&circularBuffer, batch)) ? 1U : 0U;
+        }
+        else
+        {
+            (void) xme_hal_circularBuffer_pushBackN(&circularBuffer, batch, batchSize, &pushed);
+        }
+
+        sequence += pushed;
+
+        if (0U == pushed)
+        {
+            // Buffer is full, let the consumers run (on machines with few cores)
+            xme_hal_sleep_sleep(0U);
+        }
+    }
+
+    finishThread();
+}
+
+static void
+consumerTask(void* userData)
+{
+    stressTestThread_t* thread = (stressTestThread_t*) userData;
+    uint32_t batch[MAXBATCH];
+    uint32_t batchSize = 1U;
+    uint32_t popped;
+    uint32_t i;
+
+    for (;;)
+    {
+        xme_hal_sync_enterCriticalSection(stateCriticalSection);
+        popped = remainingItems;
+        xme_hal_sync_leaveCriticalSection(stateCriticalSection);
+
+        if (0U == popped || abortThreads)
+        {
+            break;
+        }
+
+        batchSize = (batchSize % MAXBATCH) + 1U;
+
+        if (1U == batchSize)
+        {
+            popped = (XME_STATUS_SUCCESS == xme_hal_circularBuffer_popFront(&circularBuffer, batch)) ? 1U : 0U;
+        }
+        else
+        {
+            (void) xme_hal_circularBuffer_popFrontN(&circularBuffer, batch, batchSize, &popped);
+        }
+
+        for (i = 0U; i < popped; i++)
+        {
+            uint32_t producer = batch[i] >> 24;
+            uint32_t sequence = batch[i] & 0xFFFFFFU;
+
+            // Items of a producer have to arrive in the order they have
+            // been pushed, even if other consumers take some of them
+            if (producer >= MAXPRODUCERS || sequence < thread->lastSequence[producer])
+            {
+                thread->reorderings++;
+                continue;
+            }
+
+            thread->lastSequence[producer] = sequence + 1U;
+            thread->received[producer]++;
+        }
+
+        if (0U < popped)
+        {
+            xme_hal_sync_enterCriticalSection(stateCriticalSection);
+            remainingItems -= popped;
+            xme_hal_sync_leaveCriticalSection(stateCriticalSection);
+        }
+        else
+        {
+            // Buffer is empty, let the producers run (on machines with few cores)
+            xme_hal_sleep_sleep(0U);
+        }
+    }
+
+    finishThread();
+}
+
+class CircularBufferIntegrationTest : public ::testing::Test
+{
+    protected:
+        CircularBufferIntegrationTest()
+        {
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_init());
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sched_init());
+            stateCriticalSection = xme_hal_sync_createCriticalSection();
+            EXPECT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, stateCriticalSection);
+        }
+
+        virtual
+        ~CircularBufferIntegrationTest()
+        {
+            xme_hal_sync_destroyCriticalSection(stateCriticalSection);
+            stateCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+            xme_hal_sched_fini();
+            xme_hal_sync_fini();
+        }
+
+        uint16_t
+        getFinishedThreads(void)
+        {
+            uint16_t finished;
+
+            xme_hal_sync_enterCriticalSection(stateCriticalSection);
+            finished = finishedThreads;
+            xme_hal_sync_leaveCriticalSection(stateCriticalSection);
+
+            return finished;
+        }
+
+        void
+        runStressTest(xme_hal_circularBuffer_concurrency_t concurrency, uint32_t numOfProducers, uint32_t numOfConsumers)
+        {
+            xme_hal_time_timeHandle_t startTime;
+            uint32_t numOfThreads = numOfProducers + numOfConsumers;
+            uint32_t producer;
+            uint32_t i;
+
+            ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_initLockFree(&circularBuffer, BUFFERSIZE, sizeof(uint32_t), concurrency));
+
+            finishedThreads = 0U;
+            remainingItems = numOfProducers * ITEMSPERPRODUCER;
+            abortThreads = false;
+
+            for (i = 0U; i < numOfThreads; i++)
+            {
+                threads[i].id = (i < numOfProducers) ? i : i - numOfProducers;
+                threads[i].reorderings = 0U;
+                for (producer = 0U; producer < MAXPRODUCERS; producer++)
+                {
+                    threads[i].lastSequence[producer] = 0U;
+                    threads[i].received[producer] = 0U;
+                }
+            }
+
+            startTime = xme_hal_time_getCurrentTime();
+            for (i = 0U; i < numOfThreads; i++)
+            {
+                ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL,
+                    (i < numOfProducers) ? producerTask : consumerTask, &threads[i]));
+            }
+
+            while (getFinishedThreads() < numOfThreads)
+            {
+                if (xme_hal_time_getTimeInterval(&startTime, false) > xme_hal_time_timeIntervalFromSeconds(TIMEOUT_S))
+                {
+                    abortThreads = true;
+                }
+                xme_hal_sleep_sleep(((xme_hal_time_timeInterval_t)1000)*1000); // 1 ms
+            }
+
+            EXPECT_FALSE(abortThreads) << "Items have been lost, the consumers did not finish in time";
+
+            // Every item has been received exactly once and in order
+            for (producer = 0U; producer < numOfProducers; producer++)
+            {
+                uint32_t received = 0U;
+
+                for (i = numOfProducers; i < numOfThreads; i++)
+                {
+                    received += threads[i].received[producer];
+                }
+                EXPECT_EQ(ITEMSPERPRODUCER, received) << "producer " << producer;
+            }
+            for (i = numOfProducers; i < numOfThreads; i++)
+            {
+                EXPECT_EQ(0U, threads[i].reorderings) << "consumer " << threads[i].id;
+            }
+            EXPECT_EQ(0U, xme_hal_circularBuffer_getCount(&circularBuffer));
+
+            xme_hal_circularBuffer_fini(&circularBuffer);
+        }
+
+        stressTestThread_t threads[MAXPRODUCERS + MAXCONSUMERS];
+};
+
+/******************************************************************************/
+/***   Tests                                                                ***/
+/******************************************************************************/
+
+//----------------------------------------------------------------------------//
+//     CircularBufferIntegrationTest                                          //
+//----------------------------------------------------------------------------//
+
+TEST_F(CircularBufferIntegrationTest, singleProducerSingleConsumerWithoutLossOrReordering)
+{
+    runStressTest(XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC, 1U, 1U);
+}
+
+TEST_F(CircularBufferIntegrationTest, mpmcWithSingleProducerSingleConsumerWithoutLossOrReordering)
+{
+    runStressTest(XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC, 1U, 1U);
+}
+
+TEST_F(CircularBufferIntegrationTest, multipleProducersMultipleConsumersWithoutLossOrReordering)
+{
+    runStressTest(XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC, MAXPRODUCERS, MAXCONSUMERS);
+}
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
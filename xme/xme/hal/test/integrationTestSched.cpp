@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2011-2013, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Scheduler integration tests.
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "xme/hal/include/sched.h"
+#include "xme/hal/include/sleep.h"
+#include "xme/hal/include/time.h"
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define ROUNDS 200U ///< Number of times the scheduler is initialized and finalized.
+#define TASKS 4U ///< Number of one-shot tasks per round.
+#define TIMEOUT_S 10U ///< Time after which a round gives up waiting for the tasks.
+
+/******************************************************************************/
+/***   Variables                                                            ***/
+/******************************************************************************/
+static uint32_t executedTasks = 0U; ///< Incremented atomically by each task.
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+static void
+oneShotTask(void* userData)
+{
+    XME_UNUSED_PARAMETER(userData);
+
+    (void) __sync_add_and_fetch(&executedTasks, 1U);
+}
+
+/******************************************************************************/
+/***   Tests                                                                ***/
+/******************************************************************************/
+
+//----------------------------------------------------------------------------//
+//     SchedIntegrationTest                                                   //
+//----------------------------------------------------------------------------//
+
+TEST(SchedIntegrationTest, finiWhileOneShotTasksCleanUp)
+{
+    uint32_t round;
+    uint32_t i;
+
+    // xme_hal_sched_fini() is called right after the last callback, i.e.,
+    // while the one-shot tasks are removing themselves from the task table.
+    // This used to deadlock, because fini joined the threads while holding
+    // the task table mutex that the threads needed for their cleanup.
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        xme_hal_time_timeHandle_t startTime;
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_sched_init());
+
+        executedTasks = 0U;
+        for (i = 0U; i < TASKS; i++)
+        {
+            ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, oneShotTask, NULL));
+        }
+
+        startTime = xme_hal_time_getCurrentTime();
+        while (__sync_add_and_fetch(&executedTasks, 0U) < TASKS)
+        {
+            ASSERT_LT(xme_hal_time_getTimeInterval(&startTime, false), xme_hal_time_timeIntervalFromSeconds(TIMEOUT_S));
+            xme_hal_sleep_sleep(0U);
+        }
+
+        xme_hal_sched_fini();
+    }
+}
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -24,7 +24,141 @@
 
 #include "xme/core/testUtils.h"
 
+#include "xme/hal/include/sched.h"
+#include "xme/hal/include/sleep.h"
 #include "xme/hal/include/sync.h"
+#include "xme/hal/include/time.h"
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define ITERATIONS 100000U ///< Number of times each worker thread enters its critical section.
+#define CHURNSECTIONS 40U ///< Number of critical sections the churn thread creates at once.
+#define PUBLISHEDSECTIONS 200U ///< Number of critical sections the publisher thread creates one after another.
+#define RESOLVERS 3U ///< Number of threads entering the published critical sections.
+#define TIMEOUT_S 60U ///< Time after which the test gives up waiting for the threads.
+
+/******************************************************************************/
+/***   Variables                                                            ***/
+/******************************************************************************/
+static xme_hal_sync_criticalSectionHandle_t counterCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+static xme_hal_sync_criticalSectionHandle_t finishedCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+static uint32_t counter = 0U; ///< Incremented by the worker threads within counterCriticalSection.
+static uint16_t finishedThreads = 0U;
+static volatile bool stopChurn = false;
+static xme_hal_sync_criticalSectionHandle_t publishedSections[PUBLISHEDSECTIONS]; ///< Critical sections created by the publisher thread.
+static uint32_t publishedCounters[PUBLISHEDSECTIONS]; ///< Each counter is incremented within the respective published critical section.
+static uint32_t publishedCount = 0U; ///< Number of valid items in publishedSections. Written with release and read with acquire semantics.
+static uint32_t resolvedIncrements = 0U; ///< Total number of increments of publishedCounters, updated within counterCriticalSection.
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+static void
+finishThread(void)
+{
+    xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+    finishedThreads++;
+    xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+}
+
+static void
+workerTask(void* userData)
+{
+    uint32_t i;
+
+    XME_UNUSED_PARAMETER(userData);
+
+    for (i = 0U; i < ITERATIONS; i++)
+    {
+        xme_hal_sync_enterCriticalSection(counterCriticalSection);
+        counter++;
+        xme_hal_sync_leaveCriticalSection(counterCriticalSection);
+    }
+
+    finishThread();
+}
+
+static void
+churnTask(void* userData)
+{
+    xme_hal_sync_criticalSectionHandle_t handles[CHURNSECTIONS];
+    uint32_t i;
+
+    XME_UNUSED_PARAMETER(userData);
+
+    while (!stopChurn)
+    {
+        for (i = 0U; i < CHURNSECTIONS; i++)
+        {
+            handles[i] = xme_hal_sync_createCriticalSection();
+        }
+
+        for (i = 0U; i < CHURNSECTIONS; i++)
+        {
+            (void) xme_hal_sync_destroyCriticalSection(handles[i]);
+        }
+
+        xme_hal_sleep_sleep(0U);
+    }
+
+    finishThread();
+}
+
+static void
+publisherTask(void* userData)
+{
+    uint32_t i;
+
+    XME_UNUSED_PARAMETER(userData);
+
+    // Each new critical section is used by the resolver threads right away,
+    // while the churn thread keeps creating and destroying other ones, such
+    // that descriptors are resolved while new descriptor pages are added
+    for (i = 0U; i < PUBLISHEDSECTIONS; i++)
+    {
+        publishedSections[i] = xme_hal_sync_createCriticalSection();
+        publishedCounters[i] = 0U;
+        __atomic_store_n(&publishedCount, i + 1U, __ATOMIC_RELEASE);
+
+        xme_hal_sleep_sleep(0U);
+    }
+
+    finishThread();
+}
+
+static void
+resolverTask(void* userData)
+{
+    uint32_t increments = 0U;
+    uint32_t count;
+    uint32_t i;
+
+    XME_UNUSED_PARAMETER(userData);
+
+    do
+    {
+        count = __atomic_load_n(&publishedCount, __ATOMIC_ACQUIRE);
+
+        for (i = 0U; i < count; i++)
+        {
+            if (XME_STATUS_SUCCESS != xme_hal_sync_tryEnterCriticalSection(publishedSections[i]))
+            {
+                xme_hal_sync_enterCriticalSection(publishedSections[i]);
+            }
+            publishedCounters[i]++;
+            xme_hal_sync_leaveCriticalSection(publishedSections[i]);
+            increments++;
+        }
+    }
+    while (count < PUBLISHEDSECTIONS);
+
+    xme_hal_sync_enterCriticalSection(counterCriticalSection);
+    resolvedIncrements += increments;
+    xme_hal_sync_leaveCriticalSection(counterCriticalSection);
+
+    finishThread();
+}
 
 /******************************************************************************/
 /***   Classes                                                              ***/
@@ -45,6 +179,35 @@ protected:
         EXPECT_NO_XME_ASSERTION_FAILURES(xme_hal_sync_fini());
     }
 
+    uint16_t
+    getFinishedThreads(void)
+    {
+        uint16_t finished;
+
+        xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+        finished = finishedThreads;
+        xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+
+        return finished;
+    }
+
+    bool
+    waitForFinishedThreads(uint16_t numOfThreads)
+    {
+        xme_hal_time_timeHandle_t startTime = xme_hal_time_getCurrentTime();
+
+        while (getFinishedThreads() < numOfThreads)
+        {
+            if (xme_hal_time_getTimeInterval(&startTime, false) > xme_hal_time_timeIntervalFromSeconds(TIMEOUT_S))
+            {
+                return false;
+            }
+            xme_hal_sleep_sleep(((xme_hal_time_timeInterval_t)1000)*1000); // 1 ms
+        }
+
+        return true;
+    }
+
     xme_hal_sync_criticalSectionHandle_t h1;
     xme_hal_sync_criticalSectionHandle_t h2;
 };
@@ -165,6 +328,88 @@ TEST_F(SyncIntegrationTest, destroyWithoutLeaveInSameThread)
 #endif // #ifndef XME_HAL_SYNC_RECURSIVE_LOCKING
 }
 
+TEST_F(SyncIntegrationTest, handlesAreResolvedWhileOtherSectionsAreCreatedAndDestroyed)
+{
+    unsigned int assertionFailures = _xme_assert_assertionFailureCounter;
+    uint32_t total = 0U;
+    uint32_t i;
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_sched_init());
+    counterCriticalSection = xme_hal_sync_createCriticalSection();
+    ASSERT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, counterCriticalSection);
+    finishedCriticalSection = xme_hal_sync_createCriticalSection();
+    ASSERT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, finishedCriticalSection);
+    publishedCount = 0U;
+    resolvedIncrements = 0U;
+    finishedThreads = 0U;
+    stopChurn = false;
+
+    // Entering a critical section does not synchronize with the creation of
+    // other critical sections any more, so a handle must resolve correctly
+    // even while the descriptor it refers to is on a page that has just been
+    // added by another thread
+    ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, churnTask, NULL));
+    ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, publisherTask, NULL));
+    for (i = 0U; i < RESOLVERS; i++)
+    {
+        ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, resolverTask, NULL));
+    }
+
+    EXPECT_TRUE(waitForFinishedThreads(1U + RESOLVERS));
+    stopChurn = true;
+    EXPECT_TRUE(waitForFinishedThreads(2U + RESOLVERS));
+
+    xme_hal_sched_fini();
+
+    // Every handle resolved to an initialized descriptor
+    EXPECT_EQ(assertionFailures, _xme_assert_assertionFailureCounter);
+
+    // No increment has been lost, i.e., every handle resolved to its own mutex
+    for (i = 0U; i < PUBLISHEDSECTIONS; i++)
+    {
+        ASSERT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, publishedSections[i]);
+        total += publishedCounters[i];
+        EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_destroyCriticalSection(publishedSections[i]));
+    }
+    EXPECT_EQ(resolvedIncrements, total);
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_destroyCriticalSection(finishedCriticalSection));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_destroyCriticalSection(counterCriticalSection));
+}
+
+TEST_F(SyncIntegrationTest, mutualExclusionWhileOtherSectionsAreCreatedAndDestroyed)
+{
+    uint32_t i;
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_sched_init());
+    counterCriticalSection = xme_hal_sync_createCriticalSection();
+    ASSERT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, counterCriticalSection);
+    finishedCriticalSection = xme_hal_sync_createCriticalSection();
+    ASSERT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, finishedCriticalSection);
+    counter = 0U;
+    finishedThreads = 0U;
+    stopChurn = false;
+
+    // Two workers increment the counter while the churn thread keeps
+    // allocating descriptors, which must not disturb handle resolution.
+    ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, churnTask, NULL));
+    for (i = 0U; i < 2U; i++)
+    {
+        ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, workerTask, NULL));
+    }
+
+    EXPECT_TRUE(waitForFinishedThreads(2U));
+    stopChurn = true;
+    EXPECT_TRUE(waitForFinishedThreads(3U));
+
+    EXPECT_EQ(2U * ITERATIONS, counter);
+
+    xme_hal_sched_fini();
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_destroyCriticalSection(finishedCriticalSection));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_destroyCriticalSection(counterCriticalSection));
+}
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
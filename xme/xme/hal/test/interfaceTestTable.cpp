@@ -49,6 +49,22 @@ protected:
     const xme_hal_table_rowHandle_t maxTableHandle;
 };
 
+class SlabTableInterfaceTest: public ::testing::Test
+{
+protected:
+    SlabTableInterfaceTest()
+    {
+        XME_HAL_SLABTABLE_INIT(mySlabTable);
+    }
+
+    virtual ~SlabTableInterfaceTest()
+    {
+        XME_HAL_SLABTABLE_FINI(mySlabTable);
+    }
+
+    XME_HAL_SLABTABLE(double, mySlabTable, 3);
+};
+
 /******************************************************************************/
 /***   Tests                                                                ***/
 /******************************************************************************/
@@ -290,6 +306,129 @@ TEST_F(TableInterfaceTest, DISABLED_bubbleSort)
     EXPECT_EQ(d1, XME_HAL_TABLE_ITEM_FROM_HANDLE(myTable, (xme_hal_table_rowHandle_t)3));
 }
 
+//----------------------------------------------------------------------------//
+//     SlabTableInterfaceTest                                                 //
+//----------------------------------------------------------------------------//
+
+TEST_F(SlabTableInterfaceTest, countEmptyTable)
+{
+    EXPECT_EQ(0, XME_HAL_SLABTABLE_ITEM_COUNT(mySlabTable));
+}
+
+TEST_F(SlabTableInterfaceTest, removeFromEmptyTable)
+{
+    EXPECT_EQ(XME_STATUS_INVALID_HANDLE, XME_HAL_SLABTABLE_REMOVE_ITEM(mySlabTable, XME_HAL_TABLE_INVALID_SLAB_HANDLE));
+    EXPECT_EQ(XME_STATUS_INVALID_HANDLE, XME_HAL_SLABTABLE_REMOVE_ITEM(mySlabTable, (xme_hal_table_slabHandle_t)0x00010001));
+}
+
+TEST_F(SlabTableInterfaceTest, itemFromInvalidHandle)
+{
+    EXPECT_EQ(NULL, XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, XME_HAL_TABLE_INVALID_SLAB_HANDLE));
+    EXPECT_EQ(NULL, XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, (xme_hal_table_slabHandle_t)0x00010001));
+}
+
+TEST_F(SlabTableInterfaceTest, addAndRemoveItems)
+{
+    xme_hal_table_slabHandle_t handles[10];
+    uint16_t i;
+
+    for (i = 0U; i < 10U; i++)
+    {
+        double* d;
+
+        handles[i] = XME_HAL_SLABTABLE_ADD_ITEM(mySlabTable);
+        ASSERT_NE(XME_HAL_TABLE_INVALID_SLAB_HANDLE, handles[i]);
+        d = XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, handles[i]);
+        ASSERT_TRUE(NULL != d);
+        EXPECT_EQ(0.0, *d);
+        *d = i;
+    }
+    EXPECT_EQ(10, XME_HAL_SLABTABLE_ITEM_COUNT(mySlabTable));
+
+    // Removing items moves other items, but their handles stay valid
+    EXPECT_EQ(XME_STATUS_SUCCESS, XME_HAL_SLABTABLE_REMOVE_ITEM(mySlabTable, handles[0]));
+    EXPECT_EQ(XME_STATUS_SUCCESS, XME_HAL_SLABTABLE_REMOVE_ITEM(mySlabTable, handles[5]));
+    EXPECT_EQ(8, XME_HAL_SLABTABLE_ITEM_COUNT(mySlabTable));
+
+    for (i = 0U; i < 10U; i++)
+    {
+        double* d = XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, handles[i]);
+
+        if (0U == i || 5U == i)
+        {
+            EXPECT_EQ(NULL, d);
+        }
+        else
+        {
+            ASSERT_TRUE(NULL != d);
+            EXPECT_EQ((double) i, *d);
+        }
+    }
+
+    EXPECT_EQ(XME_STATUS_INVALID_HANDLE, XME_HAL_SLABTABLE_REMOVE_ITEM(mySlabTable, handles[5]));
+}
+
+TEST_F(SlabTableInterfaceTest, staleHandleOfReusedSlot)
+{
+    xme_hal_table_slabHandle_t h1;
+    xme_hal_table_slabHandle_t h2;
+
+    h1 = XME_HAL_SLABTABLE_ADD_ITEM(mySlabTable);
+    EXPECT_EQ(XME_STATUS_SUCCESS, XME_HAL_SLABTABLE_REMOVE_ITEM(mySlabTable, h1));
+
+    // The slot is reused with a new generation
+    h2 = XME_HAL_SLABTABLE_ADD_ITEM(mySlabTable);
+    EXPECT_NE(h1, h2);
+    EXPECT_EQ(NULL, XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, h1));
+    EXPECT_TRUE(NULL != XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, h2));
+    EXPECT_EQ(XME_STATUS_INVALID_HANDLE, XME_HAL_SLABTABLE_REMOVE_ITEM(mySlabTable, h1));
+
+    // Clearing invalidates all handles
+    XME_HAL_SLABTABLE_CLEAR(mySlabTable);
+    EXPECT_EQ(0, XME_HAL_SLABTABLE_ITEM_COUNT(mySlabTable));
+    EXPECT_EQ(NULL, XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, h2));
+    EXPECT_NE(h2, XME_HAL_SLABTABLE_ADD_ITEM(mySlabTable));
+}
+
+TEST_F(SlabTableInterfaceTest, iterateAndRemoveCurrent)
+{
+    double sum = 0.0;
+    uint16_t visited = 0U;
+    uint16_t i;
+
+    for (i = 1U; i <= 6U; i++)
+    {
+        xme_hal_table_slabHandle_t h = XME_HAL_SLABTABLE_ADD_ITEM(mySlabTable);
+        *XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, h) = i;
+    }
+
+    XME_HAL_SLABTABLE_ITERATE_BEGIN(mySlabTable, h, double, d);
+    {
+        EXPECT_EQ(d, XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(mySlabTable, h));
+        visited++;
+        sum += *d;
+
+        // Remove the even items while iterating
+        if (0 == ((int) *d) % 2)
+        {
+            EXPECT_EQ(XME_STATUS_SUCCESS, XME_HAL_SLABTABLE_REMOVE_ITEM(mySlabTable, h));
+        }
+    }
+    XME_HAL_SLABTABLE_ITERATE_END();
+
+    EXPECT_EQ(6U, visited);
+    EXPECT_EQ(21.0, sum);
+    EXPECT_EQ(3, XME_HAL_SLABTABLE_ITEM_COUNT(mySlabTable));
+
+    sum = 0.0;
+    XME_HAL_SLABTABLE_ITERATE_BEGIN(mySlabTable, h, double, d);
+    {
+        sum += *d;
+    }
+    XME_HAL_SLABTABLE_ITERATE_END();
+    EXPECT_EQ(9.0, sum);
+}
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2011-2014, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Circular Buffer measurement test, comparing the throughput of the
+ *         locked buffer and the lock-free variants between two threads.
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "xme/core/log.h"
+
+#include "xme/hal/include/circularBuffer.h"
+#include "xme/hal/include/sched.h"
+#include "xme/hal/include/sleep.h"
+#include "xme/hal/include/sync.h"
+#include "xme/hal/include/time.h"
+
+#include <stdint.h>
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define ITEMCOUNT 1000000U ///< Number of items passed from the producer to the consumer.
+#define BUFFERSIZE 256U ///< Size of the buffer.
+#define BATCHSIZE 32U ///< Number of items per batch operation.
+
+/******************************************************************************/
+/***   Type definitions                                                     ***/
+/******************************************************************************/
+/**
+ * \brief Circular buffer variant to measure.
+ */
+typedef struct
+{
+    const char* name; ///< Name of the variant for the report.
+    xme_hal_circularBuffer_concurrency_t concurrency; ///< Concurrency of the buffer.
+    bool locked; ///< Whether every access is protected by a critical section.
+    uint32_t batchSize; ///< Number of items per operation.
+}
+measurementVariant_t;
+
+/******************************************************************************/
+/***   Variables                                                            ***/
+/******************************************************************************/
+static xme_hal_circularBuffer_t circularBuffer;
+static const measurementVariant_t* variant = NULL;
+static xme_hal_sync_criticalSectionHandle_t bufferCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+static xme_hal_sync_criticalSectionHandle_t finishedCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+static uint16_t finishedThreads = 0U;
+static uint64_t checksum = 0U;
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+static void
+producerTask(void* userData)
+{
+    uint32_t batch[BATCHSIZE];
+    uint32_t sequence = 0U;
+    uint32_t batchSize;
+    uint32_t pushed;
+    uint32_t i;
+
+    XME_UNUSED_PARAMETER(userData);
+
+    while (sequence < ITEMCOUNT)
+    {
+        batchSize = (variant->batchSize < ITEMCOUNT - sequence) ? variant->batchSize : ITEMCOUNT - sequence;
+
+        for (i = 0U; i < batchSize; i++)
+        {
+            batch[i] = sequence + i;
+        }
+
+        if (variant->locked)
+        {
+            xme_hal_sync_enterCriticalSection(bufferCriticalSection);
+        }
+
+        if (1U == variant->batchSize)
+        {
+            pushed = (XME_STATUS_SUCCESS == xme_hal_circularBuffer_pushBack(&circularBuffer, batch)) ? 1U : 0U;
+        }
+        else
+        {
+            (void) xme_hal_circularBuffer_pushBackN(&circularBuffer, batch, batchSize, &pushed);
+        }
+
+        if (variant->locked)
+        {
+            xme_hal_sync_leaveCriticalSection(bufferCriticalSection);
+        }
+
+        sequence += pushed;
+
+        if (0U == pushed)
+        {
+            // Buffer is full, let the consumers run (on machines with few cores)
+            xme_hal_sleep_sleep(0U);
+        }
+    }
+
+    xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+    finishedThreads++;
+    xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+}
+
+static void
+consumerTask(void* userData)
+{
+    uint32_t batch[BATCHSIZE];
+    uint32_t received = 0U;
+    uint64_t sum = 0U;
+    uint32_t popped;
+    uint32_t i;
+
+    XME_UNUSED_PARAMETER(userData);
+
+    while (received < ITEMCOUNT)
+    {
+        if (variant->locked)
+        {
+            xme_hal_sync_enterCriticalSection(bufferCriticalSection);
+        }
+
+        if (1U == variant->batchSize)
+        {
+            popped = (XME_STATUS_SUCCESS == xme_hal_circularBuffer_popFront(&circularBuffer, batch)) ? 1U : 0U;
+        }
+        else
+        {
+            (void) xme_hal_circularBuffer_popFrontN(&circularBuffer, batch, variant->batchSize, &popped);
+        }
+
+        if (variant->locked)
+        {
+            xme_hal_sync_leaveCriticalSection(bufferCriticalSection);
+        }
+
+        for (i = 0U; i < popped; i++)
+        {
+            sum += batch[i];
+        }
+        received += popped;
+
+        if (0U == popped)
+        {
+            // Buffer is empty, let the producer run (on machines with few cores)
+            xme_hal_sleep_sleep(0U);
+        }
+    }
+
+    xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+    checksum = sum;
+    finishedThreads++;
+    xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+}
+
+class CircularBufferMeasurementTest : public ::testing::Test
+{
+    protected:
+        CircularBufferMeasurementTest()
+        {
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_init());
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sched_init());
+            bufferCriticalSection = xme_hal_sync_createCriticalSection();
+            EXPECT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, bufferCriticalSection);
+            finishedCriticalSection = xme_hal_sync_createCriticalSection();
+            EXPECT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, finishedCriticalSection);
+        }
+
+        virtual
+        ~CircularBufferMeasurementTest()
+        {
+            xme_hal_sync_destroyCriticalSection(finishedCriticalSection);
+            finishedCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+            xme_hal_sync_destroyCriticalSection(bufferCriticalSection);
+            bufferCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+            xme_hal_sched_fini();
+            xme_hal_sync_fini();
+        }
+
+        uint16_t
+        getFinishedThreads(void)
+        {
+            uint16_t finished;
+
+            xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+            finished = finishedThreads;
+            xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+
+            return finished;
+        }
+};
+
+/******************************************************************************/
+/***   Tests                                                                ***/
+/******************************************************************************/
+
+//----------------------------------------------------------------------------//
+//     CircularBufferMeasurementTest                                          //
+//----------------------------------------------------------------------------//
+
+TEST_F(CircularBufferMeasurementTest, throughputBetweenTwoThreads)
+{
+    static const measurementVariant_t variants[] =
+    {
+        { "locked", XME_HAL_CIRCULARBUFFER_CONCURRENCY_EXTERNAL_LOCKING, true, 1U },
+        { "locked batch", XME_HAL_CIRCULARBUFFER_CONCURRENCY_EXTERNAL_LOCKING, true, BATCHSIZE },
+        { "SPSC", XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC, false, 1U },
+        { "SPSC batch", XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC, false, BATCHSIZE },
+        { "MPMC", XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC, false, 1U },
+        { "MPMC batch", XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC, false, BATCHSIZE }
+    };
+    const uint64_t expectedChecksum = ((uint64_t) ITEMCOUNT) * (ITEMCOUNT - 1U) / 2U;
+    uint32_t v;
+
+    for (v = 0U; v < sizeof(variants) / sizeof(variants[0]); v++)
+    {
+        xme_hal_time_timeHandle_t startTime;
+        uint64_t microSeconds;
+
+        variant = &variants[v];
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_initLockFree(&circularBuffer, BUFFERSIZE, sizeof(uint32_t), variant->concurrency));
+        finishedThreads = 0U;
+        checksum = 0U;
+
+        startTime = xme_hal_time_getCurrentTime();
+        ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, consumerTask, NULL));
+        ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, producerTask, NULL));
+
+        while (getFinishedThreads() < 2U)
+        {
+            xme_hal_sleep_sleep(((xme_hal_time_timeInterval_t)1000)*100); // 0.1 ms
+        }
+
+        microSeconds = xme_hal_time_timeIntervalInMicroseconds(xme_hal_time_getTimeInterval(&startTime, false));
+
+        EXPECT_EQ(expectedChecksum, checksum) << variant->name;
+
+        XME_LOG
+        (
+            XME_LOG_NOTE,
+            "[CircularBufferMeasurementTest] %-12s %8d us for %d items (%d items/s).\n",
+            variant->name,
+            (int) microSeconds,
+            ITEMCOUNT,
+            (int) ((0U == microSeconds) ? 0U : (((uint64_t) ITEMCOUNT) * 1000000U / microSeconds))
+        );
+
+        xme_hal_circularBuffer_fini(&circularBuffer);
+    }
+}
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
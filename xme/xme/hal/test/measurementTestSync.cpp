@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2011-2014, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Synchronization measurement test, comparing threads that enter one
+ *         shared critical section with threads that enter independent ones.
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "xme/core/log.h"
+
+#include "xme/hal/include/sched.h"
+#include "xme/hal/include/sleep.h"
+#include "xme/hal/include/sync.h"
+#include "xme/hal/include/time.h"
+
+#include <stdint.h>
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define MAXTHREADS 4U ///< Number of threads entering critical sections.
+#define ITERATIONS 1000000U ///< Number of times each thread enters a critical section.
+
+/******************************************************************************/
+/***   Type definitions                                                     ***/
+/******************************************************************************/
+/**
+ * \brief Data of a measurement thread.
+ */
+typedef struct
+{
+    xme_hal_sync_criticalSectionHandle_t criticalSection; ///< Critical section entered by the thread.
+    uint32_t* counter; ///< Counter incremented within the critical section.
+}
+measurementThread_t;
+
+/******************************************************************************/
+/***   Variables                                                            ***/
+/******************************************************************************/
+static xme_hal_sync_criticalSectionHandle_t finishedCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+static uint16_t finishedThreads = 0U;
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+static void
+measurementTask(void* userData)
+{
+    measurementThread_t* thread = (measurementThread_t*) userData;
+    uint32_t i;
+
+    for (i = 0U; i < ITERATIONS; i++)
+    {
+        xme_hal_sync_enterCriticalSection(thread->criticalSection);
+        (*thread->counter)++;
+        xme_hal_sync_leaveCriticalSection(thread->criticalSection);
+    }
+
+    xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+    finishedThreads++;
+    xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+}
+
+class SyncMeasurementTest : public ::testing::Test
+{
+    protected:
+        SyncMeasurementTest()
+        {
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_init());
+            EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sched_init());
+            finishedCriticalSection = xme_hal_sync_createCriticalSection();
+            EXPECT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, finishedCriticalSection);
+        }
+
+        virtual
+        ~SyncMeasurementTest()
+        {
+            xme_hal_sync_destroyCriticalSection(finishedCriticalSection);
+            finishedCriticalSection = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+            xme_hal_sched_fini();
+            xme_hal_sync_fini();
+        }
+
+        uint16_t
+        getFinishedThreads(void)
+        {
+            uint16_t finished;
+
+            xme_hal_sync_enterCriticalSection(finishedCriticalSection);
+            finished = finishedThreads;
+            xme_hal_sync_leaveCriticalSection(finishedCriticalSection);
+
+            return finished;
+        }
+
+        void
+        measure(const char* name, bool shared)
+        {
+            xme_hal_sync_criticalSectionHandle_t criticalSections[MAXTHREADS];
+            measurementThread_t threads[MAXTHREADS];
+            uint32_t counters[MAXTHREADS];
+            xme_hal_time_timeHandle_t startTime;
+            xme_hal_time_timeInterval_t wallTime;
+            uint32_t total = 0U;
+            uint32_t i;
+
+            for (i = 0U; i < MAXTHREADS; i++)
+            {
+                criticalSections[i] = xme_hal_sync_createCriticalSection();
+                ASSERT_NE(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE, criticalSections[i]);
+                counters[i] = 0U;
+
+                // With a shared critical section, all threads increment the same counter
+                threads[i].criticalSection = shared ? criticalSections[0] : criticalSections[i];
+                threads[i].counter = shared ? &counters[0] : &counters[i];
+            }
+            finishedThreads = 0U;
+
+            startTime = xme_hal_time_getCurrentTime();
+            for (i = 0U; i < MAXTHREADS; i++)
+            {
+                ASSERT_NE(XME_HAL_SCHED_INVALID_TASK_HANDLE, xme_hal_sched_addTask(0, 0, XME_HAL_SCHED_PRIORITY_NORMAL, measurementTask, &threads[i]));
+            }
+
+            while (getFinishedThreads() < MAXTHREADS)
+            {
+                xme_hal_sleep_sleep(((xme_hal_time_timeInterval_t)1000)*100); // 0.1 ms
+            }
+
+            wallTime = xme_hal_time_getTimeInterval(&startTime, false);
+
+            for (i = 0U; i < MAXTHREADS; i++)
+            {
+                EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_sync_destroyCriticalSection(criticalSections[i]));
+                total += counters[i];
+            }
+
+            // No increment has been lost
+            EXPECT_EQ(MAXTHREADS * ITERATIONS, total) << name;
+
+            XME_LOG
+            (
+                XME_LOG_NOTE,
+                "[SyncMeasurementTest] %-11s %8.2f ns per enter and leave (%d threads).\n",
+                name,
+                (double) wallTime / ((double) MAXTHREADS * ITERATIONS),
+                MAXTHREADS
+            );
+        }
+};
+
+/******************************************************************************/
+/***   Tests                                                                ***/
+/******************************************************************************/
+
+//----------------------------------------------------------------------------//
+//     SyncMeasurementTest                                                    //
+//----------------------------------------------------------------------------//
+
+TEST_F(SyncMeasurementTest, sharedAndIndependentCriticalSections)
+{
+    // Independent critical sections should scale with the number of cores,
+    // as entering them does not take any lock shared between the threads
+    measure("shared", true);
+    measure("independent", false);
+}
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
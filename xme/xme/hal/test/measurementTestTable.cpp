@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2011-2014, fortiss GmbH.
+ * Licensed under the Apache License, Version 2.0.
+ *
+ * Use, modification and distribution are subject to the terms specified
+ * in the accompanying license file LICENSE.txt located at the root directory
+ * of this software distribution. A copy is available at
+ * http://chromosome.fortiss.org/.
+ *
+ * This file is part of CHROMOSOME.
+ *
+ * $Id$
+ */
+
+/**
+ * \file
+ *         Table measurement tests, comparing the table variants.
+ */
+
+/******************************************************************************/
+/***   Includes                                                             ***/
+/******************************************************************************/
+#include <gtest/gtest.h>
+
+#include "xme/core/log.h"
+
+#include "xme/hal/include/mem.h"
+#include "xme/hal/include/table.h"
+#include "xme/hal/include/time.h"
+
+#include <inttypes.h>
+
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+#define ITEM_COUNT 2000U ///< Number of items in each table.
+#define ROUNDS 200U ///< How often all items are looked up and iterated over.
+
+/******************************************************************************/
+/***   Type definitions                                                     ***/
+/******************************************************************************/
+/**
+ * \brief Table item, about the size of the configuration items of the waypoints.
+ */
+typedef struct
+{
+    uint32_t key; ///< Value summed up by the measurements.
+    uint8_t payload[60]; ///< Further members of the item.
+}
+tableItem_t;
+
+/**
+ * \brief Table with the memory layout of the staticMemory table port (bitmap
+ *        of occupied rows followed by all rows), which cannot be built
+ *        together with the dynamicMemory port.
+ */
+typedef struct
+{
+    uint16_t maxHandle; ///< Highest occupied row.
+    uint8_t bitmap[ITEM_COUNT * 2U]; ///< Occupied rows.
+    tableItem_t array[ITEM_COUNT * 2U]; ///< Rows.
+}
+staticLayoutTable_t;
+
+/******************************************************************************/
+/***   Classes                                                              ***/
+/******************************************************************************/
+
+class TableMeasurementTest: public ::testing::Test
+{
+protected:
+    TableMeasurementTest()
+    {
+        uint16_t i;
+
+        XME_HAL_TABLE_INIT(dynamicTable);
+        XME_HAL_SLABTABLE_INIT(slabTable);
+        staticTable = (staticLayoutTable_t*) xme_hal_mem_alloc(sizeof(staticLayoutTable_t));
+
+        // Fill twice the number of items and remove every other one, so that
+        // the tables contain holes like tables of long running applications.
+        // Other allocations in between scatter the items of the dynamic table.
+        for (i = 0U; i < 2U * ITEM_COUNT; i++)
+        {
+            dynamicHandles[i] = XME_HAL_TABLE_ADD_ITEM(dynamicTable);
+            slabHandles[i] = XME_HAL_SLABTABLE_ADD_ITEM(slabTable);
+            staticTable->bitmap[i] = 1U;
+            staticTable->maxHandle = (uint16_t)(i + 1U);
+            fragments[i] = xme_hal_mem_alloc(48U);
+
+            XME_HAL_TABLE_ITEM_FROM_HANDLE(dynamicTable, dynamicHandles[i])->key = i;
+            XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(slabTable, slabHandles[i])->key = i;
+            staticTable->array[i].key = i;
+        }
+
+        for (i = 0U; i < 2U * ITEM_COUNT; i += 2U)
+        {
+            EXPECT_EQ(XME_STATUS_SUCCESS, XME_HAL_TABLE_REMOVE_ITEM(dynamicTable, dynamicHandles[i]));
+            EXPECT_EQ(XME_STATUS_SUCCESS, XME_HAL_SLABTABLE_REMOVE_ITEM(slabTable, slabHandles[i]));
+            staticTable->bitmap[i] = 0U;
+        }
+    }
+
+    virtual ~TableMeasurementTest()
+    {
+        uint16_t i;
+
+        for (i = 0U; i < 2U * ITEM_COUNT; i++)
+        {
+            xme_hal_mem_free(fragments[i]);
+        }
+
+        xme_hal_mem_free(staticTable);
+        XME_HAL_SLABTABLE_FINI(slabTable);
+        XME_HAL_TABLE_FINI(dynamicTable);
+    }
+
+    static void
+    report(const char* variant, const char* operation, xme_hal_time_timeInterval_t wallTime, uint64_t sum, uint64_t expectedSum)
+    {
+        XME_LOG
+        (
+            XME_LOG_NOTE,
+            "%-8s %-9s %8.2f ns per item\n",
+            variant, operation,
+            (double) wallTime / ((double) ROUNDS * ITEM_COUNT)
+        );
+
+        EXPECT_EQ(expectedSum, sum) << variant << " " << operation;
+    }
+
+    XME_HAL_TABLE(tableItem_t, dynamicTable, ITEM_COUNT);
+    XME_HAL_SLABTABLE(tableItem_t, slabTable, ITEM_COUNT);
+    staticLayoutTable_t* staticTable;
+
+    xme_hal_table_rowHandle_t dynamicHandles[ITEM_COUNT * 2U];
+    xme_hal_table_slabHandle_t slabHandles[ITEM_COUNT * 2U];
+    void* fragments[ITEM_COUNT * 2U];
+};
+
+/******************************************************************************/
+/***   Tests                                                                ***/
+/******************************************************************************/
+
+//----------------------------------------------------------------------------//
+//     TableMeasurementTest                                                   //
+//----------------------------------------------------------------------------//
+
+TEST_F(TableMeasurementTest, lookupAndIterate)
+{
+    xme_hal_time_timeHandle_t startTimeHandle;
+    uint64_t expectedSum = 0U;
+    uint64_t sum;
+    uint32_t round;
+    uint16_t i;
+
+    // The remaining items have the odd keys
+    for (i = 1U; i < 2U * ITEM_COUNT; i += 2U)
+    {
+        expectedSum += i;
+    }
+    expectedSum *= ROUNDS;
+
+    // Lookup by handle
+    sum = 0U;
+    startTimeHandle = xme_hal_time_getCurrentTime();
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        for (i = 1U; i < 2U * ITEM_COUNT; i += 2U)
+        {
+            sum += XME_HAL_TABLE_ITEM_FROM_HANDLE(dynamicTable, dynamicHandles[i])->key;
+        }
+    }
+    report("dynamic", "lookup", xme_hal_time_getTimeInterval(&startTimeHandle, false), sum, expectedSum);
+
+    sum = 0U;
+    startTimeHandle = xme_hal_time_getCurrentTime();
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        for (i = 1U; i < 2U * ITEM_COUNT; i += 2U)
+        {
+            sum += XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(slabTable, slabHandles[i])->key;
+        }
+    }
+    report("slab", "lookup", xme_hal_time_getTimeInterval(&startTimeHandle, false), sum, expectedSum);
+
+    sum = 0U;
+    startTimeHandle = xme_hal_time_getCurrentTime();
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        for (i = 1U; i < 2U * ITEM_COUNT; i += 2U)
+        {
+            sum += (0U != staticTable->bitmap[i]) ? staticTable->array[i].key : 0U;
+        }
+    }
+    report("static", "lookup", xme_hal_time_getTimeInterval(&startTimeHandle, false), sum, expectedSum);
+
+    // Iteration over all items
+    sum = 0U;
+    startTimeHandle = xme_hal_time_getCurrentTime();
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        XME_HAL_TABLE_ITERATE_BEGIN(dynamicTable, xme_hal_table_rowHandle_t, handle, tableItem_t, item);
+        {
+            sum += item->key;
+        }
+        XME_HAL_TABLE_ITERATE_END();
+    }
+    report("dynamic", "iterate", xme_hal_time_getTimeInterval(&startTimeHandle, false), sum, expectedSum);
+
+    sum = 0U;
+    startTimeHandle = xme_hal_time_getCurrentTime();
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        XME_HAL_SLABTABLE_ITERATE_BEGIN(slabTable, handle, tableItem_t, item);
+        {
+            sum += item->key;
+        }
+        XME_HAL_SLABTABLE_ITERATE_END();
+    }
+    report("slab", "iterate", xme_hal_time_getTimeInterval(&startTimeHandle, false), sum, expectedSum);
+
+    sum = 0U;
+    startTimeHandle = xme_hal_time_getCurrentTime();
+    for (round = 0U; round < ROUNDS; round++)
+    {
+        for (i = 0U; i < staticTable->maxHandle; i++)
+        {
+            if (0U != staticTable->bitmap[i])
+            {
+                sum += staticTable->array[i].key;
+            }
+        }
+    }
+    report("static", "iterate", xme_hal_time_getTimeInterval(&startTimeHandle, false), sum, expectedSum);
+}
+
+/******************************************************************************/
+/***   Implementation                                                       ***/
+/******************************************************************************/
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
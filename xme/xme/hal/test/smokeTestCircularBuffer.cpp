@@ -211,6 +211,112 @@ TEST_F(CircularBufferSmokeTest, getRelativeTailAndHeadPositions)
     xme_hal_circularBuffer_fini(&circularBuffer);
 }
 
+TEST_F(CircularBufferSmokeTest, pushAndPopBatches)
+{
+    xme_hal_circularBuffer_t circularBuffer;
+    uint8_t poppedItems[5];
+    uint32_t count;
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_init(&circularBuffer, cbMaxSize, sizeof(uint8_t), false));
+    ASSERT_EQ(XME_STATUS_PERMISSION_DENIED, xme_hal_circularBuffer_popFrontN(&circularBuffer, poppedItems, 5U, &count));
+    EXPECT_EQ(0U, count);
+
+    ASSERT_EQ(XME_STATUS_PERMISSION_DENIED, xme_hal_circularBuffer_pushBackN(&circularBuffer, items, 5U, &count));
+    EXPECT_EQ(4U, count);
+    EXPECT_EQ(4U, xme_hal_circularBuffer_getCount(&circularBuffer));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_popFrontN(&circularBuffer, poppedItems, 3U, &count));
+    ASSERT_EQ(3U, count);
+    EXPECT_EQ(items[0], poppedItems[0]);
+    EXPECT_EQ(items[2], poppedItems[2]);
+
+    // Wraps around the end of the buffer
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_pushBackN(&circularBuffer, &items[4], 1U, NULL));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_popFrontN(&circularBuffer, poppedItems, 5U, &count));
+    ASSERT_EQ(2U, count);
+    EXPECT_EQ(items[3], poppedItems[0]);
+    EXPECT_EQ(items[4], poppedItems[1]);
+    xme_hal_circularBuffer_fini(&circularBuffer);
+}
+
+TEST_F(CircularBufferSmokeTest, invalidLockFreeInit)
+{
+    xme_hal_circularBuffer_t circularBuffer;
+    ASSERT_EQ(XME_STATUS_INVALID_PARAMETER, xme_hal_circularBuffer_initLockFree(&circularBuffer, 0U, sizeof(uint8_t), XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC));
+    ASSERT_EQ(XME_STATUS_INVALID_PARAMETER, xme_hal_circularBuffer_initLockFree(&circularBuffer, cbMaxSize, 0U, XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC));
+    ASSERT_EQ(XME_STATUS_INVALID_PARAMETER, xme_hal_circularBuffer_initLockFree(&circularBuffer, cbMaxSize, sizeof(uint8_t), (xme_hal_circularBuffer_concurrency_t) 42));
+}
+
+TEST_F(CircularBufferSmokeTest, lockFreePushAllItemsAndPopThemInOrder)
+{
+    const xme_hal_circularBuffer_concurrency_t variants[] = { XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC, XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC };
+    uint32_t round;
+    uint32_t v;
+    uint8_t i;
+
+    for (v = 0U; v < sizeof(variants) / sizeof(variants[0]); v++)
+    {
+        xme_hal_circularBuffer_t circularBuffer;
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_initLockFree(&circularBuffer, cbMaxSize, sizeof(uint8_t), variants[v]));
+        ASSERT_EQ(XME_STATUS_PERMISSION_DENIED, xme_hal_circularBuffer_popFront(&circularBuffer, &item));
+
+        // Several rounds, such that the positions wrap around
+        for (round = 0U; round < 3U; round++)
+        {
+            for (i = 0U; i < cbMaxSize; i++)
+            {
+                ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_pushBack(&circularBuffer, &items[i])) << "variant " << v;
+            }
+            ASSERT_EQ(XME_STATUS_PERMISSION_DENIED, xme_hal_circularBuffer_pushBack(&circularBuffer, &items[4])) << "variant " << v;
+            EXPECT_EQ(cbMaxSize, xme_hal_circularBuffer_getCount(&circularBuffer));
+
+            for (i = 0U; i < cbMaxSize; i++)
+            {
+                ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_popFront(&circularBuffer, &item));
+                EXPECT_EQ(items[i], item) << "variant " << v;
+            }
+            ASSERT_EQ(XME_STATUS_PERMISSION_DENIED, xme_hal_circularBuffer_popFront(&circularBuffer, &item));
+            EXPECT_EQ(0U, xme_hal_circularBuffer_getCount(&circularBuffer));
+        }
+        xme_hal_circularBuffer_fini(&circularBuffer);
+    }
+}
+
+TEST_F(CircularBufferSmokeTest, lockFreePushAndPopBatches)
+{
+    const xme_hal_circularBuffer_concurrency_t variants[] = { XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC, XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC };
+    uint8_t poppedItems[5];
+    uint32_t count;
+    uint32_t v;
+
+    for (v = 0U; v < sizeof(variants) / sizeof(variants[0]); v++)
+    {
+        xme_hal_circularBuffer_t circularBuffer;
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_initLockFree(&circularBuffer, cbMaxSize, sizeof(uint8_t), variants[v]));
+
+        ASSERT_EQ(XME_STATUS_PERMISSION_DENIED, xme_hal_circularBuffer_pushBackN(&circularBuffer, items, 5U, &count));
+        EXPECT_EQ(4U, count) << "variant " << v;
+
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_popFrontN(&circularBuffer, poppedItems, 3U, &count));
+        ASSERT_EQ(3U, count);
+        EXPECT_EQ(items[0], poppedItems[0]);
+        EXPECT_EQ(items[2], poppedItems[2]);
+
+        // Wraps around the end of the buffer
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_pushBackN(&circularBuffer, &items[2], 3U, &count));
+        EXPECT_EQ(3U, count);
+        ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_circularBuffer_popFrontN(&circularBuffer, poppedItems, 5U, &count));
+        ASSERT_EQ(4U, count) << "variant " << v;
+        EXPECT_EQ(items[3], poppedItems[0]);
+        EXPECT_EQ(items[2], poppedItems[1]);
+        EXPECT_EQ(items[3], poppedItems[2]);
+        EXPECT_EQ(items[4], poppedItems[3]);
+        ASSERT_EQ(XME_STATUS_PERMISSION_DENIED, xme_hal_circularBuffer_popFrontN(&circularBuffer, poppedItems, 5U, &count));
+        EXPECT_EQ(0U, count);
+        xme_hal_circularBuffer_fini(&circularBuffer);
+    }
+}
+
 int
 main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
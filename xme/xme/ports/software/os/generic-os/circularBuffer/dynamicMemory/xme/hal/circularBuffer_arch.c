@@ -34,6 +34,68 @@
 
 #include <inttypes.h>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//******************************************************************************//
+//***   Defines                                                              ***//
+//******************************************************************************//
+
+/**
+ * \def CACHE_LINE_SIZE
+ * \brief Assumed size of a cache line, the positions of producers and
+ *        consumers of the lock-free variants are kept that far apart.
+ */
+#define CACHE_LINE_SIZE 64U
+
+#if defined(_MSC_VER)
+// Volatile accesses have acquire and release semantics with the Microsoft compiler
+#define ATOMIC_LOAD_ACQUIRE(ptr) (*(ptr))
+#define ATOMIC_LOAD_RELAXED(ptr) (*(ptr))
+#define ATOMIC_STORE_RELEASE(ptr, value) (*(ptr) = (value))
+#define ATOMIC_COMPARE_EXCHANGE(ptr, expected, desired) \
+    ((long) (expected) == _InterlockedCompareExchange((volatile long*) (ptr), (long) (desired), (long) (expected)))
+#else // #if defined(_MSC_VER)
+#define ATOMIC_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define ATOMIC_LOAD_RELAXED(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define ATOMIC_STORE_RELEASE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define ATOMIC_COMPARE_EXCHANGE(ptr, expected, desired) \
+    __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#endif // #if defined(_MSC_VER)
+
+//******************************************************************************//
+//***   Type definitions                                                     ***//
+//******************************************************************************//
+
+/**
+ * \struct lockFreeState_t
+ * \brief Positions of the lock-free variants of the circular buffer.
+ *
+ * \details SPSC buffers use one slot more than items fit into the buffer,
+ *          head and tail are slot indices and the buffer is empty when they
+ *          are equal. Only the producer writes head and only the consumer
+ *          writes tail.
+ *
+ *          MPMC buffers use a power of two slots. Head and tail count all
+ *          items ever pushed and popped (modulo 2^32) and each slot has a
+ *          sequence number that tells whether it is free for the push with
+ *          the same position (sequence == position) or filled for the pop
+ *          with the same position (sequence == position + 1). Producers and
+ *          consumers reserve positions by a compare-and-swap on head and
+ *          tail respectively.
+ */
+typedef struct
+{
+    volatile uint32_t head; ///< Next position to push to.
+    uint8_t headPadding[CACHE_LINE_SIZE - sizeof(uint32_t)]; ///< Keeps producers and consumers on separate cache lines.
+    volatile uint32_t tail; ///< Next position to pop from.
+    uint8_t tailPadding[CACHE_LINE_SIZE - sizeof(uint32_t)]; ///< Keeps producers and consumers on separate cache lines.
+    uint32_t slotCount; ///< Number of slots in the buffer.
+    volatile uint32_t* sequences; ///< Sequence numbers of the slots, MPMC only.
+}
+lockFreeState_t;
+
 //******************************************************************************//
 //***   Protoypes                                                            ***//
 //******************************************************************************//
@@ -51,6 +113,98 @@ advanceReadTailPosition
     xme_hal_circularBuffer_t* circularBuffer
 );
 
+/**
+ * \brief Copies items into consecutive slots starting at the given slot index,
+ *        wrapping around at the end of the buffer.
+ *
+ * \param[in] circularBuffer The circular buffer.
+ * \param[in] slot Index of the first slot to write.
+ * \param[in] slotCount Number of slots in the buffer.
+ * \param[in] items The items to write.
+ * \param[in] itemCount Number of items to write.
+ */
+static void
+copyToSlots
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    uint32_t slot,
+    uint32_t slotCount,
+    const void* items,
+    uint32_t itemCount
+);
+
+/**
+ * \brief Copies items from consecutive slots starting at the given slot
+ *        index, wrapping around at the end of the buffer.
+ *
+ * \param[in] circularBuffer The circular buffer.
+ * \param[in] slot Index of the first slot to read.
+ * \param[in] slotCount Number of slots in the buffer.
+ * \param[out] items Where to store the items.
+ * \param[in] itemCount Number of items to read.
+ */
+static void
+copyFromSlots
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    uint32_t slot,
+    uint32_t slotCount,
+    void* items,
+    uint32_t itemCount
+);
+
+/**
+ * \brief Pushes up to itemCount items to a lock-free SPSC buffer.
+ *
+ * \return Number of items that have been pushed.
+ */
+static uint32_t
+pushBackSPSC
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    const void* items,
+    uint32_t itemCount
+);
+
+/**
+ * \brief Pops up to maxItemCount items from a lock-free SPSC buffer.
+ *
+ * \return Number of items that have been popped.
+ */
+static uint32_t
+popFrontSPSC
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    void* items,
+    uint32_t maxItemCount
+);
+
+/**
+ * \brief Pushes up to itemCount items to a lock-free MPMC buffer.
+ *
+ * \return Number of items that have been pushed.
+ */
+static uint32_t
+pushBackMPMC
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    const void* items,
+    uint32_t itemCount
+);
+
+/**
+ * \brief Pops up to maxItemCount items from a lock-free MPMC buffer.
+ *
+ * \return Number of items that have been popped.
+ */
+static uint32_t
+popFrontMPMC
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    void* items,
+    uint32_t maxItemCount
+);
+
 //******************************************************************************//
 //***   Implementation                                                       ***//
 //******************************************************************************//
@@ -124,6 +278,9 @@ xme_hal_circularBuffer_init
     // Set the overwrite policy. 
     circularBuffer->overwrite = overwrite;
 
+    circularBuffer->concurrency = XME_HAL_CIRCULARBUFFER_CONCURRENCY_EXTERNAL_LOCKING;
+    circularBuffer->lockFreeState = NULL;
+
     return XME_STATUS_SUCCESS;
 }
 
@@ -133,6 +290,15 @@ xme_hal_circularBuffer_fini
     xme_hal_circularBuffer_t* circularBuffer
 )
 {
+    lockFreeState_t* state = (lockFreeState_t*) circularBuffer->lockFreeState;
+
+    if (NULL != state)
+    {
+        xme_hal_mem_free((void*) state->sequences);
+        xme_hal_mem_free(state);
+        circularBuffer->lockFreeState = NULL;
+    }
+
     xme_hal_mem_free(circularBuffer->circularBufferStart);
     // clear out other fields too, just to be safe
 }
@@ -146,6 +312,11 @@ xme_hal_circularBuffer_pushBack
 {
     XME_ASSERT(NULL != circularBuffer);
 
+    if (XME_HAL_CIRCULARBUFFER_CONCURRENCY_EXTERNAL_LOCKING != circularBuffer->concurrency)
+    {
+        return xme_hal_circularBuffer_pushBackN(circularBuffer, item, 1U, NULL);
+    }
+
     // If the circular buffer write position (head) is going to overwrite the
     // the read position (tail)
     if(circularBuffer->count == circularBuffer->sizeOfCircularBuffer)
@@ -203,6 +374,13 @@ xme_hal_circularBuffer_popFront
 {
     XME_ASSERT(NULL != circularBuffer);
 
+    if (XME_HAL_CIRCULARBUFFER_CONCURRENCY_EXTERNAL_LOCKING != circularBuffer->concurrency)
+    {
+        uint32_t poppedCount;
+
+        return xme_hal_circularBuffer_popFrontN(circularBuffer, item, 1U, &poppedCount);
+    }
+
     // If there are no more elements to read, return error status. 
     if(circularBuffer->count == 0)
     {
@@ -232,6 +410,14 @@ xme_hal_circularBuffer_getTailPosition
 
     XME_ASSERT(NULL != circularBuffer);
 
+    if (NULL != circularBuffer->lockFreeState)
+    {
+        lockFreeState_t* state = (lockFreeState_t*) circularBuffer->lockFreeState;
+
+        *position = ATOMIC_LOAD_ACQUIRE(&state->tail) % state->slotCount;
+        return XME_STATUS_SUCCESS;
+    }
+
     tailRelativeOffset = (uintptr_t) circularBuffer->readTail - (uintptr_t) circularBuffer->circularBufferStart;
 
     *position = (uint32_t) (((uint32_t) tailRelativeOffset) / circularBuffer->itemSizeInBytes);
@@ -250,6 +436,14 @@ xme_hal_circularBuffer_getHeadPosition
 
     XME_ASSERT(NULL != circularBuffer);
 
+    if (NULL != circularBuffer->lockFreeState)
+    {
+        lockFreeState_t* state = (lockFreeState_t*) circularBuffer->lockFreeState;
+
+        *position = ATOMIC_LOAD_ACQUIRE(&state->head) % state->slotCount;
+        return XME_STATUS_SUCCESS;
+    }
+
     headRelativeOffset = (uintptr_t) circularBuffer->writeHead - (uintptr_t) circularBuffer->circularBufferStart;
 
     *position = (uint32_t) (((uint32_t) headRelativeOffset) / circularBuffer->itemSizeInBytes);
@@ -257,6 +451,404 @@ xme_hal_circularBuffer_getHeadPosition
     return XME_STATUS_SUCCESS;
 }
 
+xme_status_t
+xme_hal_circularBuffer_initLockFree
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    uint32_t maximumSize,
+    size_t itemSizeInBytes,
+    xme_hal_circularBuffer_concurrency_t concurrency
+)
+{
+    lockFreeState_t* state;
+    uint32_t slotCount;
+    uint32_t i;
+
+    XME_CHECK(maximumSize > 0, XME_STATUS_INVALID_PARAMETER);
+    XME_CHECK(itemSizeInBytes > 0, XME_STATUS_INVALID_PARAMETER);
+
+    if (XME_HAL_CIRCULARBUFFER_CONCURRENCY_EXTERNAL_LOCKING == concurrency)
+    {
+        return xme_hal_circularBuffer_init(circularBuffer, maximumSize, itemSizeInBytes, false);
+    }
+
+    if (XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC == concurrency)
+    {
+        // One slot always stays free to tell a full buffer from an empty one
+        slotCount = maximumSize + 1U;
+    }
+    else
+    {
+        XME_CHECK(XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC == concurrency, XME_STATUS_INVALID_PARAMETER);
+        XME_CHECK(maximumSize <= 0x80000000U, XME_STATUS_INVALID_PARAMETER);
+
+        // Positions wrap at 2^32, so the slot index of a position only stays
+        // consistent for a power of two slots
+        slotCount = 2U;
+        while (slotCount < maximumSize)
+        {
+            slotCount *= 2U;
+        }
+    }
+
+    state = (lockFreeState_t*) xme_hal_mem_alloc(sizeof(lockFreeState_t));
+    XME_CHECK(NULL != state, XME_STATUS_OUT_OF_RESOURCES);
+
+    state->head = 0U;
+    state->tail = 0U;
+    state->slotCount = slotCount;
+    state->sequences = NULL;
+
+    if (XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC == concurrency)
+    {
+        state->sequences = (volatile uint32_t*) xme_hal_mem_alloc(slotCount * sizeof(uint32_t));
+        XME_CHECK_REC(NULL != state->sequences, XME_STATUS_OUT_OF_RESOURCES,
+        {
+            xme_hal_mem_free(state);
+        });
+
+        for (i = 0U; i < slotCount; i++)
+        {
+            state->sequences[i] = i;
+        }
+    }
+
+    circularBuffer->circularBufferStart = xme_hal_mem_alloc(slotCount * itemSizeInBytes);
+    XME_CHECK_REC(NULL != circularBuffer->circularBufferStart, XME_STATUS_OUT_OF_RESOURCES,
+    {
+        xme_hal_mem_free((void*) state->sequences);
+        xme_hal_mem_free(state);
+    });
+
+    circularBuffer->circularBufferEnd = (char*) circularBuffer->circularBufferStart + slotCount * itemSizeInBytes;
+    circularBuffer->sizeOfCircularBuffer = (XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC == concurrency) ? maximumSize : slotCount;
+    circularBuffer->count = 0U;
+    circularBuffer->itemSizeInBytes = itemSizeInBytes;
+    circularBuffer->writeHead = circularBuffer->circularBufferStart;
+    circularBuffer->readTail = circularBuffer->circularBufferStart;
+    circularBuffer->overwrite = false;
+    circularBuffer->concurrency = concurrency;
+    circularBuffer->lockFreeState = state;
+
+    return XME_STATUS_SUCCESS;
+}
+
+xme_status_t
+xme_hal_circularBuffer_pushBackN
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    const void* items,
+    uint32_t itemCount,
+    uint32_t* const pushedCount
+)
+{
+    uint32_t pushed = 0U;
+
+    XME_ASSERT(NULL != circularBuffer);
+    XME_ASSERT(NULL != items || 0U == itemCount);
+
+    switch (circularBuffer->concurrency)
+    {
+        case XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC:
+            pushed = pushBackSPSC(circularBuffer, items, itemCount);
+            break;
+
+        case XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC:
+            pushed = pushBackMPMC(circularBuffer, items, itemCount);
+            break;
+
+        default:
+            while (pushed < itemCount &&
+                XME_STATUS_SUCCESS == xme_hal_circularBuffer_pushBack(circularBuffer,
+                    (const char*) items + pushed * circularBuffer->itemSizeInBytes))
+            {
+                pushed++;
+            }
+    }
+
+    if (NULL != pushedCount)
+    {
+        *pushedCount = pushed;
+    }
+
+    return (pushed == itemCount) ? XME_STATUS_SUCCESS : XME_STATUS_PERMISSION_DENIED;
+}
+
+xme_status_t
+xme_hal_circularBuffer_popFrontN
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    void* items,
+    uint32_t maxItemCount,
+    uint32_t* const poppedCount
+)
+{
+    uint32_t popped = 0U;
+
+    XME_ASSERT(NULL != circularBuffer);
+    XME_ASSERT(NULL != poppedCount);
+
+    switch (circularBuffer->concurrency)
+    {
+        case XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC:
+            popped = popFrontSPSC(circularBuffer, items, maxItemCount);
+            break;
+
+        case XME_HAL_CIRCULARBUFFER_CONCURRENCY_MPMC:
+            popped = popFrontMPMC(circularBuffer, items, maxItemCount);
+            break;
+
+        default:
+            while (popped < maxItemCount &&
+                XME_STATUS_SUCCESS == xme_hal_circularBuffer_popFront(circularBuffer,
+                    (char*) items + popped * circularBuffer->itemSizeInBytes))
+            {
+                popped++;
+            }
+    }
+
+    *poppedCount = popped;
+
+    return (0U < popped) ? XME_STATUS_SUCCESS : XME_STATUS_PERMISSION_DENIED;
+}
+
+uint32_t
+xme_hal_circularBuffer_getCount
+(
+    xme_hal_circularBuffer_t* circularBuffer
+)
+{
+    lockFreeState_t* state = (lockFreeState_t*) circularBuffer->lockFreeState;
+    uint32_t tail;
+    uint32_t head;
+
+    if (NULL == state)
+    {
+        return circularBuffer->count;
+    }
+
+    tail = ATOMIC_LOAD_ACQUIRE(&state->tail);
+    head = ATOMIC_LOAD_ACQUIRE(&state->head);
+
+    if (XME_HAL_CIRCULARBUFFER_CONCURRENCY_SPSC == circularBuffer->concurrency)
+    {
+        return (head + state->slotCount - tail) % state->slotCount;
+    }
+
+    // Positions of pending operations may already be reserved
+    return ((int32_t) (head - tail) > 0) ? (head - tail) : 0U;
+}
+
+static void
+copyToSlots
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    uint32_t slot,
+    uint32_t slotCount,
+    const void* items,
+    uint32_t itemCount
+)
+{
+    size_t itemSize = circularBuffer->itemSizeInBytes;
+    uint32_t firstPart = (itemCount < slotCount - slot) ? itemCount : slotCount - slot;
+
+    (void) xme_hal_mem_copy((char*) circularBuffer->circularBufferStart + slot * itemSize, items, firstPart * itemSize);
+
+    if (firstPart < itemCount)
+    {
+        (void) xme_hal_mem_copy(circularBuffer->circularBufferStart, (const char*) items + firstPart * itemSize, (itemCount - firstPart) * itemSize);
+    }
+}
+
+static void
+copyFromSlots
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    uint32_t slot,
+    uint32_t slotCount,
+    void* items,
+    uint32_t itemCount
+)
+{
+    size_t itemSize = circularBuffer->itemSizeInBytes;
+    uint32_t firstPart = (itemCount < slotCount - slot) ? itemCount : slotCount - slot;
+
+    (void) xme_hal_mem_copy(items, (const char*) circularBuffer->circularBufferStart + slot * itemSize, firstPart * itemSize);
+
+    if (firstPart < itemCount)
+    {
+        (void) xme_hal_mem_copy((char*) items + firstPart * itemSize, circularBuffer->circularBufferStart, (itemCount - firstPart) * itemSize);
+    }
+}
+
+static uint32_t
+pushBackSPSC
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    const void* items,
+    uint32_t itemCount
+)
+{
+    lockFreeState_t* state = (lockFreeState_t*) circularBuffer->lockFreeState;
+    uint32_t head = ATOMIC_LOAD_RELAXED(&state->head);
+    uint32_t tail = ATOMIC_LOAD_ACQUIRE(&state->tail);
+    uint32_t freeSlots = (tail + state->slotCount - head - 1U) % state->slotCount;
+
+    if (itemCount > freeSlots)
+    {
+        itemCount = freeSlots;
+    }
+
+    if (0U < itemCount)
+    {
+        copyToSlots(circularBuffer, head, state->slotCount, items, itemCount);
+
+        // Publish the items to the consumer
+        ATOMIC_STORE_RELEASE(&state->head, (head + itemCount) % state->slotCount);
+    }
+
+    return itemCount;
+}
+
+static uint32_t
+popFrontSPSC
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    void* items,
+    uint32_t maxItemCount
+)
+{
+    lockFreeState_t* state = (lockFreeState_t*) circularBuffer->lockFreeState;
+    uint32_t tail = ATOMIC_LOAD_RELAXED(&state->tail);
+    uint32_t head = ATOMIC_LOAD_ACQUIRE(&state->head);
+    uint32_t usedSlots = (head + state->slotCount - tail) % state->slotCount;
+
+    if (maxItemCount > usedSlots)
+    {
+        maxItemCount = usedSlots;
+    }
+
+    if (0U < maxItemCount)
+    {
+        copyFromSlots(circularBuffer, tail, state->slotCount, items, maxItemCount);
+
+        // Hand the slots back to the producer
+        ATOMIC_STORE_RELEASE(&state->tail, (tail + maxItemCount) % state->slotCount);
+    }
+
+    return maxItemCount;
+}
+
+static uint32_t
+pushBackMPMC
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    const void* items,
+    uint32_t itemCount
+)
+{
+    lockFreeState_t* state = (lockFreeState_t*) circularBuffer->lockFreeState;
+    uint32_t mask = state->slotCount - 1U;
+    uint32_t position;
+    uint32_t reserved;
+    uint32_t i;
+
+    for (;;)
+    {
+        position = ATOMIC_LOAD_RELAXED(&state->head);
+
+        // Count the free slots following the position. No other producer can
+        // fill them before the reservation, since that requires moving head.
+        reserved = 0U;
+        while (reserved < itemCount &&
+            ATOMIC_LOAD_ACQUIRE(&state->sequences[(position + reserved) & mask]) == position + reserved)
+        {
+            reserved++;
+        }
+
+        if (0U == reserved)
+        {
+            if ((int32_t) (ATOMIC_LOAD_ACQUIRE(&state->sequences[position & mask]) - position) < 0)
+            {
+                // The slot still holds the item of the previous round: full
+                return 0U;
+            }
+
+            // Another producer reserved the position in the meantime
+            continue;
+        }
+
+        if (ATOMIC_COMPARE_EXCHANGE(&state->head, position, position + reserved))
+        {
+            break;
+        }
+    }
+
+    copyToSlots(circularBuffer, position & mask, state->slotCount, items, reserved);
+
+    for (i = 0U; i < reserved; i++)
+    {
+        ATOMIC_STORE_RELEASE(&state->sequences[(position + i) & mask], position + i + 1U);
+    }
+
+    return reserved;
+}
+
+static uint32_t
+popFrontMPMC
+(
+    xme_hal_circularBuffer_t* circularBuffer,
+    void* items,
+    uint32_t maxItemCount
+)
+{
+    lockFreeState_t* state = (lockFreeState_t*) circularBuffer->lockFreeState;
+    uint32_t mask = state->slotCount - 1U;
+    uint32_t position;
+    uint32_t reserved;
+    uint32_t i;
+
+    for (;;)
+    {
+        position = ATOMIC_LOAD_RELAXED(&state->tail);
+
+        // Count the filled slots following the position
+        reserved = 0U;
+        while (reserved < maxItemCount &&
+            ATOMIC_LOAD_ACQUIRE(&state->sequences[(position + reserved) & mask]) == position + reserved + 1U)
+        {
+            reserved++;
+        }
+
+        if (0U == reserved)
+        {
+            if ((int32_t) (ATOMIC_LOAD_ACQUIRE(&state->sequences[position & mask]) - (position + 1U)) < 0)
+            {
+                // The slot has not been filled yet: empty
+                return 0U;
+            }
+
+            // Another consumer reserved the position in the meantime
+            continue;
+        }
+
+        if (ATOMIC_COMPARE_EXCHANGE(&state->tail, position, position + reserved))
+        {
+            break;
+        }
+    }
+
+    copyFromSlots(circularBuffer, position & mask, state->slotCount, items, reserved);
+
+    // Free the slots for the push one round later
+    for (i = 0U; i < reserved; i++)
+    {
+        ATOMIC_STORE_RELEASE(&state->sequences[(position + i) & mask], position + i + state->slotCount);
+    }
+
+    return reserved;
+}
+
 /**
  * @}
  */
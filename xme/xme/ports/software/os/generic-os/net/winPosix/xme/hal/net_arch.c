@@ -50,6 +50,7 @@
 #    include <netdb.h>
 #    include <arpa/inet.h>
 #    include <sys/types.h>
+#    include <sys/socket.h>
 #    include <fcntl.h>
 #    include <sys/ioctl.h>
 #   include <unistd.h>
@@ -155,6 +156,13 @@ typedef struct
     xme_hal_sync_criticalSectionHandle_t criticalSectionHandle; ///< Critical section handle for protecting critical regions.
 } xme_hal_net_configStruct_t;
 
+/**
+ * \def XME_HAL_NET_DATAGRAM_BATCH_SIZE
+ *
+ * \brief Maximum number of datagrams passed to the operating system with a single call.
+ */
+#define XME_HAL_NET_DATAGRAM_BATCH_SIZE 32U
+
 #define GENERIC_ADDRESS_TO_IP4(generic_address) (*((uint32_t *)generic_address)) ///< the IPv4 address.
 #define GENERIC_ADDRESS_TO_PORT(generic_address) (*(((uint16_t *)generic_address)+2)) ///< the address port.
 
@@ -189,6 +197,46 @@ xme_hal_net_writeDatagram_ipaddress
     uint16_t count
 );
 
+/**
+ * \brief Builds the socket address of a datagram destination.
+ *
+ * \param socketItem the socket item.
+ * \param remoteAddress the remote IP address.
+ * \param remotePort the remote port in host byte order.
+ * \param address the socket address to build.
+ *
+ * \return the length of the socket address in bytes.
+ */
+static size_t
+xme_hal_net_buildDatagramAddress
+(
+    xme_hal_net_socketItem* socketItem,
+    void* remoteAddress,
+    uint16_t remotePort,
+    xme_hal_net_address_t* address
+);
+
+/**
+ * \brief Sends a datagram to a socket address.
+ *
+ * \param socket the OS socket descriptor.
+ * \param address the socket address.
+ * \param addrlen the length of the socket address in bytes.
+ * \param buffer the buffer.
+ * \param count the number of bytes to write.
+ *
+ * \return the number of bytes written.
+ */
+static uint16_t
+xme_hal_net_sendDatagram
+(
+    SOCKET socket,
+    const struct sockaddr* address,
+    size_t addrlen,
+    const void* buffer,
+    uint16_t count
+);
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
@@ -517,6 +565,15 @@ xme_hal_net_openSocket
             else
             {
                 status = bind(socketItem->socket, (const struct sockaddr*) aiResult->ai_addr, aiResult->ai_addrlen);
+#if defined(SO_RXQ_OVFL)
+                if (0 == status && (socketItem->flags & XME_HAL_NET_SOCKET_UDP))
+                {
+                    // Let the OS report datagrams it dropped due to a full receive queue, see xme_hal_net_readDatagrams().
+                    // Failing to do so only disables the statistics.
+                    int overflow = 1;
+                    (void) setsockopt(socketItem->socket, SOL_SOCKET, SO_RXQ_OVFL, (const char*)&overflow, sizeof(overflow));
+                }
+#endif // #if defined(SO_RXQ_OVFL)
             }
         }
         else if (!(socketItem->flags & XME_HAL_NET_SOCKET_BROADCAST))
@@ -1452,39 +1509,64 @@ xme_hal_net_writeDatagram_ipaddress
     xme_hal_net_address_t broadcastAddr;
     size_t addrlen;
 
-#if defined(_WIN32) && !defined(CYGWIN)
-    int numBytes;
-#else // #if defined(_WIN32) && !defined(CYGWIN)
-    ssize_t numBytes;
-#endif // #if defined(_WIN32) && !defined(CYGWIN)
-
     if (socketItem->connected)
     {
         return 0U;
     }
 
+    addrlen = xme_hal_net_buildDatagramAddress(socketItem, remoteAddress, remotePort, &broadcastAddr);
+
+    return xme_hal_net_sendDatagram(socketItem->socket, &broadcastAddr.sa, addrlen, buffer, count);
+}
+
+static size_t
+xme_hal_net_buildDatagramAddress
+(
+    xme_hal_net_socketItem* socketItem,
+    void* remoteAddress,
+    uint16_t remotePort,
+    xme_hal_net_address_t* address
+)
+{
     if (socketItem->flags & XME_HAL_NET_SOCKET_IPV6)
     {
         // Create struct sockaddr from IPv6 address
-        struct sockaddr_in6 *Addr = &broadcastAddr.sa_in6;
-        xme_hal_mem_set(&broadcastAddr, 0, sizeof(struct sockaddr_in6));
+        struct sockaddr_in6 *Addr = &address->sa_in6;
+        xme_hal_mem_set(address, 0, sizeof(struct sockaddr_in6));
         Addr->sin6_family = AF_INET6;
         Addr->sin6_port = htons(remotePort);
-        xme_hal_mem_copy((char *)Addr->sin6_addr.s6_addr, (char *)remoteAddress, sizeof(struct sockaddr_in6) );
-        addrlen = sizeof(struct sockaddr_in6);
+        xme_hal_mem_copy((char *)Addr->sin6_addr.s6_addr, (char *)remoteAddress, sizeof(Addr->sin6_addr.s6_addr));
+        return sizeof(struct sockaddr_in6);
     }
-    else
+
     {
         // Create struct sockaddr from IPv4 address
-        struct sockaddr_in *Addr = &broadcastAddr.sa_in;
-        xme_hal_mem_set(&broadcastAddr, 0, sizeof(struct sockaddr_in));
+        struct sockaddr_in *Addr = &address->sa_in;
+        xme_hal_mem_set(address, 0, sizeof(struct sockaddr_in));
         Addr->sin_family = AF_INET;
         Addr->sin_port = htons(remotePort);
         Addr->sin_addr.s_addr = *((uint32_t *)remoteAddress);
-        addrlen = sizeof(struct sockaddr_in);
+        return sizeof(struct sockaddr_in);
     }
+}
 
-    numBytes = sendto(socketItem->socket, (char*)buffer, count, 0, (const struct sockaddr*) &broadcastAddr.sa, addrlen);
+static uint16_t
+xme_hal_net_sendDatagram
+(
+    SOCKET socket,
+    const struct sockaddr* address,
+    size_t addrlen,
+    const void* buffer,
+    uint16_t count
+)
+{
+#if defined(_WIN32) && !defined(CYGWIN)
+    int numBytes;
+#else // #if defined(_WIN32) && !defined(CYGWIN)
+    ssize_t numBytes;
+#endif // #if defined(_WIN32) && !defined(CYGWIN)
+
+    numBytes = sendto(socket, (char*)buffer, count, 0, address, addrlen);
 
 #if defined(_WIN32) && !defined(CYGWIN)
     XME_CHECK_MSG
@@ -1510,6 +1592,258 @@ xme_hal_net_writeDatagram_ipaddress
     return (uint16_t) numBytes;
 }
 
+xme_status_t
+xme_hal_net_resolveDatagramDestination
+(
+    xme_hal_net_socketHandle_t socketHandle,
+    xme_com_interface_address_t* remoteAddress,
+    xme_hal_net_datagramDestination_t* destination
+)
+{
+    xme_hal_net_socketItem* socketItem;
+    xme_hal_net_address_t address;
+    uint32_t ip = 0;
+    uint16_t port = 0;
+    size_t addrlen;
+
+    XME_CHECK(NULL != remoteAddress, XME_STATUS_INVALID_PARAMETER);
+    XME_CHECK(NULL != destination, XME_STATUS_INVALID_PARAMETER);
+
+    xme_hal_sync_enterCriticalSection(xme_hal_net_config.criticalSectionHandle);
+    {
+        // Verify socket handle
+        XME_CHECK_REC
+        (
+            NULL != (socketItem = XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_hal_net_config.sockets, socketHandle)),
+            XME_STATUS_INVALID_HANDLE,
+            {
+                xme_hal_sync_leaveCriticalSection(xme_hal_net_config.criticalSectionHandle);
+            }
+        );
+    }
+    xme_hal_sync_leaveCriticalSection(xme_hal_net_config.criticalSectionHandle);
+
+    XME_CHECK(!socketItem->connected, XME_STATUS_INVALID_CONFIGURATION);
+
+    // Translate xme_com_interface_address_t like xme_hal_net_writeDatagram() does
+    if (socketItem->flags & XME_HAL_NET_SOCKET_IPV6)
+    {
+        addrlen = xme_hal_net_buildDatagramAddress(socketItem, (void*) remoteAddress, GENERIC_ADDRESS_TO_PORT_IP6(remoteAddress), &address);
+    }
+    else
+    {
+        XME_CHECK(XME_STATUS_SUCCESS == xme_com_interface_genericAddressToIPv4(remoteAddress, &ip, &port), XME_STATUS_INVALID_PARAMETER);
+        addrlen = xme_hal_net_buildDatagramAddress(socketItem, (void*) &ip, ntohs(port), &address);
+    }
+
+    XME_ASSERT(addrlen <= sizeof(destination->address.bytes));
+
+    destination->socketHandle = socketHandle;
+    destination->nativeSocket = (uintptr_t) socketItem->socket;
+    destination->addressLength = (uint16_t) addrlen;
+    (void) xme_hal_mem_copy(destination->address.bytes, &address, addrlen);
+
+    return XME_STATUS_SUCCESS;
+}
+
+uint16_t
+xme_hal_net_writeDatagramTo
+(
+    const xme_hal_net_datagramDestination_t* destination,
+    const void* buffer,
+    uint16_t count
+)
+{
+    XME_CHECK(NULL != destination, 0U);
+    XME_CHECK(0U != destination->addressLength, 0U);
+
+    return xme_hal_net_sendDatagram
+    (
+        (SOCKET) destination->nativeSocket,
+        (const struct sockaddr*) destination->address.bytes,
+        destination->addressLength,
+        buffer,
+        count
+    );
+}
+
+uint16_t
+xme_hal_net_writeDatagrams
+(
+    const xme_hal_net_datagram_t* datagrams,
+    uint16_t count
+)
+{
+    uint16_t sent = 0U;
+
+    XME_CHECK(NULL != datagrams || 0U == count, 0U);
+
+#if defined(__linux__)
+    // Pass each run of datagrams with the same socket to a single sendmmsg() call
+    while (sent < count)
+    {
+        struct mmsghdr messages[XME_HAL_NET_DATAGRAM_BATCH_SIZE];
+        struct iovec vectors[XME_HAL_NET_DATAGRAM_BATCH_SIZE];
+        uintptr_t nativeSocket = datagrams[sent].destination->nativeSocket;
+        unsigned int batchSize = 0U;
+        int numMessages;
+
+        while (sent + batchSize < count && batchSize < XME_HAL_NET_DATAGRAM_BATCH_SIZE && datagrams[sent + batchSize].destination->nativeSocket == nativeSocket)
+        {
+            const xme_hal_net_datagram_t* datagram = &datagrams[sent + batchSize];
+
+            XME_CHECK(0U != datagram->destination->addressLength, sent);
+
+            vectors[batchSize].iov_base = (void*) datagram->buffer;
+            vectors[batchSize].iov_len = datagram->count;
+            xme_hal_mem_set(&messages[batchSize], 0, sizeof(messages[batchSize]));
+            messages[batchSize].msg_hdr.msg_name = (void*) datagram->destination->address.bytes;
+            messages[batchSize].msg_hdr.msg_namelen = datagram->destination->addressLength;
+            messages[batchSize].msg_hdr.msg_iov = &vectors[batchSize];
+            messages[batchSize].msg_hdr.msg_iovlen = 1;
+            batchSize++;
+        }
+
+        numMessages = sendmmsg((SOCKET) nativeSocket, messages, batchSize, 0);
+
+        XME_CHECK_MSG
+        (
+            -1 != numMessages,
+            sent,
+            XME_LOG_DEBUG,
+            "[xme_hal_net_writeDatagrams] returned error code %d\n",
+            errno
+        );
+
+        sent += (uint16_t) numMessages;
+
+        if ((unsigned int) numMessages < batchSize)
+        {
+            break;
+        }
+    }
+#else // #if defined(__linux__)
+    while (sent < count && 0U != xme_hal_net_writeDatagramTo(datagrams[sent].destination, datagrams[sent].buffer, datagrams[sent].count))
+    {
+        sent++;
+    }
+#endif // #if defined(__linux__)
+
+    return sent;
+}
+
+uint16_t
+xme_hal_net_readDatagrams
+(
+    xme_hal_net_socketHandle_t socketHandle,
+    xme_hal_net_receivedDatagram_t* datagrams,
+    uint16_t count,
+    uint32_t* droppedCount
+)
+{
+    xme_hal_net_socketItem* socketItem;
+    uint16_t received = 0U;
+
+    XME_CHECK(NULL != datagrams || 0U == count, 0U);
+
+    xme_hal_sync_enterCriticalSection(xme_hal_net_config.criticalSectionHandle);
+    {
+        // Verify socket handle
+        XME_CHECK_REC
+        (
+            NULL != (socketItem = XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_hal_net_config.sockets, socketHandle)),
+            0U,
+            {
+                xme_hal_sync_leaveCriticalSection(xme_hal_net_config.criticalSectionHandle);
+            }
+        );
+    }
+    xme_hal_sync_leaveCriticalSection(xme_hal_net_config.criticalSectionHandle);
+
+#if defined(__linux__)
+    // Fetch the queued datagrams with as few recvmmsg() calls as possible
+    while (received < count)
+    {
+        struct mmsghdr messages[XME_HAL_NET_DATAGRAM_BATCH_SIZE];
+        struct iovec vectors[XME_HAL_NET_DATAGRAM_BATCH_SIZE];
+        char controlBuffers[XME_HAL_NET_DATAGRAM_BATCH_SIZE][CMSG_SPACE(sizeof(uint32_t))];
+        unsigned int batchSize = 0U;
+        unsigned int i;
+        int numMessages;
+
+        while (received + batchSize < count && batchSize < XME_HAL_NET_DATAGRAM_BATCH_SIZE)
+        {
+            vectors[batchSize].iov_base = datagrams[received + batchSize].buffer;
+            vectors[batchSize].iov_len = datagrams[received + batchSize].size;
+            xme_hal_mem_set(&messages[batchSize], 0, sizeof(messages[batchSize]));
+            messages[batchSize].msg_hdr.msg_iov = &vectors[batchSize];
+            messages[batchSize].msg_hdr.msg_iovlen = 1;
+            messages[batchSize].msg_hdr.msg_control = controlBuffers[batchSize];
+            messages[batchSize].msg_hdr.msg_controllen = sizeof(controlBuffers[batchSize]);
+            batchSize++;
+        }
+
+        numMessages = recvmmsg(socketItem->socket, messages, batchSize, MSG_DONTWAIT, NULL);
+
+        // EAGAIN or EWOULDBLOCK just mean that no more datagrams are queued
+        XME_CHECK_MSG
+        (
+            -1 != numMessages || EAGAIN == errno || EWOULDBLOCK == errno,
+            received,
+            XME_LOG_DEBUG,
+            "[xme_hal_net_readDatagrams] returned error code %d\n",
+            errno
+        );
+
+        if (numMessages <= 0)
+        {
+            break;
+        }
+
+        for (i = 0U; i < (unsigned int) numMessages; i++)
+        {
+            struct cmsghdr *cmsg;
+
+            datagrams[received + i].count = (uint16_t) messages[i].msg_len;
+
+#if defined(SO_RXQ_OVFL)
+            for (cmsg = CMSG_FIRSTHDR(&messages[i].msg_hdr); NULL != cmsg; cmsg = CMSG_NXTHDR(&messages[i].msg_hdr, cmsg))
+            {
+                if (NULL != droppedCount && SOL_SOCKET == cmsg->cmsg_level && SO_RXQ_OVFL == cmsg->cmsg_type)
+                {
+                    xme_hal_mem_copy(droppedCount, CMSG_DATA(cmsg), sizeof(uint32_t));
+                }
+            }
+#else // #if defined(SO_RXQ_OVFL)
+            XME_UNUSED_PARAMETER(cmsg);
+#endif // #if defined(SO_RXQ_OVFL)
+        }
+
+        received += (uint16_t) numMessages;
+
+        if ((unsigned int) numMessages < batchSize)
+        {
+            break;
+        }
+    }
+#else // #if defined(__linux__)
+    XME_UNUSED_PARAMETER(droppedCount);
+
+    // Read the datagrams one by one as long as some are available
+    while (received < count && 0U != xme_hal_net_get_available_data_size(socketHandle))
+    {
+        datagrams[received].count = xme_hal_net_readSocket(socketHandle, datagrams[received].buffer, datagrams[received].size);
+        if (0U == datagrams[received].count)
+        {
+            break;
+        }
+        received++;
+    }
+#endif // #if defined(__linux__)
+
+    return received;
+}
+
 xme_status_t
 xme_hal_net_getInterfaceAddr
 (
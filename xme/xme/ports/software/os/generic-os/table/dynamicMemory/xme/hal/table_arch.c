@@ -260,3 +260,154 @@ xme_hal_table_hasNext
 
     return (iterator < tableDesc->maxHandle);
 }
+
+void
+xme_hal_table_finiSlab
+(
+    xme_hal_table_slabStruct_t* table
+)
+{
+    XME_ASSERT_NORVAL(NULL != table);
+
+    xme_hal_mem_free(table->items);
+    xme_hal_mem_free(table->itemSlots);
+    xme_hal_mem_free(table->slots);
+
+    table->count[0] = 0U;
+    table->capacity = 0U;
+    table->slotCount = 0U;
+    table->freeSlot = 0U;
+    table->items = NULL;
+    table->itemSlots = NULL;
+    table->slots = NULL;
+}
+
+void
+xme_hal_table_clearSlab
+(
+    xme_hal_table_slabStruct_t* table
+)
+{
+    uint16_t i;
+
+    XME_ASSERT_NORVAL(NULL != table);
+
+    // Release all slots, advancing the generation of the occupied ones
+    // so that their handles stay invalid when the slots are reused.
+    // The free list is built in reverse so that low slots are reused first.
+    table->freeSlot = 0U;
+    for (i = table->slotCount; i > 0U; i--)
+    {
+        xme_hal_table_slabSlot_t* slot = &table->slots[i-1U];
+
+        if (0U != (slot->generation & 1U))
+        {
+            slot->generation++;
+        }
+        slot->index = table->freeSlot;
+        table->freeSlot = i;
+    }
+
+    table->count[0] = 0U;
+}
+
+xme_hal_table_slabHandle_t
+xme_hal_table_addSlabItem
+(
+    xme_hal_table_slabStruct_t* table,
+    size_t itemSize
+)
+{
+    xme_hal_table_slabSlot_t* slot;
+    uint16_t slotNumber;
+    uint16_t index;
+
+    XME_ASSERT_RVAL(NULL != table, XME_HAL_TABLE_INVALID_SLAB_HANDLE);
+    XME_ASSERT_RVAL(0 != itemSize, XME_HAL_TABLE_INVALID_SLAB_HANDLE);
+
+    if (table->count[0] == table->capacity)
+    {
+        // Double the capacity. The three arrays are resized separately,
+        // the capacity is only updated when all of them have succeeded.
+        uint16_t capacity;
+        void* items;
+        uint16_t* itemSlots;
+        xme_hal_table_slabSlot_t* slots;
+
+        XME_CHECK(XME_HAL_TABLE_MAX_ROW_HANDLE != table->capacity, XME_HAL_TABLE_INVALID_SLAB_HANDLE);
+
+        capacity = (0U == table->capacity) ? 4U : (uint16_t) XME_HAL_MATH_MIN(2U * (uint32_t) table->capacity, (uint32_t) XME_HAL_TABLE_MAX_ROW_HANDLE);
+
+        items = xme_hal_mem_realloc(table->items, capacity * itemSize);
+        XME_CHECK(NULL != items, XME_HAL_TABLE_INVALID_SLAB_HANDLE);
+        table->items = items;
+
+        itemSlots = (uint16_t*) xme_hal_mem_realloc(table->itemSlots, capacity * sizeof(uint16_t));
+        XME_CHECK(NULL != itemSlots, XME_HAL_TABLE_INVALID_SLAB_HANDLE);
+        table->itemSlots = itemSlots;
+
+        slots = (xme_hal_table_slabSlot_t*) xme_hal_mem_realloc(table->slots, capacity * sizeof(xme_hal_table_slabSlot_t));
+        XME_CHECK(NULL != slots, XME_HAL_TABLE_INVALID_SLAB_HANDLE);
+        table->slots = slots;
+
+        table->capacity = capacity;
+    }
+
+    // Reuse a free slot if possible, the number of slots never exceeds the capacity
+    if (0U != table->freeSlot)
+    {
+        slotNumber = table->freeSlot;
+        slot = &table->slots[slotNumber-1U];
+        table->freeSlot = slot->index;
+    }
+    else
+    {
+        slotNumber = ++table->slotCount;
+        slot = &table->slots[slotNumber-1U];
+        slot->generation = 0U;
+    }
+
+    // Append the item and mark the slot as occupied
+    index = table->count[0]++;
+    (void) xme_hal_mem_set((uint8_t*) table->items + (size_t) index * itemSize, 0, itemSize);
+    table->itemSlots[index] = slotNumber;
+    slot->index = index;
+    slot->generation++;
+
+    return XME_HAL_TABLE_ARCH_SLAB_HANDLE(slotNumber, slot->generation);
+}
+
+xme_status_t
+xme_hal_table_removeSlabItem
+(
+    xme_hal_table_slabStruct_t* table,
+    xme_hal_table_slabHandle_t handle,
+    size_t itemSize
+)
+{
+    xme_hal_table_slabSlot_t* slot;
+    uint16_t last;
+
+    XME_ASSERT(NULL != table);
+    XME_ASSERT(0 != itemSize);
+    XME_CHECK(XME_HAL_TABLE_ARCH_SLAB_IS_VALID(*table, handle), XME_STATUS_INVALID_HANDLE);
+
+    slot = &table->slots[XME_HAL_TABLE_ARCH_SLAB_SLOT(handle)-1U];
+    last = (uint16_t)(table->count[0] - 1U);
+
+    // Move the last item into the place of the removed one to keep the items dense
+    if (slot->index != last)
+    {
+        (void) xme_hal_mem_copy((uint8_t*) table->items + (size_t) slot->index * itemSize, (uint8_t*) table->items + (size_t) last * itemSize, itemSize);
+        table->itemSlots[slot->index] = table->itemSlots[last];
+        table->slots[table->itemSlots[slot->index]-1U].index = slot->index;
+    }
+    table->count[0] = last;
+
+    // Invalidate all handles to the slot and put it on the free list
+    slot->generation++;
+    slot->index = table->freeSlot;
+    table->freeSlot = XME_HAL_TABLE_ARCH_SLAB_SLOT(handle);
+
+    return XME_STATUS_SUCCESS;
+}
@@ -61,9 +61,81 @@ typedef struct
 }
 xme_hal_table_arrayStruct_t;
 
+/**
+ * \struct xme_hal_table_slabSlot_t
+ *
+ * \brief  Slot of a slab table, maps a handle to the position of its item.
+ */
+typedef struct
+{
+    uint16_t generation; ///< Generation of the slot. Odd while the slot is occupied, incremented on every addition and removal.
+    uint16_t index;      ///< Zero-based position of the item if the slot is occupied, otherwise number of the next free slot (zero for none).
+}
+xme_hal_table_slabSlot_t;
+
+/**
+ * \struct xme_hal_table_slabStruct_t
+ *
+ * \brief  Slab table structure.
+ *
+ *         The slab table structure is the internal representation of a slab
+ *         table.
+ *
+ * \note   Note that the definition of xme_hal_table_slabStruct_t must match
+ *         the definition of the XME_HAL_SLABTABLE() macro (except for the
+ *         type of the items).
+ */
+typedef struct
+{
+    uint16_t count[1];               ///< Number of items in the table.
+    uint16_t capacity;               ///< Number of items the allocated memory can hold.
+    uint16_t slotCount;              ///< Number of slots that have ever been used.
+    uint16_t freeSlot;               ///< Number of the first free slot (zero for none).
+    void* items;                     ///< Items of the table, without holes.
+    uint16_t* itemSlots;             ///< Number of the slot of each item.
+    xme_hal_table_slabSlot_t* slots; ///< Slots of the table.
+}
+xme_hal_table_slabStruct_t;
+
 /******************************************************************************/
 /***   Defines                                                              ***/
 /******************************************************************************/
+/**
+ * \def XME_HAL_TABLE_ARCH_SLAB_SLOT
+ *
+ * \brief Returns the one-based slot number of the given slab table handle.
+ */
+#define XME_HAL_TABLE_ARCH_SLAB_SLOT(handle) \
+    ((uint16_t)(((xme_hal_table_slabHandle_t)(handle)) & 0xFFFFU))
+
+/**
+ * \def XME_HAL_TABLE_ARCH_SLAB_GENERATION
+ *
+ * \brief Returns the slot generation of the given slab table handle.
+ */
+#define XME_HAL_TABLE_ARCH_SLAB_GENERATION(handle) \
+    ((uint16_t)(((xme_hal_table_slabHandle_t)(handle)) >> 16))
+
+/**
+ * \def XME_HAL_TABLE_ARCH_SLAB_HANDLE
+ *
+ * \brief Builds a slab table handle from the given slot number and generation.
+ */
+#define XME_HAL_TABLE_ARCH_SLAB_HANDLE(slot, generation) \
+    ((xme_hal_table_slabHandle_t)((((xme_hal_table_slabHandle_t)(generation)) << 16) | ((xme_hal_table_slabHandle_t)(slot))))
+
+/**
+ * \def XME_HAL_TABLE_ARCH_SLAB_IS_VALID
+ *
+ * \brief Determines whether the given handle refers to an item of the given
+ *        slab table.
+ */
+#define XME_HAL_TABLE_ARCH_SLAB_IS_VALID(name, handle) \
+    (XME_HAL_TABLE_ARCH_SLAB_SLOT(handle) > 0U && \
+     XME_HAL_TABLE_ARCH_SLAB_SLOT(handle) <= (name).slotCount && \
+     0U != (XME_HAL_TABLE_ARCH_SLAB_GENERATION(handle) & 1U) && \
+     (name).slots[XME_HAL_TABLE_ARCH_SLAB_SLOT(handle)-1U].generation == XME_HAL_TABLE_ARCH_SLAB_GENERATION(handle))
+
 // Documented in table.h
 #define XME_HAL_TABLE(itemType, name, maxElements) \
     struct \
@@ -201,6 +273,79 @@ xme_hal_table_arrayStruct_t;
         } \
     } while (0)
 
+// Documented in table.h
+#define XME_HAL_SLABTABLE(itemType, name, maxElements) \
+    struct \
+    { \
+        /* Declaring the 'count' member as an array is a "hack"   */ \
+        /* to ensure that a valid number is passed in maxElements */ \
+        /* and that the maxElements argument is not unused.       */ \
+        uint16_t count[(1 == maxElements) ? 1 : 1]; \
+        uint16_t capacity; \
+        uint16_t slotCount; \
+        uint16_t freeSlot; \
+        itemType* items; \
+        uint16_t* itemSlots; \
+        xme_hal_table_slabSlot_t* slots; \
+    } name
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_INIT(name) \
+    do \
+    { \
+        (name).count[0] = 0U; \
+        (name).capacity = 0U; \
+        (name).slotCount = 0U; \
+        (name).freeSlot = 0U; \
+        (name).items = NULL; \
+        (name).itemSlots = NULL; \
+        (name).slots = NULL; \
+    } while (0)
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_FINI(name) \
+    xme_hal_table_finiSlab((xme_hal_table_slabStruct_t*)&(name))
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_CLEAR(name) \
+    xme_hal_table_clearSlab((xme_hal_table_slabStruct_t*)&(name))
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_ADD_ITEM(name) \
+    xme_hal_table_addSlabItem((xme_hal_table_slabStruct_t*)&(name), sizeof(*(name).items))
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_REMOVE_ITEM(name, handle) \
+    xme_hal_table_removeSlabItem((xme_hal_table_slabStruct_t*)&(name), handle, sizeof(*(name).items))
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_ITEM_COUNT(name) \
+    ((name).count[0])
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_ITEM_FROM_HANDLE(name, handle) \
+    (XME_HAL_TABLE_ARCH_SLAB_IS_VALID(name, handle) ? &(name).items[(name).slots[XME_HAL_TABLE_ARCH_SLAB_SLOT(handle)-1U].index] : NULL)
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_ITERATE_BEGIN(name, loopHandle, loopItemType, loopItem) \
+    do \
+    { \
+        uint16_t loopHandle##Position; \
+        /* Iterating backwards allows to remove the current item, which */ \
+        /* moves the last (already visited) item into its place.        */ \
+        for (loopHandle##Position = (name).count[0]; loopHandle##Position > 0U; loopHandle##Position--) \
+        { \
+            loopItemType* loopItem = &(name).items[loopHandle##Position-1U]; \
+            xme_hal_table_slabHandle_t loopHandle = XME_HAL_TABLE_ARCH_SLAB_HANDLE((name).itemSlots[loopHandle##Position-1U], (name).slots[(name).itemSlots[loopHandle##Position-1U]-1U].generation); \
+            (void) loopHandle; \
+            {
+
+// Documented in table.h
+#define XME_HAL_SLABTABLE_ITERATE_END() \
+            } \
+        } \
+    } while (0)
+
 /******************************************************************************/
 /***   Prototypes                                                           ***/
 /******************************************************************************/
@@ -250,6 +395,62 @@ xme_hal_table_removeItem
     size_t itemSize
 );
 
+/**
+ * \brief Finalizes the given slab table and frees its memory.
+ *
+ * \param[in] table Slab table.
+ */
+void
+xme_hal_table_finiSlab
+(
+    xme_hal_table_slabStruct_t* table
+);
+
+/**
+ * \brief Removes all items from the given slab table.
+ *
+ * \param[in] table Slab table.
+ */
+void
+xme_hal_table_clearSlab
+(
+    xme_hal_table_slabStruct_t* table
+);
+
+/**
+ * \brief Allocates space in the slab table for a new item.
+ *
+ * \param[in] table Slab table.
+ * \param[in] itemSize Size of an item in the table.
+ *
+ * \return Handle of the new item, which is initialized with all zeros, or
+ *         XME_HAL_TABLE_INVALID_SLAB_HANDLE if no memory is available.
+ */
+xme_hal_table_slabHandle_t
+xme_hal_table_addSlabItem
+(
+    xme_hal_table_slabStruct_t* table,
+    size_t itemSize
+);
+
+/**
+ * \brief Removes an item from the slab table.
+ *
+ * \param[in] table Slab table.
+ * \param[in] handle Handle of the item to remove.
+ * \param[in] itemSize Size of an item in the table.
+ *
+ * \retval XME_STATUS_SUCCESS if the item has been successfully removed.
+ * \retval XME_STATUS_INVALID_HANDLE if the given handle was invalid.
+ */
+xme_status_t
+xme_hal_table_removeSlabItem
+(
+    xme_hal_table_slabStruct_t* table,
+    xme_hal_table_slabHandle_t handle,
+    size_t itemSize
+);
+
 XME_EXTERN_C_END
 
 #endif // #ifndef XME_HAL_TABLE_ARCH_H
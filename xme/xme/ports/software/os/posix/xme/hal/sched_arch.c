@@ -445,6 +445,16 @@ xme_hal_sched_removeTask
 #else
 			XME_ASSERT(0 != taskDesc->threadHandle);
 #endif
+			// A one-shot task that has completed removes itself as soon as we
+			// release the task descriptors mutex, so there is nothing to do
+			if (taskDesc->selfCleanup)
+			{
+				(void) pthread_mutex_unlock(&taskDesc->threadMutex);
+				(void) pthread_mutex_unlock(&xme_hal_sched_config.taskDescriptorsMutex);
+
+				return XME_STATUS_SUCCESS;
+			}
+
 			// Schedule the task for termination (this will resume the task)
 			taskDesc->taskState = XME_HAL_SCHED_TASK_STATE_TERMINATING;
 
@@ -507,23 +517,40 @@ xme_hal_sched_removeTask
 void
 xme_hal_sched_fini(void)
 {
+	xme_hal_table_rowHandle_t taskHandle;
+	xme_hal_sched_taskDescriptor_t* taskDesc;
+
 	//setpriority(PRIO_PROCESS, 0, -20);
-	// Synchronize access to the task descriptors mutex
-	(void) pthread_mutex_lock(&xme_hal_sched_config.taskDescriptorsMutex);
+	// Terminate all threads and wait for them to "join".
+	// The task descriptors mutex must not be held while joining, because
+	// a one-shot task that has just completed needs it to remove itself.
+	do
 	{
-		// Terminate all threads and wait for them to "join"
-		XME_HAL_TABLE_ITERATE_BEGIN
-		(
-			xme_hal_sched_config.taskDescriptors,
-			xme_hal_sched_taskHandle_t, taskHandle,
-			xme_hal_sched_taskDescriptor_t, taskDesc
-		);
+		// Synchronize access to the task descriptors mutex
+		(void) pthread_mutex_lock(&xme_hal_sched_config.taskDescriptorsMutex);
 		{
-			(void) xme_hal_sched_removeTask(taskHandle);
+			taskHandle = XME_HAL_TABLE_INVALID_ROW_HANDLE;
+			taskDesc = NULL;
+
+			XME_HAL_TABLE_GET_NEXT
+			(
+				xme_hal_sched_config.taskDescriptors,
+				xme_hal_table_rowHandle_t, taskHandle,
+				xme_hal_sched_taskDescriptor_t, taskDesc,
+				true
+			);
+		}
+		(void) pthread_mutex_unlock(&xme_hal_sched_config.taskDescriptorsMutex);
+
+		if (XME_HAL_TABLE_INVALID_ROW_HANDLE != taskHandle)
+		{
+			// Either joins the thread or, if the task is already cleaning
+			// up after itself, lets it finish before we look again
+			(void) xme_hal_sched_removeTask((xme_hal_sched_taskHandle_t) taskHandle);
+			sched_yield();
 		}
-		XME_HAL_TABLE_ITERATE_END();
 	}
-	(void) pthread_mutex_unlock(&xme_hal_sched_config.taskDescriptorsMutex);
+	while (XME_HAL_TABLE_INVALID_ROW_HANDLE != taskHandle);
 
 	// Destroy the task descriptors mutex
 	(void) pthread_mutex_destroy(&xme_hal_sched_config.taskDescriptorsMutex);
@@ -821,11 +848,15 @@ xme_hal_sched_taskProc
 			// Leave the critical section
 			(void) pthread_mutex_unlock(&taskDesc->threadMutex);
 
-			// Free resources allocated in the task descriptor
-			(void) pthread_mutex_destroy(&taskDesc->threadMutex);
-
+			// Destroy the thread mutex only while holding the task descriptors
+			// mutex, such that a concurrent xme_hal_sched_removeTask() either
+			// sees the selfCleanup flag under the thread mutex or does not find
+			// the task any more
 			(void) pthread_mutex_lock(&xme_hal_sched_config.taskDescriptorsMutex);
 			{
+				// Free resources allocated in the task descriptor
+				(void) pthread_mutex_destroy(&taskDesc->threadMutex);
+
 				(void) XME_HAL_TABLE_REMOVE_ITEM(xme_hal_sched_config.taskDescriptors, (xme_hal_table_rowHandle_t)taskHandle);
 			}
 			(void) pthread_mutex_unlock(&xme_hal_sched_config.taskDescriptorsMutex);
@@ -22,6 +22,8 @@
 /******************************************************************************/
 #include "xme/hal/include/sleep.h"
 
+#include <errno.h>
+#include <time.h>
 #include <unistd.h>
 
 /******************************************************************************/
@@ -32,3 +34,13 @@ xme_hal_sleep_sleep(xme_hal_time_timeInterval_t sleepTime)
 {
 	usleep(sleepTime/1000);
 }
+
+void
+xme_hal_sleep_sleepUntil(xme_hal_time_timeHandle_t wakeUpTime)
+{
+	// Time handles are CLOCK_MONOTONIC timestamps (see time_arch.c).
+	// Restart after signals, the deadline stays the same.
+	while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeUpTime, NULL))
+	{
+	}
+}
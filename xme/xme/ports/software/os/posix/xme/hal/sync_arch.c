@@ -24,10 +24,47 @@
 
 #include "xme/core/component.h"
 
-#include "xme/hal/include/table.h"
+#include "xme/hal/include/mem.h"
 
 #include <pthread.h>
 
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+/**
+ * \def XME_HAL_SYNC_DESCRIPTORS_PER_PAGE
+ *
+ * \brief  Number of critical section descriptors allocated at once.
+ *
+ * \note   On this platform, XME_HAL_DEFINES_MAX_CRITICAL_SECTION_DESCRIPTORS
+ *         is the page size rather than an upper bound. At most
+ *         XME_HAL_SYNC_DESCRIPTORS_PER_PAGE * XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES
+ *         critical sections can exist at the same time (1280 with the
+ *         default options). XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES is a build
+ *         option defined in xme/xme_opt.h.
+ */
+#define XME_HAL_SYNC_DESCRIPTORS_PER_PAGE ((uint32_t) XME_HAL_DEFINES_MAX_CRITICAL_SECTION_DESCRIPTORS)
+
+#if XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES < 1
+    #error XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES must be at least 1.
+#endif // #if XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES < 1
+
+#if XME_HAL_SYNC_SPIN_COUNT > 0
+/**
+ * \def XME_HAL_SYNC_CPU_RELAX
+ *
+ * \brief  Tells the processor that the calling thread is spinning, such that
+ *         it can save power and give resources to sibling hardware threads.
+ */
+#if defined(__i386__) || defined(__x86_64__)
+    #define XME_HAL_SYNC_CPU_RELAX() __asm__ __volatile__ ("pause" ::: "memory")
+#elif defined(__aarch64__)
+    #define XME_HAL_SYNC_CPU_RELAX() __asm__ __volatile__ ("yield" ::: "memory")
+#else // #if defined(__i386__) || defined(__x86_64__)
+    #define XME_HAL_SYNC_CPU_RELAX() __asm__ __volatile__ ("" ::: "memory")
+#endif // #if defined(__i386__) || defined(__x86_64__)
+#endif // #if XME_HAL_SYNC_SPIN_COUNT > 0
+
 /******************************************************************************/
 /***   Type definitions                                                     ***/
 /******************************************************************************/
@@ -39,20 +76,36 @@
 typedef struct
 {
     pthread_mutex_t mutex; ///< Mutex object for implementation of critical section.
+    uint8_t inUse; ///< Non-zero while the mutex is initialized. Written with release and read with acquire semantics.
 } xme_hal_sync_criticalSectionDescriptor_t;
 
+/**
+ * \struct xme_hal_sync_criticalSectionDescriptorPage_t
+ *
+ * \brief  Block of critical section descriptors.
+ */
+typedef struct
+{
+    xme_hal_sync_criticalSectionDescriptor_t descriptors[XME_HAL_SYNC_DESCRIPTORS_PER_PAGE]; ///< Descriptors of this page.
+} xme_hal_sync_criticalSectionDescriptorPage_t;
+
 /**
  * \typedef xme_hal_sync_configStruct_t
  *
  * \brief  Synchronization configuration structure.
+ *
+ * \details Descriptor pages are never moved or freed while the component is
+ *          initialized, so a critical section handle (the index of the
+ *          descriptor plus one) is resolved without taking any lock.
  */
 XME_COMPONENT_CONFIG_STRUCT
 (
     xme_hal_sync,
     // private
     unsigned int initializationCount; ///< Number of times this component has been initialized.
-    pthread_mutex_t criticalSectionMutex; ///< Mutex for shared access to the list of critical sections.
-    XME_HAL_TABLE(xme_hal_sync_criticalSectionDescriptor_t, criticalSections, XME_HAL_DEFINES_MAX_CRITICAL_SECTION_DESCRIPTORS); // criticalSectionHandle is an index into this table ///< List of critical sections.
+    pthread_mutex_t criticalSectionMutex; ///< Mutex serializing the creation and destruction of critical sections.
+    xme_hal_sync_criticalSectionDescriptorPage_t* pages[XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES]; ///< Descriptor pages. Written with release and read with acquire semantics.
+    uint32_t pageCount; ///< Number of allocated descriptor pages.
 );
 
 /******************************************************************************/
@@ -60,9 +113,53 @@ XME_COMPONENT_CONFIG_STRUCT
 /******************************************************************************/
 static xme_hal_sync_configStruct_t xme_hal_sync_config = { 0U }; ///< Configuration structure of this component.
 
+/******************************************************************************/
+/***   Prototypes                                                           ***/
+/******************************************************************************/
+/**
+ * \brief  Retrieves the descriptor of the given critical section without
+ *         taking any lock.
+ *
+ * \param  criticalSectionHandle Handle of the critical section.
+ *
+ * \return Returns the descriptor of the critical section or NULL if the
+ *         handle does not refer to an existing critical section.
+ */
+static xme_hal_sync_criticalSectionDescriptor_t*
+xme_hal_sync_getDescriptor
+(
+    xme_hal_sync_criticalSectionHandle_t criticalSectionHandle
+);
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
+static xme_hal_sync_criticalSectionDescriptor_t*
+xme_hal_sync_getDescriptor
+(
+    xme_hal_sync_criticalSectionHandle_t criticalSectionHandle
+)
+{
+    xme_hal_sync_criticalSectionDescriptorPage_t* page;
+    xme_hal_sync_criticalSectionDescriptor_t* criticalSectionDesc;
+    uint32_t index;
+
+    XME_CHECK(XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE != criticalSectionHandle, NULL);
+
+    index = (uint32_t) criticalSectionHandle - 1U;
+    XME_CHECK(index < XME_HAL_SYNC_DESCRIPTORS_PER_PAGE * XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES, NULL);
+
+    // Pairs with the release store publishing the page
+    page = __atomic_load_n(&xme_hal_sync_config.pages[index / XME_HAL_SYNC_DESCRIPTORS_PER_PAGE], __ATOMIC_ACQUIRE);
+    XME_CHECK(NULL != page, NULL);
+
+    // Pairs with the release store after the mutex has been initialized
+    criticalSectionDesc = &page->descriptors[index % XME_HAL_SYNC_DESCRIPTORS_PER_PAGE];
+    XME_CHECK(0U != __atomic_load_n(&criticalSectionDesc->inUse, __ATOMIC_ACQUIRE), NULL);
+
+    return criticalSectionDesc;
+}
+
 xme_status_t
 xme_hal_sync_init(void)
 {
@@ -71,9 +168,7 @@ xme_hal_sync_init(void)
         pthread_mutexattr_t mta;
         int result;
 
-        XME_ASSERT(XME_ASSERT_NO_SIDE_EFFECTS(0 == XME_HAL_TABLE_ITEM_COUNT(xme_hal_sync_config.criticalSections)));
-
-        XME_HAL_TABLE_INIT(xme_hal_sync_config.criticalSections);
+        XME_ASSERT(0U == xme_hal_sync_config.pageCount);
 
         result = pthread_mutexattr_init(&mta);
         XME_ASSERT(0 == result);
@@ -105,6 +200,8 @@ xme_hal_sync_init(void)
 void
 xme_hal_sync_fini(void)
 {
+    uint32_t i;
+
     XME_ASSERT_NORVAL(xme_hal_sync_config.initializationCount > 0U);
 
     xme_hal_sync_config.initializationCount--;
@@ -114,7 +211,12 @@ xme_hal_sync_fini(void)
         // Synchronize access to the critical sections list mutex
         pthread_mutex_lock(&xme_hal_sync_config.criticalSectionMutex);
         {
-            XME_HAL_TABLE_FINI(xme_hal_sync_config.criticalSections);
+            for (i = 0U; i < xme_hal_sync_config.pageCount; i++)
+            {
+                xme_hal_mem_free(xme_hal_sync_config.pages[i]);
+                xme_hal_sync_config.pages[i] = NULL;
+            }
+            xme_hal_sync_config.pageCount = 0U;
         }
         pthread_mutex_unlock(&xme_hal_sync_config.criticalSectionMutex);
 
@@ -126,65 +228,54 @@ xme_hal_sync_fini(void)
 xme_hal_sync_criticalSectionHandle_t
 xme_hal_sync_createCriticalSection(void)
 {
-    xme_hal_sync_criticalSectionHandle_t newCriticalSectionHandle;
-    xme_hal_sync_criticalSectionDescriptor_t* criticalSectionDesc;
-    pthread_mutexattr_t mta;
-    int result;
+    xme_hal_sync_criticalSectionHandle_t newCriticalSectionHandle = XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE;
+    xme_hal_sync_criticalSectionDescriptorPage_t* page;
+    xme_hal_sync_criticalSectionDescriptor_t* criticalSectionDesc = NULL;
+    uint32_t index = 0U;
 
     XME_ASSERT_RVAL(xme_hal_sync_config.initializationCount > 0U, XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE);
 
     // Synchronize access to the critical sections list mutex
     pthread_mutex_lock(&xme_hal_sync_config.criticalSectionMutex);
     {
-        // Allocate a unique critical section handle
-        newCriticalSectionHandle = (xme_hal_sync_criticalSectionHandle_t) XME_HAL_TABLE_ADD_ITEM(xme_hal_sync_config.criticalSections);
-    }
-    pthread_mutex_unlock(&xme_hal_sync_config.criticalSectionMutex);
-
-    // Ensure that the handle is valid
-    XME_CHECK
-    (
-        XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE != newCriticalSectionHandle,
-        XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE
-    );
-
-    // Initialize the critical section descriptor
-    criticalSectionDesc = (xme_hal_sync_criticalSectionDescriptor_t*) XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_hal_sync_config.criticalSections, newCriticalSectionHandle);
-
-    XME_ASSERT_RVAL(NULL != criticalSectionDesc, XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE);
-
-    result = pthread_mutexattr_init(&mta);
-    XME_ASSERT_RVAL(0 == result, XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE);
-
-    // Locking this mutex twice from the same thread is allowed
-    // and should not block
-    result = pthread_mutexattr_settype(&mta, PTHREAD_MUTEX_RECURSIVE);
-    XME_ASSERT_RVAL(0 == result, XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE);
-
-    // TODO Fix the use of PTHREAD_MUTEX_RECURSIVE.
-    // Instead of using mta as the second argument thereby setting the property of the mutes as RECURSIVE
-    // it is being set to NULL which is the previous behviour (Issue #2345)
-    // Setting it to RECURSIVE execution manager goes into deadlock.
-    // It needs further investigation. A seperate ticket (Issue #3503) has been created for the same.
-    XME_CHECK_REC
-    (
-        0 == pthread_mutex_init(&criticalSectionDesc->mutex, NULL),
-        XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE,
+        // Reuse the first unused descriptor
+        for (index = 0U; index < xme_hal_sync_config.pageCount * XME_HAL_SYNC_DESCRIPTORS_PER_PAGE; index++)
         {
-            result = pthread_mutexattr_destroy(&mta);
-            XME_ASSERT_RVAL(0 == result, XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE);
+            page = xme_hal_sync_config.pages[index / XME_HAL_SYNC_DESCRIPTORS_PER_PAGE];
+            if (0U == page->descriptors[index % XME_HAL_SYNC_DESCRIPTORS_PER_PAGE].inUse)
+            {
+                criticalSectionDesc = &page->descriptors[index % XME_HAL_SYNC_DESCRIPTORS_PER_PAGE];
+                break;
+            }
+        }
 
-            //Remove the handle because unable to set the desired property
-            pthread_mutex_lock(&xme_hal_sync_config.criticalSectionMutex);
+        // Otherwise allocate a new page of descriptors
+        if (NULL == criticalSectionDesc && xme_hal_sync_config.pageCount < XME_HAL_SYNC_MAX_DESCRIPTOR_PAGES)
+        {
+            page = (xme_hal_sync_criticalSectionDescriptorPage_t*) xme_hal_mem_alloc(sizeof(xme_hal_sync_criticalSectionDescriptorPage_t));
+            if (NULL != page)
             {
-                XME_HAL_TABLE_REMOVE_ITEM(xme_hal_sync_config.criticalSections, (xme_hal_table_rowHandle_t)newCriticalSectionHandle);
+                // Pairs with the acquire load in xme_hal_sync_getDescriptor()
+                __atomic_store_n(&xme_hal_sync_config.pages[xme_hal_sync_config.pageCount], page, __ATOMIC_RELEASE);
+                xme_hal_sync_config.pageCount++;
+                criticalSectionDesc = &page->descriptors[0];
             }
-            pthread_mutex_unlock(&xme_hal_sync_config.criticalSectionMutex);
         }
-    );
 
-    result = pthread_mutexattr_destroy(&mta);
-    XME_ASSERT_RVAL(0 == result, XME_HAL_SYNC_INVALID_CRITICAL_SECTION_HANDLE);
+        // TODO Fix the use of PTHREAD_MUTEX_RECURSIVE.
+        // The mutex uses the default attributes, which is the previous
+        // behviour (Issue #2345). With PTHREAD_MUTEX_RECURSIVE, the
+        // execution manager goes into deadlock. It needs further
+        // investigation. A seperate ticket (Issue #3503) has been created
+        // for the same.
+        if (NULL != criticalSectionDesc && 0 == pthread_mutex_init(&criticalSectionDesc->mutex, NULL))
+        {
+            // Publish the descriptor only after the mutex has been initialized
+            __atomic_store_n(&criticalSectionDesc->inUse, 1U, __ATOMIC_RELEASE);
+            newCriticalSectionHandle = (xme_hal_sync_criticalSectionHandle_t) (index + 1U);
+        }
+    }
+    pthread_mutex_unlock(&xme_hal_sync_config.criticalSectionMutex);
 
     return newCriticalSectionHandle;
 }
@@ -204,7 +295,7 @@ xme_hal_sync_destroyCriticalSection
     pthread_mutex_lock(&xme_hal_sync_config.criticalSectionMutex);
     {
         // Retrieve the critical section descriptor
-        criticalSectionDesc = (xme_hal_sync_criticalSectionDescriptor_t*)XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_hal_sync_config.criticalSections, criticalSectionHandle);
+        criticalSectionDesc = xme_hal_sync_getDescriptor(criticalSectionHandle);
 
         XME_CHECK_REC
         (
@@ -225,11 +316,11 @@ xme_hal_sync_destroyCriticalSection
         }
 #endif // #if defined(DEBUG) && !defined(DOXYGEN)
 
+        __atomic_store_n(&criticalSectionDesc->inUse, 0U, __ATOMIC_RELEASE);
+
         // We assume that no other thread is locking the same mutex.
         // So we do not check the return value of the destroy call.
         pthread_mutex_destroy(&criticalSectionDesc->mutex);
-
-        XME_HAL_TABLE_REMOVE_ITEM(xme_hal_sync_config.criticalSections, (xme_hal_table_rowHandle_t)criticalSectionHandle);
     }
     pthread_mutex_unlock(&xme_hal_sync_config.criticalSectionMutex);
 
@@ -245,19 +336,30 @@ xme_hal_sync_enterCriticalSection
 )
 {
     xme_hal_sync_criticalSectionDescriptor_t* criticalSectionDesc;
+#if XME_HAL_SYNC_SPIN_COUNT > 0
+    unsigned int spin;
+#endif // #if XME_HAL_SYNC_SPIN_COUNT > 0
 
     XME_ASSERT_NORVAL(xme_hal_sync_config.initializationCount > 0U);
 
-    // Synchronize access to the critical sections list mutex
-    pthread_mutex_lock(&xme_hal_sync_config.criticalSectionMutex);
-    {
-        // Retrieve the critical section descriptor
-        criticalSectionDesc = (xme_hal_sync_criticalSectionDescriptor_t*) XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_hal_sync_config.criticalSections, criticalSectionHandle);
-    }
-    pthread_mutex_unlock(&xme_hal_sync_config.criticalSectionMutex);
+    criticalSectionDesc = xme_hal_sync_getDescriptor(criticalSectionHandle);
 
     XME_ASSERT_NORVAL(NULL != criticalSectionDesc);
 
+#if XME_HAL_SYNC_SPIN_COUNT > 0
+    // Critical sections are usually short, so spinning for a while avoids
+    // the cost of putting the thread to sleep and waking it up again
+    for (spin = 0U; spin < XME_HAL_SYNC_SPIN_COUNT; spin++)
+    {
+        if (0 == pthread_mutex_trylock(&criticalSectionDesc->mutex))
+        {
+            return;
+        }
+
+        XME_HAL_SYNC_CPU_RELAX();
+    }
+#endif // #if XME_HAL_SYNC_SPIN_COUNT > 0
+
     pthread_mutex_lock(&criticalSectionDesc->mutex);
 }
 
@@ -271,13 +373,7 @@ xme_hal_sync_tryEnterCriticalSection
 
     XME_ASSERT(xme_hal_sync_config.initializationCount > 0U);
 
-    // Synchronize access to the critical sections list mutex
-    pthread_mutex_lock(&xme_hal_sync_config.criticalSectionMutex);
-    {
-        // Retrieve the critical section descriptor
-        criticalSectionDesc = (xme_hal_sync_criticalSectionDescriptor_t*) XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_hal_sync_config.criticalSections, criticalSectionHandle);
-    }
-    pthread_mutex_unlock(&xme_hal_sync_config.criticalSectionMutex);
+    criticalSectionDesc = xme_hal_sync_getDescriptor(criticalSectionHandle);
 
     XME_ASSERT(NULL != criticalSectionDesc);
 
@@ -294,13 +390,7 @@ xme_hal_sync_leaveCriticalSection
 
     XME_ASSERT_NORVAL(xme_hal_sync_config.initializationCount > 0U);
 
-    // Synchronize access to the critical sections list mutex
-    pthread_mutex_lock(&xme_hal_sync_config.criticalSectionMutex);
-    {
-        // Retrieve the critical section descriptor
-        criticalSectionDesc = (xme_hal_sync_criticalSectionDescriptor_t*) XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_hal_sync_config.criticalSections, criticalSectionHandle);
-    }
-    pthread_mutex_unlock(&xme_hal_sync_config.criticalSectionMutex);
+    criticalSectionDesc = xme_hal_sync_getDescriptor(criticalSectionHandle);
 
     XME_ASSERT_NORVAL(NULL != criticalSectionDesc);
 
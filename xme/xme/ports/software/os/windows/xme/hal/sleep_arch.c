@@ -35,3 +35,16 @@ xme_hal_sleep_sleep(xme_hal_time_timeInterval_t sleepTime)
     // Windows natively offers sleeping at millisecond granularity only
     Sleep((DWORD)xme_hal_time_timeIntervalInMilliseconds(sleepTime));
 }
+
+void
+xme_hal_sleep_sleepUntil(xme_hal_time_timeHandle_t wakeUpTime)
+{
+    xme_hal_time_timeHandle_t now = xme_hal_time_getCurrentTime();
+
+    // Windows offers no absolute sleep, so convert to a relative sleep as
+    // late as possible
+    if (xme_hal_time_compareTime(now, wakeUpTime) < 0)
+    {
+        xme_hal_sleep_sleep(xme_hal_time_getTimeIntervalBetween(now, wakeUpTime));
+    }
+}
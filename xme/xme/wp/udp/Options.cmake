@@ -16,5 +16,8 @@
 #
 
 xme_build_option(XME_WP_UDP_SEND_CONFIGURATIONTABLE_SIZE 100 "xme/xme_opt.h" "Maximum number of configuration entries for the udp send waypoint")
+xme_build_option(XME_WP_UDP_SEND_BATCH_SIZE 32 "xme/xme_opt.h" "Maximum number of datagrams the udp send waypoint queues when batching is enabled")
 xme_build_option(XME_WP_UDP_RECEIVE_CONFIGURATIONTABLE_SIZE 100 "xme/xme_opt.h" "Maximum number of configuration entries for the udp receive waypoint")
+xme_build_option(XME_WP_UDP_RECEIVE_BATCH_SIZE 32 "xme/xme_opt.h" "Maximum number of datagrams the udp receive waypoint fetches with one call to the operating system when batching is enabled")
+xme_build_option(XME_WP_UDP_RECEIVE_KEYINDEX_SIZE 64 "xme/xme_opt.h" "Number of buckets of the hash index of the udp receive waypoint configurations by key")
 xme_build_option(XME_WP_UDP_HEADER_KEY_LENGTH 4 "xme/xme_opt.h" "Maximum length of connecting KEY beteween udpSend and udpRecv, stored in config table of both WayPoints and is passed via packet header")
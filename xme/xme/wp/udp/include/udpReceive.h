@@ -41,6 +41,23 @@
 
 #include <stdint.h>
 
+/******************************************************************************/
+/***   Type definitions                                                     ***/
+/******************************************************************************/
+/**
+ * \struct xme_wp_udp_udpReceive_socketStatistics_t
+ *
+ * \brief  Statistics of the datagrams received on one port.
+ */
+typedef struct
+{
+    uint32_t received; ///< Number of datagrams received from the operating system.
+    uint32_t discarded; ///< Number of received datagrams discarded because of an invalid header, an unknown key or a wrong size.
+    uint32_t dropped; ///< Number of datagrams the operating system dropped because the receive queue of the socket was full, if the platform reports it.
+    uint16_t lastQueueDepth; ///< Number of datagrams received by the last run in batching mode.
+    uint16_t maxQueueDepth; ///< Largest number of datagrams received by one run in batching mode.
+} xme_wp_udp_udpReceive_socketStatistics_t;
+
 /******************************************************************************/
 /***   Prototypes                                                           ***/
 /******************************************************************************/
@@ -63,6 +80,10 @@ xme_wp_udp_udpReceive_init(void);
  *         Executing this function will receive the topic data from the Network
  *         of the associated configuration and output it on the dataId port. 
  *         The required network configuration is chosen from the input parameter
+ *         A datagram with the key of another configuration is written to
+ *         the output port of that configuration.
+ *         If batching is enabled, all datagrams queued on the socket are
+ *         received, see xme_wp_udp_udpReceive_setBatching().
  *
  * \param  instanceId Id of the configuration for which to execute the waypoint, as returned by
  *         xme_wp_udpReceive_addConfig.
@@ -80,6 +101,44 @@ xme_wp_udp_udpReceive_run
     xme_wp_waypoint_instanceId_t instanceId
 );
 
+/**
+ * \brief  Enables or disables batching of the datagrams of this waypoint.
+ *
+ * \details When batching is enabled, xme_wp_udp_udpReceive_run() receives
+ *          all datagrams queued on the socket of the configuration with as
+ *          few calls to the operating system as possible, in chunks of
+ *          XME_WP_UDP_RECEIVE_BATCH_SIZE datagrams, and writes each of them
+ *          to the output port of the configuration with its key.
+ *          The run then returns XME_STATUS_SUCCESS if at least one sample
+ *          has been written.
+ *
+ * \param[in] enabled Whether to batch the datagrams.
+ *
+ * \retval XME_STATUS_SUCCESS if batching has been changed successfully.
+ */
+xme_status_t
+xme_wp_udp_udpReceive_setBatching
+(
+    bool enabled
+);
+
+/**
+ * \brief  Returns the statistics of the datagrams received on the given port.
+ *
+ * \param[in] port Port of at least one configuration of this waypoint.
+ * \param[out] statistics Address where to store the statistics.
+ *
+ * \retval XME_STATUS_SUCCESS if the statistics have been returned.
+ * \retval XME_STATUS_INVALID_PARAMETER if statistics is NULL.
+ * \retval XME_STATUS_NOT_FOUND if no socket has been opened for the port.
+ */
+xme_status_t
+xme_wp_udp_udpReceive_getSocketStatistics
+(
+    uint16_t port,
+    xme_wp_udp_udpReceive_socketStatistics_t* statistics
+);
+
 /**
  * \brief  Check if the given configuration exists for this waypoint.
  *
@@ -62,7 +62,9 @@ xme_wp_udp_udpSend_init(void);
  *         instanceId, via xme_wp_udp_udpSend_addConfig.
  *         Executing this function will get the topic data from the inputPort
  *         of the associated configuration and output it on the network. 
- *         The required network configuration is chosen from the input parameter
+ *         The required network configuration is chosen from the input parameter.
+ *         If batching is enabled, the datagram is only queued, see
+ *         xme_wp_udp_udpSend_setBatching().
  *
  * \param[in]  instanceId Id of the configuration for which to execute the waypoint, as returned by
  *         xme_wp_udpSend_addConfig.
@@ -79,6 +81,40 @@ xme_wp_udp_udpSend_run
     xme_wp_waypoint_instanceId_t instanceId
 );
 
+/**
+ * \brief  Enables or disables batching of the datagrams of this waypoint.
+ *
+ * \details When batching is enabled, xme_wp_udp_udpSend_run() only prepares
+ *          the datagram in the buffer of the configuration and queues it.
+ *          The queued datagrams of all configurations are sent with as few
+ *          calls to the operating system as possible by
+ *          xme_wp_udp_udpSend_flush(), which should be called once per cycle.
+ *          A datagram is sent earlier when its buffer is needed again or when
+ *          XME_WP_UDP_SEND_BATCH_SIZE datagrams are queued.
+ *          Disabling batching sends all queued datagrams.
+ *
+ * \param[in] enabled Whether to batch the datagrams.
+ *
+ * \retval XME_STATUS_SUCCESS if batching has been changed successfully.
+ * \retval XME_STATUS_INTERNAL_ERROR if queued datagrams could not be sent.
+ */
+xme_status_t
+xme_wp_udp_udpSend_setBatching
+(
+    bool enabled
+);
+
+/**
+ * \brief  Sends all datagrams queued by xme_wp_udp_udpSend_run() while
+ *         batching is enabled.
+ *
+ * \retval XME_STATUS_SUCCESS if all queued datagrams have been sent.
+ * \retval XME_STATUS_INTERNAL_ERROR if some datagrams could not be sent.
+ *         They are discarded.
+ */
+xme_status_t
+xme_wp_udp_udpSend_flush(void);
+
 /**
  * \brief  Check if the given configuration exists for this waypoint.
  *
@@ -119,6 +155,8 @@ xme_wp_udp_udpSend_getConfig
  * \param[in] isBroadcast If this port is for broadcast.
  *
  * \retval XME_STATUS_SUCCESS if the configuration has been added successfully.
+ * \retval XME_STATUS_INVALID_PARAMETER if the buffer is too small or the
+ *         destination could not be resolved.
  * \retval XME_STATUS_OUT_OF_RESOURCES if the configuration could not be added due
  *         to resource constraints (e.g. not enough memory to store entry).
  */
@@ -31,25 +31,39 @@
 
 #include <inttypes.h>
 
+/******************************************************************************/
+/***   Defines                                                              ***/
+/******************************************************************************/
+/**
+ * \def UDP_RECEIVE_MAX_BATCHES_PER_RUN
+ *
+ * \brief Maximum number of times a run in batching mode fetches
+ *        XME_WP_UDP_RECEIVE_BATCH_SIZE datagrams, so that a flooded socket
+ *        does not block the run.
+ */
+#define UDP_RECEIVE_MAX_BATCHES_PER_RUN 8U
+
+/**
+ * \def UDP_RECEIVE_KEYINDEX_BUCKET
+ *
+ * \brief Returns the bucket of the given packet header key in udpRecvKeyIndex.
+ */
+#define UDP_RECEIVE_KEYINDEX_BUCKET(key) \
+    ((uint16_t)(hashKey(key) % ((uint32_t)XME_WP_UDP_RECEIVE_KEYINDEX_SIZE)))
+
 /******************************************************************************/
 /***   Type definitions                                                     ***/
 /******************************************************************************/
 /**
- * \struct udpRecvConfigItem_t
+ * \struct udpRecvAttributeItem_t
  *
- * \brief  Structure for storing a configuration for this waypoint.
+ * \brief  Attribute contained in the payload, in the order of the payload.
  */
 typedef struct
 {
-    xme_core_dataManager_dataPacketId_t dataId; ///< Port to write the data to, which is received on the UDP socket.
-    uint16_t sizeOfData; ///< Size of the data.
-    uint16_t sizeOfTopicAndAttributes; ///< Size of topic data plus size for all attributes.
-    xme_core_topic_t topic; ///< Topic associated to this port.
-    void *buffer; ///< Buffer passed for reading the data from the network.
-    void *key; ///< The key which is added in the packet header to correctly identify the intended receipent.
-    uint16_t port; ///< Port on the given hostname for the connection.
-    xme_hal_net_socketHandle_t socketHandle; ///< The opened socket descriptor where data is received.
-} udpRecvConfigItem_t;
+    xme_core_attribute_key_t key; ///< Key of the attribute.
+    uint16_t size; ///< Size of the attribute in the payload.
+} udpRecvAttributeItem_t;
 
 /**
  * \struct udpRecvSocketConnection_t
@@ -69,8 +83,30 @@ typedef struct
     uint16_t port; ///< Port on the given hostname for the connection.
     xme_hal_net_socketHandle_t socketHandle; ///< The opened socket descriptor where data is received.
     uint8_t count; ///< count of Receive Configurations using this socketHandle
+    xme_wp_udp_udpReceive_socketStatistics_t statistics; ///< Statistics of the datagrams received on this socket.
 } udpRecvSocketConnection_t;
 
+/**
+ * \struct udpRecvConfigItem_t
+ *
+ * \brief  Structure for storing a configuration for this waypoint.
+ */
+typedef struct udpRecvConfigItem_s
+{
+    xme_core_dataManager_dataPacketId_t dataId; ///< Port to write the data to, which is received on the UDP socket.
+    uint16_t sizeOfData; ///< Size of the data.
+    uint16_t sizeOfTopicAndAttributes; ///< Size of topic data plus size for all attributes.
+    xme_core_topic_t topic; ///< Topic associated to this port.
+    void *buffer; ///< Buffer passed for reading the data from the network.
+    void *key; ///< The key which is added in the packet header to correctly identify the intended receipent.
+    uint16_t port; ///< Port on the given hostname for the connection.
+    xme_hal_net_socketHandle_t socketHandle; ///< The opened socket descriptor where data is received.
+    udpRecvSocketConnection_t* socketConnection; ///< Entry of the socket in the socket table.
+    uint8_t attributeCount; ///< Number of attributes contained in the payload.
+    udpRecvAttributeItem_t* attributes; ///< Attributes contained in the payload, resolved from the attribute descriptor list of the topic.
+    struct udpRecvConfigItem_s* nextByKey; ///< Next configuration in the same bucket of udpRecvKeyIndex.
+} udpRecvConfigItem_t;
+
 /******************************************************************************/
 /***   Variables                                                            ***/
 /******************************************************************************/
@@ -93,6 +129,94 @@ static XME_HAL_TABLE(udpRecvSocketConnection_t, xme_wp_udp_udpRecvSocketConnecti
 static xme_hal_table_rowHandle_t udpRecvIndex = XME_HAL_TABLE_INVALID_ROW_HANDLE; ///< index to the entry in config table with maximum buffer size
           ///< This will not work in multiple instances/multi threaded approach
 
+/**
+ * \brief  Configurations hashed by the key in the packet header.
+ *
+ * \details Each bucket is the head of a chain of configurations whose key
+ *          maps to that bucket, linked through the nextByKey member.
+ *          Configurations with the same key keep the order in which they
+ *          were added.
+ */
+static udpRecvConfigItem_t* udpRecvKeyIndex[XME_WP_UDP_RECEIVE_KEYINDEX_SIZE];
+
+/**
+ * \struct xme_wp_udp_udpRecvBatch
+ * \brief  Buffers for receiving several datagrams per run when batching is enabled.
+ */
+static struct
+{
+    bool enabled; ///< Whether xme_wp_udp_udpReceive_run() receives all queued datagrams.
+    uint8_t* storage; ///< Memory of the buffers.
+    uint16_t datagramSize; ///< Size of each buffer.
+    xme_hal_net_receivedDatagram_t datagrams[XME_WP_UDP_RECEIVE_BATCH_SIZE]; ///< Buffers to receive the datagrams in.
+} xme_wp_udp_udpRecvBatch;
+
+/******************************************************************************/
+/***   Prototypes                                                           ***/
+/******************************************************************************/
+/**
+ * \brief  Hashes a packet header key.
+ *
+ * \param[in] key Key of XME_WP_UDP_HEADER_KEY_LENGTH bytes.
+ *
+ * \return Hash value of the key.
+ */
+static uint32_t
+hashKey
+(
+    const void* key
+);
+
+/**
+ * \brief  Finds the configuration for the given packet header key.
+ *
+ * \details Prefers a configuration that receives on the given socket.
+ *
+ * \param[in] key Key of the received packet.
+ * \param[in] socketHandle Socket the packet has been received on.
+ *
+ * \return The configuration or NULL if no configuration uses the key.
+ */
+static udpRecvConfigItem_t*
+findConfigurationByKey
+(
+    const void* key,
+    xme_hal_net_socketHandle_t socketHandle
+);
+
+/**
+ * \brief  Writes a received sample to the output port of the given configuration.
+ *
+ * \param[in] configurationItem Configuration the sample belongs to.
+ * \param[in] samplePayload Payload of the sample.
+ *
+ * \retval XME_STATUS_SUCCESS if the sample has been written.
+ * \retval XME_STATUS_INTERNAL_ERROR if writing to the output port failed.
+ */
+static xme_status_t
+writeSample
+(
+    udpRecvConfigItem_t* configurationItem,
+    void* samplePayload
+);
+
+/**
+ * \brief  Receives all datagrams queued on the socket of the given
+ *         configuration and writes them to the configurations of their keys.
+ *
+ * \param[in] configurationItem Configuration whose socket to receive from.
+ * \param[in] maxDatagramSize Size of the largest packet of all configurations.
+ *
+ * \retval XME_STATUS_SUCCESS if at least one sample has been written.
+ * \retval XME_STATUS_INTERNAL_ERROR if no sample has been written.
+ */
+static xme_status_t
+receiveBatch
+(
+    udpRecvConfigItem_t* configurationItem,
+    uint16_t maxDatagramSize
+);
+
 /******************************************************************************/
 /***   Implementation                                                       ***/
 /******************************************************************************/
@@ -113,6 +237,12 @@ xme_wp_udp_udpReceive_init(void)
 
     udpRecvIndex = XME_HAL_TABLE_INVALID_ROW_HANDLE;
 
+    (void) xme_hal_mem_set(udpRecvKeyIndex, 0, sizeof(udpRecvKeyIndex));
+
+    xme_wp_udp_udpRecvBatch.enabled = false;
+    xme_wp_udp_udpRecvBatch.storage = NULL;
+    xme_wp_udp_udpRecvBatch.datagramSize = 0U;
+
     return XME_STATUS_SUCCESS;
 }
 
@@ -122,12 +252,9 @@ xme_wp_udp_udpReceive_run
     xme_wp_waypoint_instanceId_t instanceId
 )
 {
-    xme_status_t status;
     udpRecvConfigItem_t *configurationItem;
     udpRecvConfigItem_t *configurationItemMaxBuffer;
-    xme_hal_table_rowHandle_t configItemHandle = XME_HAL_TABLE_INVALID_ROW_HANDLE;
     uint16_t sampleSize;
-    void* samplePayload;
     xme_com_packet_sample_header_t* sampleHeader;
 
     xme_hal_sync_enterCriticalSection(xme_wp_udp_udpRecvConfigTable.criticalSectionHandle);
@@ -142,6 +269,11 @@ xme_wp_udp_udpReceive_run
         XME_STATUS_INVALID_HANDLE
     );
 
+    if (xme_wp_udp_udpRecvBatch.enabled)
+    {
+        return receiveBatch(configurationItem, configurationItemMaxBuffer->sizeOfTopicAndAttributes + (uint16_t) sizeof(xme_com_packet_sample_header_t));
+    }
+
     // Read the data on the network and check if it contains valid packet header
     sampleSize = xme_hal_net_readSocket
     (
@@ -155,6 +287,8 @@ xme_wp_udp_udpReceive_run
         XME_STATUS_INTERNAL_ERROR
     );
 
+    configurationItem->socketConnection->statistics.received++;
+
     //Get the header from the packet
     sampleHeader = (xme_com_packet_sample_header_t*)(configurationItemMaxBuffer->buffer);
     if (!XME_COM_PACKET_VALID(*sampleHeader))
@@ -164,6 +298,7 @@ xme_wp_udp_udpReceive_run
             XME_LOG_DEBUG, "Discarding packet with invalid header (magic=0x%02X, ver=0x%02X, type=0x%02X)\n",
             sampleHeader->packetHeader.magic, sampleHeader->packetHeader.version, sampleHeader->packetHeader.packetType
         );
+        configurationItem->socketConnection->statistics.discarded++;
 
         return XME_STATUS_INTERNAL_ERROR;
     }
@@ -173,16 +308,11 @@ xme_wp_udp_udpReceive_run
         //OK we were expecting data for the given instanceId but seems like the data for some other key
         //came first.
         //Remember we have currently two ports, one for BROADCAST listening and other regular
-        //So iterate over the table to locate the right configItem
+        //So look up the right configItem by the key
         //And if it still does not exist then we flag an error
-        udpRecvConfigItem_t* configurationItemTemp = NULL;
+        udpRecvConfigItem_t* configurationItemTemp = findConfigurationByKey(sampleHeader->key, configurationItem->socketHandle);
 
-        XME_HAL_TABLE_GET_NEXT(xme_wp_udp_udpRecvConfigTable.table,
-                                    xme_hal_table_rowHandle_t, configItemHandle,
-                                    udpRecvConfigItem_t, configurationItemTemp,
-                                    (xme_hal_mem_compare((sampleHeader->key),configurationItemTemp->key, XME_WP_UDP_HEADER_KEY_LENGTH)==0));
-    
-        if (XME_HAL_TABLE_INVALID_ROW_HANDLE == configItemHandle)
+        if (NULL == configurationItemTemp)
         {
             uint8_t i;
 
@@ -194,27 +324,81 @@ xme_wp_udp_udpReceive_run
             for(i = 0;i < XME_WP_UDP_HEADER_KEY_LENGTH; i++)
                 XME_LOG(XME_LOG_DEBUG, "%" PRIu8 ,sampleHeader->key[i]);
             XME_LOG(XME_LOG_DEBUG, "\n");
+            configurationItem->socketConnection->statistics.discarded++;
 
             return XME_STATUS_INTERNAL_ERROR;
         }
 
         configurationItem = configurationItemTemp;
+    }
 
-        XME_CHECK
-        (
-            NULL != configurationItem,
-            XME_STATUS_INVALID_HANDLE
-        );
+    //Get the paylod from the packet and copy it out to the dataId of the found configuration
+    return writeSample(configurationItem, XME_COM_PACKET_SAMPLE_PAYLOAD( configurationItemMaxBuffer->buffer ));
+}
+
+static uint32_t
+hashKey
+(
+    const void* key
+)
+{
+    // FNV-1a
+    const uint8_t* bytes = (const uint8_t*) key;
+    uint32_t hash = 2166136261U;
+    uint8_t i;
+
+    for (i = 0; i < XME_WP_UDP_HEADER_KEY_LENGTH; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619U;
+    }
+
+    return hash;
+}
+
+static udpRecvConfigItem_t*
+findConfigurationByKey
+(
+    const void* key,
+    xme_hal_net_socketHandle_t socketHandle
+)
+{
+    udpRecvConfigItem_t* configurationItem;
+    udpRecvConfigItem_t* firstMatch = NULL;
+
+    for (configurationItem = udpRecvKeyIndex[UDP_RECEIVE_KEYINDEX_BUCKET(key)]; NULL != configurationItem; configurationItem = configurationItem->nextByKey)
+    {
+        if (xme_hal_mem_compare(key, configurationItem->key, XME_WP_UDP_HEADER_KEY_LENGTH) == 0)
+        {
+            if (configurationItem->socketHandle == socketHandle)
+            {
+                return configurationItem;
+            }
+
+            if (NULL == firstMatch)
+            {
+                firstMatch = configurationItem;
+            }
+        }
     }
 
-    //Get the paylod from the packet
-    samplePayload = XME_COM_PACKET_SAMPLE_PAYLOAD( configurationItemMaxBuffer->buffer );
+    return firstMatch;
+}
+
+static xme_status_t
+writeSample
+(
+    udpRecvConfigItem_t* configurationItem,
+    void* samplePayload
+)
+{
+    xme_status_t status;
+    uint8_t i;
+    uint8_t* payloadPtr = ((uint8_t*)samplePayload) + configurationItem->sizeOfData;
 
     // Indicate we are going to start the write operation.
     status = xme_core_dataHandler_startWriteOperation(configurationItem->dataId);
     XME_CHECK(XME_STATUS_SUCCESS == status, XME_STATUS_INTERNAL_ERROR);
 
-    // And copy it out to the dataId of the found configuration
     status = xme_core_dataHandler_writeData(configurationItem->dataId,
                                             samplePayload,
                                             configurationItem->sizeOfData);
@@ -222,34 +406,23 @@ xme_wp_udp_udpReceive_run
     XME_CHECK(XME_STATUS_SUCCESS == status, XME_STATUS_INTERNAL_ERROR);
 
     // Get all attributes from payload and write them to the output port
+    for (i = 0; i < configurationItem->attributeCount; i++)
     {
-        xme_core_attribute_descriptor_list_t attributeDescriptorList;
-        uint8_t i;
-        uint8_t* payloadPtr = ((uint8_t*)samplePayload) + configurationItem->sizeOfData;
+        status = xme_core_dataHandler_writeAttribute
+        (
+            configurationItem->dataId,
+            configurationItem->attributes[i].key,
+            payloadPtr,
+            configurationItem->attributes[i].size
+        );
 
-        status = xme_core_directory_attribute_getAttributeDescriptorList(configurationItem->topic, &attributeDescriptorList);
+        payloadPtr += configurationItem->attributes[i].size;
+        
+        XME_ASSERT(status == XME_STATUS_SUCCESS);
 
-        if (XME_STATUS_SUCCESS == status) // When there is no attribute desciptor list for the given topic, then simply do nothing
+        if (status != XME_STATUS_SUCCESS)
         {
-            for (i = 0; i < attributeDescriptorList.length; i++)
-            {
-                status = xme_core_dataHandler_writeAttribute
-                (
-                    configurationItem->dataId,
-                    attributeDescriptorList.element[i].key,
-                    payloadPtr,
-                    attributeDescriptorList.element[i].size
-                );
-
-                payloadPtr += attributeDescriptorList.element[i].size;
-                
-                XME_ASSERT(status == XME_STATUS_SUCCESS);
-
-                if (status != XME_STATUS_SUCCESS)
-                {
-                    XME_LOG(XME_LOG_WARNING, "Writing of attribute '%" PRIu32 "' failed with status %" PRIu32 ".", attributeDescriptorList.element[i].key, status);
-                }
-            }
+            XME_LOG(XME_LOG_WARNING, "Writing of attribute '%" PRIu32 "' failed with status %" PRIu32 ".", configurationItem->attributes[i].key, status);
         }
     }
 
@@ -259,6 +432,133 @@ xme_wp_udp_udpReceive_run
     return XME_STATUS_SUCCESS;
 }
 
+static xme_status_t
+receiveBatch
+(
+    udpRecvConfigItem_t* configurationItem,
+    uint16_t maxDatagramSize
+)
+{
+    xme_wp_udp_udpReceive_socketStatistics_t* statistics = &configurationItem->socketConnection->statistics;
+    uint16_t written = 0U;
+    uint16_t queueDepth = 0U;
+    uint16_t received;
+    uint8_t batch;
+    uint16_t i;
+
+    // (Re)allocate the buffers when a configuration with larger packets has been added
+    if (xme_wp_udp_udpRecvBatch.datagramSize < maxDatagramSize)
+    {
+        uint8_t* storage = (uint8_t*) xme_hal_mem_realloc(xme_wp_udp_udpRecvBatch.storage, (size_t) XME_WP_UDP_RECEIVE_BATCH_SIZE * maxDatagramSize);
+        XME_CHECK(NULL != storage, XME_STATUS_INTERNAL_ERROR);
+
+        xme_wp_udp_udpRecvBatch.storage = storage;
+        xme_wp_udp_udpRecvBatch.datagramSize = maxDatagramSize;
+        for (i = 0U; i < XME_WP_UDP_RECEIVE_BATCH_SIZE; i++)
+        {
+            xme_wp_udp_udpRecvBatch.datagrams[i].buffer = &storage[(size_t) i * maxDatagramSize];
+            xme_wp_udp_udpRecvBatch.datagrams[i].size = maxDatagramSize;
+        }
+    }
+
+    batch = 0U;
+    do
+    {
+        received = xme_hal_net_readDatagrams
+        (
+            configurationItem->socketHandle,
+            xme_wp_udp_udpRecvBatch.datagrams,
+            XME_WP_UDP_RECEIVE_BATCH_SIZE,
+            &statistics->dropped
+        );
+        queueDepth += received;
+
+        for (i = 0U; i < received; i++)
+        {
+            xme_hal_net_receivedDatagram_t* datagram = &xme_wp_udp_udpRecvBatch.datagrams[i];
+            xme_com_packet_sample_header_t* sampleHeader = (xme_com_packet_sample_header_t*) datagram->buffer;
+            udpRecvConfigItem_t* sampleConfigurationItem;
+
+            statistics->received++;
+
+            if (datagram->count <= (uint16_t) sizeof(xme_com_packet_sample_header_t) || !XME_COM_PACKET_VALID(*sampleHeader))
+            {
+                XME_LOG(XME_LOG_DEBUG, "Discarding packet with invalid header\n");
+                statistics->discarded++;
+                continue;
+            }
+
+            sampleConfigurationItem = (xme_hal_mem_compare(sampleHeader->key, configurationItem->key, XME_WP_UDP_HEADER_KEY_LENGTH) == 0) ?
+                configurationItem : findConfigurationByKey(sampleHeader->key, configurationItem->socketHandle);
+
+            if (NULL == sampleConfigurationItem || datagram->count < sampleConfigurationItem->sizeOfTopicAndAttributes + (uint16_t) sizeof(xme_com_packet_sample_header_t))
+            {
+                XME_LOG(XME_LOG_DEBUG, "Discarding packet with invalid key or size\n");
+                statistics->discarded++;
+                continue;
+            }
+
+            if (XME_STATUS_SUCCESS == writeSample(sampleConfigurationItem, XME_COM_PACKET_SAMPLE_PAYLOAD(datagram->buffer)))
+            {
+                written++;
+            }
+        }
+    }
+    while (XME_WP_UDP_RECEIVE_BATCH_SIZE == received && ++batch < UDP_RECEIVE_MAX_BATCHES_PER_RUN);
+
+    statistics->lastQueueDepth = queueDepth;
+    if (queueDepth > statistics->maxQueueDepth)
+    {
+        statistics->maxQueueDepth = queueDepth;
+    }
+
+    return (0U != written) ? XME_STATUS_SUCCESS : XME_STATUS_INTERNAL_ERROR;
+}
+
+xme_status_t
+xme_wp_udp_udpReceive_setBatching
+(
+    bool enabled
+)
+{
+    xme_wp_udp_udpRecvBatch.enabled = enabled;
+
+    if (!enabled)
+    {
+        xme_hal_mem_free(xme_wp_udp_udpRecvBatch.storage);
+        xme_wp_udp_udpRecvBatch.storage = NULL;
+        xme_wp_udp_udpRecvBatch.datagramSize = 0U;
+    }
+
+    return XME_STATUS_SUCCESS;
+}
+
+xme_status_t
+xme_wp_udp_udpReceive_getSocketStatistics
+(
+    uint16_t port,
+    xme_wp_udp_udpReceive_socketStatistics_t* statistics
+)
+{
+    xme_hal_table_rowHandle_t socketConnectionRH = XME_HAL_TABLE_INVALID_ROW_HANDLE;
+    udpRecvSocketConnection_t* socketConnectionItem = NULL;
+
+    XME_CHECK(NULL != statistics, XME_STATUS_INVALID_PARAMETER);
+
+    XME_HAL_TABLE_GET_NEXT
+    (
+        xme_wp_udp_udpRecvSocketConnection_table,
+        xme_hal_table_rowHandle_t, socketConnectionRH,
+        udpRecvSocketConnection_t, socketConnectionItem,
+        socketConnectionItem->port == port
+    );
+    XME_CHECK(XME_HAL_TABLE_INVALID_ROW_HANDLE != socketConnectionRH, XME_STATUS_NOT_FOUND);
+
+    *statistics = socketConnectionItem->statistics;
+
+    return XME_STATUS_SUCCESS;
+}
+
 xme_status_t
 xme_wp_udp_udpReceive_getConfig
 (
@@ -312,12 +612,14 @@ xme_wp_udp_udpReceive_addConfig
 
     sizeOfTopicAndAttributes = sizeOfData;
 
-    if (XME_STATUS_SUCCESS == status) // When there is no attribute desciptor list for the given topic, then simply do nothing
+    if (XME_STATUS_SUCCESS != status) // When there is no attribute desciptor list for the given topic, then simply do nothing
     {
-        for (i = 0; i < attributeDescriptorList.length; i++)
-        {
-            sizeOfTopicAndAttributes += attributeDescriptorList.element[i].size;
-        }
+        attributeDescriptorList.length = 0U;
+    }
+
+    for (i = 0; i < attributeDescriptorList.length; i++)
+    {
+        sizeOfTopicAndAttributes += attributeDescriptorList.element[i].size;
     }
 
     XME_CHECK
@@ -424,10 +726,58 @@ xme_wp_udp_udpReceive_addConfig
         );
         socketConnectionItem->port = port;
         socketConnectionItem->count = 0;
+        (void) xme_hal_mem_set(&socketConnectionItem->statistics, 0, sizeof(socketConnectionItem->statistics));
     }
     XME_ASSERT(NULL != socketConnectionItem);
     socketConnectionItem->count++;
     configurationItem->socketHandle = socketConnectionItem->socketHandle;
+    configurationItem->socketConnection = socketConnectionItem;
+
+    // Cache the attributes contained in the payload, the attribute descriptor list is not looked up on every run
+    configurationItem->attributeCount = attributeDescriptorList.length;
+    configurationItem->attributes = NULL;
+    if (0U != attributeDescriptorList.length)
+    {
+        configurationItem->attributes = (udpRecvAttributeItem_t*) xme_hal_mem_alloc(attributeDescriptorList.length * sizeof(udpRecvAttributeItem_t));
+        XME_CHECK_REC
+        (
+            NULL != configurationItem->attributes,
+            XME_STATUS_OUT_OF_RESOURCES,
+            {
+                // Release the socket again if this configuration was its only user
+                if (0U == --socketConnectionItem->count)
+                {
+                    (void) xme_hal_net_closeSocket(socketConnectionItem->socketHandle);
+                    (void) xme_hal_net_destroySocket(socketConnectionItem->socketHandle);
+                    (void) XME_HAL_TABLE_REMOVE_ITEM(xme_wp_udp_udpRecvSocketConnection_table, socketConnectionRH);
+                }
+                xme_hal_mem_free(configurationItem->key);
+                xme_hal_sync_enterCriticalSection(xme_wp_udp_udpRecvConfigTable.criticalSectionHandle);
+                status = XME_HAL_TABLE_REMOVE_ITEM(xme_wp_udp_udpRecvConfigTable.table, configurationItemHandle);
+                xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpRecvConfigTable.criticalSectionHandle);
+                XME_CHECK(XME_STATUS_SUCCESS == status, XME_STATUS_INTERNAL_ERROR);
+            }
+        );
+        for (i = 0; i < attributeDescriptorList.length; i++)
+        {
+            configurationItem->attributes[i].key = attributeDescriptorList.element[i].key;
+            configurationItem->attributes[i].size = (uint16_t) attributeDescriptorList.element[i].size;
+        }
+    }
+
+    // Append the configuration to the chain of its key
+    {
+        udpRecvConfigItem_t** link = &udpRecvKeyIndex[UDP_RECEIVE_KEYINDEX_BUCKET(configurationItem->key)];
+
+        while (NULL != *link)
+        {
+            link = &(*link)->nextByKey;
+        }
+        configurationItem->nextByKey = NULL;
+        xme_hal_sync_enterCriticalSection(xme_wp_udp_udpRecvConfigTable.criticalSectionHandle);
+        *link = configurationItem;
+        xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpRecvConfigTable.criticalSectionHandle);
+    }
 
     if (XME_HAL_TABLE_INVALID_ROW_HANDLE != udpRecvIndex)
     {
@@ -462,7 +812,22 @@ xme_wp_udp_udpReceive_removeConfig
 
     XME_CHECK(NULL != configurationItem, XME_STATUS_INVALID_HANDLE);
 
+    // Unlink the configuration from the chain of its key
+    {
+        udpRecvConfigItem_t** link = &udpRecvKeyIndex[UDP_RECEIVE_KEYINDEX_BUCKET(configurationItem->key)];
+
+        while (NULL != *link && configurationItem != *link)
+        {
+            link = &(*link)->nextByKey;
+        }
+        XME_ASSERT(NULL != *link);
+        xme_hal_sync_enterCriticalSection(xme_wp_udp_udpRecvConfigTable.criticalSectionHandle);
+        *link = configurationItem->nextByKey;
+        xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpRecvConfigTable.criticalSectionHandle);
+    }
+
     xme_hal_mem_free(configurationItem->key);
+    xme_hal_mem_free(configurationItem->attributes);
 
     XME_HAL_TABLE_GET_NEXT
     (
@@ -497,6 +862,7 @@ xme_wp_udp_udpReceive_fini(void)
     );
     {
         xme_hal_mem_free(configurationItem->key);
+        xme_hal_mem_free(configurationItem->attributes);
     }
     XME_HAL_TABLE_ITERATE_END();
 
@@ -519,6 +885,9 @@ xme_wp_udp_udpReceive_fini(void)
     XME_HAL_TABLE_FINI(xme_wp_udp_udpRecvSocketConnection_table);
     udpRecvIndex = XME_HAL_TABLE_INVALID_ROW_HANDLE;
 
+    (void) xme_hal_mem_set(udpRecvKeyIndex, 0, sizeof(udpRecvKeyIndex));
+    (void) xme_wp_udp_udpReceive_setBatching(false);
+
     return XME_STATUS_SUCCESS;
 
 }
@@ -34,6 +34,17 @@
 /******************************************************************************/
 /***   Type definitions                                                     ***/
 /******************************************************************************/
+/**
+ * \struct udpSendAttributeItem_t
+ *
+ * \brief  Attribute appended to the payload, in the order of the payload.
+ */
+typedef struct
+{
+    xme_core_attribute_key_t key; ///< Key of the attribute.
+    uint16_t size; ///< Size of the attribute in the payload.
+} udpSendAttributeItem_t;
+
 /**
  * \struct udpSendConfigItem_t
  *
@@ -50,6 +61,9 @@ typedef struct
     char* hostname; ///< Hostname to which data is to be sent.
     uint16_t port; ///< Port of the given hostname to which data is to be sent.
     xme_hal_net_socketHandle_t socketHandle; ///< The opened socket descriptor where data will be pumped.
+    xme_hal_net_datagramDestination_t destination; ///< Destination resolved from hostname and port.
+    uint8_t attributeCount; ///< Number of attributes appended to the payload.
+    udpSendAttributeItem_t* attributes; ///< Attributes appended to the payload, resolved from the attribute descriptor list of the topic.
 } udpSendConfigItem_t;
 
 /******************************************************************************/
@@ -75,9 +89,33 @@ static xme_hal_net_socketHandle_t udpSendSocketHandle = XME_HAL_NET_INVALID_SOCK
  *        broadcast their data on the network using xme_hal_net_writeDatagram.
  */
 static xme_hal_net_socketHandle_t udpSendBroadcastSocketHandle = XME_HAL_NET_INVALID_SOCKET_HANDLE;
+
+/**
+ * \struct xme_wp_udp_udpSendBatch
+ * \brief  Datagrams that are sent with a single call when batching is enabled.
+ *         Protected by the critical section of the configuration table.
+ */
+static struct
+{
+    bool enabled; ///< Whether xme_wp_udp_udpSend_run() only queues the datagrams.
+    uint16_t count; ///< Number of queued datagrams.
+    xme_hal_net_datagram_t datagrams[XME_WP_UDP_SEND_BATCH_SIZE]; ///< Queued datagrams.
+} xme_wp_udp_udpSendBatch;
+
 /******************************************************************************/
 /***   Prototypes                                                           ***/
 /******************************************************************************/
+/**
+ * \brief  Sends all queued datagrams.
+ *
+ * \note   Must be called from within the critical section of the configuration table.
+ *
+ * \retval XME_STATUS_SUCCESS if all queued datagrams have been sent.
+ * \retval XME_STATUS_INTERNAL_ERROR if some datagrams could not be sent.
+ *         They are discarded nevertheless.
+ */
+static xme_status_t
+flushBatch(void);
 
 /******************************************************************************/
 /***   Implementation                                                       ***/
@@ -87,6 +125,9 @@ xme_wp_udp_udpSend_init(void)
 {
     XME_HAL_TABLE_INIT(xme_wp_udp_udpSendConfigTable.table);
 
+    xme_wp_udp_udpSendBatch.enabled = false;
+    xme_wp_udp_udpSendBatch.count = 0U;
+
     udpSendSocketHandle = XME_HAL_NET_INVALID_SOCKET_HANDLE;
     udpSendBroadcastSocketHandle = XME_HAL_NET_INVALID_SOCKET_HANDLE;
     XME_CHECK
@@ -105,11 +146,10 @@ xme_wp_udp_udpSend_run
 )
 {
     xme_status_t status;
-    xme_com_interface_address_t destinationAddress;
-    char ipPort[XME_COM_INTERFACE_IPV4_STRING_BUFFER_SIZE];
     udpSendConfigItem_t *configurationItem;
     void* samplePayload;
     uint32_t bytesRead=0, bytesWritten;
+    uint16_t sizeOfPacket;
     
     xme_hal_sync_enterCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
     configurationItem = XME_HAL_TABLE_ITEM_FROM_HANDLE(xme_wp_udp_udpSendConfigTable.table, (xme_hal_table_rowHandle_t) instanceId);
@@ -120,6 +160,24 @@ xme_wp_udp_udpSend_run
         NULL != configurationItem,
         XME_STATUS_INVALID_HANDLE
     );
+
+    if (xme_wp_udp_udpSendBatch.enabled)
+    {
+        uint16_t i;
+
+        // A queued datagram in the same buffer has to be sent before the buffer is overwritten
+        xme_hal_sync_enterCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+        for (i = 0U; i < xme_wp_udp_udpSendBatch.count; i++)
+        {
+            if (xme_wp_udp_udpSendBatch.datagrams[i].buffer == configurationItem->buffer)
+            {
+                (void) flushBatch();
+                break;
+            }
+        }
+        xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+    }
+
     //Create the packet in the given buffer space
     XME_COM_PACKET_INIT(*(xme_com_packet_sample_header_t*)(configurationItem->buffer), XME_COM_PACKET_HEADER_TYPE_SAMPLE);
     //And copy the key
@@ -140,64 +198,140 @@ xme_wp_udp_udpSend_run
             &bytesRead
             );
 
-    XME_CHECK(XME_STATUS_SUCCESS == status, XME_STATUS_INTERNAL_ERROR);
-    XME_CHECK(bytesRead == configurationItem->sizeOfData, XME_STATUS_INTERNAL_ERROR);
+    XME_CHECK_REC
+    (
+        XME_STATUS_SUCCESS == status && bytesRead == configurationItem->sizeOfData,
+        XME_STATUS_INTERNAL_ERROR,
+        {
+            (void) xme_core_dataHandler_completeReadOperation(configurationItem->dataId);
+        }
+    );
 
     // Read all attributes and append them to the payload
     {
-        xme_core_attribute_descriptor_list_t attributeDescriptorList;
         uint8_t i;
         uint8_t* payloadPtr = ((uint8_t*)samplePayload) + configurationItem->sizeOfData;
 
-        status = xme_core_directory_attribute_getAttributeDescriptorList(configurationItem->topic, &attributeDescriptorList);
-
-        if (XME_STATUS_SUCCESS == status) // When there is no attribute desciptor list for the given topic, then simply do nothing
+        for (i = 0; i < configurationItem->attributeCount; i++)
         {
-            for (i = 0; i < attributeDescriptorList.length; i++)
+            status = xme_core_dataHandler_readAttribute
+            (
+                configurationItem->dataId,
+                configurationItem->attributes[i].key,
+                payloadPtr,
+                configurationItem->attributes[i].size,
+                &bytesRead
+            );
+
+            payloadPtr += configurationItem->attributes[i].size;
+            
+            XME_ASSERT(status == XME_STATUS_SUCCESS);
+
+            if (status != XME_STATUS_SUCCESS || configurationItem->attributes[i].size != bytesRead)
             {
-                status = xme_core_dataHandler_readAttribute
-                (
-                    configurationItem->dataId,
-                    attributeDescriptorList.element[i].key,
-                    payloadPtr,
-                    attributeDescriptorList.element[i].size,
-                    &bytesRead
-                );
-
-                payloadPtr += attributeDescriptorList.element[i].size;
-                
-                XME_ASSERT(status == XME_STATUS_SUCCESS);
-
-                if (status != XME_STATUS_SUCCESS || attributeDescriptorList.element[i].size != bytesRead)
-                {
-                    XME_LOG(XME_LOG_WARNING, "Reading of attribute '%" PRIu32 "' failed with status %" PRIu32 ".", attributeDescriptorList.element[i].key, status);
-                }
+                XME_LOG(XME_LOG_WARNING, "Reading of attribute '%" PRIu32 "' failed with status %" PRIu32 ".", configurationItem->attributes[i].key, status);
             }
         }
     }
 
-    // send the data on the network
-    xme_hal_safeString_snprintf(ipPort,XME_COM_INTERFACE_IPV4_STRING_BUFFER_SIZE,"%s:%hu",configurationItem->hostname,configurationItem->port);
-    xme_com_interface_ipv4StringToGenericAddress(ipPort, &destinationAddress);
+    sizeOfPacket = configurationItem->sizeOfTopicAndAttributes + (uint16_t)sizeof(xme_com_packet_sample_header_t);
+
+    if (xme_wp_udp_udpSendBatch.enabled)
+    {
+        // queue the datagram, it is sent by xme_wp_udp_udpSend_flush()
+        xme_hal_sync_enterCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+        if (XME_WP_UDP_SEND_BATCH_SIZE == xme_wp_udp_udpSendBatch.count)
+        {
+            (void) flushBatch();
+        }
+        xme_wp_udp_udpSendBatch.datagrams[xme_wp_udp_udpSendBatch.count].destination = &configurationItem->destination;
+        xme_wp_udp_udpSendBatch.datagrams[xme_wp_udp_udpSendBatch.count].buffer = configurationItem->buffer;
+        xme_wp_udp_udpSendBatch.datagrams[xme_wp_udp_udpSendBatch.count].count = sizeOfPacket;
+        xme_wp_udp_udpSendBatch.count++;
+        xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+    }
+    else
+    {
+        // send the data on the network
+        bytesWritten = xme_hal_net_writeDatagramTo
+        (
+            &configurationItem->destination,
+            configurationItem->buffer,
+            sizeOfPacket
+        );
+        XME_CHECK_MSG_REC
+        (
+            0 != bytesWritten, 
+            XME_STATUS_INTERNAL_ERROR,
+            {
+                (void) xme_core_dataHandler_completeReadOperation(configurationItem->dataId);
+            },
+            XME_LOG_ALWAYS,
+            "[UDPSend] xme_hal_net_writeDatagramTo failed with bytesWritten as 0\n"
+        );
+    }
+
+    //Complete the read operation before returning
+    XME_CHECK(XME_STATUS_SUCCESS == xme_core_dataHandler_completeReadOperation(configurationItem->dataId), XME_STATUS_INTERNAL_ERROR);
+    
+    return XME_STATUS_SUCCESS;
+}
+
+xme_status_t
+xme_wp_udp_udpSend_setBatching
+(
+    bool enabled
+)
+{
+    xme_status_t status = XME_STATUS_SUCCESS;
+
+    xme_hal_sync_enterCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+    if (!enabled)
+    {
+        status = flushBatch();
+    }
+    xme_wp_udp_udpSendBatch.enabled = enabled;
+    xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+
+    return status;
+}
+
+xme_status_t
+xme_wp_udp_udpSend_flush(void)
+{
+    xme_status_t status;
+
+    xme_hal_sync_enterCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+    status = flushBatch();
+    xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+
+    return status;
+}
+
+static xme_status_t
+flushBatch(void)
+{
+    uint16_t sent;
+    uint16_t count = xme_wp_udp_udpSendBatch.count;
+
+    if (0U == count)
+    {
+        return XME_STATUS_SUCCESS;
+    }
+
+    sent = xme_hal_net_writeDatagrams(xme_wp_udp_udpSendBatch.datagrams, count);
+    xme_wp_udp_udpSendBatch.count = 0U;
 
-    bytesWritten = xme_hal_net_writeDatagram
-    (
-        configurationItem->socketHandle,
-        &destinationAddress,
-        configurationItem->buffer,
-        (configurationItem->sizeOfTopicAndAttributes + (uint16_t)sizeof(xme_com_packet_sample_header_t))
-    );
     XME_CHECK_MSG
     (
-        0 != bytesWritten, 
+        sent == count,
         XME_STATUS_INTERNAL_ERROR,
         XME_LOG_ALWAYS,
-        "[UDPSend] xme_hal_net_writeDatagram failed with bytesWritten as 0\n"
+        "[UDPSend] xme_hal_net_writeDatagrams sent only %" PRIu16 " of %" PRIu16 " datagrams\n",
+        sent,
+        count
     );
 
-    //Complete the read operation before returning
-    XME_CHECK(XME_STATUS_SUCCESS == xme_core_dataHandler_completeReadOperation(configurationItem->dataId), XME_STATUS_INTERNAL_ERROR);
-    
     return XME_STATUS_SUCCESS;
 }
 
@@ -250,18 +384,22 @@ xme_wp_udp_udpSend_addConfig
     uint16_t sizeOfTopicAndAttributes;
     uint8_t i;
     xme_core_attribute_descriptor_list_t attributeDescriptorList;
+    xme_com_interface_address_t destinationAddress;
+    char ipPort[XME_COM_INTERFACE_IPV4_STRING_BUFFER_SIZE];
     xme_status_t status;
 
     status = xme_core_directory_attribute_getAttributeDescriptorList(topic, &attributeDescriptorList);
 
     sizeOfTopicAndAttributes = sizeOfData;
 
-    if (XME_STATUS_SUCCESS == status) // When there is no attribute desciptor list for the given topic, then simply do nothing
+    if (XME_STATUS_SUCCESS != status) // When there is no attribute desciptor list for the given topic, then simply do nothing
     {
-        for (i = 0; i < attributeDescriptorList.length; i++)
-        {
-            sizeOfTopicAndAttributes += attributeDescriptorList.element[i].size;
-        }
+        attributeDescriptorList.length = 0U;
+    }
+
+    for (i = 0; i < attributeDescriptorList.length; i++)
+    {
+        sizeOfTopicAndAttributes += attributeDescriptorList.element[i].size;
     }
 
     XME_CHECK
@@ -393,6 +531,28 @@ xme_wp_udp_udpSend_addConfig
         configurationItem->hostname = (char *)xme_hal_mem_alloc(sizeof("255.255.255.255"));
         XME_CHECK(NULL != xme_hal_safeString_strncpy(configurationItem->hostname, "255.255.255.255", sizeof("255.255.255.255") ),XME_STATUS_INTERNAL_ERROR);
     }
+
+    // Resolve the destination once instead of on every run
+    xme_hal_safeString_snprintf(ipPort,XME_COM_INTERFACE_IPV4_STRING_BUFFER_SIZE,"%s:%hu",configurationItem->hostname,port);
+    XME_CHECK_REC
+    (
+        XME_STATUS_SUCCESS == xme_com_interface_ipv4StringToGenericAddress(ipPort, &destinationAddress)
+        && XME_STATUS_SUCCESS == xme_hal_net_resolveDatagramDestination
+        (
+            (isBroadcast ? udpSendBroadcastSocketHandle : udpSendSocketHandle),
+            &destinationAddress,
+            &configurationItem->destination
+        ),
+        XME_STATUS_INVALID_PARAMETER,
+        {
+            xme_hal_mem_free(configurationItem->hostname);
+            xme_hal_sync_enterCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+            (void) XME_HAL_TABLE_REMOVE_ITEM(xme_wp_udp_udpSendConfigTable.table, configurationItemHandle);
+            xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+            XME_LOG(XME_LOG_ERROR,"[udpSendWayPoint] Destination '%s' could not be resolved\n", ipPort);
+        }
+    );
+
     configurationItem->key = (void *)xme_hal_mem_alloc(XME_WP_UDP_HEADER_KEY_LENGTH);
     xme_hal_mem_copy(configurationItem->key,key,XME_WP_UDP_HEADER_KEY_LENGTH);
     configurationItem->port = port;
@@ -403,6 +563,31 @@ xme_wp_udp_udpSend_addConfig
     configurationItem->buffer = buffer;
     configurationItem->socketHandle = (isBroadcast ? udpSendBroadcastSocketHandle : udpSendSocketHandle);
 
+    // Cache the attributes to append, the attribute descriptor list is not looked up on every run
+    configurationItem->attributeCount = attributeDescriptorList.length;
+    configurationItem->attributes = NULL;
+    if (0U != attributeDescriptorList.length)
+    {
+        configurationItem->attributes = (udpSendAttributeItem_t*) xme_hal_mem_alloc(attributeDescriptorList.length * sizeof(udpSendAttributeItem_t));
+        XME_CHECK_REC
+        (
+            NULL != configurationItem->attributes,
+            XME_STATUS_OUT_OF_RESOURCES,
+            {
+                xme_hal_mem_free(configurationItem->hostname);
+                xme_hal_mem_free(configurationItem->key);
+                xme_hal_sync_enterCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+                (void) XME_HAL_TABLE_REMOVE_ITEM(xme_wp_udp_udpSendConfigTable.table, configurationItemHandle);
+                xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+            }
+        );
+        for (i = 0; i < attributeDescriptorList.length; i++)
+        {
+            configurationItem->attributes[i].key = attributeDescriptorList.element[i].key;
+            configurationItem->attributes[i].size = (uint16_t) attributeDescriptorList.element[i].size;
+        }
+    }
+
     return XME_STATUS_SUCCESS;
 }
 
@@ -425,8 +610,11 @@ xme_wp_udp_udpSend_removeConfig
 
     xme_hal_mem_free(configurationItem->hostname);
     xme_hal_mem_free(configurationItem->key);
+    xme_hal_mem_free(configurationItem->attributes);
 
     xme_hal_sync_enterCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
+    // Queued datagrams refer to the destination of the configuration
+    (void) flushBatch();
     status = XME_HAL_TABLE_REMOVE_ITEM(xme_wp_udp_udpSendConfigTable.table, (xme_hal_table_rowHandle_t)(instanceId));
     xme_hal_sync_leaveCriticalSection(xme_wp_udp_udpSendConfigTable.criticalSectionHandle);
 
@@ -439,6 +627,10 @@ xme_status_t
 xme_wp_udp_udpSend_fini(void)
 {
     xme_status_t status;
+
+    (void) flushBatch();
+    xme_wp_udp_udpSendBatch.enabled = false;
+
     XME_HAL_TABLE_ITERATE_BEGIN
     (
         xme_wp_udp_udpSendConfigTable.table,
@@ -448,6 +640,7 @@ xme_wp_udp_udpSend_fini(void)
     {
         xme_hal_mem_free(configurationItem->hostname);
         xme_hal_mem_free(configurationItem->key);
+        xme_hal_mem_free(configurationItem->attributes);
     }
     XME_HAL_TABLE_ITERATE_END();
 
@@ -371,6 +371,126 @@ TEST_F(UDPWaypointInterfaceTest, DISABLED_sendAndReadAndBroadcastTogether)
     EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_removeConfig(udpReceiveInstanceId2));
 }
 
+TEST_F(UDPWaypointInterfaceTest, sendAndReadBatched)
+{
+    xme_status_t status;
+    uint8_t successCount = 0U;
+    uint32_t bytesRead, stringLen;
+    uint8_t loopCount = 10U;
+    uint8_t key1[] = { 1, 2, 3, 5 };
+
+    stringLen = strlen(STRING) + 1;
+    topicRecv = (char*) xme_hal_mem_alloc(stringLen);
+    topicSend = (char*) xme_hal_mem_alloc(stringLen);
+    xme_hal_safeString_strncpy(topicSend, STRING, stringLen);
+
+    recvBuffer = (char*) xme_hal_mem_alloc(strlen(topicSend) + xme_wp_udp_udpReceive_getPackageOverHead());
+    sendBuffer = (char*) xme_hal_mem_alloc(strlen(topicSend) + xme_wp_udp_udpSend_getPackageOverHead());
+
+    udpRecvTest(33221u, strlen(topicSend), key1);
+    udpSendTest("127.0.0.1", 33221u, (uint16_t) strlen(topicSend), key1);
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_setBatching(true));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeData((xme_core_dataManager_dataPacketId_t) dataPortSend, topicSend, strlen(topicSend)));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_run(udpSendInstanceId1));
+
+    // The datagram is only queued until the batch is flushed
+    xme_hal_sleep_sleep(xme_hal_time_timeIntervalFromMilliseconds(100));
+    EXPECT_EQ(XME_STATUS_INTERNAL_ERROR, xme_wp_udp_udpReceive_run(udpReceiveInstanceId1));
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_flush());
+    while (loopCount-- > 0U)
+    {
+        XME_LOG(XME_LOG_ALWAYS,"Waiting for data in sendAndReadBatched (loop count %u)\n", loopCount);
+        xme_hal_sleep_sleep(xme_hal_time_timeIntervalFromMilliseconds(100));
+        status = xme_wp_udp_udpReceive_run(udpReceiveInstanceId1); // returns XME_STATUS_INTERNAL_ERROR if no data available
+        if (XME_STATUS_SUCCESS == status) successCount++;
+        EXPECT_TRUE(XME_STATUS_SUCCESS == status || XME_STATUS_INTERNAL_ERROR == status);
+    }
+    ASSERT_EQ(1U, successCount);
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_readData((xme_core_dataManager_dataPacketId_t) dataPortSend, topicRecv, stringLen, &bytesRead));
+    EXPECT_EQ(0, xme_hal_mem_compare(topicRecv, topicSend, strlen(topicSend)));
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_setBatching(false));
+
+    xme_hal_mem_free(sendBuffer);
+    xme_hal_mem_free(recvBuffer);
+
+    xme_hal_mem_free(topicSend);
+    xme_hal_mem_free(topicRecv);
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_removeConfig(udpSendInstanceId1));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_removeConfig(udpReceiveInstanceId1));
+}
+
+TEST_F(UDPWaypointInterfaceTest, readBatchedWithSeveralKeys)
+{
+    xme_wp_waypoint_instanceId_t udpSendInstanceId3 = XME_WP_WAYPOINT_INSTANCEID_INVALID;
+    xme_wp_udp_udpReceive_socketStatistics_t statistics;
+    uint32_t bytesRead, stringLen;
+    uint16_t bufferSize;
+    uint8_t key1[] = { 1, 2, 3, 6 };
+    uint8_t key2[] = { 1, 2, 3, 7 };
+    uint8_t unknownKey[] = { 1, 2, 3, 8 };
+
+    stringLen = strlen(STRING) + 1;
+    topicRecv = (char*) xme_hal_mem_alloc(stringLen);
+    topicSend = (char*) xme_hal_mem_alloc(stringLen);
+    xme_hal_safeString_strncpy(topicSend, STRING, stringLen);
+
+    bufferSize = (uint16_t) (stringLen + xme_wp_udp_udpReceive_getPackageOverHead());
+    recvBuffer = (char*) xme_hal_mem_alloc(bufferSize);
+    sendBuffer = (char*) xme_hal_mem_alloc(bufferSize);
+
+    // Two configurations on the same port, only the first one is run
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_addConfig(&udpReceiveInstanceId1, (xme_core_dataManager_dataPacketId_t) 1, (xme_core_topic_t) 1, (uint16_t) stringLen, recvBuffer, bufferSize, key1, 33222u));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_addConfig(&udpReceiveInstanceId2, (xme_core_dataManager_dataPacketId_t) 3, (xme_core_topic_t) 1, (uint16_t) stringLen, recvBuffer, bufferSize, key2, 33222u));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_addConfig(&udpSendInstanceId1, (xme_core_dataManager_dataPacketId_t) 2, (xme_core_topic_t) 1, (uint16_t) stringLen, sendBuffer, bufferSize, key1, "127.0.0.1", 33222u, false));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_addConfig(&udpSendInstanceId2, (xme_core_dataManager_dataPacketId_t) 4, (xme_core_topic_t) 1, (uint16_t) stringLen, sendBuffer, bufferSize, key2, "127.0.0.1", 33222u, false));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_addConfig(&udpSendInstanceId3, (xme_core_dataManager_dataPacketId_t) 0, (xme_core_topic_t) 1, (uint16_t) stringLen, sendBuffer, bufferSize, unknownKey, "127.0.0.1", 33222u, false));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeData((xme_core_dataManager_dataPacketId_t) 2, STRING, stringLen));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeData((xme_core_dataManager_dataPacketId_t) 4, STRING2, strlen(STRING2) + 1));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeData((xme_core_dataManager_dataPacketId_t) 0, STRING2, strlen(STRING2) + 1));
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_run(udpSendInstanceId3));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_run(udpSendInstanceId2));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_run(udpSendInstanceId1));
+    xme_hal_sleep_sleep(xme_hal_time_timeIntervalFromMilliseconds(100));
+
+    // A single run receives all queued datagrams and dispatches them by key
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_setBatching(true));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_run(udpReceiveInstanceId1));
+    EXPECT_EQ(XME_STATUS_INTERNAL_ERROR, xme_wp_udp_udpReceive_run(udpReceiveInstanceId1));
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_readData((xme_core_dataManager_dataPacketId_t) 1, topicRecv, stringLen, &bytesRead));
+    EXPECT_STREQ(STRING, topicRecv);
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_readData((xme_core_dataManager_dataPacketId_t) 3, topicRecv, strlen(STRING2) + 1, &bytesRead));
+    EXPECT_STREQ(STRING2, topicRecv);
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_getSocketStatistics(33222u, &statistics));
+    EXPECT_EQ(3U, statistics.received);
+    EXPECT_EQ(1U, statistics.discarded);
+    EXPECT_EQ(0U, statistics.lastQueueDepth);
+    EXPECT_EQ(3U, statistics.maxQueueDepth);
+    EXPECT_EQ(XME_STATUS_NOT_FOUND, xme_wp_udp_udpReceive_getSocketStatistics(33223u, &statistics));
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_setBatching(false));
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_removeConfig(udpSendInstanceId1));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_removeConfig(udpSendInstanceId2));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_removeConfig(udpSendInstanceId3));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_removeConfig(udpReceiveInstanceId1));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpReceive_removeConfig(udpReceiveInstanceId2));
+
+    xme_hal_mem_free(sendBuffer);
+    xme_hal_mem_free(recvBuffer);
+
+    xme_hal_mem_free(topicSend);
+    xme_hal_mem_free(topicRecv);
+}
+
 TEST_F(UDPWaypointInterfaceTest, sendAndReadWithAttributes)
 {
     xme_status_t status;
@@ -27,6 +27,7 @@
 #include "xme/core/dataHandler/include/dataHandler.h"
 #include "xme/core/dataHandler/include/dataHandlerConfigurator.h"
 #include "xme/core/broker/include/broker.h"
+#include "xme/core/directory/include/attribute.h"
 
 #include "xme/wp/test/testUtil.h"
 #include "xme/wp/udp/include/udpSend.h"
@@ -34,8 +35,10 @@
 
 #include "xme/hal/include/time.h"
 #include "xme/hal/include/mem.h"
+#include "xme/hal/include/safeString.h"
 
 #include <inttypes.h>
+#include <time.h>
 
 /******************************************************************************/
 /***   Defines                                                              ***/
@@ -43,6 +46,7 @@
 #define CONFIG_COUNT 100 ///< How many configurations will be added to the waypoints.
 #define WCET_IN_NS_UDP_SEND    100000000 ///< Error triggered, when maximum measured wcet of xme_wp_udp_udpSend_run exceeds this value.
 #define WCET_IN_NS_UDP_RECEIVE 100000000 ///< Error triggered, when maximum measured wcet of xme_wp_udp_udpReceive_run exceeds this value.
+#define THROUGHPUT_ROUNDS 200 ///< How often all udp send configurations are run in the throughput measurement.
 
 /******************************************************************************/
 /***   Type definitions                                                     ***/
@@ -64,6 +68,8 @@ protected:
 
     xme_wp_waypoint_instanceId_t udpSendInstanceIds[CONFIG_COUNT];
     xme_wp_waypoint_instanceId_t udpReceiveInstanceIds[CONFIG_COUNT];
+    xme_core_dataManager_dataPacketId_t udpSendDataPacketId;
+    void* udpSendBuffers[CONFIG_COUNT];
 
     MeasurementTest()
     {
@@ -81,12 +87,19 @@ protected:
 
     virtual ~MeasurementTest()
     {
+        uint32_t i;
+
         xme_wp_udp_udpSend_fini();
         xme_wp_udp_udpReceive_fini();
         xme_core_broker_fini();
         xme_core_dataHandler_fini();
         xme_hal_net_fini();
         xme_hal_sync_fini();
+
+        for (i = 0; i < CONFIG_COUNT; i++)
+        {
+            xme_hal_mem_free(udpSendBuffers[i]);
+        }
     }
 
     /**
@@ -96,7 +109,6 @@ protected:
     {
 
         xme_core_dataManager_dataPacketId_t dataPacketId;
-        void* buffer;
         uint32_t i;
         uint8_t key[] = {0, 0, 0, 1};
 #if 0
@@ -112,9 +124,12 @@ protected:
         metadata.element = metadata_elements;
 #endif // #if 0
 
-        buffer = xme_hal_mem_alloc(sizeof(testStrcut_t) + xme_wp_udp_udpSend_getPackageOverHead());
-
         status = xme_core_dataHandler_createDataPacket(sizeof(testStrcut_t), &dataPacketId);
+        udpSendDataPacketId = dataPacketId;
+        XME_ASSERT_NORVAL(XME_STATUS_SUCCESS == status);
+
+        // Keep the sample, so that every run of the waypoint sends it
+        status = xme_core_dataHandler_setDataPacketPersistency(dataPacketId, true);
 
 #if 0
         // Create subscription, which will be used in all configurations
@@ -137,16 +152,20 @@ protected:
         xme_core_dataHandler_configure();
 
         // Add configurations
-        // Every configuration will use the same port, buffer and topic (this should not influence execution time)
+        // Every configuration will use the same port and topic (this should not influence execution time)
+        // Each configuration has its own buffer, so that the datagrams can be batched
         for (i = 0; i < CONFIG_COUNT; i++)
         {
+            udpSendBuffers[i] = xme_hal_mem_alloc(sizeof(testStrcut_t) + xme_wp_udp_udpSend_getPackageOverHead());
+            key[0] = (uint8_t) i;
+
             xme_wp_udp_udpSend_addConfig
             (
                 &udpSendInstanceIds[i],
                 dataPacketId,
                 (xme_core_topic_t)XME_CORE_TOPIC_USER,
                 sizeof(testStrcut_t),
-                buffer,
+                udpSendBuffers[i],
                 sizeof(testStrcut_t) + xme_wp_udp_udpSend_getPackageOverHead(),
                 key,
                 "127.0.0.1",
@@ -222,6 +241,106 @@ protected:
 
 };
 
+/**
+ * \brief Runs all udp send configurations THROUGHPUT_ROUNDS times and reports
+ *        the achieved messages per second and the CPU time per message.
+ *
+ * \param[in] name Name of the measured variant.
+ * \param[in] run Function that sends the datagram of the given configuration.
+ * \param[in] flush Function called after each round, may be NULL.
+ * \param[in] instanceIds Configurations to run.
+ */
+static void
+measureThroughput
+(
+    const char* name,
+    xme_status_t (*run)(xme_wp_waypoint_instanceId_t instanceId),
+    xme_status_t (*flush)(void),
+    xme_wp_waypoint_instanceId_t* instanceIds
+)
+{
+    xme_hal_time_timeHandle_t startTimeHandle;
+    xme_hal_time_timeInterval_t wallTime;
+    clock_t startCpuTime;
+    double cpuTime;
+    uint32_t failures = 0U;
+    uint32_t round;
+    uint32_t i;
+    uint64_t messages = (uint64_t) THROUGHPUT_ROUNDS * CONFIG_COUNT;
+
+    startCpuTime = clock();
+    startTimeHandle = xme_hal_time_getCurrentTime();
+
+    for (round = 0; round < THROUGHPUT_ROUNDS; round++)
+    {
+        for (i = 0; i < CONFIG_COUNT; i++)
+        {
+            if (XME_STATUS_SUCCESS != run(instanceIds[i]))
+            {
+                failures++;
+            }
+        }
+
+        if (NULL != flush && XME_STATUS_SUCCESS != flush())
+        {
+            failures++;
+        }
+    }
+
+    wallTime = xme_hal_time_getTimeInterval(&startTimeHandle, false);
+    cpuTime = (double) (clock() - startCpuTime) / CLOCKS_PER_SEC;
+
+    XME_LOG
+    (
+        XME_LOG_NOTE,
+        "Throughput of %s over loopback with %" PRIu32 " configurations:\n"
+        "Messages per second: %12.0f\n"
+        "CPU time per message: %11.0f ns\n",
+        name, (uint32_t) CONFIG_COUNT,
+        (double) messages * 1000000000.0 / (double) (0U != wallTime ? wallTime : 1U),
+        cpuTime * 1000000000.0 / (double) messages
+    );
+
+    EXPECT_EQ(0U, failures) << "Sending failed in " << name;
+}
+
+/**
+ * \brief Sends the sample like xme_wp_udp_udpSend_run() did before the
+ *        configuration was resolved at xme_wp_udp_udpSend_addConfig():
+ *        looks up the attributes and translates the destination on every run.
+ *        Serves as reference in the throughput measurement.
+ */
+static xme_core_dataManager_dataPacketId_t referenceDataPacketId;
+static xme_hal_net_socketHandle_t referenceSocketHandle;
+static void* referenceBuffer;
+
+static xme_status_t
+referenceRun
+(
+    xme_wp_waypoint_instanceId_t instanceId
+)
+{
+    xme_core_attribute_descriptor_list_t attributeDescriptorList;
+    xme_com_interface_address_t destinationAddress;
+    char ipPort[XME_COM_INTERFACE_IPV4_STRING_BUFFER_SIZE];
+    uint32_t bytesRead = 0;
+    uint16_t size = (uint16_t) (sizeof(testStrcut_t) + xme_wp_udp_udpSend_getPackageOverHead());
+
+    XME_UNUSED_PARAMETER(instanceId);
+
+    XME_CHECK(XME_STATUS_SUCCESS == xme_core_dataHandler_startReadOperation(referenceDataPacketId), XME_STATUS_INTERNAL_ERROR);
+    XME_CHECK(XME_STATUS_SUCCESS == xme_core_dataHandler_readData(referenceDataPacketId, (uint8_t*) referenceBuffer + xme_wp_udp_udpSend_getPackageOverHead(), sizeof(testStrcut_t), &bytesRead), XME_STATUS_INTERNAL_ERROR);
+    (void) xme_core_directory_attribute_getAttributeDescriptorList((xme_core_topic_t)XME_CORE_TOPIC_USER, &attributeDescriptorList);
+
+    xme_hal_safeString_snprintf(ipPort, XME_COM_INTERFACE_IPV4_STRING_BUFFER_SIZE, "%s:%hu", "127.0.0.1", (uint16_t) 12345);
+    xme_com_interface_ipv4StringToGenericAddress(ipPort, &destinationAddress);
+    XME_CHECK(0U != xme_hal_net_writeDatagram(referenceSocketHandle, &destinationAddress, referenceBuffer, size), XME_STATUS_INTERNAL_ERROR);
+
+    XME_CHECK(XME_STATUS_SUCCESS == xme_core_dataHandler_completeReadOperation(referenceDataPacketId), XME_STATUS_INTERNAL_ERROR);
+
+    return XME_STATUS_SUCCESS;
+}
+
 /******************************************************************************/
 /***   Tests                                                                ***/
 /******************************************************************************/
@@ -243,6 +362,32 @@ TEST_F(MeasurementTest, udpSendRunMeasurement)
     ) << "Expected WCET of xme_wp_udp_udpSend_run() exceeded!";
 }
 
+TEST_F(MeasurementTest, udpSendThroughputMeasurement)
+{
+    testStrcut_t sample;
+
+    sample.x = 42U;
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_startWriteOperation(udpSendDataPacketId));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_writeData(udpSendDataPacketId, &sample, sizeof(sample)));
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_core_dataHandler_completeWriteOperation(udpSendDataPacketId));
+
+    referenceDataPacketId = udpSendDataPacketId;
+    referenceBuffer = udpSendBuffers[0];
+    referenceSocketHandle = xme_hal_net_createSocket(NULL, XME_HAL_NET_SOCKET_UDP | XME_HAL_NET_SOCKET_NONBLOCKING, NULL, 0);
+    ASSERT_NE(XME_HAL_NET_INVALID_SOCKET_HANDLE, referenceSocketHandle);
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_hal_net_openSocket(referenceSocketHandle));
+
+    measureThroughput("per-run resolution (reference)", &referenceRun, NULL, udpSendInstanceIds);
+    measureThroughput("xme_wp_udp_udpSend_run()", &xme_wp_udp_udpSend_run, NULL, udpSendInstanceIds);
+
+    ASSERT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_setBatching(true));
+    measureThroughput("xme_wp_udp_udpSend_run() with batching", &xme_wp_udp_udpSend_run, &xme_wp_udp_udpSend_flush, udpSendInstanceIds);
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_wp_udp_udpSend_setBatching(false));
+
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_net_closeSocket(referenceSocketHandle));
+    EXPECT_EQ(XME_STATUS_SUCCESS, xme_hal_net_destroySocket(referenceSocketHandle));
+}
+
 TEST_F(MeasurementTest, udpReceiveRunMeasurement)
 {
     EXPECT_FALSE